@@ -35,6 +35,9 @@ public:
 		return world;
 	}
 
+	/// <summary>ブロードフェーズ用のワールド範囲</summary>
+	AABB GetWorldBounds() override { return GetWorldAABB(); }
+
 protected:
 	AABB aabb_ = { {-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f} };
 };
@@ -0,0 +1,53 @@
+#define NOMINMAX
+#include "CapsuleCollider.h"
+#include "DebugDrawLineSystem.h"
+#include <algorithm>
+
+using namespace MyMath;
+
+CapsuleMath CapsuleCollider::GetWorldCapsule() {
+	const Matrix4x4 rotateMatrix = GetWorldRotateMatrix();
+	const Vector3 position = GetWorldPosition();
+
+	CapsuleMath capsule;
+	capsule.segment.origin = position + TransformNormal(localStart_, rotateMatrix);
+	capsule.segment.diff = TransformNormal(localEnd_ - localStart_, rotateMatrix);
+	capsule.radius = radius_;
+	return capsule;
+}
+
+AABB CapsuleCollider::ComputeBounds(const CapsuleMath& capsule) {
+	const Vector3& start = capsule.segment.origin;
+	const Vector3 end = start + capsule.segment.diff;
+	const float r = capsule.radius;
+	return {
+		{ std::min(start.x, end.x) - r, std::min(start.y, end.y) - r, std::min(start.z, end.z) - r },
+		{ std::max(start.x, end.x) + r, std::max(start.y, end.y) + r, std::max(start.z, end.z) + r },
+	};
+}
+
+void CapsuleCollider::DebugLineAdd() {
+	if (!isColliderVisible_) return;
+
+	DebugDrawLineSystem* debugDraw = DebugDrawLineSystem::GetInstance();
+	if (!debugDraw) return;
+
+	const CapsuleMath capsule = GetWorldCapsule();
+	const Vector3& start = capsule.segment.origin;
+	const Vector3 end = start + capsule.segment.diff;
+
+	// 両端の球
+	debugDraw->DrawSphere(start, capsule.radius, currentColliderColor_);
+	debugDraw->DrawSphere(end, capsule.radius, currentColliderColor_);
+
+	// 側面の4本（中心線に垂直な2方向）
+	Vector3 axis = capsule.segment.diff;
+	if (Length(axis) <= 0.0f) { return; }
+	axis = Normalize(axis);
+	const Vector3 reference = std::abs(axis.y) < 0.99f ? Vector3{ 0.0f, 1.0f, 0.0f } : Vector3{ 1.0f, 0.0f, 0.0f };
+	const Vector3 side = Normalize(Cross(axis, reference)) * capsule.radius;
+	const Vector3 up = Normalize(Cross(side, axis)) * capsule.radius;
+	for (const Vector3& offset : { side, side * -1.0f, up, up * -1.0f }) {
+		debugDraw->AddLine(start + offset, end + offset, currentColliderColor_);
+	}
+}
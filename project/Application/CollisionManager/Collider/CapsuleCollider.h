@@ -0,0 +1,55 @@
+#pragma once
+#include "ICollider.h"
+#include "Engine/MyMath/MyFunction.h"
+
+/// <summary>
+/// カプセルコライダー（線分 + 半径）
+/// </summary>
+class CapsuleCollider : public ICollider {
+public:
+	CapsuleCollider() { colliderType_ = ColliderType::CAPSULE; }
+
+	void DebugLineAdd() override;
+
+	float GetRadius() const { return radius_; }
+	void SetRadius(float radius) { radius_ = radius; }
+
+	/// <summary>中心線の両端（ローカル座標、回転前）</summary>
+	const Vector3& GetLocalStart() const { return localStart_; }
+	const Vector3& GetLocalEnd() const { return localEnd_; }
+	void SetSegment(const Vector3& localStart, const Vector3& localEnd) {
+		localStart_ = localStart;
+		localEnd_ = localEnd;
+	}
+
+	/// <summary>Y軸方向の高さ（半球を除いた中心線の長さ）で中心線をセット</summary>
+	void SetHeight(float height) {
+		localStart_ = { 0.0f, -height * 0.5f, 0.0f };
+		localEnd_ = { 0.0f, height * 0.5f, 0.0f };
+	}
+
+	/// <summary>回転（ラジアン、XYZ順）</summary>
+	const Vector3& GetCapsuleRotate() const { return rotate_; }
+	void SetCapsuleRotate(const Vector3& rotate) { rotate_ = rotate; }
+
+	/// <summary>
+	/// ワールドの回転行列（既定は SetCapsuleRotate の値）
+	/// 親の回転に追従させたい場合はオーバーライドする
+	/// </summary>
+	virtual Matrix4x4 GetWorldRotateMatrix() { return MyMath::MakeRotateXYZMatrix(rotate_); }
+
+	/// <summary>衝突判定用のカプセルをワールド座標で返す</summary>
+	CapsuleMath GetWorldCapsule();
+
+	/// <summary>ブロードフェーズ用のワールド範囲（カプセルを囲むAABB）</summary>
+	AABB GetWorldBounds() override { return ComputeBounds(GetWorldCapsule()); }
+
+	/// <summary>カプセルを囲むAABB</summary>
+	static AABB ComputeBounds(const CapsuleMath& capsule);
+
+protected:
+	float radius_ = 0.5f;
+	Vector3 localStart_ = { 0.0f, -0.5f, 0.0f };
+	Vector3 localEnd_ = { 0.0f, 0.5f, 0.0f };
+	Vector3 rotate_ = { 0.0f, 0.0f, 0.0f };
+};
@@ -1,6 +1,7 @@
 #pragma once
 #define NOMINMAX
 #include <algorithm>
+#include <cfloat>
 #include "Engine.h"
 #include "CollisionManager/CollisionConfig.h"
 
@@ -12,12 +13,22 @@
 enum class ColliderType {
 	SPHERE = 0,		// 球体
 	AABB = 1,		// AABB
-	OBB = 2,		// OBB(未実装)
+	OBB = 2,		// OBB
 	SPRITE = 3,		// 2Dスプライト
-	CAPSULE = 4,	// カプセル（未実装）
+	CAPSULE = 4,	// カプセル
+	MESH = 5,		// 静的な三角形メッシュ
 	Count			// 配列サイズ用
 };
 
+/// <summary>
+/// 接触の詳細（Enter / Stay のコールバックに渡す）
+/// </summary>
+struct CollisionContactInfo {
+	// フレーム内で最初に接触した時刻（0:前フレームの位置 1:今フレームの位置）
+	// 連続判定（SetContinuous）のコライダーを含むペアで求まり、それ以外は今フレームの位置での判定なので 1
+	float timeOfImpact = 1.0f;
+};
+
 /// <summary>
 /// コライダー基底インターフェース
 /// </summary>
@@ -28,15 +39,29 @@ public:
 	/// <summary>衝突し始めたフレームに呼ばれる</summary>
 	virtual void OnCollisionEnter(ICollider* other) {}
 
+	/// <summary>衝突し始めたフレームに呼ばれる（接触の詳細付き、既定は OnCollisionEnter(other) を呼ぶ）</summary>
+	virtual void OnCollisionEnter(ICollider* other, const CollisionContactInfo& info) { OnCollisionEnter(other); }
+
 	/// <summary>衝突し続けている間、毎フレーム呼ばれる</summary>
 	virtual void OnCollisionStay(ICollider* other) {}
 
+	/// <summary>衝突し続けている間、毎フレーム呼ばれる（接触の詳細付き、既定は OnCollisionStay(other) を呼ぶ）</summary>
+	virtual void OnCollisionStay(ICollider* other, const CollisionContactInfo& info) { OnCollisionStay(other); }
+
 	/// <summary>衝突が終わったフレームに呼ばれる</summary>
 	virtual void OnCollisionExit(ICollider* other) {}
 
 	/// <summary>ワールド座標を取得</summary>
 	virtual Vector3 GetWorldPosition() = 0;
 
+	/// <summary>
+	/// ブロードフェーズ用のワールド範囲を取得
+	/// 未対応の型は無限大の範囲を返し、ブロードフェーズでは全コライダーと総当たりになる
+	/// </summary>
+	virtual AABB GetWorldBounds() {
+		return { { -FLT_MAX, -FLT_MAX, -FLT_MAX }, { FLT_MAX, FLT_MAX, FLT_MAX } };
+	}
+
 	/// <summary>デバッグ描画（派生クラスでオーバーライド）</summary>
 	virtual void DebugLineAdd() {}
 
@@ -50,6 +75,29 @@ public:
 	uint32_t GetCollisionMask() const { return collisionMask_; }
 	void SetCollisionMask(uint32_t mask) { collisionMask_ = mask; }
 
+	// --- 連続判定（球のみ、前フレームの位置から今フレームの位置までの移動全体で判定する） ---
+
+	/// <summary>速い弾など、1フレームの移動で薄い物体をすり抜けるものに使う</summary>
+	bool IsContinuous() const { return isContinuous_; }
+	void SetContinuous(bool continuous) {
+		isContinuous_ = continuous;
+		hasSweepStart_ = false;
+	}
+
+	/// <summary>移動の始点を忘れる（ワープした時など、次の判定は今の位置だけで行う）</summary>
+	void ResetSweep() { hasSweepStart_ = false; }
+
+	/// <summary>
+	/// 今フレームの移動の始点を取得し、次フレームの始点として current を覚える（CollisionManager が1フレームに1回呼ぶ）
+	/// 始点がまだ無ければ current を返す
+	/// </summary>
+	Vector3 AdvanceSweep(const Vector3& current) {
+		const Vector3 start = hasSweepStart_ ? sweepStart_ : current;
+		sweepStart_ = current;
+		hasSweepStart_ = true;
+		return start;
+	}
+
 	// --- デバッグ表示 ---
 	bool IsColliderVisible() const { return isColliderVisible_; }
 	void SetColliderVisible(bool visible) { isColliderVisible_ = visible; }
@@ -68,4 +116,7 @@ protected:
 	bool isColliderVisible_ = true;
 	uint32_t defaultColliderColor_ = 0x00FF00FF;
 	uint32_t currentColliderColor_ = 0x00FF00FF;
+	bool isContinuous_ = false;
+	bool hasSweepStart_ = false;
+	Vector3 sweepStart_ = {};
 };
@@ -0,0 +1,118 @@
+#include "MeshCollider.h"
+#include "DebugDrawLineSystem.h"
+#include "Model.h"
+#include "Logger.h"
+#include <unordered_map>
+
+namespace {
+
+	/// <summary>
+	/// モデルのパスごとのローカル座標の木（同じモデルを置いたコライダー同士で共有する）
+	/// 使っているコライダーが無くなったら解放されるよう weak_ptr で持つ
+	/// </summary>
+	std::unordered_map<std::string, std::weak_ptr<const CollisionMesh>>& GetSharedMeshes() {
+		static std::unordered_map<std::string, std::weak_ptr<const CollisionMesh>> sharedMeshes;
+		return sharedMeshes;
+	}
+
+	/// <summary>モデルの全メッシュの三角形を頂点座標のリストにする（インデックスがあれば展開する）</summary>
+	std::vector<Vector3> CollectPositions(const Model& model) {
+		std::vector<Vector3> positions;
+		for (const Mesh& mesh : model.GetMeshes()) {
+			const std::vector<VertexData>& vertices = mesh.GetVertices();
+			auto push = [&](uint32_t index) {
+				const Vector4& p = vertices[index].position;
+				positions.push_back({ p.x, p.y, p.z });
+			};
+			if (mesh.HasIndices()) {
+				const std::vector<uint32_t>& indices = mesh.GetIndices();
+				for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+					push(indices[i]);
+					push(indices[i + 1]);
+					push(indices[i + 2]);
+				}
+			} else {
+				for (uint32_t i = 0; i + 2 < vertices.size(); i += 3) {
+					push(i);
+					push(i + 1);
+					push(i + 2);
+				}
+			}
+		}
+		return positions;
+	}
+}
+
+void MeshCollider::SetMesh(const Model* model) {
+	if (!model) {
+		localMesh_.reset();
+		worldMesh_.Clear();
+		return;
+	}
+
+	// 同じモデルの木が既にあれば共有する
+	const std::string& filePath = model->GetFilePath();
+	auto& sharedMeshes = GetSharedMeshes();
+	if (auto it = sharedMeshes.find(filePath); it != sharedMeshes.end()) {
+		if (std::shared_ptr<const CollisionMesh> shared = it->second.lock()) {
+			localMesh_ = std::move(shared);
+			worldMesh_.Transform(*localMesh_, worldMatrix_);
+			return;
+		}
+	}
+
+	auto mesh = std::make_shared<CollisionMesh>();
+	const std::string cachePath = MakeCachePath(filePath);
+	if (mesh->LoadOrBuild(CollectPositions(*model), cachePath)) {
+		Logger::Log(Logger::GetStream(),
+			std::format("MeshCollider: Loaded BVH cache '{}' ({} triangles)\n", cachePath, mesh->GetTriangleCount()));
+	}
+	sharedMeshes[filePath] = mesh;
+	localMesh_ = std::move(mesh);
+	worldMesh_.Transform(*localMesh_, worldMatrix_);
+}
+
+void MeshCollider::SetMesh(const std::vector<Vector3>& positions, const std::string& cachePath) {
+	auto mesh = std::make_shared<CollisionMesh>();
+	mesh->LoadOrBuild(positions, cachePath);
+	localMesh_ = std::move(mesh);
+	worldMesh_.Transform(*localMesh_, worldMatrix_);
+}
+
+void MeshCollider::SetWorldMatrix(const Matrix4x4& worldMatrix) {
+	worldMatrix_ = worldMatrix;
+	if (localMesh_) {
+		worldMesh_.Transform(*localMesh_, worldMatrix_);
+	}
+}
+
+std::string MeshCollider::MakeCachePath(const std::string& modelFilePath) {
+	// プリミティブは "primitive_..." でファイルが無い
+	const size_t slash = modelFilePath.find_last_of("/\\");
+	if (slash == std::string::npos) {
+		return "";
+	}
+	const size_t dot = modelFilePath.find_last_of('.');
+	const std::string stem = (dot != std::string::npos && dot > slash) ? modelFilePath.substr(0, dot) : modelFilePath;
+	return stem + ".colmesh";
+}
+
+void MeshCollider::DebugLineAdd() {
+	if (!isColliderVisible_) return;
+
+	DebugDrawLineSystem* debugDraw = DebugDrawLineSystem::GetInstance();
+	if (!debugDraw) return;
+
+	// 三角形が多い地形などは線が多くなりすぎるので範囲だけ描く
+	const uint32_t triangleCount = worldMesh_.GetTriangleCount();
+	if (triangleCount > kDebugTriangleLimit) {
+		debugDraw->DrawAABB(worldMesh_.GetBounds(), currentColliderColor_);
+		return;
+	}
+	for (uint32_t i = 0; i < triangleCount; ++i) {
+		const TriangleMath& tri = worldMesh_.GetTriangle(i);
+		debugDraw->AddLine(tri.vertices[0], tri.vertices[1], currentColliderColor_);
+		debugDraw->AddLine(tri.vertices[1], tri.vertices[2], currentColliderColor_);
+		debugDraw->AddLine(tri.vertices[2], tri.vertices[0], currentColliderColor_);
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "ICollider.h"
+#include "CollisionManager/CollisionMesh.h"
+#include "Engine/MyMath/MyFunction.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class Model;
+
+/// <summary>
+/// 静的な三角形メッシュのコライダー（地形・岩の壁など、手で置いた AABB の代わりにモデルの形そのままで当てる）
+/// 木はモデルのローカル座標で作って同じモデルのコライダー同士で共有し、SetWorldMatrix の時にだけワールド座標へ置き直す
+/// 動かないものに使う（毎フレーム行列を変えると三角形を全て変換し直すことになる）
+/// 判定できる相手は 球・AABB・カプセル とレイキャスト（メッシュ同士・OBB とは当たらない）
+/// </summary>
+class MeshCollider : public ICollider {
+public:
+	MeshCollider() { colliderType_ = ColliderType::MESH; }
+
+	// デバッグ描画で三角形の辺を描く上限（超えたら範囲だけ描く）
+	static constexpr uint32_t kDebugTriangleLimit = 4096;
+
+	void DebugLineAdd() override;
+
+	/// <summary>
+	/// モデルの全メッシュの三角形で形状を作る
+	/// 木はモデルの隣のキャッシュ（拡張子を .colmesh にしたもの）から読み、無い・古ければ作って保存する
+	/// </summary>
+	void SetMesh(const Model* model);
+
+	/// <summary>
+	/// 三角形リストで形状を作る（ローカル座標）
+	/// </summary>
+	/// <param name="positions">頂点座標（3つで三角形1つ）</param>
+	/// <param name="cachePath">木のキャッシュのパス（空ならキャッシュしない）</param>
+	void SetMesh(const std::vector<Vector3>& positions, const std::string& cachePath = "");
+
+	/// <summary>ワールド行列（Object3D なら Transform3D::GetWorldMatrix の値をそのまま渡す）</summary>
+	void SetWorldMatrix(const Matrix4x4& worldMatrix);
+	const Matrix4x4& GetWorldMatrix() const { return worldMatrix_; }
+
+	/// <summary>衝突判定用のメッシュ（ワールド座標）</summary>
+	const CollisionMesh& GetWorldMesh() const { return worldMesh_; }
+
+	/// <summary>ワールド行列の平行移動成分</summary>
+	Vector3 GetWorldPosition() override { return { worldMatrix_.m[3][0], worldMatrix_.m[3][1], worldMatrix_.m[3][2] }; }
+
+	/// <summary>ブロードフェーズ用のワールド範囲（木の根の範囲）</summary>
+	AABB GetWorldBounds() override { return worldMesh_.GetBounds(); }
+
+	/// <summary>モデルのファイルパスからキャッシュのパスを作る（プリミティブなどファイルが無いものは空）</summary>
+	static std::string MakeCachePath(const std::string& modelFilePath);
+
+protected:
+	std::shared_ptr<const CollisionMesh> localMesh_;
+	CollisionMesh worldMesh_;
+	Matrix4x4 worldMatrix_ = MyMath::MakeIdentity4x4();
+};
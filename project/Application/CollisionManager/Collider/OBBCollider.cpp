@@ -0,0 +1,61 @@
+#include "OBBCollider.h"
+#include "DebugDrawLineSystem.h"
+#include <cmath>
+
+using namespace MyMath;
+
+OBB OBBCollider::GetWorldOBB() {
+	// 回転行列の各行が回転後の座標軸になる
+	const Matrix4x4 rotateMatrix = GetWorldRotateMatrix();
+
+	OBB obb;
+	obb.center = GetWorldPosition();
+	for (int i = 0; i < 3; ++i) {
+		obb.orientations[i] = Normalize({ rotateMatrix.m[i][0], rotateMatrix.m[i][1], rotateMatrix.m[i][2] });
+	}
+	obb.size = halfSize_;
+	return obb;
+}
+
+AABB OBBCollider::ComputeBounds(const OBB& obb) {
+	// 各軸への投影の半径は、座標軸の成分の絶対値と半分サイズの積の和
+	const Vector3& u = obb.orientations[0];
+	const Vector3& v = obb.orientations[1];
+	const Vector3& w = obb.orientations[2];
+	const Vector3 extent = {
+		std::abs(u.x) * obb.size.x + std::abs(v.x) * obb.size.y + std::abs(w.x) * obb.size.z,
+		std::abs(u.y) * obb.size.x + std::abs(v.y) * obb.size.y + std::abs(w.y) * obb.size.z,
+		std::abs(u.z) * obb.size.x + std::abs(v.z) * obb.size.y + std::abs(w.z) * obb.size.z,
+	};
+	return { obb.center - extent, obb.center + extent };
+}
+
+void OBBCollider::DebugLineAdd() {
+	if (!isColliderVisible_) return;
+
+	DebugDrawLineSystem* debugDraw = DebugDrawLineSystem::GetInstance();
+	if (!debugDraw) return;
+
+	const OBB obb = GetWorldOBB();
+	const Vector3 axisX = obb.orientations[0] * obb.size.x;
+	const Vector3 axisY = obb.orientations[1] * obb.size.y;
+	const Vector3 axisZ = obb.orientations[2] * obb.size.z;
+
+	// 8頂点（ビット0:X 1:Y 2:Z の符号）
+	Vector3 corners[8];
+	for (int i = 0; i < 8; ++i) {
+		corners[i] = obb.center
+			+ axisX * ((i & 1) ? 1.0f : -1.0f)
+			+ axisY * ((i & 2) ? 1.0f : -1.0f)
+			+ axisZ * ((i & 4) ? 1.0f : -1.0f);
+	}
+
+	// 12辺（1ビットだけ違う頂点同士を結ぶ）
+	for (int i = 0; i < 8; ++i) {
+		for (int bit = 1; bit < 8; bit <<= 1) {
+			if ((i & bit) == 0) {
+				debugDraw->AddLine(corners[i], corners[i | bit], currentColliderColor_);
+			}
+		}
+	}
+}
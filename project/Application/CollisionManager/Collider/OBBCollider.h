@@ -1,13 +1,43 @@
 #pragma once
 #include "ICollider.h"
+#include "Engine/MyMath/MyFunction.h"
 
 /// <summary>
-/// OBBコライダー（未実装）
+/// OBBコライダー
 /// </summary>
 class OBBCollider : public ICollider {
 public:
 	OBBCollider() { colliderType_ = ColliderType::OBB; }
 
-	void OnCollision(ICollider* other) override {}
-	Vector3 GetWorldPosition() override { return {}; }
+	void DebugLineAdd() override;
+
+	/// <summary>座標軸方向の長さの半分</summary>
+	const Vector3& GetHalfSize() const { return halfSize_; }
+	void SetHalfSize(const Vector3& halfSize) { halfSize_ = halfSize; }
+
+	/// <summary>サイズ指定でOBBをセット（中心からの半分サイズ）</summary>
+	void SetOBBSize(const Vector3& size) { halfSize_ = { size.x * 0.5f, size.y * 0.5f, size.z * 0.5f }; }
+
+	/// <summary>回転（ラジアン、XYZ順）</summary>
+	const Vector3& GetOBBRotate() const { return rotate_; }
+	void SetOBBRotate(const Vector3& rotate) { rotate_ = rotate; }
+
+	/// <summary>
+	/// ワールドの回転行列（既定は SetOBBRotate の値）
+	/// 親の回転に追従させたい場合はオーバーライドする
+	/// </summary>
+	virtual Matrix4x4 GetWorldRotateMatrix() { return MyMath::MakeRotateXYZMatrix(rotate_); }
+
+	/// <summary>衝突判定用のOBBをワールド座標で返す</summary>
+	OBB GetWorldOBB();
+
+	/// <summary>ブロードフェーズ用のワールド範囲（OBBを囲むAABB）</summary>
+	AABB GetWorldBounds() override { return ComputeBounds(GetWorldOBB()); }
+
+	/// <summary>OBBを囲むAABB</summary>
+	static AABB ComputeBounds(const OBB& obb);
+
+protected:
+	Vector3 halfSize_ = { 1.0f, 1.0f, 1.0f };
+	Vector3 rotate_ = { 0.0f, 0.0f, 0.0f };
 };
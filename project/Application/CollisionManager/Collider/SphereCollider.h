@@ -22,6 +22,13 @@ public:
 		return s;
 	}
 
+	/// <summary>ブロードフェーズ用のワールド範囲（球を囲むAABB）</summary>
+	AABB GetWorldBounds() override {
+		Vector3 center = GetWorldPosition();
+		return { { center.x - radius_, center.y - radius_, center.z - radius_ },
+		         { center.x + radius_, center.y + radius_, center.z + radius_ } };
+	}
+
 protected:
 	float radius_ = 1.0f;
 };
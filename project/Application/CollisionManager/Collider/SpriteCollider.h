@@ -2,12 +2,9 @@
 #include "ICollider.h"
 
 /// <summary>
-/// 2Dスプライトコライダー（未実装）
+/// 2Dスプライトコライダー（未実装、判定関数は登録していない）
 /// </summary>
 class SpriteCollider : public ICollider {
 public:
 	SpriteCollider() { colliderType_ = ColliderType::SPRITE; }
-
-	void OnCollision(ICollider* other) override {}
-	Vector3 GetWorldPosition() override { return {}; }
 };
@@ -10,8 +10,11 @@ using namespace MyMath;
 // 球と球
 /*-----------------------------------------------------------------------*/
 bool Collision::IsCollision(const SphereMath& a, const SphereMath& b) {
-	float distance = Length(Subtract(a.center, b.center));
-	return distance <= a.radius + b.radius;
+	// 平方根を取らずに2乗同士で比べる（CollisionBatch と同じ結果になる）
+	float radius = a.radius + b.radius;
+	if (radius < 0.0f) { return false; }
+	Vector3 diff = Subtract(a.center, b.center);
+	return Dot(diff, diff) <= radius * radius;
 }
 
 /*-----------------------------------------------------------------------*/
@@ -31,8 +34,9 @@ bool Collision::IsCollision(const SphereMath& sphere, const AABB& aabb) {
 		std::clamp(sphere.center.y, aabb.min.y, aabb.max.y),
 		std::clamp(sphere.center.z, aabb.min.z, aabb.max.z),
 	};
-	float distance = Length(Subtract(closestPoint, sphere.center));
-	return distance <= sphere.radius;
+	if (sphere.radius < 0.0f) { return false; }
+	Vector3 diff = Subtract(closestPoint, sphere.center);
+	return Dot(diff, diff) <= sphere.radius * sphere.radius;
 }
 
 /*-----------------------------------------------------------------------*/
@@ -117,38 +121,797 @@ bool Collision::IsCollision(const Segment& seg, const PlaneMath& plane) {
 // 三角形と線分
 /*-----------------------------------------------------------------------*/
 bool Collision::IsCollision(const TriangleMath& tri, const Segment& seg) {
-	// 三角形の中心座標
-	Vector3 center = {
-		(tri.vertices[0].x + tri.vertices[1].x + tri.vertices[2].x) / 3.0f,
-		(tri.vertices[0].y + tri.vertices[1].y + tri.vertices[2].y) / 3.0f,
-		(tri.vertices[0].z + tri.vertices[1].z + tri.vertices[2].z) / 3.0f
+	// 交点の位置と法線は使わない
+	float t = 0.0f;
+	Vector3 normal;
+	return Raycast(seg, tri, t, normal);
+}
+
+namespace {
+
+	// 平行な辺の外積がほぼ0になった時の誤差対策（Ericson, Real-Time Collision Detection 4.4.1）
+	constexpr float kParallelEpsilon = 1.0e-6f;
+
+	/// <summary>点とAABBの最短距離の2乗</summary>
+	float PointAABBDistanceSquared(const Vector3& p, const AABB& aabb) {
+		auto axis = [](float v, float lo, float hi) {
+			if (v < lo) { return (lo - v) * (lo - v); }
+			if (v > hi) { return (v - hi) * (v - hi); }
+			return 0.0f;
+		};
+		return axis(p.x, aabb.min.x, aabb.max.x) + axis(p.y, aabb.min.y, aabb.max.y) + axis(p.z, aabb.min.z, aabb.max.z);
+	}
+
+	/// <summary>OBBのローカル座標へ（軸方向の成分）</summary>
+	Vector3 ToOBBLocal(const OBB& obb, const Vector3& v) {
+		return { Dot(v, obb.orientations[0]), Dot(v, obb.orientations[1]), Dot(v, obb.orientations[2]) };
+	}
+
+	/// <summary>AABB を軸の揃った OBB に変換</summary>
+	OBB ToOBB(const AABB& aabb) {
+		OBB obb;
+		obb.center = (aabb.min + aabb.max) * 0.5f;
+		obb.orientations[0] = { 1.0f, 0.0f, 0.0f };
+		obb.orientations[1] = { 0.0f, 1.0f, 0.0f };
+		obb.orientations[2] = { 0.0f, 0.0f, 1.0f };
+		obb.size = (aabb.max - aabb.min) * 0.5f;
+		return obb;
+	}
+
+	float GetComponent(const Vector3& v, int axis) {
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+}
+
+/*-----------------------------------------------------------------------*/
+// 球とOBB
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const SphereMath& sphere, const OBB& obb) {
+	if (sphere.radius < 0.0f) { return false; }
+	return DistanceSquared(obb, sphere.center) <= sphere.radius * sphere.radius;
+}
+
+/*-----------------------------------------------------------------------*/
+// AABBとOBB
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const AABB& aabb, const OBB& obb) {
+	return IsCollision(ToOBB(aabb), obb);
+}
+
+/*-----------------------------------------------------------------------*/
+// OBBとOBB
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const OBB& a, const OBB& b) {
+	const Vector3 diff = Subtract(b.center, a.center);
+
+	// 1. 外接球で早期に除外（離れているペアの大半はここで終わる）
+	const float boundA = Length(a.size);
+	const float boundB = Length(b.size);
+	if (Dot(diff, diff) > (boundA + boundB) * (boundA + boundB)) {
+		return false;
+	}
+
+	// 2. b の軸を a の座標系で表した回転行列と、その絶対値
+	float r[3][3];
+	float absR[3][3];
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			r[i][j] = Dot(a.orientations[i], b.orientations[j]);
+			absR[i][j] = std::abs(r[i][j]) + kParallelEpsilon;
+		}
+	}
+	const Vector3 tLocal = ToOBBLocal(a, diff);
+	const float t[3] = { tLocal.x, tLocal.y, tLocal.z };
+	const float ea[3] = { a.size.x, a.size.y, a.size.z };
+	const float eb[3] = { b.size.x, b.size.y, b.size.z };
+
+	// 3. a の面の法線（3軸）
+	for (int i = 0; i < 3; ++i) {
+		const float ra = ea[i];
+		const float rb = eb[0] * absR[i][0] + eb[1] * absR[i][1] + eb[2] * absR[i][2];
+		if (std::abs(t[i]) > ra + rb) { return false; }
+	}
+
+	// 4. b の面の法線（3軸）
+	for (int j = 0; j < 3; ++j) {
+		const float ra = ea[0] * absR[0][j] + ea[1] * absR[1][j] + ea[2] * absR[2][j];
+		const float rb = eb[j];
+		if (std::abs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]) > ra + rb) { return false; }
+	}
+
+	// 5. 辺同士の外積（9軸）
+	for (int i = 0; i < 3; ++i) {
+		const int i1 = (i + 1) % 3;
+		const int i2 = (i + 2) % 3;
+		for (int j = 0; j < 3; ++j) {
+			const int j1 = (j + 1) % 3;
+			const int j2 = (j + 2) % 3;
+			const float ra = ea[i1] * absR[i2][j] + ea[i2] * absR[i1][j];
+			const float rb = eb[j1] * absR[i][j2] + eb[j2] * absR[i][j1];
+			if (std::abs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb) { return false; }
+		}
+	}
+	return true;
+}
+
+/*-----------------------------------------------------------------------*/
+// 球とカプセル
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const SphereMath& sphere, const CapsuleMath& capsule) {
+	const float radius = sphere.radius + capsule.radius;
+	if (radius < 0.0f) { return false; }
+	return DistanceSquared(capsule.segment, sphere.center) <= radius * radius;
+}
+
+/*-----------------------------------------------------------------------*/
+// AABBとカプセル
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const AABB& aabb, const CapsuleMath& capsule) {
+	if (capsule.radius < 0.0f) { return false; }
+	const float radiusSq = capsule.radius * capsule.radius;
+	const Vector3& start = capsule.segment.origin;
+	const Vector3 end = start + capsule.segment.diff;
+
+	// 1. カプセルを囲むAABBと重ならなければ除外
+	const float r = capsule.radius;
+	if (std::min(start.x, end.x) - r > aabb.max.x || std::max(start.x, end.x) + r < aabb.min.x ||
+	    std::min(start.y, end.y) - r > aabb.max.y || std::max(start.y, end.y) + r < aabb.min.y ||
+	    std::min(start.z, end.z) - r > aabb.max.z || std::max(start.z, end.z) + r < aabb.min.z) {
+		return false;
+	}
+
+	// 2. 端点が届いていれば確定
+	if (PointAABBDistanceSquared(start, aabb) <= radiusSq || PointAABBDistanceSquared(end, aabb) <= radiusSq) {
+		return true;
+	}
+
+	// 3. 線分全体との最短距離
+	return DistanceSquared(capsule.segment, aabb) <= radiusSq;
+}
+
+/*-----------------------------------------------------------------------*/
+// OBBとカプセル
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const OBB& obb, const CapsuleMath& capsule) {
+	if (capsule.radius < 0.0f) { return false; }
+
+	// 1. OBB の外接球と線分の距離で除外
+	const float bound = Length(obb.size) + capsule.radius;
+	if (DistanceSquared(capsule.segment, obb.center) > bound * bound) {
+		return false;
+	}
+
+	// 2. ローカル座標に移して AABB と同じ手順で判定
+	CapsuleMath local;
+	local.segment.origin = ToOBBLocal(obb, Subtract(capsule.segment.origin, obb.center));
+	local.segment.diff = ToOBBLocal(obb, capsule.segment.diff);
+	local.radius = capsule.radius;
+	return IsCollision(AABB{ -obb.size, obb.size }, local);
+}
+
+/*-----------------------------------------------------------------------*/
+// カプセルとカプセル
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const CapsuleMath& a, const CapsuleMath& b) {
+	const float radius = a.radius + b.radius;
+	if (radius < 0.0f) { return false; }
+	return DistanceSquared(a.segment, b.segment) <= radius * radius;
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分と点の最短距離の2乗
+/*-----------------------------------------------------------------------*/
+float Collision::DistanceSquared(const Segment& seg, const Vector3& point) {
+	const float lengthSq = Dot(seg.diff, seg.diff);
+	float t = 0.0f;
+	if (lengthSq > 0.0f) {
+		t = std::clamp(Dot(Subtract(point, seg.origin), seg.diff) / lengthSq, 0.0f, 1.0f);
+	}
+	const Vector3 diff = Subtract(seg.origin + seg.diff * t, point);
+	return Dot(diff, diff);
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分と線分の最短距離の2乗（Ericson, Real-Time Collision Detection 5.1.9）
+/*-----------------------------------------------------------------------*/
+float Collision::DistanceSquared(const Segment& a, const Segment& b) {
+	const Vector3& d1 = a.diff;
+	const Vector3& d2 = b.diff;
+	const Vector3 r = Subtract(a.origin, b.origin);
+	const float lengthSqA = Dot(d1, d1);
+	const float lengthSqB = Dot(d2, d2);
+	const float f = Dot(d2, r);
+
+	float s = 0.0f;
+	float t = 0.0f;
+	if (lengthSqA <= 0.0f && lengthSqB <= 0.0f) {
+		// 両方とも点
+		return Dot(r, r);
+	}
+	if (lengthSqA <= 0.0f) {
+		// a が点
+		t = std::clamp(f / lengthSqB, 0.0f, 1.0f);
+	} else {
+		const float c = Dot(d1, r);
+		if (lengthSqB <= 0.0f) {
+			// b が点
+			s = std::clamp(-c / lengthSqA, 0.0f, 1.0f);
+		} else {
+			const float bDot = Dot(d1, d2);
+			const float denom = lengthSqA * lengthSqB - bDot * bDot;
+			// 平行なら s は任意なので 0 から始める
+			s = denom > 0.0f ? std::clamp((bDot * f - c * lengthSqB) / denom, 0.0f, 1.0f) : 0.0f;
+			t = (bDot * s + f) / lengthSqB;
+			if (t < 0.0f) {
+				t = 0.0f;
+				s = std::clamp(-c / lengthSqA, 0.0f, 1.0f);
+			} else if (t > 1.0f) {
+				t = 1.0f;
+				s = std::clamp((bDot - c) / lengthSqA, 0.0f, 1.0f);
+			}
+		}
+	}
+	const Vector3 diff = Subtract(a.origin + d1 * s, b.origin + d2 * t);
+	return Dot(diff, diff);
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分とAABBの最短距離の2乗
+/*-----------------------------------------------------------------------*/
+float Collision::DistanceSquared(const Segment& seg, const AABB& aabb) {
+	// 点とAABBの距離の2乗は線分上のパラメータ t について凸な区分的2次関数になる
+	// 各軸が面の平面をまたぐ t で区切り、区間ごとに2次関数の最小値を求める
+	float breaks[8];
+	int breakCount = 0;
+	breaks[breakCount++] = 0.0f;
+	breaks[breakCount++] = 1.0f;
+	for (int axis = 0; axis < 3; ++axis) {
+		const float o = GetComponent(seg.origin, axis);
+		const float d = GetComponent(seg.diff, axis);
+		if (d == 0.0f) { continue; }
+		for (float bound : { GetComponent(aabb.min, axis), GetComponent(aabb.max, axis) }) {
+			const float t = (bound - o) / d;
+			if (t > 0.0f && t < 1.0f) {
+				breaks[breakCount++] = t;
+			}
+		}
+	}
+	// 高々8個なので挿入ソート
+	for (int i = 1; i < breakCount; ++i) {
+		const float value = breaks[i];
+		int j = i;
+		for (; j > 0 && breaks[j - 1] > value; --j) {
+			breaks[j] = breaks[j - 1];
+		}
+		breaks[j] = value;
+	}
+
+	float best = PointAABBDistanceSquared(seg.origin, aabb);
+	for (int k = 0; k + 1 < breakCount; ++k) {
+		const float t0 = breaks[k];
+		const float t1 = breaks[k + 1];
+		if (t1 <= t0) { continue; }
+
+		// 区間の中点で各軸がどの面の外側かを決め、a t^2 + b t の係数を集める
+		const float tm = (t0 + t1) * 0.5f;
+		float qa = 0.0f;
+		float qb = 0.0f;
+		for (int axis = 0; axis < 3; ++axis) {
+			const float o = GetComponent(seg.origin, axis);
+			const float d = GetComponent(seg.diff, axis);
+			const float p = o + d * tm;
+			float bound = 0.0f;
+			if (p < GetComponent(aabb.min, axis)) {
+				bound = GetComponent(aabb.min, axis);
+			} else if (p > GetComponent(aabb.max, axis)) {
+				bound = GetComponent(aabb.max, axis);
+			} else {
+				continue;
+			}
+			qa += d * d;
+			qb += 2.0f * d * (o - bound);
+		}
+
+		float t = t1;
+		if (qa > 0.0f) {
+			t = std::clamp(-qb / (2.0f * qa), t0, t1);
+		}
+		best = std::min(best, PointAABBDistanceSquared(seg.origin + seg.diff * t, aabb));
+		if (best <= 0.0f) { break; }
+	}
+	return std::min(best, PointAABBDistanceSquared(seg.origin + seg.diff, aabb));
+}
+
+/*-----------------------------------------------------------------------*/
+// 点とOBBの最短距離の2乗
+/*-----------------------------------------------------------------------*/
+float Collision::DistanceSquared(const OBB& obb, const Vector3& point) {
+	const Vector3 local = ToOBBLocal(obb, Subtract(point, obb.center));
+	return PointAABBDistanceSquared(local, { -obb.size, obb.size });
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分とOBBの最短距離の2乗
+/*-----------------------------------------------------------------------*/
+float Collision::DistanceSquared(const Segment& seg, const OBB& obb) {
+	// OBB のローカル座標に移すと中心が原点の AABB になる
+	Segment local;
+	local.origin = ToOBBLocal(obb, Subtract(seg.origin, obb.center));
+	local.diff = ToOBBLocal(obb, seg.diff);
+	return DistanceSquared(local, AABB{ -obb.size, obb.size });
+}
+
+namespace {
+
+	/// <summary>始点が形状の内側だった時の法線（線分の逆向き）</summary>
+	Vector3 InsideNormal(const Segment& seg) {
+		if (Dot(seg.diff, seg.diff) <= 0.0f) {
+			return { 0.0f, 0.0f, 0.0f };
+		}
+		return Normalize(seg.diff) * -1.0f;
+	}
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分と球の交点
+/*-----------------------------------------------------------------------*/
+bool Collision::Raycast(const Segment& seg, const SphereMath& sphere, float& outT, Vector3& outNormal) {
+	if (sphere.radius < 0.0f) { return false; }
+
+	// |m + t d|^2 = r^2 を t について解く
+	const Vector3 m = Subtract(seg.origin, sphere.center);
+	const float c = Dot(m, m) - sphere.radius * sphere.radius;
+	if (c <= 0.0f) {
+		outT = 0.0f;
+		outNormal = InsideNormal(seg);
+		return true;
+	}
+
+	const float a = Dot(seg.diff, seg.diff);
+	const float b = Dot(m, seg.diff);
+	if (a <= 0.0f || b >= 0.0f) {
+		// 外側から遠ざかっている
+		return false;
+	}
+	const float discriminant = b * b - a * c;
+	if (discriminant < 0.0f) {
+		return false;
+	}
+	const float t = (-b - std::sqrt(discriminant)) / a;
+	if (t > 1.0f) {
+		return false;
+	}
+	outT = std::max(t, 0.0f);
+	outNormal = Normalize(Subtract(seg.origin + seg.diff * outT, sphere.center));
+	return true;
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分とAABBの交点
+/*-----------------------------------------------------------------------*/
+bool Collision::Raycast(const Segment& seg, const AABB& aabb, float& outT, Vector3& outNormal) {
+	// スラブごとに入る t・出る t を絞り、最後に入った面を交点の面にする
+	float tMin = 0.0f;
+	float tMax = 1.0f;
+	int enterAxis = -1;
+	for (int axis = 0; axis < 3; ++axis) {
+		const float o = GetComponent(seg.origin, axis);
+		const float d = GetComponent(seg.diff, axis);
+		const float lo = GetComponent(aabb.min, axis);
+		const float hi = GetComponent(aabb.max, axis);
+		if (d == 0.0f) {
+			if (o < lo || o > hi) { return false; }
+			continue;
+		}
+		const float inverse = 1.0f / d;
+		float t0 = (lo - o) * inverse;
+		float t1 = (hi - o) * inverse;
+		if (t0 > t1) { std::swap(t0, t1); }
+		if (t0 > tMin) {
+			tMin = t0;
+			enterAxis = axis;
+		}
+		tMax = std::min(tMax, t1);
+		if (tMin > tMax) { return false; }
+	}
+
+	outT = tMin;
+	if (enterAxis < 0) {
+		outNormal = InsideNormal(seg);
+		return true;
+	}
+	const float sign = GetComponent(seg.diff, enterAxis) > 0.0f ? -1.0f : 1.0f;
+	outNormal = { enterAxis == 0 ? sign : 0.0f, enterAxis == 1 ? sign : 0.0f, enterAxis == 2 ? sign : 0.0f };
+	return true;
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分とOBBの交点
+/*-----------------------------------------------------------------------*/
+bool Collision::Raycast(const Segment& seg, const OBB& obb, float& outT, Vector3& outNormal) {
+	Segment local;
+	local.origin = ToOBBLocal(obb, Subtract(seg.origin, obb.center));
+	local.diff = ToOBBLocal(obb, seg.diff);
+
+	Vector3 localNormal;
+	if (!Raycast(local, AABB{ -obb.size, obb.size }, outT, localNormal)) {
+		return false;
+	}
+	outNormal = obb.orientations[0] * localNormal.x + obb.orientations[1] * localNormal.y + obb.orientations[2] * localNormal.z;
+	return true;
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分とカプセルの交点
+/*-----------------------------------------------------------------------*/
+bool Collision::Raycast(const Segment& seg, const CapsuleMath& capsule, float& outT, Vector3& outNormal) {
+	if (capsule.radius < 0.0f) { return false; }
+	const float radiusSq = capsule.radius * capsule.radius;
+
+	// 1. 始点が内側
+	if (DistanceSquared(capsule.segment, seg.origin) <= radiusSq) {
+		outT = 0.0f;
+		outNormal = InsideNormal(seg);
+		return true;
+	}
+
+	// 2. 両端の球
+	bool hit = false;
+	float bestT = 2.0f;
+	float t = 0.0f;
+	Vector3 normal;
+	const SphereMath caps[2] = {
+		{ capsule.segment.origin, capsule.radius },
+		{ capsule.segment.origin + capsule.segment.diff, capsule.radius },
+	};
+	for (const SphereMath& cap : caps) {
+		if (Raycast(seg, cap, t, normal) && t < bestT) {
+			bestT = t;
+			outNormal = normal;
+			hit = true;
+		}
+	}
+
+	// 3. 側面（中心線に垂直な成分だけで円柱との交点を求め、中心線の範囲内かを確認）
+	const Vector3& axis = capsule.segment.diff;
+	const float axisLengthSq = Dot(axis, axis);
+	if (axisLengthSq > 0.0f) {
+		const Vector3 m = Subtract(seg.origin, capsule.segment.origin);
+		const float md = Dot(m, axis);
+		const float nd = Dot(seg.diff, axis);
+		const Vector3 mPerp = m - axis * (md / axisLengthSq);
+		const Vector3 nPerp = seg.diff - axis * (nd / axisLengthSq);
+
+		const float a = Dot(nPerp, nPerp);
+		const float b = Dot(mPerp, nPerp);
+		const float c = Dot(mPerp, mPerp) - radiusSq;
+		const float discriminant = b * b - a * c;
+		if (a > 0.0f && discriminant >= 0.0f) {
+			const float tSide = (-b - std::sqrt(discriminant)) / a;
+			const float s = (md + tSide * nd) / axisLengthSq;
+			if (tSide >= 0.0f && tSide <= 1.0f && tSide < bestT && s >= 0.0f && s <= 1.0f) {
+				bestT = tSide;
+				outNormal = Normalize(mPerp + nPerp * tSide);
+				hit = true;
+			}
+		}
+	}
+
+	if (!hit) {
+		return false;
+	}
+	outT = bestT;
+	return true;
+}
+
+/*-----------------------------------------------------------------------*/
+// 移動する球と球
+/*-----------------------------------------------------------------------*/
+bool Collision::Sweep(const SphereMath& sphere, const Vector3& motion, const SphereMath& target, const Vector3& targetMotion, float& outT) {
+	// 相手から見た相対的な移動にすると、半径の和の球に対する線分の判定になる
+	Segment relative;
+	relative.origin = Subtract(Subtract(sphere.center, motion), Subtract(target.center, targetMotion));
+	relative.diff = Subtract(motion, targetMotion);
+
+	Vector3 normal;
+	return Raycast(relative, SphereMath{ { 0.0f, 0.0f, 0.0f }, sphere.radius + target.radius }, outT, normal);
+}
+
+/*-----------------------------------------------------------------------*/
+// 移動する球とAABB（Ericson, Real-Time Collision Detection 5.5.7）
+/*-----------------------------------------------------------------------*/
+bool Collision::Sweep(const SphereMath& sphere, const Vector3& motion, const AABB& target, float& outT) {
+	const float r = sphere.radius;
+	if (r < 0.0f) { return false; }
+
+	// 1. 半径だけ膨らませた箱に対する線分の判定（角・辺の丸みを無視した広めの判定）
+	const Segment seg = { Subtract(sphere.center, motion), motion };
+	const AABB fat = { { target.min.x - r, target.min.y - r, target.min.z - r },
+	                   { target.max.x + r, target.max.y + r, target.max.z + r } };
+	float t = 0.0f;
+	Vector3 normal;
+	if (!Raycast(seg, fat, t, normal)) {
+		return false;
+	}
+
+	// 2. 交点が元の箱の外にはみ出している軸（下側:u 上側:v）
+	const Vector3 p = seg.origin + seg.diff * t;
+	int u = 0;
+	int v = 0;
+	for (int axis = 0; axis < 3; ++axis) {
+		if (GetComponent(p, axis) < GetComponent(target.min, axis)) { u |= 1 << axis; }
+		if (GetComponent(p, axis) > GetComponent(target.max, axis)) { v |= 1 << axis; }
+	}
+	const int m = u | v;
+	const int outsideCount = (m & 1) + ((m >> 1) & 1) + ((m >> 2) & 1);
+
+	// 3. 面の領域ならそのまま確定
+	if (outsideCount <= 1) {
+		outT = t;
+		return true;
+	}
+
+	// 4. 辺・頂点の領域は、辺を中心線にした半径 r のカプセルとの判定になる
+	auto corner = [&target](int bits) -> Vector3 {
+		return { (bits & 1) ? target.max.x : target.min.x, (bits & 2) ? target.max.y : target.min.y, (bits & 4) ? target.max.z : target.min.z };
 	};
+	auto edgeCapsule = [&](int from, int to) -> CapsuleMath {
+		const Vector3 start = corner(from);
+		return { { start, Subtract(corner(to), start) }, r };
+	};
+
+	if (outsideCount == 2) {
+		// 辺の領域（はみ出していない軸に沿った辺）
+		return Raycast(seg, edgeCapsule(u ^ 7, v), outT, normal);
+	}
+
+	// 頂点の領域（頂点に集まる3辺のうち最も早いもの）
+	bool hit = false;
+	float bestT = 2.0f;
+	for (int bit = 1; bit < 8; bit <<= 1) {
+		if (Raycast(seg, edgeCapsule(v, v ^ bit), t, normal) && t < bestT) {
+			bestT = t;
+			hit = true;
+		}
+	}
+	if (hit) {
+		outT = bestT;
+	}
+	return hit;
+}
+
+/*-----------------------------------------------------------------------*/
+// 移動する球とOBB
+/*-----------------------------------------------------------------------*/
+bool Collision::Sweep(const SphereMath& sphere, const Vector3& motion, const OBB& target, float& outT) {
+	// OBB のローカル座標では中心が原点の AABB になる
+	SphereMath local;
+	local.center = ToOBBLocal(target, Subtract(sphere.center, target.center));
+	local.radius = sphere.radius;
+	return Sweep(local, ToOBBLocal(target, motion), AABB{ -target.size, target.size }, outT);
+}
+
+/*-----------------------------------------------------------------------*/
+// 移動する球とカプセル
+/*-----------------------------------------------------------------------*/
+bool Collision::Sweep(const SphereMath& sphere, const Vector3& motion, const CapsuleMath& target, float& outT) {
+	// 球の中心の線分と、半径の和のカプセル
+	const Segment seg = { Subtract(sphere.center, motion), motion };
+	Vector3 normal;
+	return Raycast(seg, CapsuleMath{ target.segment, target.radius + sphere.radius }, outT, normal);
+}
+
+namespace {
 
-	// 三角形の存在する平面を作成
-	PlaneMath plane;
-	plane.distance = Distance(center, { 0.0f, 0.0f, 0.0f });
-	plane.normal = Cross(
-		Subtract(tri.vertices[1], tri.vertices[0]),
-		Subtract(tri.vertices[2], tri.vertices[1])
-	);
-
-	if (!IsCollision(seg, plane)) return false;
-
-	// 衝突点
-	Vector3 p = MakeCollisionPoint(seg, plane);
-
-	Vector3 v01 = Subtract(tri.vertices[1], tri.vertices[0]);
-	Vector3 v12 = Subtract(tri.vertices[2], tri.vertices[1]);
-	Vector3 v20 = Subtract(tri.vertices[0], tri.vertices[2]);
-	Vector3 v0p = Subtract(p, tri.vertices[0]);
-	Vector3 v1p = Subtract(p, tri.vertices[1]);
-	Vector3 v2p = Subtract(p, tri.vertices[2]);
-
-	Vector3 cross01 = Cross(v01, v1p);
-	Vector3 cross12 = Cross(v12, v2p);
-	Vector3 cross20 = Cross(v20, v0p);
-
-	return (Dot(cross01, plane.normal) >= 0.0f &&
-		Dot(cross12, plane.normal) >= 0.0f &&
-		Dot(cross20, plane.normal) >= 0.0f);
+	/// <summary>点に最も近い三角形上の点（Ericson, Real-Time Collision Detection 5.1.5）</summary>
+	Vector3 ClosestPointOnTriangle(const Vector3& p, const TriangleMath& tri) {
+		const Vector3& a = tri.vertices[0];
+		const Vector3& b = tri.vertices[1];
+		const Vector3& c = tri.vertices[2];
+		const Vector3 ab = b - a;
+		const Vector3 ac = c - a;
+
+		// 頂点の領域
+		const Vector3 ap = p - a;
+		const float d1 = Dot(ab, ap);
+		const float d2 = Dot(ac, ap);
+		if (d1 <= 0.0f && d2 <= 0.0f) { return a; }
+
+		const Vector3 bp = p - b;
+		const float d3 = Dot(ab, bp);
+		const float d4 = Dot(ac, bp);
+		if (d3 >= 0.0f && d4 <= d3) { return b; }
+
+		const Vector3 cp = p - c;
+		const float d5 = Dot(ab, cp);
+		const float d6 = Dot(ac, cp);
+		if (d6 >= 0.0f && d5 <= d6) { return c; }
+
+		// 辺の領域
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+			return a + ab * (d1 / (d1 - d3));
+		}
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+			return a + ac * (d2 / (d2 - d6));
+		}
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+			return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+		}
+
+		// 面の内側（退化した三角形は上の領域のどれかで返る）
+		const float denominator = va + vb + vc;
+		if (!(denominator > 0.0f)) { return a; }
+		const float v = vb / denominator;
+		const float w = vc / denominator;
+		return a + ab * v + ac * w;
+	}
+
+	/// <summary>三角形の辺（i 番目の頂点から次の頂点へ）</summary>
+	Segment TriangleEdge(const TriangleMath& tri, int i) {
+		return { tri.vertices[i], tri.vertices[(i + 1) % 3] - tri.vertices[i] };
+	}
+}
+
+/*-----------------------------------------------------------------------*/
+// 点と三角形の最短距離の2乗
+/*-----------------------------------------------------------------------*/
+float Collision::DistanceSquared(const TriangleMath& tri, const Vector3& point) {
+	const Vector3 diff = ClosestPointOnTriangle(point, tri) - point;
+	return Dot(diff, diff);
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分と三角形の最短距離の2乗
+/*-----------------------------------------------------------------------*/
+float Collision::DistanceSquared(const Segment& seg, const TriangleMath& tri) {
+	float t = 0.0f;
+	Vector3 normal;
+	if (Raycast(seg, tri, t, normal)) {
+		return 0.0f;
+	}
+
+	// 交差しなければ、最短は線分の端点と三角形・線分と三角形の辺のどれか
+	float best = std::min(DistanceSquared(tri, seg.origin), DistanceSquared(tri, seg.origin + seg.diff));
+	for (int i = 0; i < 3; ++i) {
+		best = std::min(best, DistanceSquared(seg, TriangleEdge(tri, i)));
+	}
+	return best;
+}
+
+/*-----------------------------------------------------------------------*/
+// 球と三角形
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const SphereMath& sphere, const TriangleMath& tri) {
+	if (sphere.radius < 0.0f) { return false; }
+	return DistanceSquared(tri, sphere.center) <= sphere.radius * sphere.radius;
+}
+
+/*-----------------------------------------------------------------------*/
+// AABBと三角形（分離軸判定、13軸。Akenine-Moller の方法）
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const AABB& aabb, const TriangleMath& tri) {
+	const Vector3 center = (aabb.min + aabb.max) * 0.5f;
+	const Vector3 half = (aabb.max - aabb.min) * 0.5f;
+	const Vector3 v[3] = { tri.vertices[0] - center, tri.vertices[1] - center, tri.vertices[2] - center };
+
+	// 1. AABB の3軸（三角形の範囲との重なり）
+	for (int axis = 0; axis < 3; ++axis) {
+		const float p0 = GetComponent(v[0], axis);
+		const float p1 = GetComponent(v[1], axis);
+		const float p2 = GetComponent(v[2], axis);
+		const float h = GetComponent(half, axis);
+		if (std::min({ p0, p1, p2 }) > h || std::max({ p0, p1, p2 }) < -h) {
+			return false;
+		}
+	}
+
+	// 2. AABB の軸と三角形の辺の外積（9軸）
+	const Vector3 edges[3] = { v[1] - v[0], v[2] - v[1], v[0] - v[2] };
+	for (const Vector3& e : edges) {
+		const Vector3 axes[3] = { { 0.0f, -e.z, e.y }, { e.z, 0.0f, -e.x }, { -e.y, e.x, 0.0f } };
+		for (const Vector3& a : axes) {
+			const float p0 = Dot(v[0], a);
+			const float p1 = Dot(v[1], a);
+			const float p2 = Dot(v[2], a);
+			const float r = half.x * std::abs(a.x) + half.y * std::abs(a.y) + half.z * std::abs(a.z);
+			if (std::min({ p0, p1, p2 }) > r || std::max({ p0, p1, p2 }) < -r) {
+				return false;
+			}
+		}
+	}
+
+	// 3. 三角形の法線（平面と AABB）
+	const Vector3 normal = Cross(edges[0], edges[1]);
+	const float distance = Dot(normal, v[0]);
+	const float r = half.x * std::abs(normal.x) + half.y * std::abs(normal.y) + half.z * std::abs(normal.z);
+	return std::abs(distance) <= r;
+}
+
+/*-----------------------------------------------------------------------*/
+// カプセルと三角形
+/*-----------------------------------------------------------------------*/
+bool Collision::IsCollision(const CapsuleMath& capsule, const TriangleMath& tri) {
+	if (capsule.radius < 0.0f) { return false; }
+	return DistanceSquared(capsule.segment, tri) <= capsule.radius * capsule.radius;
+}
+
+/*-----------------------------------------------------------------------*/
+// 線分と三角形の交点（両面、Moller-Trumbore）
+/*-----------------------------------------------------------------------*/
+bool Collision::Raycast(const Segment& seg, const TriangleMath& tri, float& outT, Vector3& outNormal) {
+	const Vector3 e1 = tri.vertices[1] - tri.vertices[0];
+	const Vector3 e2 = tri.vertices[2] - tri.vertices[0];
+	const Vector3 p = Cross(seg.diff, e2);
+	const float determinant = Dot(e1, p);
+	if (determinant == 0.0f) {
+		// 平面と平行・退化した三角形
+		return false;
+	}
+
+	// 平行に近いと逆数が大きくなり NaN も出うるので、範囲内であることを否定形で確かめる
+	const float inverse = 1.0f / determinant;
+	const Vector3 s = seg.origin - tri.vertices[0];
+	const float u = Dot(s, p) * inverse;
+	if (!(u >= 0.0f && u <= 1.0f)) { return false; }
+	const Vector3 q = Cross(s, e1);
+	const float v = Dot(seg.diff, q) * inverse;
+	if (!(v >= 0.0f && u + v <= 1.0f)) { return false; }
+	const float t = Dot(e2, q) * inverse;
+	if (!(t >= 0.0f && t <= 1.0f)) { return false; }
+
+	// 法線は線分に向かい合う側
+	Vector3 normal = Normalize(Cross(e1, e2));
+	if (Dot(normal, seg.diff) > 0.0f) {
+		normal = normal * -1.0f;
+	}
+	outT = t;
+	outNormal = normal;
+	return true;
+}
+
+/*-----------------------------------------------------------------------*/
+// 移動する球と三角形
+/*-----------------------------------------------------------------------*/
+bool Collision::Sweep(const SphereMath& sphere, const Vector3& motion, const TriangleMath& target, float& outT) {
+	if (sphere.radius < 0.0f) { return false; }
+	const Segment seg = { Subtract(sphere.center, motion), motion };
+	const float radiusSq = sphere.radius * sphere.radius;
+
+	// 移動の始めから重なっている
+	if (DistanceSquared(target, seg.origin) <= radiusSq) {
+		outT = 0.0f;
+		return true;
+	}
+
+	// 三角形を半径で膨らませた形（面を法線方向にずらした2枚 + 辺のカプセル）との最初の交点
+	bool hit = false;
+	float best = 1.0f;
+	const Vector3 normal = Cross(target.vertices[1] - target.vertices[0], target.vertices[2] - target.vertices[0]);
+	if (Dot(normal, normal) > 0.0f) {
+		const Vector3 offset = Normalize(normal) * sphere.radius;
+		for (const Vector3& side : { offset, offset * -1.0f }) {
+			const TriangleMath face = { { target.vertices[0] + side, target.vertices[1] + side, target.vertices[2] + side } };
+			float t = 0.0f;
+			Vector3 n;
+			if (Raycast(seg, face, t, n) && t <= best) {
+				best = t;
+				hit = true;
+			}
+		}
+	}
+	for (int i = 0; i < 3; ++i) {
+		float t = 0.0f;
+		Vector3 n;
+		if (Raycast(seg, CapsuleMath{ TriangleEdge(target, i), sphere.radius }, t, n) && t <= best) {
+			best = t;
+			hit = true;
+		}
+	}
+	if (hit) {
+		outT = best;
+	}
+	return hit;
 }
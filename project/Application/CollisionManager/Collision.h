@@ -29,4 +29,92 @@ public:
 
 	/// <summary>三角形と線分</summary>
 	static bool IsCollision(const TriangleMath& tri, const Segment& seg);
+
+	/// <summary>球とOBB</summary>
+	static bool IsCollision(const SphereMath& sphere, const OBB& obb);
+
+	/// <summary>AABBとOBB（AABB を軸が揃った OBB として分離軸判定）</summary>
+	static bool IsCollision(const AABB& aabb, const OBB& obb);
+
+	/// <summary>OBBとOBB（分離軸判定、15軸）</summary>
+	static bool IsCollision(const OBB& a, const OBB& b);
+
+	/// <summary>球とカプセル</summary>
+	static bool IsCollision(const SphereMath& sphere, const CapsuleMath& capsule);
+
+	/// <summary>AABBとカプセル</summary>
+	static bool IsCollision(const AABB& aabb, const CapsuleMath& capsule);
+
+	/// <summary>OBBとカプセル</summary>
+	static bool IsCollision(const OBB& obb, const CapsuleMath& capsule);
+
+	/// <summary>カプセルとカプセル</summary>
+	static bool IsCollision(const CapsuleMath& a, const CapsuleMath& b);
+
+	/// <summary>球と三角形</summary>
+	static bool IsCollision(const SphereMath& sphere, const TriangleMath& tri);
+
+	/// <summary>AABBと三角形（分離軸判定、13軸）</summary>
+	static bool IsCollision(const AABB& aabb, const TriangleMath& tri);
+
+	/// <summary>カプセルと三角形</summary>
+	static bool IsCollision(const CapsuleMath& capsule, const TriangleMath& tri);
+
+	/// <summary>線分と点の最短距離の2乗</summary>
+	static float DistanceSquared(const Segment& seg, const Vector3& point);
+
+	/// <summary>線分と線分の最短距離の2乗</summary>
+	static float DistanceSquared(const Segment& a, const Segment& b);
+
+	/// <summary>線分とAABBの最短距離の2乗（交差していれば0）</summary>
+	static float DistanceSquared(const Segment& seg, const AABB& aabb);
+
+	/// <summary>点とOBBの最短距離の2乗（内側なら0）</summary>
+	static float DistanceSquared(const OBB& obb, const Vector3& point);
+
+	/// <summary>線分とOBBの最短距離の2乗（交差していれば0）</summary>
+	static float DistanceSquared(const Segment& seg, const OBB& obb);
+
+	/// <summary>点と三角形の最短距離の2乗</summary>
+	static float DistanceSquared(const TriangleMath& tri, const Vector3& point);
+
+	/// <summary>線分と三角形の最短距離の2乗（交差していれば0）</summary>
+	static float DistanceSquared(const Segment& seg, const TriangleMath& tri);
+
+	/// <summary>
+	/// 線分と球の最初の交点（t は線分上の位置 0～1、始点が内側なら t=0 で法線は線分の逆向き）
+	/// 以下の Raycast も同じ約束
+	/// </summary>
+	static bool Raycast(const Segment& seg, const SphereMath& sphere, float& outT, Vector3& outNormal);
+
+	/// <summary>線分とAABBの最初の交点</summary>
+	static bool Raycast(const Segment& seg, const AABB& aabb, float& outT, Vector3& outNormal);
+
+	/// <summary>線分とOBBの最初の交点</summary>
+	static bool Raycast(const Segment& seg, const OBB& obb, float& outT, Vector3& outNormal);
+
+	/// <summary>線分とカプセルの最初の交点</summary>
+	static bool Raycast(const Segment& seg, const CapsuleMath& capsule, float& outT, Vector3& outNormal);
+
+	/// <summary>線分と三角形の交点（両面、法線は線分に向かい合う側）</summary>
+	static bool Raycast(const Segment& seg, const TriangleMath& tri, float& outT, Vector3& outNormal);
+
+	/// <summary>
+	/// 移動する球と球の最初の接触時刻（連続判定）
+	/// 形状は今フレームの位置、motion は前フレームからの移動量で、t は 0:前フレーム 1:今フレーム
+	/// 移動の始めから重なっていれば t=0。以下の Sweep も同じ約束
+	/// </summary>
+	static bool Sweep(const SphereMath& sphere, const Vector3& motion, const SphereMath& target, const Vector3& targetMotion, float& outT);
+
+	/// <summary>移動する球と静止したAABB</summary>
+	static bool Sweep(const SphereMath& sphere, const Vector3& motion, const AABB& target, float& outT);
+
+	/// <summary>移動する球と静止したOBB</summary>
+	static bool Sweep(const SphereMath& sphere, const Vector3& motion, const OBB& target, float& outT);
+
+	/// <summary>移動する球と静止したカプセル</summary>
+	static bool Sweep(const SphereMath& sphere, const Vector3& motion, const CapsuleMath& target, float& outT);
+
+	/// <summary>移動する球と静止した三角形</summary>
+	static bool Sweep(const SphereMath& sphere, const Vector3& motion, const TriangleMath& target, float& outT);
 };
@@ -0,0 +1,162 @@
+#define NOMINMAX
+#include "CollisionBatch.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define COLLISION_BATCH_SSE
+#endif
+
+namespace {
+
+	/// <summary>count から4の倍数まで配列の末尾を value で埋める</summary>
+	void Pad(float* values, uint32_t count, uint32_t padded, float value) {
+		for (uint32_t i = count; i < padded; ++i) {
+			values[i] = value;
+		}
+	}
+
+	uint32_t RoundUp(uint32_t count) {
+		return (count + CollisionBatch::kWidth - 1) / CollisionBatch::kWidth * CollisionBatch::kWidth;
+	}
+
+#ifdef COLLISION_BATCH_SSE
+	/// <summary>4レーンの比較結果から当たったペアの番号を書き出す</summary>
+	uint32_t StoreHits(__m128 mask, uint32_t base, uint32_t* hitIndices, uint32_t hitCount) {
+		int bits = _mm_movemask_ps(mask);
+		while (bits != 0) {
+			const uint32_t lane = (bits & 1) ? 0 : ((bits & 2) ? 1 : ((bits & 4) ? 2 : 3));
+			hitIndices[hitCount++] = base + lane;
+			bits &= bits - 1;
+		}
+		return hitCount;
+	}
+#endif
+}
+
+/*-----------------------------------------------------------------------*/
+// 球と球
+/*-----------------------------------------------------------------------*/
+uint32_t CollisionBatch::Test(SphereSpherePairs& pairs, uint32_t* hitIndices) {
+	const uint32_t count = pairs.count;
+	const uint32_t padded = RoundUp(count);
+
+	// 端数は半径が負の（絶対に当たらない）球で埋める
+	for (float* values : { pairs.ax, pairs.ay, pairs.az, pairs.bx, pairs.by, pairs.bz }) {
+		Pad(values, count, padded, 0.0f);
+	}
+	Pad(pairs.ar, count, padded, -1.0f);
+	Pad(pairs.br, count, padded, -1.0f);
+
+	uint32_t hitCount = 0;
+#ifdef COLLISION_BATCH_SSE
+	for (uint32_t i = 0; i < padded; i += kWidth) {
+		const __m128 dx = _mm_sub_ps(_mm_load_ps(&pairs.ax[i]), _mm_load_ps(&pairs.bx[i]));
+		const __m128 dy = _mm_sub_ps(_mm_load_ps(&pairs.ay[i]), _mm_load_ps(&pairs.by[i]));
+		const __m128 dz = _mm_sub_ps(_mm_load_ps(&pairs.az[i]), _mm_load_ps(&pairs.bz[i]));
+		const __m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		const __m128 radius = _mm_add_ps(_mm_load_ps(&pairs.ar[i]), _mm_load_ps(&pairs.br[i]));
+		// 半径の和が負（埋めたレーン）なら当たらない
+		const __m128 mask = _mm_and_ps(_mm_cmple_ps(distanceSq, _mm_mul_ps(radius, radius)),
+		                               _mm_cmpge_ps(radius, _mm_setzero_ps()));
+		hitCount = StoreHits(mask, i, hitIndices, hitCount);
+	}
+#else
+	for (uint32_t i = 0; i < padded; ++i) {
+		const float dx = pairs.ax[i] - pairs.bx[i];
+		const float dy = pairs.ay[i] - pairs.by[i];
+		const float dz = pairs.az[i] - pairs.bz[i];
+		const float radius = pairs.ar[i] + pairs.br[i];
+		if (radius >= 0.0f && dx * dx + dy * dy + dz * dz <= radius * radius) {
+			hitIndices[hitCount++] = i;
+		}
+	}
+#endif
+	pairs.count = 0;
+	return hitCount;
+}
+
+/*-----------------------------------------------------------------------*/
+// 球とAABB
+/*-----------------------------------------------------------------------*/
+uint32_t CollisionBatch::Test(SphereAABBPairs& pairs, uint32_t* hitIndices) {
+	const uint32_t count = pairs.count;
+	const uint32_t padded = RoundUp(count);
+
+	// 端数は半径が負の（絶対に当たらない）球で埋める
+	for (float* values : { pairs.cx, pairs.cy, pairs.cz, pairs.minX, pairs.minY, pairs.minZ, pairs.maxX, pairs.maxY, pairs.maxZ }) {
+		Pad(values, count, padded, 0.0f);
+	}
+	Pad(pairs.r, count, padded, -1.0f);
+
+	uint32_t hitCount = 0;
+#ifdef COLLISION_BATCH_SSE
+	for (uint32_t i = 0; i < padded; i += kWidth) {
+		const __m128 cx = _mm_load_ps(&pairs.cx[i]);
+		const __m128 cy = _mm_load_ps(&pairs.cy[i]);
+		const __m128 cz = _mm_load_ps(&pairs.cz[i]);
+		// 最近接点（std::clamp と同じく max で下限、min で上限）
+		const __m128 dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cx, _mm_load_ps(&pairs.minX[i])), _mm_load_ps(&pairs.maxX[i])), cx);
+		const __m128 dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cy, _mm_load_ps(&pairs.minY[i])), _mm_load_ps(&pairs.maxY[i])), cy);
+		const __m128 dz = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cz, _mm_load_ps(&pairs.minZ[i])), _mm_load_ps(&pairs.maxZ[i])), cz);
+		const __m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		const __m128 radius = _mm_load_ps(&pairs.r[i]);
+		const __m128 mask = _mm_and_ps(_mm_cmple_ps(distanceSq, _mm_mul_ps(radius, radius)),
+		                               _mm_cmpge_ps(radius, _mm_setzero_ps()));
+		hitCount = StoreHits(mask, i, hitIndices, hitCount);
+	}
+#else
+	for (uint32_t i = 0; i < padded; ++i) {
+		const float dx = std::min(std::max(pairs.cx[i], pairs.minX[i]), pairs.maxX[i]) - pairs.cx[i];
+		const float dy = std::min(std::max(pairs.cy[i], pairs.minY[i]), pairs.maxY[i]) - pairs.cy[i];
+		const float dz = std::min(std::max(pairs.cz[i], pairs.minZ[i]), pairs.maxZ[i]) - pairs.cz[i];
+		const float radius = pairs.r[i];
+		if (radius >= 0.0f && dx * dx + dy * dy + dz * dz <= radius * radius) {
+			hitIndices[hitCount++] = i;
+		}
+	}
+#endif
+	pairs.count = 0;
+	return hitCount;
+}
+
+/*-----------------------------------------------------------------------*/
+// AABBとAABB
+/*-----------------------------------------------------------------------*/
+uint32_t CollisionBatch::Test(AABBAABBPairs& pairs, uint32_t* hitIndices) {
+	const uint32_t count = pairs.count;
+	const uint32_t padded = RoundUp(count);
+
+	// 端数は min > max の（どれとも重ならない）箱で埋める
+	for (float* values : { pairs.aMinX, pairs.aMinY, pairs.aMinZ, pairs.bMinX, pairs.bMinY, pairs.bMinZ }) {
+		Pad(values, count, padded, 1.0f);
+	}
+	for (float* values : { pairs.aMaxX, pairs.aMaxY, pairs.aMaxZ, pairs.bMaxX, pairs.bMaxY, pairs.bMaxZ }) {
+		Pad(values, count, padded, -1.0f);
+	}
+
+	uint32_t hitCount = 0;
+#ifdef COLLISION_BATCH_SSE
+	auto overlap = [](const float* aMin, const float* aMax, const float* bMin, const float* bMax) {
+		return _mm_and_ps(_mm_cmple_ps(_mm_load_ps(aMin), _mm_load_ps(bMax)),
+		                  _mm_cmpge_ps(_mm_load_ps(aMax), _mm_load_ps(bMin)));
+	};
+	for (uint32_t i = 0; i < padded; i += kWidth) {
+		const __m128 mask = _mm_and_ps(_mm_and_ps(
+			overlap(&pairs.aMinX[i], &pairs.aMaxX[i], &pairs.bMinX[i], &pairs.bMaxX[i]),
+			overlap(&pairs.aMinY[i], &pairs.aMaxY[i], &pairs.bMinY[i], &pairs.bMaxY[i])),
+			overlap(&pairs.aMinZ[i], &pairs.aMaxZ[i], &pairs.bMinZ[i], &pairs.bMaxZ[i]));
+		hitCount = StoreHits(mask, i, hitIndices, hitCount);
+	}
+#else
+	for (uint32_t i = 0; i < padded; ++i) {
+		if (pairs.aMinX[i] <= pairs.bMaxX[i] && pairs.aMaxX[i] >= pairs.bMinX[i] &&
+		    pairs.aMinY[i] <= pairs.bMaxY[i] && pairs.aMaxY[i] >= pairs.bMinY[i] &&
+		    pairs.aMinZ[i] <= pairs.bMaxZ[i] && pairs.aMaxZ[i] >= pairs.bMinZ[i]) {
+			hitIndices[hitCount++] = i;
+		}
+	}
+#endif
+	pairs.count = 0;
+	return hitCount;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "Engine/MyMath/MyFunction.h"
+#include <cstdint>
+
+/// <summary>
+/// 球・AABB のナローフェーズをまとめて判定するカーネル
+/// ブロードフェーズ後の候補ペアを型の組み合わせごとに SoA（成分ごとの連続した配列）へ詰め、
+/// SSE で4ペアずつ判定する（距離は2乗のまま比べるので平方根は使わない）
+/// 判定結果は Collision::IsCollision の同じ型の組み合わせと一致する
+/// </summary>
+namespace CollisionBatch {
+
+	// 一度に判定するペア数（SSE の4レーン）
+	constexpr uint32_t kWidth = 4;
+
+	// 1つのバッチに積めるペア数（kWidth の倍数、作業領域が L1 に収まる程度）
+	constexpr uint32_t kCapacity = 256;
+
+	/// <summary>球と球のペア（SoA）</summary>
+	struct SphereSpherePairs {
+		alignas(16) float ax[kCapacity], ay[kCapacity], az[kCapacity], ar[kCapacity];
+		alignas(16) float bx[kCapacity], by[kCapacity], bz[kCapacity], br[kCapacity];
+		uint32_t count = 0;
+
+		void Push(const SphereMath& a, const SphereMath& b) {
+			const uint32_t i = count++;
+			ax[i] = a.center.x; ay[i] = a.center.y; az[i] = a.center.z; ar[i] = a.radius;
+			bx[i] = b.center.x; by[i] = b.center.y; bz[i] = b.center.z; br[i] = b.radius;
+		}
+		bool IsFull() const { return count == kCapacity; }
+	};
+
+	/// <summary>球とAABBのペア（SoA）</summary>
+	struct SphereAABBPairs {
+		alignas(16) float cx[kCapacity], cy[kCapacity], cz[kCapacity], r[kCapacity];
+		alignas(16) float minX[kCapacity], minY[kCapacity], minZ[kCapacity];
+		alignas(16) float maxX[kCapacity], maxY[kCapacity], maxZ[kCapacity];
+		uint32_t count = 0;
+
+		void Push(const SphereMath& sphere, const AABB& aabb) {
+			const uint32_t i = count++;
+			cx[i] = sphere.center.x; cy[i] = sphere.center.y; cz[i] = sphere.center.z; r[i] = sphere.radius;
+			minX[i] = aabb.min.x; minY[i] = aabb.min.y; minZ[i] = aabb.min.z;
+			maxX[i] = aabb.max.x; maxY[i] = aabb.max.y; maxZ[i] = aabb.max.z;
+		}
+		bool IsFull() const { return count == kCapacity; }
+	};
+
+	/// <summary>AABBとAABBのペア（SoA）</summary>
+	struct AABBAABBPairs {
+		alignas(16) float aMinX[kCapacity], aMinY[kCapacity], aMinZ[kCapacity];
+		alignas(16) float aMaxX[kCapacity], aMaxY[kCapacity], aMaxZ[kCapacity];
+		alignas(16) float bMinX[kCapacity], bMinY[kCapacity], bMinZ[kCapacity];
+		alignas(16) float bMaxX[kCapacity], bMaxY[kCapacity], bMaxZ[kCapacity];
+		uint32_t count = 0;
+
+		void Push(const AABB& a, const AABB& b) {
+			const uint32_t i = count++;
+			aMinX[i] = a.min.x; aMinY[i] = a.min.y; aMinZ[i] = a.min.z;
+			aMaxX[i] = a.max.x; aMaxY[i] = a.max.y; aMaxZ[i] = a.max.z;
+			bMinX[i] = b.min.x; bMinY[i] = b.min.y; bMinZ[i] = b.min.z;
+			bMaxX[i] = b.max.x; bMaxY[i] = b.max.y; bMaxZ[i] = b.max.z;
+		}
+		bool IsFull() const { return count == kCapacity; }
+	};
+
+	/// <summary>
+	/// 積んだペアをまとめて判定する
+	/// 当たったペアの番号（Push した順）を hitIndices に書き、その数を返す（hitIndices は kCapacity 個分必要）
+	/// 4の倍数に満たない端数は当たらない値で埋めてから判定する
+	/// </summary>
+	uint32_t Test(SphereSpherePairs& pairs, uint32_t* hitIndices);
+	uint32_t Test(SphereAABBPairs& pairs, uint32_t* hitIndices);
+	uint32_t Test(AABBAABBPairs& pairs, uint32_t* hitIndices);
+}
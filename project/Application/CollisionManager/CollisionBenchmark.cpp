@@ -0,0 +1,226 @@
+#define NOMINMAX
+#include "CollisionBenchmark.h"
+#include "CollisionManager.h"
+#include "CollisionConfig.h"
+#ifdef USEIMGUI
+#include "ImGui/ImGuiManager.h"
+#endif
+#include "Logger.h"
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+	// 計測で使う固定のデルタタイム（60fps）
+	constexpr float kDeltaTime = 1.0f / 60.0f;
+
+	// どの方式でも同じコライダー群を生成するためのシード
+	constexpr uint32_t kSeed = 24680;
+
+	// 1コライダーあたりの広さ（XZ平面、数が増えても密度が変わらないようにする）
+	constexpr float kAreaPerCollider = 25.0f;
+
+	/// <summary>計測用の球（位置と速度だけを持つ）</summary>
+	class BenchmarkSphere : public SphereCollider {
+	public:
+		Vector3 GetWorldPosition() override { return position; }
+
+		Vector3 position = {};
+		Vector3 velocity = {};
+	};
+
+	/// <summary>計測用の箱（壁として動かさない）</summary>
+	class BenchmarkBox : public AABBCollider {
+	public:
+		Vector3 GetWorldPosition() override { return position; }
+
+		Vector3 position = {};
+	};
+
+	/// <summary>計測用のコライダー群（TestShooter のような弾幕を想定）</summary>
+	struct BenchmarkScene {
+		std::vector<std::unique_ptr<BenchmarkSphere>> spheres;
+		std::vector<std::unique_ptr<BenchmarkBox>> boxes;
+		float halfExtent = 0.0f;
+	};
+
+	/// <summary>
+	/// コライダー群を生成（壁5%、自機2%、敵13%、自機弾40%、敵弾40%）
+	/// movingRatio の割合の球だけを動かす（小さくすると TestWall のような静的な配置に近づく）
+	/// </summary>
+	BenchmarkScene CreateScene(uint32_t colliderCount, float movingRatio) {
+		BenchmarkScene scene;
+		scene.halfExtent = std::sqrt(static_cast<float>(colliderCount) * kAreaPerCollider) * 0.5f;
+
+		std::mt19937 engine(kSeed);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		std::uniform_real_distribution<float> area(-scene.halfExtent, scene.halfExtent);
+		std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+		for (uint32_t i = 0; i < colliderCount; ++i) {
+			const float kind = unit(engine);
+			const Vector3 position = { area(engine), (unit(engine) - 0.5f) * 2.0f, area(engine) };
+
+			if (kind < 0.05f) {
+				// 壁
+				auto box = std::make_unique<BenchmarkBox>();
+				box->position = position;
+				box->SetAABBSize({ 1.0f + unit(engine) * 7.0f, 2.0f, 1.0f + unit(engine) * 7.0f });
+				box->SetCollisionAttribute(kCollisionAttributeObjects);
+				box->SetCollisionMask(kCollisionAttributePlayer | kCollisionAttributeEnemy |
+					kCollisionAttributePlayerBullet | kCollisionAttributeEnemyBullet);
+				scene.boxes.push_back(std::move(box));
+				continue;
+			}
+
+			auto sphere = std::make_unique<BenchmarkSphere>();
+			sphere->position = position;
+			float speed = 0.0f;
+			if (kind < 0.07f) {
+				// 自機
+				sphere->SetRadius(1.0f);
+				sphere->SetCollisionAttribute(kCollisionAttributePlayer);
+				sphere->SetCollisionMask(kCollisionAttributeEnemy | kCollisionAttributeEnemyBullet | kCollisionAttributeObjects);
+				speed = 5.0f;
+			} else if (kind < 0.20f) {
+				// 敵
+				sphere->SetRadius(1.0f + unit(engine) * 0.5f);
+				sphere->SetCollisionAttribute(kCollisionAttributeEnemy);
+				sphere->SetCollisionMask(kCollisionAttributePlayer | kCollisionAttributePlayerBullet | kCollisionAttributeObjects);
+				speed = 2.0f;
+			} else if (kind < 0.60f) {
+				// 自機弾
+				sphere->SetRadius(0.25f);
+				sphere->SetCollisionAttribute(kCollisionAttributePlayerBullet);
+				sphere->SetCollisionMask(kCollisionAttributeEnemy | kCollisionAttributeObjects);
+				speed = 15.0f;
+			} else {
+				// 敵弾
+				sphere->SetRadius(0.25f);
+				sphere->SetCollisionAttribute(kCollisionAttributeEnemyBullet);
+				sphere->SetCollisionMask(kCollisionAttributePlayer | kCollisionAttributeObjects);
+				speed = 10.0f;
+			}
+			const float direction = angle(engine);
+			if (unit(engine) >= movingRatio) {
+				speed = 0.0f;
+			}
+			sphere->velocity = { std::cos(direction) * speed, 0.0f, std::sin(direction) * speed };
+			scene.spheres.push_back(std::move(sphere));
+		}
+		return scene;
+	}
+
+	/// <summary>球を1フレーム動かす（範囲外に出たら反対側へ回り込む）</summary>
+	void StepScene(BenchmarkScene& scene) {
+		const float extent = scene.halfExtent * 2.0f;
+		for (auto& sphere : scene.spheres) {
+			Vector3& p = sphere->position;
+			p.x += sphere->velocity.x * kDeltaTime;
+			p.z += sphere->velocity.z * kDeltaTime;
+			if (p.x > scene.halfExtent) { p.x -= extent; }
+			if (p.x < -scene.halfExtent) { p.x += extent; }
+			if (p.z > scene.halfExtent) { p.z -= extent; }
+			if (p.z < -scene.halfExtent) { p.z += extent; }
+		}
+	}
+}
+
+CollisionBenchmark::Result CollisionBenchmark::Run(CollisionBroadphaseType type, uint32_t colliderCount, uint32_t frameCount, float movingRatio, bool batchNarrowphase, bool parallel) {
+	BenchmarkScene scene = CreateScene(colliderCount, movingRatio);
+
+	CollisionManager manager;
+	manager.Initialize();
+	manager.SetBroadphaseType(type);
+	manager.SetBatchNarrowphase(batchNarrowphase);
+	manager.SetParallel(parallel);
+
+	Result result;
+	result.colliderCount = colliderCount;
+	result.frameCount = frameCount;
+
+	// シーンと同じく一度だけ登録する
+	for (auto& box : scene.boxes) {
+		manager.RegisterCollider(box.get());
+	}
+	for (auto& sphere : scene.spheres) {
+		manager.RegisterCollider(sphere.get());
+	}
+
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		StepScene(scene);
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		manager.Update();
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		result.totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+		result.candidateCount += manager.GetLastCandidateCount();
+		result.contactCount += manager.GetContactCount();
+	}
+
+	result.msPerFrame = frameCount > 0 ? result.totalMs / frameCount : 0.0;
+	return result;
+}
+
+bool CollisionBenchmark::RunAll(uint32_t colliderCount, uint32_t frameCount) {
+	bool passed = true;
+
+	// 方式が違っても接触数は一致するはず
+	Result results[static_cast<int>(CollisionBroadphaseType::Count)];
+	for (int i = 0; i < static_cast<int>(CollisionBroadphaseType::Count); ++i) {
+		const CollisionBroadphaseType type = static_cast<CollisionBroadphaseType>(i);
+		results[i] = Run(type, colliderCount, frameCount);
+		LogResult(type, results[i]);
+		passed = passed && results[i].contactCount == results[0].contactCount;
+	}
+
+	// 逐次でも並列と同じ接触数になるはず
+	const CollisionBroadphaseType serialType = static_cast<CollisionBroadphaseType>(0);
+	const Result serial = Run(serialType, colliderCount, frameCount, 1.0f, true, false);
+	LogResult(serialType, serial);
+	passed = passed && serial.contactCount == results[0].contactCount;
+
+	Logger::Log(Logger::GetStream(), std::format("CollisionBenchmark: {}\n", passed ? "PASSED" : "FAILED"));
+	return passed;
+}
+
+void CollisionBenchmark::LogResult(CollisionBroadphaseType type, const Result& result) {
+	Logger::Log(Logger::GetStream(),
+		std::format("CollisionBenchmark [{}]: {} colliders x {} frames, {:.3f} ms ({:.4f} ms/frame, candidates {}, contacts {})\n",
+			CollisionBroadphaseUtil::GetName(type), result.colliderCount, result.frameCount,
+			result.totalMs, result.msPerFrame, result.candidateCount, result.contactCount));
+}
+
+void CollisionBenchmark::ImGui() {
+#ifdef USEIMGUI
+	ImGui::DragInt("Colliders", &colliderCount_, 10.0f, 10, 100000);
+	ImGui::DragInt("Frames", &frameCount_, 1.0f, 1, 10000);
+	ImGui::SliderFloat("Moving Ratio", &movingRatio_, 0.0f, 1.0f);
+	ImGui::Checkbox("Batch Narrowphase", &batchNarrowphase_);
+	ImGui::Checkbox("Parallel", &parallel_);
+
+	if (ImGui::Button("Run All Broadphases")) {
+		for (int i = 0; i < static_cast<int>(CollisionBroadphaseType::Count); ++i) {
+			const CollisionBroadphaseType type = static_cast<CollisionBroadphaseType>(i);
+			results_[i] = Run(type, static_cast<uint32_t>(colliderCount_), static_cast<uint32_t>(frameCount_), movingRatio_, batchNarrowphase_, parallel_);
+			LogResult(type, results_[i]);
+		}
+		hasResult_ = true;
+	}
+
+	if (hasResult_) {
+		const double baseMs = results_[0].msPerFrame;
+		for (int i = 0; i < static_cast<int>(CollisionBroadphaseType::Count); ++i) {
+			const Result& result = results_[i];
+			ImGui::Text("%-14s %.4f ms/frame  x%.1f  (candidates %llu, contacts %llu)",
+				CollisionBroadphaseUtil::GetName(static_cast<CollisionBroadphaseType>(i)), result.msPerFrame,
+				result.msPerFrame > 0.0 ? baseMs / result.msPerFrame : 0.0,
+				static_cast<unsigned long long>(result.candidateCount), static_cast<unsigned long long>(result.contactCount));
+		}
+	}
+#endif
+}
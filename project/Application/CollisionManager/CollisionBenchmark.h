@@ -0,0 +1,54 @@
+#pragma once
+#include "CollisionBroadphase.h"
+#include <cstdint>
+
+/// <summary>
+/// 衝突判定のブロードフェーズのベンチマーク
+/// 描画やシーンに依存せず、合成したコライダー群（弾・敵・壁）を動かしながら CollisionManager::Update を計測する
+/// 方式が違っても衝突ペアの合計は一致するはずなので、結果の検証にも使う
+/// </summary>
+class CollisionBenchmark {
+public:
+	/// <summary>計測結果</summary>
+	struct Result {
+		uint32_t colliderCount = 0;		// コライダー数
+		uint32_t frameCount = 0;		// 更新フレーム数
+		double totalMs = 0.0;			// 判定にかかった合計時間（ミリ秒）
+		double msPerFrame = 0.0;		// 1フレームあたりの時間（ミリ秒）
+		uint64_t candidateCount = 0;	// ナローフェーズに回したペアの合計
+		uint64_t contactCount = 0;		// 衝突していたペアの合計（検証用）
+	};
+
+	/// <summary>
+	/// 指定した方式で計測する
+	/// </summary>
+	/// <param name="type">ブロードフェーズの方式</param>
+	/// <param name="colliderCount">コライダー数</param>
+	/// <param name="frameCount">更新フレーム数</param>
+	/// <param name="movingRatio">動かす球の割合（0で壁・弾が止まったままの静的な配置）</param>
+	/// <param name="batchNarrowphase">ナローフェーズを SIMD でまとめて判定するか</param>
+	/// <param name="parallel">判定を JobSystem で並列に行うか（接触数は逐次と一致するはず）</param>
+	static Result Run(CollisionBroadphaseType type, uint32_t colliderCount, uint32_t frameCount,
+		float movingRatio = 1.0f, bool batchNarrowphase = true, bool parallel = true);
+
+	/// <summary>
+	/// 全方式を計測してログに出す（ImGui を使わないコマンドラインからの実行用）
+	/// </summary>
+	/// <returns>全方式の接触数と、逐次・並列の接触数がそれぞれ一致すれば true</returns>
+	static bool RunAll(uint32_t colliderCount = 500, uint32_t frameCount = 120);
+
+	/// <summary>ImGui（コライダー数・フレーム数の設定と全方式の実行）</summary>
+	void ImGui();
+
+private:
+	/// <summary>結果をログに出力</summary>
+	static void LogResult(CollisionBroadphaseType type, const Result& result);
+
+	int colliderCount_ = 500;
+	int frameCount_ = 120;
+	float movingRatio_ = 1.0f;
+	bool batchNarrowphase_ = true;
+	bool parallel_ = true;
+	Result results_[static_cast<int>(CollisionBroadphaseType::Count)];
+	bool hasResult_ = false;
+};
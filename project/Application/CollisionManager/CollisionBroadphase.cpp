@@ -0,0 +1,373 @@
+#define NOMINMAX
+#include "CollisionBroadphase.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iterator>
+
+namespace {
+
+	constexpr const char* kBroadphaseNames[] = { "Brute Force", "Uniform Grid", "Sweep And Prune" };
+	static_assert(std::size(kBroadphaseNames) == static_cast<size_t>(CollisionBroadphaseType::Count), "kBroadphaseNames must match CollisionBroadphaseType");
+
+	// セル座標の範囲（キーに各軸21bitで詰めるため）
+	constexpr int32_t kCellCoordMin = -(1 << 20);
+	constexpr int32_t kCellCoordMax = (1 << 20) - 1;
+
+	// 自動で決めるセルの大きさの下限（点のようなコライダーばかりの時に細かくなりすぎないように）
+	constexpr float kMinAutoCellSize = 1.0e-2f;
+
+	// スイープ軸を切り替える分散の比（小さな揺れで毎フレーム並べ直さないように）
+	constexpr float kAxisSwitchRatio = 1.5f;
+
+	// 追加されたコライダーがこの割合を超えたら挿入ソートをやめて全体を並べ直す
+	constexpr uint32_t kFullSortAddDivisor = 8;
+
+	/// <summary>範囲の重なり（接しているものも含む。Collision::IsCollision と同じ）</summary>
+	bool Overlaps(const AABB& a, const AABB& b) {
+		return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+		       a.min.y <= b.max.y && a.max.y >= b.min.y &&
+		       a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+
+	bool IsFinite(const AABB& bounds) {
+		return std::isfinite(bounds.min.x) && std::isfinite(bounds.min.y) && std::isfinite(bounds.min.z) &&
+		       std::isfinite(bounds.max.x) && std::isfinite(bounds.max.y) && std::isfinite(bounds.max.z);
+	}
+
+	float GetAxisValue(const Vector3& v, int axis) {
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+}
+
+const char* CollisionBroadphaseUtil::GetName(CollisionBroadphaseType type) {
+	const size_t index = static_cast<size_t>(type);
+	return index < std::size(kBroadphaseNames) ? kBroadphaseNames[index] : kBroadphaseNames[0];
+}
+
+void CollisionUniformGrid::FindPairs(const std::vector<AABB>& bounds, std::vector<CollisionIndexPair>& outPairs) {
+	outPairs.clear();
+	Prepare(bounds);
+	CollectPairs(bounds, 0, 1, outPairs);
+}
+
+void CollisionUniformGrid::Prepare(const std::vector<AABB>& bounds) {
+	entries_.clear();
+	largeIndices_.clear();
+
+	const uint32_t count = static_cast<uint32_t>(bounds.size());
+	minCells_.resize(count);
+	isLarge_.assign(count, 0);
+
+	lastCellSize_ = cellSize_ > 0.0f ? cellSize_ : ComputeAutoCellSize(bounds);
+	const float inverseCellSize = 1.0f / lastCellSize_;
+
+	// 1. 各コライダーを重なるセルに登録（大きすぎるものは総当たりに回す）
+	for (uint32_t i = 0; i < count; ++i) {
+		if (!IsFinite(bounds[i])) {
+			isLarge_[i] = 1;
+			largeIndices_.push_back(i);
+			continue;
+		}
+
+		const Cell lo = ToCell(bounds[i].min, inverseCellSize);
+		const Cell hi = ToCell(bounds[i].max, inverseCellSize);
+		// 各軸最大2^21セルなので、2軸ずつ掛けて判定すればあふれない
+		const int64_t cellCountXY = static_cast<int64_t>(hi.x - lo.x + 1) * (hi.y - lo.y + 1);
+		if (cellCountXY > kMaxCellsPerCollider || cellCountXY * (hi.z - lo.z + 1) > kMaxCellsPerCollider) {
+			isLarge_[i] = 1;
+			largeIndices_.push_back(i);
+			continue;
+		}
+
+		minCells_[i] = lo;
+		for (int32_t z = lo.z; z <= hi.z; ++z) {
+			for (int32_t y = lo.y; y <= hi.y; ++y) {
+				for (int32_t x = lo.x; x <= hi.x; ++x) {
+					entries_.push_back({ MakeKey({ x, y, z }), i });
+				}
+			}
+		}
+	}
+
+	// 2. キーで並べ替えて同じセルの登録を連続させる（同じセル内はインデックス順）
+	std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+		return a.key != b.key ? a.key < b.key : a.index < b.index;
+	});
+}
+
+void CollisionUniformGrid::CollectPairs(const std::vector<AABB>& bounds, uint32_t taskIndex, uint32_t taskCount,
+	std::vector<CollisionIndexPair>& outPairs) const {
+	// 3. 受け持ちのセルで、同じセルに入ったもの同士を候補にする
+	//    （登録数で等分した位置をセルの先頭まで進めて境界にするので、セルが2つのタスクにまたがることはない）
+	const size_t entryCount = entries_.size();
+	const size_t rangeBegin = AlignToCellStart(entryCount * taskIndex / taskCount);
+	const size_t rangeEnd = AlignToCellStart(entryCount * (taskIndex + 1) / taskCount);
+	for (size_t begin = rangeBegin; begin < rangeEnd;) {
+		const uint64_t key = entries_[begin].key;
+		size_t end = begin + 1;
+		while (end < entryCount && entries_[end].key == key) {
+			++end;
+		}
+
+		for (size_t a = begin; a < end; ++a) {
+			const uint32_t indexA = entries_[a].index;
+			const Cell& minA = minCells_[indexA];
+			for (size_t b = a + 1; b < end; ++b) {
+				const uint32_t indexB = entries_[b].index;
+				const Cell& minB = minCells_[indexB];
+
+				// 両者が共有する最初のセルでだけ報告する（複数セルでの重複を除く）
+				const Cell firstShared = { std::max(minA.x, minB.x), std::max(minA.y, minB.y), std::max(minA.z, minB.z) };
+				if (MakeKey(firstShared) != key) {
+					continue;
+				}
+				if (Overlaps(bounds[indexA], bounds[indexB])) {
+					outPairs.push_back({ indexA, indexB });
+				}
+			}
+		}
+		begin = end;
+	}
+
+	// 4. 受け持ちの大きなコライダーは全コライダーと比べる（大きなもの同士は1回だけ）
+	const uint32_t count = static_cast<uint32_t>(bounds.size());
+	const size_t largeCount = largeIndices_.size();
+	for (size_t i = largeCount * taskIndex / taskCount; i < largeCount * (taskIndex + 1) / taskCount; ++i) {
+		const uint32_t large = largeIndices_[i];
+		for (uint32_t other = 0; other < count; ++other) {
+			if (other == large || (isLarge_[other] && other < large)) {
+				continue;
+			}
+			if (Overlaps(bounds[large], bounds[other])) {
+				outPairs.push_back({ std::min(large, other), std::max(large, other) });
+			}
+		}
+	}
+}
+
+size_t CollisionUniformGrid::AlignToCellStart(size_t begin) const {
+	if (begin == 0 || begin >= entries_.size()) {
+		return begin;
+	}
+	// キーで並んでいるので、直前と同じキーが続く範囲を二分探索で飛ばす
+	const uint64_t key = entries_[begin - 1].key;
+	const auto it = std::partition_point(entries_.begin() + begin, entries_.end(),
+		[key](const Entry& entry) { return entry.key == key; });
+	return static_cast<size_t>(it - entries_.begin());
+}
+
+float CollisionUniformGrid::ComputeAutoCellSize(const std::vector<AABB>& bounds) const {
+	// 平均的なコライダーが1～数セルに収まる大きさ（最大辺の平均の2倍）
+	double total = 0.0;
+	uint32_t used = 0;
+	for (const AABB& b : bounds) {
+		// 無限大の範囲（未対応の型）は総当たりに回るので含めない
+		const float extent = std::max({ b.max.x - b.min.x, b.max.y - b.min.y, b.max.z - b.min.z });
+		if (!IsFinite(b) || !std::isfinite(extent)) {
+			continue;
+		}
+		total += extent;
+		++used;
+	}
+	if (used == 0) {
+		return 1.0f;
+	}
+	return std::max(static_cast<float>(total / used) * 2.0f, kMinAutoCellSize);
+}
+
+CollisionUniformGrid::Cell CollisionUniformGrid::ToCell(const Vector3& position, float inverseCellSize) const {
+	auto toCoord = [inverseCellSize](float value) {
+		const float cell = std::floor(value * inverseCellSize);
+		return static_cast<int32_t>(std::clamp(cell, static_cast<float>(kCellCoordMin), static_cast<float>(kCellCoordMax)));
+	};
+	return { toCoord(position.x), toCoord(position.y), toCoord(position.z) };
+}
+
+uint64_t CollisionUniformGrid::MakeKey(const Cell& cell) {
+	constexpr uint64_t kMask = (1ull << 21) - 1;
+	const uint64_t x = static_cast<uint64_t>(cell.x - kCellCoordMin) & kMask;
+	const uint64_t y = static_cast<uint64_t>(cell.y - kCellCoordMin) & kMask;
+	const uint64_t z = static_cast<uint64_t>(cell.z - kCellCoordMin) & kMask;
+	return x | (y << 21) | (z << 42);
+}
+
+void CollisionSweepAndPrune::FindPairs(const std::vector<ICollider*>& colliders, const std::vector<AABB>& bounds, std::vector<CollisionIndexPair>& outPairs) {
+	outPairs.clear();
+
+	// 1. 登録の増減を端点列に反映し、軸と端点の値を更新
+	const uint32_t addedCount = SyncProxies(colliders);
+	const bool axisChanged = SelectAxis(bounds);
+	UpdateEndpointValues(bounds);
+
+	// 2. 並べ替え（通常はほぼ整列済みなので挿入ソート）
+	const uint32_t liveCount = static_cast<uint32_t>(proxyMap_.size());
+	wasLastFullSort_ = axisChanged || addedCount * kFullSortAddDivisor > liveCount;
+	if (wasLastFullSort_) {
+		std::sort(endpoints_.begin(), endpoints_.end(), Less);
+		lastSwapCount_ = 0;
+	} else {
+		InsertionSort();
+	}
+
+	// 3. スイープ（min で区間を開き、開いている区間と重なりを確認、max で閉じる）
+	active_.clear();
+	for (const Endpoint& endpoint : endpoints_) {
+		const uint32_t proxyIndex = endpoint.GetProxy();
+		Proxy& proxy = proxies_[proxyIndex];
+
+		if (endpoint.IsMax()) {
+			const uint32_t slot = proxy.activeSlot;
+			const uint32_t last = active_.back();
+			active_[slot] = last;
+			proxies_[last].activeSlot = slot;
+			active_.pop_back();
+			continue;
+		}
+
+		const uint32_t index = proxy.index;
+		for (uint32_t other : active_) {
+			const uint32_t otherIndex = proxies_[other].index;
+			if (Overlaps(bounds[index], bounds[otherIndex])) {
+				outPairs.push_back({ std::min(index, otherIndex), std::max(index, otherIndex) });
+			}
+		}
+		proxy.activeSlot = static_cast<uint32_t>(active_.size());
+		active_.push_back(proxyIndex);
+	}
+}
+
+void CollisionSweepAndPrune::Clear() {
+	endpoints_.clear();
+	proxies_.clear();
+	freeProxies_.clear();
+	proxyMap_.clear();
+	active_.clear();
+	frame_ = 0;
+	lastSwapCount_ = 0;
+	wasLastFullSort_ = false;
+}
+
+uint32_t CollisionSweepAndPrune::SyncProxies(const std::vector<ICollider*>& colliders) {
+	++frame_;
+
+	// 1. 既存の proxy に今フレームの位置を記録（新しいコライダーは後で追加）
+	std::vector<uint32_t>& added = addedIndices_;
+	added.clear();
+	uint32_t keptCount = 0;
+	for (uint32_t i = 0; i < static_cast<uint32_t>(colliders.size()); ++i) {
+		auto it = proxyMap_.find(colliders[i]);
+		if (it == proxyMap_.end()) {
+			added.push_back(i);
+			continue;
+		}
+		Proxy& proxy = proxies_[it->second];
+		if (proxy.frame == frame_) {
+			continue;	// 同じコライダーの重複登録は1つとして扱う
+		}
+		proxy.index = i;
+		proxy.frame = frame_;
+		++keptCount;
+	}
+
+	// 2. 今フレームに登録されなかった proxy を外し、端点を詰める
+	if (keptCount < proxyMap_.size()) {
+		for (uint32_t p = 0; p < static_cast<uint32_t>(proxies_.size()); ++p) {
+			Proxy& proxy = proxies_[p];
+			if (proxy.collider != nullptr && proxy.frame != frame_) {
+				proxyMap_.erase(proxy.collider);
+				proxy.collider = nullptr;
+				freeProxies_.push_back(p);
+			}
+		}
+		std::erase_if(endpoints_, [this](const Endpoint& endpoint) {
+			return proxies_[endpoint.GetProxy()].collider == nullptr;
+		});
+	}
+
+	// 3. 新しいコライダーの端点を末尾に追加（値は後で設定し、並べ替えで正しい位置へ移る）
+	uint32_t addedCount = 0;
+	for (uint32_t i : added) {
+		ICollider* collider = colliders[i];
+		if (proxyMap_.contains(collider)) {
+			continue;	// 今フレーム内での重複登録
+		}
+		uint32_t p = 0;
+		if (!freeProxies_.empty()) {
+			p = freeProxies_.back();
+			freeProxies_.pop_back();
+		} else {
+			p = static_cast<uint32_t>(proxies_.size());
+			proxies_.emplace_back();
+		}
+		proxies_[p] = { collider, i, frame_, 0 };
+		proxyMap_.emplace(collider, p);
+		endpoints_.push_back({ 0.0f, p << 1 });
+		endpoints_.push_back({ 0.0f, (p << 1) | 1u });
+		++addedCount;
+	}
+	return addedCount;
+}
+
+bool CollisionSweepAndPrune::SelectAxis(const std::vector<AABB>& bounds) {
+	// 中心の分散（有限の範囲だけ）
+	double sum[3] = {};
+	double squareSum[3] = {};
+	uint32_t used = 0;
+	for (const AABB& b : bounds) {
+		if (!IsFinite(b)) {
+			continue;
+		}
+		for (int axis = 0; axis < 3; ++axis) {
+			const double center = (static_cast<double>(GetAxisValue(b.min, axis)) + GetAxisValue(b.max, axis)) * 0.5;
+			sum[axis] += center;
+			squareSum[axis] += center * center;
+		}
+		++used;
+	}
+	if (used == 0) {
+		return false;
+	}
+
+	double variance[3] = {};
+	int best = 0;
+	for (int axis = 0; axis < 3; ++axis) {
+		const double mean = sum[axis] / used;
+		variance[axis] = squareSum[axis] / used - mean * mean;
+		if (variance[axis] > variance[best]) {
+			best = axis;
+		}
+	}
+	if (best == axis_ || variance[best] <= variance[axis_] * kAxisSwitchRatio) {
+		return false;
+	}
+	axis_ = best;
+	return true;
+}
+
+void CollisionSweepAndPrune::UpdateEndpointValues(const std::vector<AABB>& bounds) {
+	for (Endpoint& endpoint : endpoints_) {
+		const AABB& b = bounds[proxies_[endpoint.GetProxy()].index];
+		float minValue = GetAxisValue(b.min, axis_);
+		float maxValue = GetAxisValue(b.max, axis_);
+		// NaN や min > max でも min が max より前に来るようにする（スイープで開く前に閉じないため）
+		if (std::isnan(minValue)) { minValue = -FLT_MAX; }
+		if (std::isnan(maxValue)) { maxValue = FLT_MAX; }
+		endpoint.value = endpoint.IsMax() ? std::max(minValue, maxValue) : minValue;
+	}
+}
+
+void CollisionSweepAndPrune::InsertionSort() {
+	uint32_t swapCount = 0;
+	for (size_t i = 1; i < endpoints_.size(); ++i) {
+		const Endpoint endpoint = endpoints_[i];
+		size_t j = i;
+		while (j > 0 && Less(endpoint, endpoints_[j - 1])) {
+			endpoints_[j] = endpoints_[j - 1];
+			--j;
+		}
+		swapCount += static_cast<uint32_t>(i - j);
+		endpoints_[j] = endpoint;
+	}
+	lastSwapCount_ = swapCount;
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include "Engine/MyMath/MyFunction.h"
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class ICollider;
+
+/// <summary>
+/// ブロードフェーズ（衝突しうるペアの絞り込み）の方式
+/// ※ ImGui のコンボと名前の配列で使うため連番を維持すること
+/// </summary>
+enum class CollisionBroadphaseType {
+	BruteForce = 0,		// 総当たり（従来の二重ループ）
+	UniformGrid = 1,	// 一様グリッド（空間ハッシュ）
+	SweepAndPrune = 2,	// ソート＆スイープ（軸ごとの端点列をフレーム間で保持）
+	Count
+};
+
+/// <summary>ブロードフェーズ方式の名前変換</summary>
+namespace CollisionBroadphaseUtil {
+	const char* GetName(CollisionBroadphaseType type);
+}
+
+/// <summary>候補ペア（コライダー配列のインデックス、常に first < second）</summary>
+using CollisionIndexPair = std::pair<uint32_t, uint32_t>;
+
+/// <summary>
+/// 一様グリッド（空間ハッシュ）によるブロードフェーズ
+/// 各コライダーのワールド範囲が重なるセルに登録し、同じセルに入ったもの同士だけを候補にする
+/// 複数のセルで重なるペアは「両者の最小セルの大きい方」のセルでだけ報告するので、重複除去の集合は不要
+/// </summary>
+class CollisionUniformGrid {
+public:
+	// 1コライダーが登録できる最大セル数（超える大きなものは全コライダーと総当たりする）
+	static constexpr uint32_t kMaxCellsPerCollider = 64;
+
+	/// <summary>
+	/// 候補ペアを列挙する（範囲の重なりまで確認済み、順序は不定）
+	/// </summary>
+	/// <param name="bounds">コライダー毎のワールド範囲</param>
+	/// <param name="outPairs">候補ペアの出力先（クリアしてから追加する）</param>
+	void FindPairs(const std::vector<AABB>& bounds, std::vector<CollisionIndexPair>& outPairs);
+
+	/// <summary>
+	/// FindPairs を複数のタスクに分けて行う時の準備（セルへの登録と並べ替え）
+	/// この後 CollectPairs を taskCount 回（並列でよい）呼ぶと、全体で FindPairs と同じペアになる
+	/// </summary>
+	void Prepare(const std::vector<AABB>& bounds);
+
+	/// <summary>
+	/// Prepare したセルのうち taskIndex 番目の受け持ち分の候補ペアを outPairs に追加する
+	/// 受け持ちは登録数がほぼ均等になるようセルの並びで分け、大きなコライダーも均等に分ける
+	/// const なので、次の Prepare までは別のタスクから同時に呼んでよい
+	/// </summary>
+	void CollectPairs(const std::vector<AABB>& bounds, uint32_t taskIndex, uint32_t taskCount,
+		std::vector<CollisionIndexPair>& outPairs) const;
+
+	/// <summary>セルの大きさ（0以下なら範囲の平均の大きさから毎回自動で決める）</summary>
+	void SetCellSize(float cellSize) { cellSize_ = cellSize; }
+	float GetCellSize() const { return cellSize_; }
+
+	/// <summary>直近の FindPairs で使ったセルの大きさ</summary>
+	float GetLastCellSize() const { return lastCellSize_; }
+
+	/// <summary>直近の FindPairs でセルに登録した数</summary>
+	uint32_t GetLastEntryCount() const { return static_cast<uint32_t>(entries_.size()); }
+
+	/// <summary>直近の FindPairs で総当たりにした大きなコライダーの数</summary>
+	uint32_t GetLastLargeCount() const { return static_cast<uint32_t>(largeIndices_.size()); }
+
+private:
+	/// <summary>セル座標</summary>
+	struct Cell {
+		int32_t x, y, z;
+	};
+
+	/// <summary>セルへの登録（キーで並べ替えて同じセルをまとめる）</summary>
+	struct Entry {
+		uint64_t key;
+		uint32_t index;
+	};
+
+	/// <summary>entries_[begin] 以降で最初のセルの先頭（begin がセルの途中なら次のセルへ進める）</summary>
+	size_t AlignToCellStart(size_t begin) const;
+
+	/// <summary>範囲の平均の大きさからセルの大きさを決める</summary>
+	float ComputeAutoCellSize(const std::vector<AABB>& bounds) const;
+
+	/// <summary>座標からセル座標へ</summary>
+	Cell ToCell(const Vector3& position, float inverseCellSize) const;
+
+	/// <summary>セル座標をキーに詰める（各軸21bit）</summary>
+	static uint64_t MakeKey(const Cell& cell);
+
+	float cellSize_ = 0.0f;
+	float lastCellSize_ = 0.0f;
+
+	// 作業領域（毎フレーム再確保しないよう保持）
+	std::vector<Entry> entries_;
+	std::vector<Cell> minCells_;			// コライダー毎の最小セル（重複除去に使う）
+	std::vector<uint32_t> largeIndices_;	// セルに登録しきれない大きなコライダー
+	std::vector<uint8_t> isLarge_;
+};
+
+/// <summary>
+/// ソート＆スイープ（Sweep and Prune）によるブロードフェーズ
+/// 1軸上の範囲の端点（min / max）を並べた列をフレーム間で保持し、挿入ソートで更新する
+/// 物体はフレーム間で少ししか動かないので並べ替えはほぼ O(n) になり、静的な配置が多いシーンでは O(n + k) に近づく
+/// コライダーはポインタで識別するので、毎フレーム登録し直しても端点列はそのまま使い回せる
+/// </summary>
+class CollisionSweepAndPrune {
+public:
+	/// <summary>
+	/// 候補ペアを列挙する（範囲の重なりまで確認済み、順序は不定）
+	/// </summary>
+	/// <param name="colliders">コライダー（端点列の識別に使う、重複しないこと）</param>
+	/// <param name="bounds">コライダー毎のワールド範囲（colliders と同じ並び）</param>
+	/// <param name="outPairs">候補ペアの出力先（クリアしてから追加する）</param>
+	void FindPairs(const std::vector<ICollider*>& colliders, const std::vector<AABB>& bounds, std::vector<CollisionIndexPair>& outPairs);
+
+	/// <summary>保持している端点列を破棄する（次の FindPairs で作り直す）</summary>
+	void Clear();
+
+	/// <summary>現在スイープに使っている軸（0:X 1:Y 2:Z）</summary>
+	int GetAxis() const { return axis_; }
+
+	/// <summary>直近の FindPairs の挿入ソートで入れ替えた回数</summary>
+	uint32_t GetLastSwapCount() const { return lastSwapCount_; }
+
+	/// <summary>直近の FindPairs で全体を並べ直したか（初回・軸の変更・大量の追加時）</summary>
+	bool WasLastFullSort() const { return wasLastFullSort_; }
+
+private:
+	/// <summary>端点（proxy の番号と min / max の区別を1つに詰める）</summary>
+	struct Endpoint {
+		float value;
+		uint32_t data;	// (proxy << 1) | isMax
+
+		uint32_t GetProxy() const { return data >> 1; }
+		bool IsMax() const { return (data & 1u) != 0; }
+	};
+
+	/// <summary>コライダー1つ分の登録情報</summary>
+	struct Proxy {
+		ICollider* collider = nullptr;	// nullptr なら空き
+		uint32_t index = 0;				// 今フレームのコライダー配列での位置
+		uint32_t frame = 0;				// 最後に登録されたフレーム
+		uint32_t activeSlot = 0;		// スイープ中のアクティブ列での位置
+	};
+
+	/// <summary>端点の並び順（値が同じなら min を先にして、接しているものも重なりとして拾う）</summary>
+	static bool Less(const Endpoint& a, const Endpoint& b) {
+		return a.value != b.value ? a.value < b.value : (a.data & 1u) < (b.data & 1u);
+	}
+
+	/// <summary>今フレームのコライダーを proxy に対応付け、増減を端点列に反映</summary>
+	uint32_t SyncProxies(const std::vector<ICollider*>& colliders);
+
+	/// <summary>中心の分散が最も大きい軸を選ぶ（切り替えは十分に差がある時だけ）</summary>
+	bool SelectAxis(const std::vector<AABB>& bounds);
+
+	/// <summary>端点の値を今フレームの範囲で更新</summary>
+	void UpdateEndpointValues(const std::vector<AABB>& bounds);
+
+	/// <summary>挿入ソート（ほぼ整列済みの列を前提にする）</summary>
+	void InsertionSort();
+
+	int axis_ = 0;
+	uint32_t frame_ = 0;
+	uint32_t lastSwapCount_ = 0;
+	bool wasLastFullSort_ = false;
+
+	// フレーム間で保持する端点列と proxy
+	std::vector<Endpoint> endpoints_;
+	std::vector<Proxy> proxies_;
+	std::vector<uint32_t> freeProxies_;
+	std::unordered_map<ICollider*, uint32_t> proxyMap_;
+
+	// 作業領域（毎フレーム再確保しないよう保持）
+	std::vector<uint32_t> active_;			// スイープ中に区間が開いている proxy
+	std::vector<uint32_t> addedIndices_;	// 今フレームに新しく登録されたコライダー
+};
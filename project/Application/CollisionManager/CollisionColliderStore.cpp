@@ -0,0 +1,222 @@
+#define NOMINMAX
+#include "CollisionColliderStore.h"
+#include "Collider/SphereCollider.h"
+#include "Collider/AABBCollider.h"
+#include "Collider/OBBCollider.h"
+#include "Collider/CapsuleCollider.h"
+#include "Collider/MeshCollider.h"
+#include <algorithm>
+
+ColliderHandle CollisionColliderStore::Register(ICollider* collider) {
+	if (collider == nullptr) {
+		return {};
+	}
+	if (auto it = slotMap_.find(collider); it != slotMap_.end()) {
+		return { it->second, slots_[it->second].generation };
+	}
+
+	// 今フレームだけの追加に入っていれば外す（同じコライダーを二重に詰めない）
+	if (transientSet_.erase(collider) != 0) {
+		transient_.erase(std::find(transient_.begin(), transient_.end(), collider));
+	}
+
+	uint32_t slotIndex = 0;
+	if (!freeSlots_.empty()) {
+		slotIndex = freeSlots_.back();
+		freeSlots_.pop_back();
+	} else {
+		slotIndex = static_cast<uint32_t>(slots_.size());
+		slots_.emplace_back();
+	}
+
+	Slot& slot = slots_[slotIndex];
+	slot.denseIndex = static_cast<uint32_t>(registered_.size());
+	registered_.push_back(collider);
+	registeredSlots_.push_back(slotIndex);
+	slotMap_.emplace(collider, slotIndex);
+	return { slotIndex, slot.generation };
+}
+
+bool CollisionColliderStore::Unregister(ColliderHandle handle) {
+	if (!IsValid(handle)) {
+		return false;
+	}
+
+	Slot& slot = slots_[handle.index];
+	const uint32_t denseIndex = slot.denseIndex;
+	ICollider* collider = registered_[denseIndex];
+
+	// 末尾と入れ替えて詰める
+	const uint32_t last = static_cast<uint32_t>(registered_.size()) - 1;
+	if (denseIndex != last) {
+		registered_[denseIndex] = registered_[last];
+		registeredSlots_[denseIndex] = registeredSlots_[last];
+		slots_[registeredSlots_[denseIndex]].denseIndex = denseIndex;
+	}
+	registered_.pop_back();
+	registeredSlots_.pop_back();
+
+	// 世代を進めて古いハンドルを無効にする
+	slot.denseIndex = ColliderHandle::kInvalidIndex;
+	++slot.generation;
+	freeSlots_.push_back(handle.index);
+	slotMap_.erase(collider);
+	removed_.push_back(collider);
+	return true;
+}
+
+bool CollisionColliderStore::Unregister(ICollider* collider) {
+	auto it = slotMap_.find(collider);
+	if (it == slotMap_.end()) {
+		return false;
+	}
+	return Unregister(ColliderHandle{ it->second, slots_[it->second].generation });
+}
+
+bool CollisionColliderStore::IsValid(ColliderHandle handle) const {
+	return handle.index < slots_.size() &&
+	       slots_[handle.index].generation == handle.generation &&
+	       slots_[handle.index].denseIndex != ColliderHandle::kInvalidIndex;
+}
+
+ICollider* CollisionColliderStore::Get(ColliderHandle handle) const {
+	return IsValid(handle) ? registered_[slots_[handle.index].denseIndex] : nullptr;
+}
+
+void CollisionColliderStore::ClearRegistered() {
+	for (uint32_t slotIndex : registeredSlots_) {
+		Slot& slot = slots_[slotIndex];
+		slot.denseIndex = ColliderHandle::kInvalidIndex;
+		++slot.generation;
+		freeSlots_.push_back(slotIndex);
+	}
+	registered_.clear();
+	registeredSlots_.clear();
+	slotMap_.clear();
+	removed_.clear();
+}
+
+void CollisionColliderStore::TakeRemovedColliders(std::vector<ICollider*>& out) {
+	out.swap(removed_);
+	removed_.clear();
+}
+
+bool CollisionColliderStore::AddTransient(ICollider* collider) {
+	if (collider == nullptr || slotMap_.contains(collider) || !transientSet_.insert(collider).second) {
+		return false;
+	}
+	transient_.push_back(collider);
+	return true;
+}
+
+void CollisionColliderStore::ClearTransient() {
+	transient_.clear();
+	transientSet_.clear();
+}
+
+void CollisionColliderStore::Refresh() {
+	colliders_.clear();
+	types_.clear();
+	attributes_.clear();
+	masks_.clear();
+	shapeIndices_.clear();
+	bounds_.clear();
+	spheres_.clear();
+	sphereMotions_.clear();
+	swept_.clear();
+	sweptCount_ = 0;
+	aabbs_.clear();
+	obbs_.clear();
+	capsules_.clear();
+	meshes_.clear();
+
+	for (ICollider* collider : registered_) {
+		Append(collider);
+	}
+	for (ICollider* collider : transient_) {
+		Append(collider);
+	}
+	ApplySweeps();
+}
+
+void CollisionColliderStore::Append(ICollider* collider) {
+	const ColliderType type = collider->GetColliderType();
+	colliders_.push_back(collider);
+	types_.push_back(type);
+	attributes_.push_back(collider->GetCollisionAttribute());
+	masks_.push_back(collider->GetCollisionMask());
+	swept_.push_back(0);
+
+	// ワールド形状の取得は1コライダー1回（範囲も形状から求める）
+	switch (type) {
+	case ColliderType::SPHERE: {
+		// 連続判定の移動量と範囲は ApplySweeps で入れる
+		const SphereMath sphere = static_cast<SphereCollider*>(collider)->GetWorldSphere();
+		const float r = sphere.radius;
+		shapeIndices_.push_back(static_cast<uint32_t>(spheres_.size()));
+		spheres_.push_back(sphere);
+		sphereMotions_.push_back({ 0.0f, 0.0f, 0.0f });
+		bounds_.push_back({ { sphere.center.x - r, sphere.center.y - r, sphere.center.z - r },
+		                    { sphere.center.x + r, sphere.center.y + r, sphere.center.z + r } });
+		break;
+	}
+	case ColliderType::AABB: {
+		const AABB aabb = static_cast<AABBCollider*>(collider)->GetWorldAABB();
+		shapeIndices_.push_back(static_cast<uint32_t>(aabbs_.size()));
+		aabbs_.push_back(aabb);
+		bounds_.push_back(aabb);
+		break;
+	}
+	case ColliderType::OBB: {
+		const OBB obb = static_cast<OBBCollider*>(collider)->GetWorldOBB();
+		shapeIndices_.push_back(static_cast<uint32_t>(obbs_.size()));
+		obbs_.push_back(obb);
+		bounds_.push_back(OBBCollider::ComputeBounds(obb));
+		break;
+	}
+	case ColliderType::CAPSULE: {
+		const CapsuleMath capsule = static_cast<CapsuleCollider*>(collider)->GetWorldCapsule();
+		shapeIndices_.push_back(static_cast<uint32_t>(capsules_.size()));
+		capsules_.push_back(capsule);
+		bounds_.push_back(CapsuleCollider::ComputeBounds(capsule));
+		break;
+	}
+	case ColliderType::MESH: {
+		// 静的なので三角形は詰め直さず、コライダーの木をそのまま参照する
+		const CollisionMesh& mesh = static_cast<MeshCollider*>(collider)->GetWorldMesh();
+		shapeIndices_.push_back(static_cast<uint32_t>(meshes_.size()));
+		meshes_.push_back(&mesh);
+		bounds_.push_back(mesh.GetBounds());
+		break;
+	}
+	default:
+		// 型ごとの配列を持たない型はコライダーから直接判定する
+		shapeIndices_.push_back(0);
+		bounds_.push_back(collider->GetWorldBounds());
+		break;
+	}
+}
+
+void CollisionColliderStore::ApplySweeps() {
+	// colliders_ は重複しないので、始点を進めるのは1コライダー1回になる
+	for (uint32_t i = 0; i < static_cast<uint32_t>(colliders_.size()); ++i) {
+		if (types_[i] != ColliderType::SPHERE || !colliders_[i]->IsContinuous()) {
+			continue;
+		}
+
+		// 前フレームの位置からの移動量を求め、範囲は移動全体を囲む
+		const SphereMath& sphere = spheres_[shapeIndices_[i]];
+		const float r = sphere.radius;
+		const Vector3 start = colliders_[i]->AdvanceSweep(sphere.center);
+		const Vector3 motion = { sphere.center.x - start.x, sphere.center.y - start.y, sphere.center.z - start.z };
+		if (motion.x == 0.0f && motion.y == 0.0f && motion.z == 0.0f) {
+			continue;
+		}
+
+		swept_[i] = 1;
+		++sweptCount_;
+		sphereMotions_[shapeIndices_[i]] = motion;
+		bounds_[i] = { { std::min(sphere.center.x, start.x) - r, std::min(sphere.center.y, start.y) - r, std::min(sphere.center.z, start.z) - r },
+		               { std::max(sphere.center.x, start.x) + r, std::max(sphere.center.y, start.y) + r, std::max(sphere.center.z, start.z) + r } };
+	}
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include "Collider/ICollider.h"
+#include "CollisionMesh.h"
+#include "Engine/MyMath/MyFunction.h"
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/// <summary>
+/// 登録したコライダーのハンドル（登録解除後に同じ番号が再利用されても世代で区別する）
+/// </summary>
+struct ColliderHandle {
+	static constexpr uint32_t kInvalidIndex = 0xFFFFFFFF;
+
+	uint32_t index = kInvalidIndex;
+	uint32_t generation = 0;
+
+	bool IsValid() const { return index != kInvalidIndex; }
+	bool operator==(const ColliderHandle& other) const = default;
+};
+
+/// <summary>
+/// コライダーの密な格納領域
+/// 登録は一度だけ行いハンドルで管理し、衝突判定に使うワールド形状は毎フレーム1回だけ型ごとの配列に詰め直す
+/// ブロードフェーズ・ナローフェーズは仮想呼び出しや散らばったオブジェクトではなく、この連続した配列を読む
+/// </summary>
+class CollisionColliderStore {
+public:
+	// --- 登録（フレームをまたいで保持） ---
+
+	/// <summary>コライダーを登録（登録済みなら既存のハンドルを返す、今フレームだけの追加に入っていればそちらから外す）</summary>
+	ColliderHandle Register(ICollider* collider);
+
+	/// <summary>登録を解除（無効・解除済みのハンドルなら false）</summary>
+	bool Unregister(ColliderHandle handle);
+	bool Unregister(ICollider* collider);
+
+	/// <summary>ハンドルが現在も有効か</summary>
+	bool IsValid(ColliderHandle handle) const;
+
+	/// <summary>ハンドルからコライダーを取得（無効なら nullptr）</summary>
+	ICollider* Get(ColliderHandle handle) const;
+
+	/// <summary>全ての登録を解除</summary>
+	void ClearRegistered();
+
+	/// <summary>登録中のコライダー数</summary>
+	uint32_t GetRegisteredCount() const { return static_cast<uint32_t>(registered_.size()); }
+
+	/// <summary>前回の TakeRemovedColliders 以降に登録解除されたコライダーを受け取る（接触の破棄用）</summary>
+	void TakeRemovedColliders(std::vector<ICollider*>& out);
+
+	// --- 今フレームだけの追加（シーン側で毎フレーム登録し直すもの） ---
+
+	/// <summary>今フレームだけ追加（登録済み・追加済みのコライダーは二重に詰めないよう false を返して無視する）</summary>
+	bool AddTransient(ICollider* collider);
+	void ClearTransient();
+	uint32_t GetTransientCount() const { return static_cast<uint32_t>(transient_.size()); }
+
+	// --- 毎フレームの詰め直し ---
+
+	/// <summary>
+	/// 登録中 + 今フレームのコライダーのワールド形状を型ごとの配列に詰め直す
+	/// 連続判定の球は移動の始点もここで次フレームへ進めるので、1フレームに1回だけ呼ぶこと
+	/// </summary>
+	void Refresh();
+
+	/// <summary>Refresh で詰めたコライダー数（以下のインデックスはこの範囲）</summary>
+	uint32_t GetCount() const { return static_cast<uint32_t>(colliders_.size()); }
+
+	ICollider* GetCollider(uint32_t i) const { return colliders_[i]; }
+	ColliderType GetType(uint32_t i) const { return types_[i]; }
+	uint32_t GetAttribute(uint32_t i) const { return attributes_[i]; }
+	uint32_t GetMask(uint32_t i) const { return masks_[i]; }
+
+	/// <summary>球・AABB・OBB・カプセルのワールド形状（型が違うインデックスで呼ばないこと）</summary>
+	const SphereMath& GetSphere(uint32_t i) const { return spheres_[shapeIndices_[i]]; }
+	const AABB& GetAABB(uint32_t i) const { return aabbs_[shapeIndices_[i]]; }
+	const OBB& GetOBB(uint32_t i) const { return obbs_[shapeIndices_[i]]; }
+	const CapsuleMath& GetCapsule(uint32_t i) const { return capsules_[shapeIndices_[i]]; }
+
+	/// <summary>メッシュ（ワールド座標、コライダーが持つものを指すだけで詰め直さない）</summary>
+	const CollisionMesh& GetMesh(uint32_t i) const { return *meshes_[shapeIndices_[i]]; }
+
+	/// <summary>連続判定で今フレームに動いた球か（形状は今フレームの位置、始点は GetSphere(i).center - GetSphereMotion(i)）</summary>
+	bool IsSwept(uint32_t i) const { return swept_[i] != 0; }
+	const Vector3& GetSphereMotion(uint32_t i) const { return sphereMotions_[shapeIndices_[i]]; }
+
+	/// <summary>Refresh で連続判定になった球の数</summary>
+	uint32_t GetSweptCount() const { return sweptCount_; }
+
+	/// <summary>ブロードフェーズの入力（コライダーとワールド範囲、同じ並び）</summary>
+	const std::vector<ICollider*>& GetColliders() const { return colliders_; }
+	const std::vector<AABB>& GetBounds() const { return bounds_; }
+
+private:
+	/// <summary>ハンドルの番号ごとの情報</summary>
+	struct Slot {
+		uint32_t denseIndex = ColliderHandle::kInvalidIndex;	// registered_ での位置（空きなら無効値）
+		uint32_t generation = 0;
+	};
+
+	/// <summary>1コライダーの形状を型ごとの配列に追加</summary>
+	void Append(ICollider* collider);
+
+	/// <summary>連続判定の球の始点を進め、移動量と移動全体を囲む範囲を入れる（詰め終わった後に1コライダー1回）</summary>
+	void ApplySweeps();
+
+	// 登録中のコライダー（密な配列、解除は末尾との入れ替え）
+	std::vector<ICollider*> registered_;
+	std::vector<uint32_t> registeredSlots_;		// registered_ と同じ並びのスロット番号
+	std::vector<Slot> slots_;
+	std::vector<uint32_t> freeSlots_;
+	std::unordered_map<ICollider*, uint32_t> slotMap_;	// 登録・解除時だけ使う
+	std::vector<ICollider*> removed_;
+
+	// 今フレームだけのコライダー
+	std::vector<ICollider*> transient_;
+	std::unordered_set<ICollider*> transientSet_;	// 重複の確認用
+
+	// 毎フレーム詰め直す配列（コライダー毎）
+	std::vector<ICollider*> colliders_;
+	std::vector<ColliderType> types_;
+	std::vector<uint32_t> attributes_;
+	std::vector<uint32_t> masks_;
+	std::vector<uint32_t> shapeIndices_;	// 型ごとの配列での位置
+	std::vector<AABB> bounds_;				// 連続判定の球は移動全体を囲む範囲
+	std::vector<uint8_t> swept_;
+	uint32_t sweptCount_ = 0;
+
+	// 型ごとのワールド形状
+	std::vector<SphereMath> spheres_;
+	std::vector<Vector3> sphereMotions_;	// spheres_ と同じ並び（前フレームからの移動量、連続判定でなければ0）
+	std::vector<AABB> aabbs_;
+	std::vector<OBB> obbs_;
+	std::vector<CapsuleMath> capsules_;
+	std::vector<const CollisionMesh*> meshes_;
+};
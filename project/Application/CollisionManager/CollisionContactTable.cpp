@@ -0,0 +1,109 @@
+#define NOMINMAX
+#include "CollisionContactTable.h"
+#include <algorithm>
+#include <utility>
+
+CollisionContactTable::CollisionContactTable() {
+	slots_.resize(kMinCapacity);
+}
+
+void CollisionContactTable::BeginFrame() {
+	++frame_;
+	contactCount_ = 0;
+}
+
+void CollisionContactTable::Add(ICollider* a, ICollider* b, uint32_t indexA, uint32_t indexB, float timeOfImpact) {
+	if (a > b) {
+		std::swap(a, b);
+		std::swap(indexA, indexB);
+	}
+	ReserveForInsert();
+
+	// 線形探査（削除済みの位置は見つからなかった時の挿入先として覚えておく）
+	const size_t mask = slots_.size() - 1;
+	size_t index = static_cast<size_t>(Hash(a, b)) & mask;
+	Contact* insertSlot = nullptr;
+	for (;; index = (index + 1) & mask) {
+		Contact& slot = slots_[index];
+		if (IsEmpty(slot)) {
+			if (insertSlot == nullptr) {
+				insertSlot = &slot;
+				++usedCount_;
+			}
+			break;
+		}
+		if (IsRemoved(slot)) {
+			if (insertSlot == nullptr) {
+				insertSlot = &slot;
+			}
+			continue;
+		}
+		if (slot.a == a && slot.b == b) {
+			// 既にある → 今フレームの接触として記録
+			if (slot.lastFrame != frame_) {
+				slot.lastFrame = frame_;
+				slot.timeOfImpact = timeOfImpact;
+				slot.indexA = indexA;
+				slot.indexB = indexB;
+				++contactCount_;
+			} else {
+				slot.timeOfImpact = std::min(slot.timeOfImpact, timeOfImpact);
+			}
+			return;
+		}
+	}
+
+	*insertSlot = { a, b, frame_, frame_, timeOfImpact, indexA, indexB };
+	++liveCount_;
+	++contactCount_;
+}
+
+void CollisionContactTable::Clear() {
+	for (Contact& slot : slots_) {
+		slot = {};
+	}
+	usedCount_ = 0;
+	liveCount_ = 0;
+	contactCount_ = 0;
+}
+
+uint64_t CollisionContactTable::Hash(const ICollider* a, const ICollider* b) {
+	// 2つのポインタを混ぜる（splitmix64 の最終段）
+	uint64_t h = reinterpret_cast<uintptr_t>(a) * 0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(b);
+	h ^= h >> 30;
+	h *= 0xBF58476D1CE4E5B9ull;
+	h ^= h >> 27;
+	h *= 0x94D049BB133111EBull;
+	h ^= h >> 31;
+	return h;
+}
+
+void CollisionContactTable::ReserveForInsert() {
+	// 使用率（削除済みを含む）を 1/2 以下に保つ
+	if ((usedCount_ + 1) * 2 <= slots_.size()) {
+		return;
+	}
+	// 接触ペアだけで 1/4 を超えるなら大きくし、そうでなければ削除済みを掃除するだけ
+	size_t capacity = slots_.size();
+	while ((liveCount_ + 1) * 4 > capacity) {
+		capacity *= 2;
+	}
+	Rehash(capacity);
+}
+
+void CollisionContactTable::Rehash(size_t capacity) {
+	rehashBuffer_.assign(capacity, Contact{});
+	const size_t mask = capacity - 1;
+	for (const Contact& slot : slots_) {
+		if (slot.a == nullptr) {
+			continue;
+		}
+		size_t index = static_cast<size_t>(Hash(slot.a, slot.b)) & mask;
+		while (!IsEmpty(rehashBuffer_[index])) {
+			index = (index + 1) & mask;
+		}
+		rehashBuffer_[index] = slot;
+	}
+	slots_.swap(rehashBuffer_);
+	usedCount_ = liveCount_;
+}
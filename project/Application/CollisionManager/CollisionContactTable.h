@@ -0,0 +1,178 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ICollider;
+
+/// <summary>接触の状態（Resolve で通知する）</summary>
+enum class CollisionContactState {
+	Enter,	// 今フレームから接触
+	Stay,	// 前フレームから接触し続けている
+	Exit	// 前フレームまで接触していた（通知後に表から外す）
+};
+
+/// <summary>
+/// 衝突ペアの表（オープンアドレス法のハッシュ表）
+/// ペアごとに最後に接触したフレームを記録し、前フレームとの比較をせずに Enter / Stay / Exit を1回の走査で振り分ける
+/// 要素は平坦な配列に置くので、表が大きくなる時以外は毎フレームの確保もコピーも発生しない
+/// 通知は表の並び（ポインタのハッシュ順で実行ごとに変わる）ではなく、コライダーの番号で並べ替えた順に行う
+/// </summary>
+class CollisionContactTable {
+public:
+	/// <summary>接触ペア（a < b に正規化済み）</summary>
+	struct Contact {
+		ICollider* a = nullptr;		// nullptr なら空き（b も nullptr なら未使用、b が非 nullptr なら削除済み）
+		ICollider* b = nullptr;
+		uint32_t lastFrame = 0;		// 最後に接触したフレーム
+		uint32_t enterFrame = 0;	// 接触し始めたフレーム
+		float timeOfImpact = 1.0f;	// 最後に接触したフレーム内の接触時刻（CollisionContactInfo::timeOfImpact）
+		uint32_t indexA = 0;		// 最後に接触したフレームでの a / b の番号（通知順を決める）
+		uint32_t indexB = 0;
+	};
+
+	CollisionContactTable();
+
+	/// <summary>新しいフレームを始める（今フレームの接触数をリセット）</summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 今フレームの接触を記録（同じペアを何度追加しても1つ、接触時刻は早い方）
+	/// indexA / indexB はコライダーの今フレームの番号（CollisionColliderStore のインデックス）
+	/// </summary>
+	void Add(ICollider* a, ICollider* b, uint32_t indexA, uint32_t indexB, float timeOfImpact = 1.0f);
+
+	/// <summary>
+	/// 全ペアを1回走査して状態を振り分け、離れたペアを表から外してから、
+	/// 番号の小さい方・大きい方の順に並べ替えて通知する（同じ登録順なら毎回同じ順になる）
+	/// 通知の前に表の更新は終わっているので、callback の中で Add / Clear を呼ばないこと
+	/// </summary>
+	/// <param name="callback">void(const Contact&amp;, CollisionContactState)</param>
+	template<typename Callback>
+	void Resolve(Callback&& callback);
+
+	/// <summary>全ペアを破棄（Exit は通知しない）</summary>
+	void Clear();
+
+	/// <summary>
+	/// 指定したコライダーを含むペアを外し、相手が残るペアだけ番号の順に Exit を通知する（登録解除・破棄されたコライダー用）
+	/// 外したコライダー側には通知しない（破棄済みのことがあるので、callback でも参照しないこと）
+	/// </summary>
+	/// <param name="colliders">外すコライダー（並べ替える）</param>
+	/// <param name="callback">void(ICollider* survivor, ICollider* removed)</param>
+	template<typename Callback>
+	void RemoveColliders(std::vector<ICollider*>& colliders, Callback&& callback);
+
+	/// <summary>今フレームの接触ペア数</summary>
+	uint32_t GetContactCount() const { return contactCount_; }
+
+	/// <summary>表の大きさ（ImGui表示用）</summary>
+	uint32_t GetCapacity() const { return static_cast<uint32_t>(slots_.size()); }
+
+private:
+	/// <summary>通知待ちの状態（並べ替えてから通知する）</summary>
+	struct Event {
+		uint64_t order;		// (小さい方の番号 << 32) | 大きい方の番号
+		CollisionContactState state;
+		Contact contact;
+	};
+
+	/// <summary>ペアの番号から通知順のキーを作る</summary>
+	static uint64_t MakeOrder(const Contact& contact) {
+		const uint64_t lo = std::min(contact.indexA, contact.indexB);
+		const uint64_t hi = std::max(contact.indexA, contact.indexB);
+		return (lo << 32) | hi;
+	}
+
+	/// <summary>ペアのハッシュ値</summary>
+	static uint64_t Hash(const ICollider* a, const ICollider* b);
+
+	/// <summary>空き・削除済みの判定</summary>
+	static bool IsEmpty(const Contact& slot) { return slot.a == nullptr && slot.b == nullptr; }
+	static bool IsRemoved(const Contact& slot) { return slot.a == nullptr && slot.b != nullptr; }
+
+	/// <summary>表を作り直す（削除済みを除き、必要なら大きくする）</summary>
+	void Rehash(size_t capacity);
+
+	/// <summary>削除済みが増えた・使用率が高い時に Rehash する</summary>
+	void ReserveForInsert();
+
+	// 最小の表の大きさ（2の累乗）
+	static constexpr size_t kMinCapacity = 64;
+
+	std::vector<Contact> slots_;
+	std::vector<Contact> rehashBuffer_;	// Rehash 用（同じ大きさなら再確保しない）
+	std::vector<Event> events_;			// Resolve 用（毎フレーム再確保しないよう保持）
+	uint32_t usedCount_ = 0;			// 接触ペア + 削除済み
+	uint32_t liveCount_ = 0;			// 表にある接触ペア
+	uint32_t contactCount_ = 0;			// 今フレームに接触したペア
+	uint32_t frame_ = 0;
+};
+
+template<typename Callback>
+inline void CollisionContactTable::RemoveColliders(std::vector<ICollider*>& colliders, Callback&& callback) {
+	if (colliders.empty() || liveCount_ == 0) {
+		return;
+	}
+	std::sort(colliders.begin(), colliders.end());
+	auto contains = [&colliders](ICollider* collider) {
+		return std::binary_search(colliders.begin(), colliders.end(), collider);
+	};
+
+	// 1. 外すコライダーを含むペアを削除済みにし、相手が残るペアだけ溜める
+	events_.clear();
+	for (Contact& slot : slots_) {
+		if (slot.a == nullptr) {
+			continue;
+		}
+		const bool removedA = contains(slot.a);
+		const bool removedB = contains(slot.b);
+		if (!removedA && !removedB) {
+			continue;
+		}
+		if (removedA != removedB) {
+			events_.push_back({ MakeOrder(slot), CollisionContactState::Exit, slot });
+		}
+		slot.a = nullptr;
+		--liveCount_;
+	}
+
+	// 2. 番号の順に並べ替えて、残る側にだけ通知
+	std::sort(events_.begin(), events_.end(), [](const Event& a, const Event& b) { return a.order < b.order; });
+	for (const Event& event : events_) {
+		if (contains(event.contact.a)) {
+			callback(event.contact.b, event.contact.a);
+		} else {
+			callback(event.contact.a, event.contact.b);
+		}
+	}
+}
+
+template<typename Callback>
+inline void CollisionContactTable::Resolve(Callback&& callback) {
+	// 1. 状態を振り分けて溜める（Exit のペアはここで表から外す）
+	events_.clear();
+	for (Contact& slot : slots_) {
+		if (slot.a == nullptr) {
+			continue;
+		}
+		if (slot.lastFrame != frame_) {
+			// 今フレームに追加されなかった → Exit して削除済みにする（番号は最後に接触したフレームのもの）
+			events_.push_back({ MakeOrder(slot), CollisionContactState::Exit, slot });
+			slot.a = nullptr;
+			--liveCount_;
+			continue;
+		}
+		events_.push_back({ MakeOrder(slot),
+			slot.enterFrame == frame_ ? CollisionContactState::Enter : CollisionContactState::Stay, slot });
+	}
+
+	// 2. 番号の順に並べ替えて通知（番号が入れ替わって同じキーになった時は Enter / Stay を Exit より先にする）
+	std::sort(events_.begin(), events_.end(), [](const Event& a, const Event& b) {
+		return a.order != b.order ? a.order < b.order : a.state < b.state;
+	});
+	for (const Event& event : events_) {
+		callback(event.contact, event.state);
+	}
+}
@@ -1,5 +1,9 @@
+#define NOMINMAX
 #include "CollisionManager.h"
 #include "Collision.h"
+#include "ImGui/ImGuiManager.h"
+#include "JobSystem.h"
+#include <algorithm>
 
 CollisionManager::CollisionManager() {
 	RegisterCollisionHandlers();
@@ -8,129 +12,472 @@ CollisionManager::CollisionManager() {
 CollisionManager::~CollisionManager() {}
 
 void CollisionManager::Initialize() {
-	colliders_.clear();
-	currentPairs_.clear();
-	prevPairs_.clear();
+	store_.ClearRegistered();
+	store_.ClearTransient();
+	contacts_.Clear();
+	sweepAndPrune_.Clear();
+	queryIndex_.Clear();
 }
 
 void CollisionManager::Update() {
-	// 1. 前フレームのペアを保存
-	prevPairs_ = currentPairs_;
-	currentPairs_.clear();
+	// 1. 登録解除されたコライダーの接触を外し、残った相手にだけ Exit を通知（破棄済みのオブジェクトへは呼ばない）
+	store_.TakeRemovedColliders(removedColliders_);
+	contacts_.RemoveColliders(removedColliders_, [](ICollider* survivor, ICollider* removed) {
+		survivor->OnCollisionExit(removed);
+	});
 
-	// 2. 色をリセット
-	ResetAllColliderColors();
+	// 2. 新しいフレームを開始（前フレームの接触は表に残したまま）
+	contacts_.BeginFrame();
 
-	// 3. 今フレームの衝突ペアを全検査
-	CheckAllCollision();
+	// 3. ワールド形状を型ごとの配列に詰め直す（コライダーへのアクセスはここで1回だけ）
+	store_.Refresh();
 
-	// 4. Enter / Stay / Exit を振り分けてコールバック
-	// --- Enter: 今フレームにある && 前フレームにない ---
-	for (const auto& pair : currentPairs_) {
-		ICollider* a = pair.first;
-		ICollider* b = pair.second;
+	// 4. クエリ用の空間インデックスを作り直す（次の Update までのクエリはこの形状を見る）
+	queryIndex_.Build(store_);
 
-		a->SetColliderColor(hitColor_);
-		b->SetColliderColor(hitColor_);
+	// 5. 色をリセット
+	ResetAllColliderColors();
 
-		if (prevPairs_.count(pair) == 0) {
-			a->OnCollisionEnter(b);
-			b->OnCollisionEnter(a);
-		} else {
-			a->OnCollisionStay(b);
-			b->OnCollisionStay(a);
+	// 6. 今フレームの衝突ペアを全検査（タスクごとに判定し、接触したペアに今フレームの印を付ける）
+	CheckAllCollision();
+
+	// 7. 表を1回走査して Enter / Stay / Exit を振り分け、番号順に並べてからメインスレッドでコールバック
+	contacts_.Resolve([this](const CollisionContactTable::Contact& contact, CollisionContactState state) {
+		// 番号の小さいコライダーから呼ぶ（ポインタの大小は実行ごとに変わるので使わない）
+		ICollider* a = contact.a;
+		ICollider* b = contact.b;
+		if (contact.indexB < contact.indexA) {
+			std::swap(a, b);
 		}
-	}
+		CollisionContactInfo info;
+		info.timeOfImpact = contact.timeOfImpact;
 
-	// --- Exit: 前フレームにある && 今フレームにない ---
-	for (const auto& pair : prevPairs_) {
-		if (currentPairs_.count(pair) == 0) {
-			pair.first->OnCollisionExit(pair.second);
-			pair.second->OnCollisionExit(pair.first);
+		switch (state) {
+		case CollisionContactState::Enter:
+			a->SetColliderColor(hitColor_);
+			b->SetColliderColor(hitColor_);
+			a->OnCollisionEnter(b, info);
+			b->OnCollisionEnter(a, info);
+			break;
+		case CollisionContactState::Stay:
+			a->SetColliderColor(hitColor_);
+			b->SetColliderColor(hitColor_);
+			a->OnCollisionStay(b, info);
+			b->OnCollisionStay(a, info);
+			break;
+		case CollisionContactState::Exit:
+			a->OnCollisionExit(b);
+			b->OnCollisionExit(a);
+			break;
 		}
-	}
+	});
+}
+
+ColliderHandle CollisionManager::RegisterCollider(ICollider* collider) {
+	return store_.Register(collider);
+}
+
+void CollisionManager::UnregisterCollider(ColliderHandle handle) {
+	store_.Unregister(handle);
+}
+
+void CollisionManager::UnregisterCollider(ICollider* collider) {
+	store_.Unregister(collider);
 }
 
 void CollisionManager::AddCollider(ICollider* collider) {
 	if (collider != nullptr) {
-		colliders_.push_back(collider);
+		store_.AddTransient(collider);
 	}
 }
 
 void CollisionManager::ClearColliderList() {
-	colliders_.clear();
+	store_.ClearTransient();
 }
 
 void CollisionManager::ResetAllColliderColors() {
-	for (ICollider* collider : colliders_) {
-		if (collider) {
-			collider->ResetColliderColor();
-		}
+	for (ICollider* collider : store_.GetColliders()) {
+		collider->ResetColliderColor();
 	}
 }
 
 void CollisionManager::CheckAllCollision() {
-	auto itrA = colliders_.begin();
-	for (; itrA != colliders_.end(); ++itrA) {
-		auto itrB = itrA;
-		++itrB;
-		for (; itrB != colliders_.end(); ++itrB) {
-			if (CheckCollisionPair(*itrA, *itrB)) {
-				currentPairs_.insert(MakePair(*itrA, *itrB));
+	switch (broadphaseType_) {
+	case CollisionBroadphaseType::UniformGrid:
+		CheckAllCollisionGrid();
+		break;
+	case CollisionBroadphaseType::SweepAndPrune:
+		CheckAllCollisionSweepAndPrune();
+		break;
+	default:
+		CheckAllCollisionBruteForce();
+		break;
+	}
+}
+
+void CollisionManager::CheckAllCollisionBruteForce() {
+	const uint32_t count = store_.GetCount();
+	const uint64_t pairCount = count > 1 ? static_cast<uint64_t>(count) * (count - 1) / 2 : 0;
+	lastCandidateCount_ = static_cast<uint32_t>(pairCount);
+
+	// 1. 行 a は count-1-a ペアなので、累積のペア数が均等になる位置で行を区切る
+	const uint32_t taskCount = PlanTasks(pairCount, kMinBruteForcePairsPerTask);
+	taskRowStarts_.assign(taskCount + 1, count);
+	taskRowStarts_[0] = 0;
+	uint32_t row = 0;
+	uint64_t accumulated = 0;
+	for (uint32_t task = 1; task < taskCount; ++task) {
+		const uint64_t target = pairCount * task / taskCount;
+		while (row < count && accumulated < target) {
+			accumulated += count - 1 - row;
+			++row;
+		}
+		taskRowStarts_[task] = row;
+	}
+
+	// 2. 各タスクが受け持ちの行を総当たり
+	RunTasks(taskCount, [this, count](NarrowphaseTask& task, uint32_t taskIndex) {
+		for (uint32_t a = taskRowStarts_[taskIndex]; a < taskRowStarts_[taskIndex + 1]; ++a) {
+			for (uint32_t b = a + 1; b < count; ++b) {
+				QueuePair(task, a, b);
+			}
+		}
+		FlushBatches(task);
+	});
+	CommitTasks(taskCount);
+}
+
+void CollisionManager::CheckAllCollisionGrid() {
+	// 1. セルに登録して並べ替える（逐次）
+	const std::vector<AABB>& bounds = store_.GetBounds();
+	grid_.Prepare(bounds);
+
+	// 2. セルをタスクに分け、同じセルに入った範囲の重なるペアの列挙から判定までを各タスクで行う
+	const uint32_t taskCount = PlanTasks(grid_.GetLastEntryCount(), kMinGridEntriesPerTask);
+	RunTasks(taskCount, [this, &bounds, taskCount](NarrowphaseTask& task, uint32_t taskIndex) {
+		task.pairs.clear();
+		grid_.CollectPairs(bounds, taskIndex, taskCount, task.pairs);
+		for (const CollisionIndexPair& candidate : task.pairs) {
+			QueuePair(task, candidate.first, candidate.second);
+		}
+		FlushBatches(task);
+	});
+
+	lastCandidateCount_ = 0;
+	for (uint32_t i = 0; i < taskCount; ++i) {
+		lastCandidateCount_ += static_cast<uint32_t>(narrowphaseTasks_[i]->pairs.size());
+	}
+	CommitTasks(taskCount);
+}
+
+void CollisionManager::CheckAllCollisionSweepAndPrune() {
+	// 1. 前フレームからの端点列を挿入ソートで更新し、スイープで重なるペアを列挙（端点列を順に辿るので逐次）
+	sweepAndPrune_.FindPairs(store_.GetColliders(), store_.GetBounds(), candidatePairs_);
+
+	// 2. 候補だけを判定
+	CheckCandidatePairs();
+}
+
+void CollisionManager::CheckCandidatePairs() {
+	const size_t candidateCount = candidatePairs_.size();
+	lastCandidateCount_ = static_cast<uint32_t>(candidateCount);
+
+	// マスク → 型の組み合わせごとのバッチ（またはdispatchTable_）で判定（候補をタスクに等分）
+	const uint32_t taskCount = PlanTasks(candidateCount, kMinCandidatesPerTask);
+	RunTasks(taskCount, [this, candidateCount, taskCount](NarrowphaseTask& task, uint32_t taskIndex) {
+		const size_t begin = candidateCount * taskIndex / taskCount;
+		const size_t end = candidateCount * (taskIndex + 1) / taskCount;
+		for (size_t i = begin; i < end; ++i) {
+			QueuePair(task, candidatePairs_[i].first, candidatePairs_[i].second);
+		}
+		FlushBatches(task);
+	});
+	CommitTasks(taskCount);
+}
+
+uint32_t CollisionManager::PlanTasks(uint64_t workCount, uint64_t minWorkPerTask) {
+	uint32_t taskCount = 1;
+	const uint32_t threadCount = JobSystem::GetInstance()->GetWorkerCount() + 1;
+	if (useParallel_ && threadCount > 1) {
+		const uint64_t maxTaskCount = std::min(threadCount * kTasksPerThread, kMaxTaskCount);
+		taskCount = static_cast<uint32_t>(std::clamp<uint64_t>(workCount / minWorkPerTask, 1, maxTaskCount));
+	}
+
+	while (narrowphaseTasks_.size() < taskCount) {
+		narrowphaseTasks_.push_back(std::make_unique<NarrowphaseTask>());
+	}
+	lastTaskCount_ = taskCount;
+	return taskCount;
+}
+
+void CollisionManager::RunTasks(uint32_t taskCount, const std::function<void(NarrowphaseTask&, uint32_t)>& job) {
+	for (uint32_t i = 0; i < taskCount; ++i) {
+		narrowphaseTasks_[i]->contacts.clear();
+	}
+	if (taskCount == 1) {
+		job(*narrowphaseTasks_[0], 0);
+		return;
+	}
+	JobSystem::GetInstance()->ParallelFor(taskCount, [&](uint32_t taskIndex) {
+		job(*narrowphaseTasks_[taskIndex], taskIndex);
+	});
+}
+
+void CollisionManager::CommitTasks(uint32_t taskCount) {
+	// タスク順に移すので、同じタスク数なら表への追加順も毎回同じ
+	for (uint32_t i = 0; i < taskCount; ++i) {
+		for (const PendingContact& contact : narrowphaseTasks_[i]->contacts) {
+			contacts_.Add(store_.GetCollider(contact.a), store_.GetCollider(contact.b),
+				contact.a, contact.b, contact.timeOfImpact);
+		}
+	}
+}
+
+void CollisionManager::ImGui() {
+#ifdef USEIMGUI
+	if (ImGui::TreeNode("Collision Manager")) {
+		// ブロードフェーズの切り替え
+		if (ImGui::BeginCombo("Broadphase", CollisionBroadphaseUtil::GetName(broadphaseType_))) {
+			for (int i = 0; i < static_cast<int>(CollisionBroadphaseType::Count); ++i) {
+				const CollisionBroadphaseType type = static_cast<CollisionBroadphaseType>(i);
+				if (ImGui::Selectable(CollisionBroadphaseUtil::GetName(type), type == broadphaseType_)) {
+					broadphaseType_ = type;
+				}
+			}
+			ImGui::EndCombo();
+		}
+
+		if (broadphaseType_ == CollisionBroadphaseType::UniformGrid) {
+			float cellSize = grid_.GetCellSize();
+			if (ImGui::DragFloat("Cell Size (0 = auto)", &cellSize, 0.1f, 0.0f, 1000.0f)) {
+				grid_.SetCellSize(cellSize);
 			}
+			ImGui::Text("Cell: %.2f  Entries: %u  Large: %u",
+				grid_.GetLastCellSize(), grid_.GetLastEntryCount(), grid_.GetLastLargeCount());
+		}
+		if (broadphaseType_ == CollisionBroadphaseType::SweepAndPrune) {
+			constexpr const char* kAxisNames[] = { "X", "Y", "Z" };
+			ImGui::Text("Axis: %s  Swaps: %u%s", kAxisNames[sweepAndPrune_.GetAxis()],
+				sweepAndPrune_.GetLastSwapCount(), sweepAndPrune_.WasLastFullSort() ? "  (full sort)" : "");
 		}
+
+		// 直近フレームの統計
+		ImGui::Text("Colliders: %u (registered %u, transient %u)",
+			store_.GetCount(), store_.GetRegisteredCount(), store_.GetTransientCount());
+		ImGui::Checkbox("Batch Narrowphase (SIMD)", &useBatchNarrowphase_);
+		ImGui::Checkbox("Parallel (JobSystem)", &useParallel_);
+		ImGui::SameLine();
+		ImGui::Text("Tasks: %u", lastTaskCount_);
+		ImGui::Text("Candidates: %u  Contacts: %u (table %u)", lastCandidateCount_, contacts_.GetContactCount(), contacts_.GetCapacity());
+		ImGui::Text("Query Index: %u colliders, %u nodes", queryIndex_.GetItemCount(), queryIndex_.GetNodeCount());
+		ImGui::Text("Continuous: %u swept spheres", store_.GetSweptCount());
+
+		if (ImGui::TreeNode("Benchmark")) {
+			benchmark_.ImGui();
+			ImGui::TreePop();
+		}
+		if (ImGui::TreeNode("Narrowphase Benchmark")) {
+			narrowphaseBenchmark_.ImGui();
+			ImGui::TreePop();
+		}
+		ImGui::TreePop();
 	}
+#endif
 }
 
-bool CollisionManager::CheckCollisionPair(ICollider* colliderA, ICollider* colliderB) {
+void CollisionManager::QueuePair(NarrowphaseTask& task, uint32_t indexA, uint32_t indexB) const {
 	// 1. マスクフィルタ（最安、最優先）
-	if ((colliderA->GetCollisionAttribute() & colliderB->GetCollisionMask()) == 0 ||
-	    (colliderB->GetCollisionAttribute() & colliderA->GetCollisionMask()) == 0) {
-		return false;
+	if ((store_.GetAttribute(indexA) & store_.GetMask(indexB)) == 0 ||
+	    (store_.GetAttribute(indexB) & store_.GetMask(indexA)) == 0) {
+		return;
 	}
 
 	// 2. 型正規化（常に小さいインデックス側を a にする）
-	ICollider* a = colliderA;
-	ICollider* b = colliderB;
-	if (static_cast<int>(a->GetColliderType()) > static_cast<int>(b->GetColliderType())) {
+	uint32_t a = indexA;
+	uint32_t b = indexB;
+	if (static_cast<int>(store_.GetType(a)) > static_cast<int>(store_.GetType(b))) {
 		std::swap(a, b);
 	}
 
-	int typeA = static_cast<int>(a->GetColliderType());
-	int typeB = static_cast<int>(b->GetColliderType());
+	const ColliderType typeA = store_.GetType(a);
+	const ColliderType typeB = store_.GetType(b);
 
-	// 3. テーブル参照（O(1)）
-	CollisionFunc func = dispatchTable_[typeA][typeB];
-	if (!func) return false; // 未実装ペアはスキップ
+	// 3. 連続判定で動いた球を含むペアは移動全体で判定し、接触時刻を記録
+	//    （連続判定は球だけなので、型を正規化した後は a が球。球同士なら b 側だけ動いている場合もある）
+	if (store_.IsSwept(a) || store_.IsSwept(b)) {
+		uint32_t sphere = a;
+		uint32_t other = b;
+		if (!store_.IsSwept(a)) {
+			std::swap(sphere, other);
+		}
+		if (SweepFunc sweep = sweepTable_[static_cast<int>(store_.GetType(other))]) {
+			float timeOfImpact = 1.0f;
+			if (sweep(store_, sphere, other, timeOfImpact)) {
+				task.contacts.push_back({ a, b, timeOfImpact });
+			}
+			return;
+		}
+	}
 
-	// 4. 数学計算
-	return func(a, b);
+	// 4. 球・AABB の組み合わせは型ごとの SoA に積んでまとめて判定
+	if (useBatchNarrowphase_) {
+		if (typeA == ColliderType::SPHERE && typeB == ColliderType::SPHERE) {
+			task.sphereSpherePairs.Push(store_.GetSphere(a), store_.GetSphere(b));
+			task.sphereSphereIndices.push_back({ a, b });
+			if (task.sphereSpherePairs.IsFull()) {
+				FlushBatch(task, task.sphereSpherePairs, task.sphereSphereIndices);
+			}
+			return;
+		}
+		if (typeA == ColliderType::SPHERE && typeB == ColliderType::AABB) {
+			task.sphereAABBPairs.Push(store_.GetSphere(a), store_.GetAABB(b));
+			task.sphereAABBIndices.push_back({ a, b });
+			if (task.sphereAABBPairs.IsFull()) {
+				FlushBatch(task, task.sphereAABBPairs, task.sphereAABBIndices);
+			}
+			return;
+		}
+		if (typeA == ColliderType::AABB && typeB == ColliderType::AABB) {
+			task.aabbAABBPairs.Push(store_.GetAABB(a), store_.GetAABB(b));
+			task.aabbAABBIndices.push_back({ a, b });
+			if (task.aabbAABBPairs.IsFull()) {
+				FlushBatch(task, task.aabbAABBPairs, task.aabbAABBIndices);
+			}
+			return;
+		}
+	}
+
+	// 5. それ以外はテーブル参照（O(1)）で1ペアずつ判定
+	CollisionFunc func = dispatchTable_[static_cast<int>(typeA)][static_cast<int>(typeB)];
+	if (!func) return; // 未実装ペアはスキップ
+
+	if (func(store_, a, b)) {
+		task.contacts.push_back({ a, b, 1.0f });
+	}
+}
+
+void CollisionManager::FlushBatches(NarrowphaseTask& task) const {
+	FlushBatch(task, task.sphereSpherePairs, task.sphereSphereIndices);
+	FlushBatch(task, task.sphereAABBPairs, task.sphereAABBIndices);
+	FlushBatch(task, task.aabbAABBPairs, task.aabbAABBIndices);
+}
+
+template<typename Pairs>
+void CollisionManager::FlushBatch(NarrowphaseTask& task, Pairs& pairs, std::vector<CollisionIndexPair>& indices) const {
+	if (indices.empty()) {
+		return;
+	}
+	const uint32_t hitCount = CollisionBatch::Test(pairs, task.batchHits);
+	for (uint32_t i = 0; i < hitCount; ++i) {
+		const CollisionIndexPair& hit = indices[task.batchHits[i]];
+		task.contacts.push_back({ hit.first, hit.second, 1.0f });
+	}
+	indices.clear();
 }
 
 void CollisionManager::RegisterCollisionHandlers() {
 	// --- Sphere vs Sphere ---
 	dispatchTable_[static_cast<int>(ColliderType::SPHERE)][static_cast<int>(ColliderType::SPHERE)] =
-	    [](ICollider* a, ICollider* b) -> bool {
-		    auto* sa = static_cast<SphereCollider*>(a);
-		    auto* sb = static_cast<SphereCollider*>(b);
-		    return Collision::IsCollision(sa->GetWorldSphere(), sb->GetWorldSphere());
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetSphere(a), store.GetSphere(b));
 	    };
 
 	// --- Sphere vs AABB ---
 	dispatchTable_[static_cast<int>(ColliderType::SPHERE)][static_cast<int>(ColliderType::AABB)] =
-	    [](ICollider* a, ICollider* b) -> bool {
-		    auto* sphere = static_cast<SphereCollider*>(a);
-		    auto* aabb   = static_cast<AABBCollider*>(b);
-		    return Collision::IsCollision(sphere->GetWorldSphere(), aabb->GetWorldAABB());
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetSphere(a), store.GetAABB(b));
 	    };
 
 	// --- AABB vs AABB ---
 	dispatchTable_[static_cast<int>(ColliderType::AABB)][static_cast<int>(ColliderType::AABB)] =
-	    [](ICollider* a, ICollider* b) -> bool {
-		    auto* aabbA = static_cast<AABBCollider*>(a);
-		    auto* aabbB = static_cast<AABBCollider*>(b);
-		    return Collision::IsCollision(aabbA->GetWorldAABB(), aabbB->GetWorldAABB());
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetAABB(a), store.GetAABB(b));
+	    };
+
+	// --- Sphere vs OBB ---
+	dispatchTable_[static_cast<int>(ColliderType::SPHERE)][static_cast<int>(ColliderType::OBB)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetSphere(a), store.GetOBB(b));
+	    };
+
+	// --- Sphere vs Capsule ---
+	dispatchTable_[static_cast<int>(ColliderType::SPHERE)][static_cast<int>(ColliderType::CAPSULE)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetSphere(a), store.GetCapsule(b));
+	    };
+
+	// --- AABB vs OBB ---
+	dispatchTable_[static_cast<int>(ColliderType::AABB)][static_cast<int>(ColliderType::OBB)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetAABB(a), store.GetOBB(b));
+	    };
+
+	// --- AABB vs Capsule ---
+	dispatchTable_[static_cast<int>(ColliderType::AABB)][static_cast<int>(ColliderType::CAPSULE)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetAABB(a), store.GetCapsule(b));
+	    };
+
+	// --- OBB vs OBB ---
+	dispatchTable_[static_cast<int>(ColliderType::OBB)][static_cast<int>(ColliderType::OBB)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetOBB(a), store.GetOBB(b));
+	    };
+
+	// --- OBB vs Capsule ---
+	dispatchTable_[static_cast<int>(ColliderType::OBB)][static_cast<int>(ColliderType::CAPSULE)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetOBB(a), store.GetCapsule(b));
+	    };
+
+	// --- Capsule vs Capsule ---
+	dispatchTable_[static_cast<int>(ColliderType::CAPSULE)][static_cast<int>(ColliderType::CAPSULE)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return Collision::IsCollision(store.GetCapsule(a), store.GetCapsule(b));
+	    };
+
+	// --- Sphere vs Mesh ---
+	dispatchTable_[static_cast<int>(ColliderType::SPHERE)][static_cast<int>(ColliderType::MESH)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return store.GetMesh(b).IsCollision(store.GetSphere(a));
+	    };
+
+	// --- AABB vs Mesh ---
+	dispatchTable_[static_cast<int>(ColliderType::AABB)][static_cast<int>(ColliderType::MESH)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return store.GetMesh(b).IsCollision(store.GetAABB(a));
+	    };
+
+	// --- Capsule vs Mesh ---
+	dispatchTable_[static_cast<int>(ColliderType::CAPSULE)][static_cast<int>(ColliderType::MESH)] =
+	    [](const CollisionColliderStore& store, uint32_t a, uint32_t b) -> bool {
+		    return store.GetMesh(b).IsCollision(store.GetCapsule(a));
+	    };
+
+	// --- 連続判定（動いた球 vs 各型、球同士は両方の移動を考える） ---
+	sweepTable_[static_cast<int>(ColliderType::SPHERE)] =
+	    [](const CollisionColliderStore& store, uint32_t sphere, uint32_t other, float& outT) -> bool {
+		    return Collision::Sweep(store.GetSphere(sphere), store.GetSphereMotion(sphere),
+		                            store.GetSphere(other), store.GetSphereMotion(other), outT);
+	    };
+	sweepTable_[static_cast<int>(ColliderType::AABB)] =
+	    [](const CollisionColliderStore& store, uint32_t sphere, uint32_t other, float& outT) -> bool {
+		    return Collision::Sweep(store.GetSphere(sphere), store.GetSphereMotion(sphere), store.GetAABB(other), outT);
+	    };
+	sweepTable_[static_cast<int>(ColliderType::OBB)] =
+	    [](const CollisionColliderStore& store, uint32_t sphere, uint32_t other, float& outT) -> bool {
+		    return Collision::Sweep(store.GetSphere(sphere), store.GetSphereMotion(sphere), store.GetOBB(other), outT);
+	    };
+	sweepTable_[static_cast<int>(ColliderType::CAPSULE)] =
+	    [](const CollisionColliderStore& store, uint32_t sphere, uint32_t other, float& outT) -> bool {
+		    return Collision::Sweep(store.GetSphere(sphere), store.GetSphereMotion(sphere), store.GetCapsule(other), outT);
+	    };
+
+	sweepTable_[static_cast<int>(ColliderType::MESH)] =
+	    [](const CollisionColliderStore& store, uint32_t sphere, uint32_t other, float& outT) -> bool {
+		    return store.GetMesh(other).Sweep(store.GetSphere(sphere), store.GetSphereMotion(sphere), outT);
 	    };
 
-	// OBB, Sprite は実装時に RegisterCollisionHandlers() へ追加する
+	// Sprite は実装時に RegisterCollisionHandlers() へ追加する
+	// （型ごとの配列を持たない型は store.GetCollider() から形状を取得する）
 }
@@ -3,40 +3,186 @@
 #include "Collider/ICollider.h"
 #include "Collider/SphereCollider.h"
 #include "Collider/AABBCollider.h"
-#include <list>
-#include <set>
+#include "Collider/OBBCollider.h"
+#include "Collider/CapsuleCollider.h"
+#include "Collider/MeshCollider.h"
+#include "CollisionBroadphase.h"
+#include "CollisionBenchmark.h"
+#include "CollisionNarrowphaseBenchmark.h"
+#include "CollisionContactTable.h"
+#include "CollisionColliderStore.h"
+#include "CollisionBatch.h"
+#include "CollisionQuery.h"
+#include <functional>
+#include <memory>
 #include <utility>
+#include <vector>
 
 /// <summary>
 /// 衝突判定マネージャー
 /// Enter / Stay / Exit の3段階コールバックに対応
+/// 候補の列挙とナローフェーズは JobSystem のタスクに分けて判定し、接触はタスクごとの領域に溜める
+/// コールバックは判定が全て終わってからメインスレッドで、コライダーの番号（登録順）の順に呼ぶ
 /// </summary>
 class CollisionManager {
 public:
 	CollisionManager();
 	~CollisionManager();
 
-	/// <summary>初期化（コライダーリストのクリア）</summary>
+	/// <summary>初期化（登録・接触をすべてクリア）</summary>
 	void Initialize();
 
-	/// <summary>更新処理（色リセット → 衝突判定 → Enter/Stay/Exit 通知）</summary>
+	/// <summary>更新処理（形状の詰め直し → 色リセット → 衝突判定 → Enter/Stay/Exit 通知）</summary>
 	void Update();
 
-	/// <summary>コライダーをリストに登録</summary>
+	/// <summary>
+	/// コライダーを登録（解除するまで毎フレーム判定される）
+	/// 破棄する前に必ず UnregisterCollider すること
+	/// </summary>
+	ColliderHandle RegisterCollider(ICollider* collider);
+
+	/// <summary>
+	/// 登録を解除（次の Update で、接触していた相手にだけ OnCollisionExit を呼ぶ）
+	/// 解除したコライダー自身には Exit を呼ばない。相手に渡すポインタは破棄済みのことがあるので比較にだけ使うこと
+	/// </summary>
+	void UnregisterCollider(ColliderHandle handle);
+	void UnregisterCollider(ICollider* collider);
+
+	/// <summary>コライダーを今フレームだけ追加（Manager外のコライダーなど、登録済み・追加済みのものは無視）</summary>
 	void AddCollider(ICollider* collider);
 
-	/// <summary>コライダーリストをクリア</summary>
+	/// <summary>今フレームだけ追加したコライダーをクリア（登録済みのものは残る）</summary>
 	void ClearColliderList();
 
+	/// <summary>ImGui用のデバッグ表示（ブロードフェーズの切り替え・統計・ベンチマーク）</summary>
+	void ImGui();
+
 	void SetHitColor(const uint32_t& color) { hitColor_ = color; }
 	uint32_t GetHitColor() const { return hitColor_; }
 
+	// --- ブロードフェーズ ---
+	void SetBroadphaseType(CollisionBroadphaseType type) { broadphaseType_ = type; }
+	CollisionBroadphaseType GetBroadphaseType() const { return broadphaseType_; }
+
+	/// <summary>一様グリッドのセルの大きさ（0以下なら自動）</summary>
+	void SetGridCellSize(float cellSize) { grid_.SetCellSize(cellSize); }
+	float GetGridCellSize() const { return grid_.GetCellSize(); }
+
+	/// <summary>球・AABB の組み合わせを SIMD でまとめて判定するか（false なら1ペアずつ dispatchTable_）</summary>
+	void SetBatchNarrowphase(bool enabled) { useBatchNarrowphase_ = enabled; }
+	bool IsBatchNarrowphase() const { return useBatchNarrowphase_; }
+
+	/// <summary>
+	/// 候補の列挙（総当たり・グリッド）とナローフェーズを JobSystem で並列に行うか
+	/// どちらでも接触とコールバックの順は変わらない（ペアが少ないフレームは並列でも1タスクで行う）
+	/// </summary>
+	void SetParallel(bool enabled) { useParallel_ = enabled; }
+	bool IsParallel() const { return useParallel_; }
+
+	/// <summary>直近の Update で判定を分けたタスク数</summary>
+	uint32_t GetLastTaskCount() const { return lastTaskCount_; }
+
+	/// <summary>直近の Update でナローフェーズに回したペア数</summary>
+	uint32_t GetLastCandidateCount() const { return lastCandidateCount_; }
+
+	/// <summary>直近の Update で連続判定になった球の数</summary>
+	uint32_t GetSweptCount() const { return store_.GetSweptCount(); }
+
+	/// <summary>直近の Update で衝突していたペア数</summary>
+	uint32_t GetContactCount() const { return contacts_.GetContactCount(); }
+
+	// --- クエリ（直近の Update 時点の形状が対象、Update と同時でなければ複数スレッドから呼んでよい） ---
+
+	/// <summary>最も近い交点を求める（ロックオン・視線の確認・照準など）</summary>
+	bool Raycast(const Vector3& origin, const Vector3& direction, float maxDistance,
+		CollisionRaycastHit& outHit, const CollisionQueryFilter& filter = {}) const {
+		return queryIndex_.Raycast(origin, direction, maxDistance, outHit, filter);
+	}
+
+	/// <summary>全ての交点を近い順に求める</summary>
+	uint32_t RaycastAll(const Vector3& origin, const Vector3& direction, float maxDistance,
+		std::vector<CollisionRaycastHit>& outHits, const CollisionQueryFilter& filter = {}) const {
+		return queryIndex_.RaycastAll(origin, direction, maxDistance, outHits, filter);
+	}
+
+	/// <summary>球と重なるコライダーを求める</summary>
+	uint32_t OverlapSphere(const SphereMath& sphere, std::vector<ICollider*>& outColliders,
+		const CollisionQueryFilter& filter = {}) const {
+		return queryIndex_.OverlapSphere(sphere, outColliders, filter);
+	}
+
+	/// <summary>AABBと重なるコライダーを求める</summary>
+	uint32_t OverlapAABB(const AABB& aabb, std::vector<ICollider*>& outColliders,
+		const CollisionQueryFilter& filter = {}) const {
+		return queryIndex_.OverlapAABB(aabb, outColliders, filter);
+	}
+
 private:
-	/// <summary>全ペアを総当たりして今フレームの衝突ペア集合を構築</summary>
+	/// <summary>ナローフェーズで当たったペア（store_ のインデックス、型を正規化した順）</summary>
+	struct PendingContact {
+		uint32_t a;
+		uint32_t b;
+		float timeOfImpact;
+	};
+
+	/// <summary>
+	/// 判定タスクの作業領域（タスクごとに1つ持ち、ほかのタスクと共有しない）
+	/// 当たったペアは contacts に溜め、全タスクの完了後にメインスレッドがタスク順に contacts_ へ移す
+	/// </summary>
+	struct NarrowphaseTask {
+		std::vector<CollisionIndexPair> pairs;		// このタスクで列挙した候補ペア（グリッド）
+		std::vector<PendingContact> contacts;
+
+		// バッチナローフェーズ（型の組み合わせごとの SoA と、対応するコライダーのインデックス）
+		CollisionBatch::SphereSpherePairs sphereSpherePairs;
+		CollisionBatch::SphereAABBPairs sphereAABBPairs;
+		CollisionBatch::AABBAABBPairs aabbAABBPairs;
+		std::vector<CollisionIndexPair> sphereSphereIndices;
+		std::vector<CollisionIndexPair> sphereAABBIndices;
+		std::vector<CollisionIndexPair> aabbAABBIndices;
+		uint32_t batchHits[CollisionBatch::kCapacity] = {};
+	};
+
+	/// <summary>ブロードフェーズで候補を絞り、今フレームの衝突ペアを記録</summary>
 	void CheckAllCollision();
 
-	/// <summary>2コライダー間の衝突を判定してペア集合に追加</summary>
-	bool CheckCollisionPair(ICollider* a, ICollider* b);
+	/// <summary>全ペアを総当たりして衝突ペアを記録（従来方式、行をペア数が均等になるようタスクに分ける）</summary>
+	void CheckAllCollisionBruteForce();
+
+	/// <summary>一様グリッドで候補ペアを列挙して衝突ペアを記録（セルをタスクに分け、列挙から判定まで各タスクで行う）</summary>
+	void CheckAllCollisionGrid();
+
+	/// <summary>ソート＆スイープで候補ペアを列挙して衝突ペアを記録（スイープは逐次、判定はタスクに分ける）</summary>
+	void CheckAllCollisionSweepAndPrune();
+
+	/// <summary>candidatePairs_ をタスクに等分してナローフェーズで判定し、衝突ペアを記録</summary>
+	void CheckCandidatePairs();
+
+	/// <summary>
+	/// 作業量からタスク数を決め、作業領域を用意する
+	/// 並列にしない・ワーカーが居ない・作業量が minWorkPerTask に満たない時は1
+	/// </summary>
+	uint32_t PlanTasks(uint64_t workCount, uint64_t minWorkPerTask);
+
+	/// <summary>タスクごとに job を実行する（2つ以上なら JobSystem で並列、完了まで戻らない）</summary>
+	void RunTasks(uint32_t taskCount, const std::function<void(NarrowphaseTask&, uint32_t)>& job);
+
+	/// <summary>各タスクの接触をタスク順に contacts_ へ記録する（メインスレッド）</summary>
+	void CommitTasks(uint32_t taskCount);
+
+	/// <summary>
+	/// 2コライダー間の衝突を判定（マスク → 連続判定 sweepTable_ → 型の組み合わせごとのバッチ or dispatchTable_）
+	/// 当たれば task.contacts に積む（バッチに積んだペアは FlushBatches まで結果が出ない）
+	/// store_ を読むだけなので、別々の task なら並列に呼んでよい
+	/// </summary>
+	void QueuePair(NarrowphaseTask& task, uint32_t indexA, uint32_t indexB) const;
+
+	/// <summary>積んであるバッチをすべて判定して接触を積む</summary>
+	void FlushBatches(NarrowphaseTask& task) const;
+
+	/// <summary>1つのバッチを判定して接触を積み、空にする</summary>
+	template<typename Pairs>
+	void FlushBatch(NarrowphaseTask& task, Pairs& pairs, std::vector<CollisionIndexPair>& indices) const;
 
 	/// <summary>全コライダーの色をデフォルトにリセット</summary>
 	void ResetAllColliderColors();
@@ -45,26 +191,59 @@ private:
 	void RegisterCollisionHandlers();
 
 	// --- 型 ---
-	using CollisionFunc = bool(*)(ICollider*, ICollider*);
-	using ColliderPair  = std::pair<ICollider*, ICollider*>;
-
-	/// <summary>ポインタを常に小さい順に並べてペアを作る（正規化）</summary>
-	static ColliderPair MakePair(ICollider* a, ICollider* b) {
-		if (a > b) std::swap(a, b);
-		return { a, b };
-	}
-
-	// コライダーリスト
-	std::list<ICollider*> colliders_;
-
-	// 衝突ペアの集合（Enter/Stay/Exit 判定用）
-	std::set<ColliderPair> currentPairs_;
-	std::set<ColliderPair> prevPairs_;
+	// 引数は store_ のインデックス（常に typeA <= typeB）
+	using CollisionFunc = bool(*)(const CollisionColliderStore&, uint32_t, uint32_t);
+	// 連続判定の球 sphere と相手 other の最初の接触時刻を outT に返す
+	using SweepFunc = bool(*)(const CollisionColliderStore&, uint32_t sphere, uint32_t other, float& outT);
+
+	// コライダー（登録済み + 今フレームだけのもの、形状は型ごとに詰め直す）
+	CollisionColliderStore store_;
+	std::vector<ICollider*> removedColliders_;
+
+	// ブロードフェーズ
+	CollisionBroadphaseType broadphaseType_ = CollisionBroadphaseType::UniformGrid;
+	CollisionUniformGrid grid_;
+	CollisionSweepAndPrune sweepAndPrune_;
+	uint32_t lastCandidateCount_ = 0;
+
+	// レイキャスト・重なりのクエリ用の空間インデックス（Update で作り直す）
+	CollisionQueryIndex queryIndex_;
+
+	// ブロードフェーズの作業領域（毎フレーム再確保しないよう保持）
+	std::vector<CollisionIndexPair> candidatePairs_;
+	std::vector<uint32_t> taskRowStarts_;	// 総当たりでの各タスクの先頭の行
+
+	// バッチナローフェーズ（球・AABB の組み合わせを SIMD でまとめて判定）
+	bool useBatchNarrowphase_ = true;
+
+	// 並列判定（タスクの作業領域は SoA が大きいので一度作ったら使い回す）
+	// タスクはスレッド数より多めに分けて負荷の偏りをならし、1タスクの作業量が少なすぎる時は分けない
+	// （総当たりはほとんどのペアがマスクで弾かれて安いので多め）
+	static constexpr uint32_t kMaxTaskCount = 64;
+	static constexpr uint32_t kTasksPerThread = 4;
+	static constexpr uint64_t kMinBruteForcePairsPerTask = 4096;
+	static constexpr uint64_t kMinCandidatesPerTask = 256;
+	static constexpr uint64_t kMinGridEntriesPerTask = 256;
+	bool useParallel_ = true;
+	uint32_t lastTaskCount_ = 1;
+	std::vector<std::unique_ptr<NarrowphaseTask>> narrowphaseTasks_;
+
+	// ブロードフェーズのベンチマーク（ImGuiから実行）
+	CollisionBenchmark benchmark_;
+
+	// ナローフェーズの検証とベンチマーク（ImGuiから実行）
+	CollisionNarrowphaseBenchmark narrowphaseBenchmark_;
+
+	// 衝突ペアの表（フレーム番号で Enter/Stay/Exit を判定）
+	CollisionContactTable contacts_;
 
 	// 2次元 dispatch table（行=typeA, 列=typeB、常に typeA<=typeB）
 	static constexpr int kTypeCount = static_cast<int>(ColliderType::Count);
 	CollisionFunc dispatchTable_[kTypeCount][kTypeCount] = {};
 
+	// 連続判定の球と相手の型ごとの判定（未登録の型は今フレームの位置で dispatchTable_ の判定）
+	SweepFunc sweepTable_[kTypeCount] = {};
+
 	// 衝突時の色（デフォルト: 赤）
 	uint32_t hitColor_ = 0xFF0000FF;
 };
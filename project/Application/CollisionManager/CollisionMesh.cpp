@@ -0,0 +1,496 @@
+#define NOMINMAX
+#include "CollisionMesh.h"
+#include "Collision.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <fstream>
+
+using namespace MyMath;
+
+namespace {
+
+	// キャッシュの識別子と形式の版（Node や並びを変えたら版を上げる）
+	constexpr uint32_t kCacheMagic = 0x48534D43;	// "CMSH"
+	constexpr uint32_t kCacheVersion = 1;
+
+	/// <summary>キャッシュの先頭</summary>
+	struct CacheHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceHash;
+		uint32_t triangleCount;
+		uint32_t nodeCount;
+	};
+
+	void Merge(AABB& bounds, const Vector3& point) {
+		bounds.min = { std::min(bounds.min.x, point.x), std::min(bounds.min.y, point.y), std::min(bounds.min.z, point.z) };
+		bounds.max = { std::max(bounds.max.x, point.x), std::max(bounds.max.y, point.y), std::max(bounds.max.z, point.z) };
+	}
+
+	void Merge(AABB& bounds, const AABB& other) {
+		Merge(bounds, other.min);
+		Merge(bounds, other.max);
+	}
+
+	AABB EmptyBounds() {
+		return { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+	}
+
+	AABB TriangleBounds(const TriangleMath& tri) {
+		AABB bounds = { tri.vertices[0], tri.vertices[0] };
+		Merge(bounds, tri.vertices[1]);
+		Merge(bounds, tri.vertices[2]);
+		return bounds;
+	}
+
+	/// <summary>表面積の半分（SAH の比較にしか使わないので定数倍は省く）</summary>
+	float HalfArea(const AABB& bounds) {
+		const Vector3 size = bounds.max - bounds.min;
+		return size.x * size.y + size.y * size.z + size.z * size.x;
+	}
+
+	float GetAxisValue(const Vector3& v, int axis) {
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	/// <summary>範囲の重なり（接しているものも含む）</summary>
+	bool Overlaps(const Vector3& min, const Vector3& max, const AABB& bounds) {
+		return min.x <= bounds.max.x && max.x >= bounds.min.x &&
+		       min.y <= bounds.max.y && max.y >= bounds.min.y &&
+		       min.z <= bounds.max.z && max.z >= bounds.min.z;
+	}
+
+	/// <summary>ノード判定用の線分（逆数を先に求めておく）</summary>
+	struct SegmentSlab {
+		Vector3 origin;
+		Vector3 inverse;
+
+		explicit SegmentSlab(const Segment& segment) : origin(segment.origin) {
+			// 0 除算で NaN が出ないよう、成分0は十分小さな値で割る
+			auto invert = [](float d) { return 1.0f / (d != 0.0f ? d : 1.0e-30f); };
+			inverse = { invert(segment.diff.x), invert(segment.diff.y), invert(segment.diff.z) };
+		}
+
+		/// <summary>範囲を margin だけ広げた箱に 0～tLimit の間で入るか</summary>
+		bool Hits(const Vector3& min, const Vector3& max, float margin, float tLimit) const {
+			const float tx0 = (min.x - margin - origin.x) * inverse.x;
+			const float tx1 = (max.x + margin - origin.x) * inverse.x;
+			const float ty0 = (min.y - margin - origin.y) * inverse.y;
+			const float ty1 = (max.y + margin - origin.y) * inverse.y;
+			const float tz0 = (min.z - margin - origin.z) * inverse.z;
+			const float tz1 = (max.z + margin - origin.z) * inverse.z;
+			const float tEnter = std::max({ std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), 0.0f });
+			const float tExit = std::min({ std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), tLimit });
+			return tEnter <= tExit;
+		}
+	};
+}
+
+void CollisionMesh::Build(const std::vector<Vector3>& positions) {
+	Clear();
+	const uint32_t triangleCount = static_cast<uint32_t>(positions.size() / 3);
+	sourceHash_ = HashPositions(positions);
+	if (triangleCount == 0) {
+		return;
+	}
+
+	std::vector<BuildItem> items(triangleCount);
+	for (uint32_t i = 0; i < triangleCount; ++i) {
+		const TriangleMath tri = { { positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2] } };
+		items[i].bounds = TriangleBounds(tri);
+		items[i].centroid = (items[i].bounds.min + items[i].bounds.max) * 0.5f;
+		items[i].index = i;
+	}
+
+	// 葉は1つ以上の三角形を持つので、ノード数は 2n - 1 を超えない
+	nodes_.reserve(triangleCount * 2 - 1);
+	BuildNode(items, 0, triangleCount, 0);
+
+	order_.resize(triangleCount);
+	triangles_.resize(triangleCount);
+	for (uint32_t i = 0; i < triangleCount; ++i) {
+		const uint32_t index = items[i].index;
+		order_[i] = index;
+		triangles_[i] = { { positions[index * 3], positions[index * 3 + 1], positions[index * 3 + 2] } };
+	}
+}
+
+void CollisionMesh::BuildNode(std::vector<BuildItem>& items, uint32_t begin, uint32_t end, uint32_t depth) {
+	const uint32_t nodeIndex = static_cast<uint32_t>(nodes_.size());
+	nodes_.push_back({});
+
+	// 1. 範囲と中心の範囲
+	AABB bounds = items[begin].bounds;
+	AABB centroidBounds = { items[begin].centroid, items[begin].centroid };
+	for (uint32_t i = begin + 1; i < end; ++i) {
+		Merge(bounds, items[i].bounds);
+		Merge(centroidBounds, items[i].centroid);
+	}
+	nodes_[nodeIndex].min = bounds.min;
+	nodes_[nodeIndex].max = bounds.max;
+
+	auto makeLeaf = [&]() {
+		nodes_[nodeIndex].triangles = (begin << kCountBits) | (end - begin);
+		nodes_[nodeIndex].skip = nodeIndex + 1;
+	};
+
+	const uint32_t count = end - begin;
+	const Vector3 extent = centroidBounds.max - centroidBounds.min;
+	const int widestAxis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+	if (count <= kMinLeafSize || (count <= kMaxLeafSize && !(GetAxisValue(extent, widestAxis) > 0.0f))) {
+		makeLeaf();
+		return;
+	}
+
+	// 2. 各軸の中心の範囲をビンに分け、境界ごとに SAH のコスト（左右の 表面積 × 三角形数）を比べる
+	int bestAxis = -1;
+	uint32_t bestBin = 0;
+	float bestCost = FLT_MAX;
+	if (depth < kMaxSAHDepth) {
+		for (int axis = 0; axis < 3; ++axis) {
+			const float axisMin = GetAxisValue(centroidBounds.min, axis);
+			const float axisExtent = GetAxisValue(extent, axis);
+			if (!(axisExtent > 0.0f)) {
+				continue;
+			}
+			const float scale = kBinCount / axisExtent;
+
+			AABB binBounds[kBinCount];
+			uint32_t binCounts[kBinCount] = {};
+			for (AABB& b : binBounds) {
+				b = EmptyBounds();
+			}
+			for (uint32_t i = begin; i < end; ++i) {
+				const uint32_t bin = std::min(kBinCount - 1, static_cast<uint32_t>((GetAxisValue(items[i].centroid, axis) - axisMin) * scale));
+				++binCounts[bin];
+				Merge(binBounds[bin], items[i].bounds);
+			}
+
+			// 右からの累積を先に求め、左から累積しながら境界 (bin | bin+1) のコストを出す
+			float rightCosts[kBinCount] = {};
+			AABB accumulated = EmptyBounds();
+			uint32_t accumulatedCount = 0;
+			for (uint32_t bin = kBinCount - 1; bin > 0; --bin) {
+				Merge(accumulated, binBounds[bin]);
+				accumulatedCount += binCounts[bin];
+				rightCosts[bin] = accumulatedCount > 0 ? HalfArea(accumulated) * accumulatedCount : 0.0f;
+			}
+			accumulated = EmptyBounds();
+			accumulatedCount = 0;
+			for (uint32_t bin = 0; bin + 1 < kBinCount; ++bin) {
+				Merge(accumulated, binBounds[bin]);
+				accumulatedCount += binCounts[bin];
+				if (accumulatedCount == 0 || accumulatedCount == count) {
+					continue;
+				}
+				const float cost = HalfArea(accumulated) * accumulatedCount + rightCosts[bin + 1];
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = bin;
+				}
+			}
+		}
+	}
+
+	// 3. 分けない方が安ければ葉にする（分けると子を2つ調べる分だけ余計にかかるので、その分を足して比べる）
+	const float leafCost = HalfArea(bounds) * count;
+	if (count <= kMaxLeafSize && (bestAxis < 0 || bestCost + HalfArea(bounds) >= leafCost)) {
+		makeLeaf();
+		return;
+	}
+
+	uint32_t middle = begin;
+	if (bestAxis >= 0) {
+		const float axisMin = GetAxisValue(centroidBounds.min, bestAxis);
+		const float scale = kBinCount / GetAxisValue(extent, bestAxis);
+		auto split = std::partition(items.begin() + begin, items.begin() + end, [&](const BuildItem& item) {
+			const uint32_t bin = std::min(kBinCount - 1, static_cast<uint32_t>((GetAxisValue(item.centroid, bestAxis) - axisMin) * scale));
+			return bin <= bestBin;
+		});
+		middle = static_cast<uint32_t>(split - items.begin());
+	}
+	if (middle == begin || middle == end) {
+		// 中心が全て同じ・深すぎる場合は、最も広い軸の要素数の中央値で分ける
+		middle = begin + count / 2;
+		std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+			[widestAxis](const BuildItem& a, const BuildItem& b) { return GetAxisValue(a.centroid, widestAxis) < GetAxisValue(b.centroid, widestAxis); });
+	}
+
+	// 4. 左右の部分木を深さ優先で並べ、部分木の次のノードを skip にする
+	BuildNode(items, begin, middle, depth + 1);
+	BuildNode(items, middle, end, depth + 1);
+	nodes_[nodeIndex].triangles = 0;
+	nodes_[nodeIndex].skip = static_cast<uint32_t>(nodes_.size());
+}
+
+bool CollisionMesh::LoadOrBuild(const std::vector<Vector3>& positions, const std::string& cachePath) {
+	if (!cachePath.empty() && LoadCache(cachePath, positions)) {
+		return true;
+	}
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	Build(positions);
+	const auto end = std::chrono::high_resolution_clock::now();
+	Logger::Log(Logger::GetStream(),
+		std::format("CollisionMesh: Built BVH ({} triangles, {} nodes) in {:.3f} ms\n",
+			GetTriangleCount(), GetNodeCount(), std::chrono::duration<double, std::milli>(end - start).count()));
+
+	if (!cachePath.empty() && !SaveCache(cachePath)) {
+		Logger::Log(Logger::GetStream(), std::format("CollisionMesh: Failed to write cache '{}'\n", cachePath));
+	}
+	return false;
+}
+
+bool CollisionMesh::SaveCache(const std::string& path) const {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+
+	const CacheHeader header = { kCacheMagic, kCacheVersion, sourceHash_, GetTriangleCount(), GetNodeCount() };
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(nodes_.data()), static_cast<std::streamsize>(nodes_.size() * sizeof(Node)));
+	file.write(reinterpret_cast<const char*>(order_.data()), static_cast<std::streamsize>(order_.size() * sizeof(uint32_t)));
+	return static_cast<bool>(file);
+}
+
+bool CollisionMesh::LoadCache(const std::string& path, const std::vector<Vector3>& positions) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	// 1. 形式と元の頂点が作った時と同じか（モデルを差し替えたら作り直す）
+	CacheHeader header = {};
+	const uint32_t triangleCount = static_cast<uint32_t>(positions.size() / 3);
+	const uint64_t hash = HashPositions(positions);
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		header.magic != kCacheMagic || header.version != kCacheVersion ||
+		header.sourceHash != hash || header.triangleCount != triangleCount ||
+		header.nodeCount == 0 || header.nodeCount > triangleCount * 2) {
+		return false;
+	}
+
+	std::vector<Node> nodes(header.nodeCount);
+	std::vector<uint32_t> order(header.triangleCount);
+	if (!file.read(reinterpret_cast<char*>(nodes.data()), static_cast<std::streamsize>(nodes.size() * sizeof(Node))) ||
+		!file.read(reinterpret_cast<char*>(order.data()), static_cast<std::streamsize>(order.size() * sizeof(uint32_t)))) {
+		return false;
+	}
+
+	// 2. 壊れたファイルで範囲外を読まないよう、番号を確かめる
+	for (uint32_t n = 0; n < header.nodeCount; ++n) {
+		const Node& node = nodes[n];
+		if (node.skip <= n || node.skip > header.nodeCount ||
+			(node.IsLeaf() && node.GetFirst() + node.GetCount() > triangleCount)) {
+			return false;
+		}
+	}
+	for (uint32_t index : order) {
+		if (index >= triangleCount) {
+			return false;
+		}
+	}
+
+	// 3. 三角形は頂点から並べ直す（キャッシュには木の形と並びだけを持つ）
+	nodes_ = std::move(nodes);
+	order_ = std::move(order);
+	sourceHash_ = hash;
+	triangles_.resize(triangleCount);
+	for (uint32_t i = 0; i < triangleCount; ++i) {
+		const uint32_t index = order_[i];
+		triangles_[i] = { { positions[index * 3], positions[index * 3 + 1], positions[index * 3 + 2] } };
+	}
+	return true;
+}
+
+void CollisionMesh::Transform(const CollisionMesh& source, const Matrix4x4& matrix) {
+	nodes_ = source.nodes_;
+	order_ = source.order_;
+	sourceHash_ = source.sourceHash_;
+	triangles_.resize(source.triangles_.size());
+	for (size_t i = 0; i < triangles_.size(); ++i) {
+		for (int v = 0; v < 3; ++v) {
+			triangles_[i].vertices[v] = MyMath::Transform(source.triangles_[i].vertices[v], matrix);
+		}
+	}
+	Refit();
+}
+
+void CollisionMesh::Refit() {
+	// 子は必ず親より後ろにあるので、後ろから順に更新すれば子が先に終わる
+	for (size_t n = nodes_.size(); n-- > 0;) {
+		Node& node = nodes_[n];
+		AABB bounds = EmptyBounds();
+		if (node.IsLeaf()) {
+			for (uint32_t i = node.GetFirst(); i < node.GetFirst() + node.GetCount(); ++i) {
+				Merge(bounds, TriangleBounds(triangles_[i]));
+			}
+		} else {
+			// 左の子は直後、右の子は左の部分木の次
+			const Node& left = nodes_[n + 1];
+			const Node& right = nodes_[left.skip];
+			bounds = { left.min, left.max };
+			Merge(bounds, AABB{ right.min, right.max });
+		}
+		node.min = bounds.min;
+		node.max = bounds.max;
+	}
+}
+
+void CollisionMesh::Clear() {
+	nodes_.clear();
+	triangles_.clear();
+	order_.clear();
+	sourceHash_ = 0;
+}
+
+template<class NodeTest, class Visit>
+void CollisionMesh::Traverse(NodeTest nodeTest, Visit visit) const {
+	const uint32_t nodeCount = static_cast<uint32_t>(nodes_.size());
+	uint32_t n = 0;
+	while (n < nodeCount) {
+		const Node& node = nodes_[n];
+		if (!nodeTest(node)) {
+			n = node.skip;
+			continue;
+		}
+		if (!node.IsLeaf()) {
+			++n;
+			continue;
+		}
+		for (uint32_t i = node.GetFirst(); i < node.GetFirst() + node.GetCount(); ++i) {
+			if (visit(triangles_[i])) {
+				return;
+			}
+		}
+		n = node.skip;
+	}
+}
+
+bool CollisionMesh::Raycast(const Segment& seg, float& outT, Vector3& outNormal) const {
+	// 見つかるたびに tLimit を縮めて、それより遠いノードを飛ばす
+	const SegmentSlab slab(seg);
+	float tLimit = 1.0f;
+	bool found = false;
+	Traverse(
+		[&](const Node& node) { return slab.Hits(node.min, node.max, 0.0f, tLimit); },
+		[&](const TriangleMath& tri) {
+			float t = 0.0f;
+			Vector3 normal;
+			if (Collision::Raycast(seg, tri, t, normal) && t <= tLimit) {
+				tLimit = t;
+				outT = t;
+				outNormal = normal;
+				found = true;
+			}
+			return false;
+		});
+	return found;
+}
+
+bool CollisionMesh::IsCollision(const SphereMath& sphere) const {
+	if (sphere.radius < 0.0f) {
+		return false;
+	}
+	const float radiusSq = sphere.radius * sphere.radius;
+	bool hit = false;
+	Traverse(
+		[&](const Node& node) {
+			const Vector3 closest = {
+				std::clamp(sphere.center.x, node.min.x, node.max.x),
+				std::clamp(sphere.center.y, node.min.y, node.max.y),
+				std::clamp(sphere.center.z, node.min.z, node.max.z),
+			};
+			const Vector3 diff = closest - sphere.center;
+			return Dot(diff, diff) <= radiusSq;
+		},
+		[&](const TriangleMath& tri) {
+			hit = Collision::IsCollision(sphere, tri);
+			return hit;
+		});
+	return hit;
+}
+
+bool CollisionMesh::IsCollision(const AABB& aabb) const {
+	bool hit = false;
+	Traverse(
+		[&](const Node& node) { return Overlaps(node.min, node.max, aabb); },
+		[&](const TriangleMath& tri) {
+			hit = Collision::IsCollision(aabb, tri);
+			return hit;
+		});
+	return hit;
+}
+
+bool CollisionMesh::IsCollision(const CapsuleMath& capsule) const {
+	if (capsule.radius < 0.0f) {
+		return false;
+	}
+	// ノードはカプセルを半径だけ広げた線分の範囲で絞る
+	const Vector3& start = capsule.segment.origin;
+	const Vector3 end = start + capsule.segment.diff;
+	const float r = capsule.radius;
+	const AABB bounds = {
+		{ std::min(start.x, end.x) - r, std::min(start.y, end.y) - r, std::min(start.z, end.z) - r },
+		{ std::max(start.x, end.x) + r, std::max(start.y, end.y) + r, std::max(start.z, end.z) + r },
+	};
+	bool hit = false;
+	Traverse(
+		[&](const Node& node) { return Overlaps(node.min, node.max, bounds); },
+		[&](const TriangleMath& tri) {
+			hit = Collision::IsCollision(capsule, tri);
+			return hit;
+		});
+	return hit;
+}
+
+bool CollisionMesh::Sweep(const SphereMath& sphere, const Vector3& motion, float& outT) const {
+	if (sphere.radius < 0.0f) {
+		return false;
+	}
+	// 中心の線分で、半径だけ広げたノードを走査する（見つかるたびに tLimit を縮める）
+	const Segment seg = { sphere.center - motion, motion };
+	const SegmentSlab slab(seg);
+	float tLimit = 1.0f;
+	bool found = false;
+	Traverse(
+		[&](const Node& node) { return slab.Hits(node.min, node.max, sphere.radius, tLimit); },
+		[&](const TriangleMath& tri) {
+			float t = 0.0f;
+			if (Collision::Sweep(sphere, motion, tri, t) && t <= tLimit) {
+				tLimit = t;
+				outT = t;
+				found = true;
+			}
+			// 始めから重なっていればそれより早い接触はない
+			return found && tLimit <= 0.0f;
+		});
+	return found;
+}
+
+AABB CollisionMesh::GetBounds() const {
+	if (nodes_.empty()) {
+		return { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+	}
+	return { nodes_[0].min, nodes_[0].max };
+}
+
+uint64_t CollisionMesh::HashPositions(const std::vector<Vector3>& positions) {
+	// FNV-1a（頂点のビット列と数）
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto mix = [&hash](const void* data, size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 0x100000001B3ull;
+		}
+	};
+	const uint64_t count = positions.size();
+	mix(&count, sizeof(count));
+	mix(positions.data(), positions.size() * sizeof(Vector3));
+	return hash;
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include "Engine/MyMath/MyFunction.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 静的な三角形メッシュの衝突判定用データ（三角形の BVH）
+/// 木は SAH（表面積の見積もり）で分割を選んで作り、作った木はモデルの隣にバイナリのキャッシュとして保存して次回から読み込むだけにする
+/// ノードは深さ優先の順に並べ、内部ノードの左の子は直後、各ノードは部分木の次のノード（skip）を持つので、
+/// 走査はスタックを使わず配列を先頭から進むだけで済む（当たらなければ skip へ飛ぶ）
+/// クエリは const なので、作り直しと同時でなければ複数のジョブから並列に呼んでよい
+/// </summary>
+class CollisionMesh {
+public:
+	// 葉に入れる三角形数（kMinLeafSize 以下は必ず葉、kMaxLeafSize 以下は SAH で分けない方が安ければ葉）
+	static constexpr uint32_t kMinLeafSize = 2;
+	static constexpr uint32_t kMaxLeafSize = 8;
+
+	// SAH の分割候補を探す時のビン数（軸ごと）
+	static constexpr uint32_t kBinCount = 16;
+
+	// この深さより下は要素数の中央値で分ける（偏った分割が続いても再帰が深くなりすぎないように）
+	static constexpr uint32_t kMaxSAHDepth = 48;
+
+	/// <summary>
+	/// 三角形リストから木を作る
+	/// </summary>
+	/// <param name="positions">頂点座標（3つで三角形1つ、端数は無視）</param>
+	void Build(const std::vector<Vector3>& positions);
+
+	/// <summary>
+	/// キャッシュが有効なら読み込み、無い・古い場合は作ってキャッシュに保存する
+	/// </summary>
+	/// <param name="positions">頂点座標（キャッシュの検証と三角形の復元に使う）</param>
+	/// <param name="cachePath">キャッシュのパス（空ならキャッシュを使わない）</param>
+	/// <returns>キャッシュから読み込めたか</returns>
+	bool LoadOrBuild(const std::vector<Vector3>& positions, const std::string& cachePath);
+
+	/// <summary>木をキャッシュに保存する</summary>
+	bool SaveCache(const std::string& path) const;
+
+	/// <summary>キャッシュから木を読み込む（頂点が作った時と違う・壊れていれば false で何も変えない）</summary>
+	bool LoadCache(const std::string& path, const std::vector<Vector3>& positions);
+
+	/// <summary>
+	/// source を行列で変換したものにする（木の形はそのままで三角形と範囲だけ作り直す）
+	/// ローカル座標で作った木をワールド座標に置く時に使う
+	/// </summary>
+	void Transform(const CollisionMesh& source, const Matrix4x4& matrix);
+
+	/// <summary>空にする</summary>
+	void Clear();
+
+	/// <summary>線分との最初の交点（t は線分上の位置 0～1、法線は線分に向かい合う側）</summary>
+	bool Raycast(const Segment& seg, float& outT, Vector3& outNormal) const;
+
+	/// <summary>球・AABB・カプセルと重なる三角形があるか</summary>
+	bool IsCollision(const SphereMath& sphere) const;
+	bool IsCollision(const AABB& aabb) const;
+	bool IsCollision(const CapsuleMath& capsule) const;
+
+	/// <summary>移動する球との最初の接触時刻（約束は Collision::Sweep と同じ）</summary>
+	bool Sweep(const SphereMath& sphere, const Vector3& motion, float& outT) const;
+
+	/// <summary>全体の範囲（空なら大きさ0）</summary>
+	AABB GetBounds() const;
+
+	bool IsEmpty() const { return nodes_.empty(); }
+	uint32_t GetTriangleCount() const { return static_cast<uint32_t>(triangles_.size()); }
+	uint32_t GetNodeCount() const { return static_cast<uint32_t>(nodes_.size()); }
+
+	/// <summary>木の並びでの三角形（葉ごとに連続）</summary>
+	const TriangleMath& GetTriangle(uint32_t i) const { return triangles_[i]; }
+
+private:
+	// 葉の三角形の先頭と数を1つに詰める時の、数のビット数
+	static constexpr uint32_t kCountBits = 4;
+	static constexpr uint32_t kCountMask = (1u << kCountBits) - 1;
+	static_assert(kMaxLeafSize <= kCountMask, "葉の三角形数が kCountBits に収まらない");
+
+	/// <summary>
+	/// ノード（32バイト、キャッシュラインに2つ）
+	/// triangles が0なら内部ノード、それ以外は葉で (先頭 << kCountBits) | 数
+	/// </summary>
+	struct Node {
+		Vector3 min;
+		uint32_t skip;		// この部分木の次に調べるノード（最後なら nodes_.size()）
+		Vector3 max;
+		uint32_t triangles;
+
+		bool IsLeaf() const { return triangles != 0; }
+		uint32_t GetFirst() const { return triangles >> kCountBits; }
+		uint32_t GetCount() const { return triangles & kCountMask; }
+	};
+	static_assert(sizeof(Node) == 32, "Node はキャッシュの形式でもあるので大きさを変えないこと");
+
+	/// <summary>作成時の要素（三角形の範囲と中心、並べ替えで一緒に動かす）</summary>
+	struct BuildItem {
+		AABB bounds;
+		Vector3 centroid;
+		uint32_t index;
+	};
+
+	/// <summary>items[begin, end) から部分木を作る</summary>
+	void BuildNode(std::vector<BuildItem>& items, uint32_t begin, uint32_t end, uint32_t depth);
+
+	/// <summary>葉の範囲を三角形から、内部ノードの範囲を子から求め直す（後ろから順に）</summary>
+	void Refit();
+
+	/// <summary>
+	/// ノードを先頭から順に走査し、nodeTest(node) を通った葉の三角形ごとに visit(triangle) を呼ぶ
+	/// visit が true を返したらそこで打ち切る
+	/// </summary>
+	template<class NodeTest, class Visit>
+	void Traverse(NodeTest nodeTest, Visit visit) const;
+
+	/// <summary>頂点座標のハッシュ（キャッシュの検証用）</summary>
+	static uint64_t HashPositions(const std::vector<Vector3>& positions);
+
+	std::vector<Node> nodes_;
+	std::vector<TriangleMath> triangles_;	// 木の並び
+	std::vector<uint32_t> order_;			// 木の並びでの元の三角形の番号（キャッシュに保存する）
+	uint64_t sourceHash_ = 0;
+};
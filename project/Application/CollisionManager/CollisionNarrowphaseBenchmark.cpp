@@ -0,0 +1,444 @@
+#define NOMINMAX
+#include "CollisionNarrowphaseBenchmark.h"
+#include "Collision.h"
+#ifdef USEIMGUI
+#include "ImGui/ImGuiManager.h"
+#endif
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace MyMath;
+
+namespace {
+
+	// どの組み合わせでも同じ乱数列から形状を生成するためのシード
+	constexpr uint32_t kSeed = 13579;
+
+	// 形状を置く範囲（原点中心の立方体の半分の大きさ、2割程度の組が衝突する密度）
+	constexpr float kHalfExtent = 2.5f;
+
+	// 参照で線分を区切る数・箱の各軸を区切る数
+	constexpr int kSegmentDivision = 64;
+	constexpr int kBoxDivision = 8;
+
+	// 平行な組・長さ0の線分を混ぜる割合（分岐の境目を通すため）
+	constexpr float kDegenerateRatio = 0.1f;
+
+	constexpr const char* kShapePairNames[] = {
+		"Sphere-OBB", "AABB-OBB", "OBB-OBB", "Sphere-Capsule", "AABB-Capsule", "OBB-Capsule", "Capsule-Capsule",
+	};
+	static_assert(std::size(kShapePairNames) == static_cast<size_t>(CollisionNarrowphaseBenchmark::ShapePair::Count));
+
+	/// <summary>形状生成用の乱数</summary>
+	class Random {
+	public:
+		float Range(float min, float max) { return std::uniform_real_distribution<float>(min, max)(engine_); }
+		Vector3 Range3(float min, float max) { return { Range(min, max), Range(min, max), Range(min, max) }; }
+		bool Chance(float ratio) { return Range(0.0f, 1.0f) < ratio; }
+		Matrix4x4 Rotation() { return MakeRotateXYZMatrix(Range3(0.0f, 6.2831853f)); }
+
+	private:
+		std::mt19937 engine_{ kSeed };
+	};
+
+	/// <summary>参照で求めた距離（真の距離 d に対して d <= distance <= d + error）</summary>
+	struct Reference {
+		float distance;
+		float radius;	// 衝突とみなす距離
+		float error;	// 標本化による誤差の上限
+	};
+
+	/// <summary>判定結果が参照と矛盾しないか（誤差の範囲に入る組は両方を許す）</summary>
+	bool Agrees(bool hit, const Reference& reference) {
+		return hit ? reference.distance <= reference.radius + reference.error : reference.distance > reference.radius;
+	}
+
+	/// <summary>交差の有無だけが分かる参照（誤差なし）</summary>
+	Reference ExactReference(bool intersects) {
+		return { intersects ? 0.0f : 1.0f, 0.0f, 0.0f };
+	}
+
+	// --- 形状の生成 ---
+
+	SphereMath MakeSphere(Random& random) {
+		return { random.Range3(-kHalfExtent, kHalfExtent), random.Range(0.1f, 1.5f) };
+	}
+
+	AABB MakeAABB(Random& random) {
+		const Vector3 center = random.Range3(-kHalfExtent, kHalfExtent);
+		const Vector3 half = random.Range3(0.2f, 1.5f);
+		return { center - half, center + half };
+	}
+
+	OBB MakeOBB(Random& random, const Matrix4x4& rotation) {
+		OBB obb;
+		obb.center = random.Range3(-kHalfExtent, kHalfExtent);
+		for (int i = 0; i < 3; ++i) {
+			obb.orientations[i] = { rotation.m[i][0], rotation.m[i][1], rotation.m[i][2] };
+		}
+		obb.size = random.Range3(0.2f, 1.5f);
+		return obb;
+	}
+
+	OBB MakeOBB(Random& random) {
+		return MakeOBB(random, random.Rotation());
+	}
+
+	CapsuleMath MakeCapsule(Random& random) {
+		CapsuleMath capsule;
+		capsule.segment.origin = random.Range3(-kHalfExtent, kHalfExtent);
+		capsule.segment.diff = random.Chance(kDegenerateRatio) ? Vector3{ 0.0f, 0.0f, 0.0f } : random.Range3(-2.0f, 2.0f);
+		capsule.radius = random.Range(0.1f, 1.0f);
+		return capsule;
+	}
+
+	// --- 全体の回転（結果が変わらないことの確認用） ---
+
+	Vector3 RotateVector(const Vector3& v, const Matrix4x4& rotation) {
+		return TransformNormal(v, rotation);
+	}
+
+	OBB RotateOBB(const OBB& obb, const Matrix4x4& rotation) {
+		OBB rotated = obb;
+		rotated.center = RotateVector(obb.center, rotation);
+		for (int i = 0; i < 3; ++i) {
+			rotated.orientations[i] = RotateVector(obb.orientations[i], rotation);
+		}
+		return rotated;
+	}
+
+	CapsuleMath RotateCapsule(const CapsuleMath& capsule, const Matrix4x4& rotation) {
+		CapsuleMath rotated = capsule;
+		rotated.segment.origin = RotateVector(capsule.segment.origin, rotation);
+		rotated.segment.diff = RotateVector(capsule.segment.diff, rotation);
+		return rotated;
+	}
+
+	// --- 参照（判定関数とは別の方法で求める） ---
+
+	/// <summary>点をOBBのローカル座標へ</summary>
+	Vector3 ToLocal(const OBB& obb, const Vector3& point) {
+		const Vector3 d = point - obb.center;
+		return { Dot(d, obb.orientations[0]), Dot(d, obb.orientations[1]), Dot(d, obb.orientations[2]) };
+	}
+
+	/// <summary>点とOBBの距離（ローカル座標で各軸をはみ出した分）</summary>
+	float PointOBBDistance(const Vector3& point, const OBB& obb) {
+		const Vector3 local = ToLocal(obb, point);
+		const Vector3 outside = {
+			std::max(std::abs(local.x) - obb.size.x, 0.0f),
+			std::max(std::abs(local.y) - obb.size.y, 0.0f),
+			std::max(std::abs(local.z) - obb.size.z, 0.0f),
+		};
+		return Length(outside);
+	}
+
+	/// <summary>AABB を軸の揃った OBB に</summary>
+	OBB ToOBB(const AABB& aabb) {
+		OBB obb;
+		obb.center = (aabb.min + aabb.max) * 0.5f;
+		obb.orientations[0] = { 1.0f, 0.0f, 0.0f };
+		obb.orientations[1] = { 0.0f, 1.0f, 0.0f };
+		obb.orientations[2] = { 0.0f, 0.0f, 1.0f };
+		obb.size = (aabb.max - aabb.min) * 0.5f;
+		return obb;
+	}
+
+	/// <summary>線分がOBBを通るか（ローカル座標でスラブごとに t の範囲を絞る）</summary>
+	bool SegmentHitsOBB(const Vector3& start, const Vector3& end, const OBB& obb) {
+		const Vector3 p = ToLocal(obb, start);
+		const Vector3 q = ToLocal(obb, end);
+		const float origin[3] = { p.x, p.y, p.z };
+		const float dir[3] = { q.x - p.x, q.y - p.y, q.z - p.z };
+		const float extent[3] = { obb.size.x, obb.size.y, obb.size.z };
+
+		float tMin = 0.0f;
+		float tMax = 1.0f;
+		for (int axis = 0; axis < 3; ++axis) {
+			if (dir[axis] == 0.0f) {
+				if (std::abs(origin[axis]) > extent[axis]) { return false; }
+				continue;
+			}
+			float t0 = (-extent[axis] - origin[axis]) / dir[axis];
+			float t1 = (extent[axis] - origin[axis]) / dir[axis];
+			if (t0 > t1) { std::swap(t0, t1); }
+			tMin = std::max(tMin, t0);
+			tMax = std::min(tMax, t1);
+			if (tMin > tMax) { return false; }
+		}
+		return true;
+	}
+
+	/// <summary>OBB の辺のどれかが相手を通るか</summary>
+	bool AnyEdgeHitsOBB(const OBB& box, const OBB& other) {
+		Vector3 corners[8];
+		for (int i = 0; i < 8; ++i) {
+			corners[i] = box.center
+				+ box.orientations[0] * (box.size.x * ((i & 1) ? 1.0f : -1.0f))
+				+ box.orientations[1] * (box.size.y * ((i & 2) ? 1.0f : -1.0f))
+				+ box.orientations[2] * (box.size.z * ((i & 4) ? 1.0f : -1.0f));
+		}
+		for (int i = 0; i < 8; ++i) {
+			for (int bit = 1; bit < 8; bit <<= 1) {
+				if ((i & bit) == 0 && SegmentHitsOBB(corners[i], corners[i | bit], other)) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// 箱同士が交差するか
+	/// 交差していれば、どちらかの辺が相手の面を貫くか、一方が他方に完全に含まれる（中心が中にある）
+	/// </summary>
+	bool OBBsIntersect(const OBB& a, const OBB& b) {
+		return PointOBBDistance(a.center, b) == 0.0f || PointOBBDistance(b.center, a) == 0.0f ||
+			AnyEdgeHitsOBB(a, b) || AnyEdgeHitsOBB(b, a);
+	}
+
+	/// <summary>線分上を等間隔に区切った点で距離の最小値を取る（距離関数はリプシッツ定数1）</summary>
+	template<class DistanceFunc>
+	Reference SampleSegment(const Segment& segment, float radius, DistanceFunc distance) {
+		float best = distance(segment.origin);
+		for (int i = 1; i <= kSegmentDivision; ++i) {
+			const float t = static_cast<float>(i) / kSegmentDivision;
+			best = std::min(best, distance(segment.origin + segment.diff * t));
+		}
+		return { best, radius, Length(segment.diff) / (2.0f * kSegmentDivision) };
+	}
+
+	// --- 組み合わせごとの実行 ---
+
+	/// <summary>生成した組を参照・不変条件と突き合わせ、判定時間を計測する</summary>
+	template<class ShapeA, class ShapeB, class GenerateFunc, class ReferenceFunc, class InvarianceFunc>
+	CollisionNarrowphaseBenchmark::Result RunPair(uint32_t sampleCount, uint32_t repeatCount,
+		GenerateFunc generate, ReferenceFunc reference, InvarianceFunc invariance) {
+		Random random;
+		std::vector<ShapeA> shapesA;
+		std::vector<ShapeB> shapesB;
+		shapesA.reserve(sampleCount);
+		shapesB.reserve(sampleCount);
+		for (uint32_t i = 0; i < sampleCount; ++i) {
+			auto [a, b] = generate(random);
+			shapesA.push_back(a);
+			shapesB.push_back(b);
+		}
+
+		CollisionNarrowphaseBenchmark::Result result;
+		result.sampleCount = sampleCount;
+
+		// 1. 検証
+		for (uint32_t i = 0; i < sampleCount; ++i) {
+			const bool hit = Collision::IsCollision(shapesA[i], shapesB[i]);
+			if (hit) { ++result.hitCount; }
+			if (!Agrees(hit, reference(shapesA[i], shapesB[i]))) { ++result.mismatchCount; }
+			if (!invariance(shapesA[i], shapesB[i], hit, random)) { ++result.invarianceCount; }
+		}
+
+		// 2. 計測（連続した配列を順に判定する、ブロードフェーズ後のナローフェーズと同じ形）
+		uint32_t hitSum = 0;
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t repeat = 0; repeat < repeatCount; ++repeat) {
+			for (uint32_t i = 0; i < sampleCount; ++i) {
+				hitSum += Collision::IsCollision(shapesA[i], shapesB[i]) ? 1u : 0u;
+			}
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		// 計測ループが最適化で消えないよう結果を使う（検証時と同じ結果になっているはず）
+		if (hitSum != result.hitCount * repeatCount) {
+			++result.mismatchCount;
+		}
+
+		const double pairCount = static_cast<double>(sampleCount) * repeatCount;
+		result.nsPerPair = pairCount > 0.0 ? std::chrono::duration<double, std::nano>(end - start).count() / pairCount : 0.0;
+		return result;
+	}
+}
+
+CollisionNarrowphaseBenchmark::Result CollisionNarrowphaseBenchmark::Run(ShapePair pair, uint32_t sampleCount, uint32_t repeatCount) {
+	switch (pair) {
+	case ShapePair::SphereOBB:
+		return RunPair<SphereMath, OBB>(sampleCount, repeatCount,
+			[](Random& random) { return std::make_pair(MakeSphere(random), MakeOBB(random)); },
+			[](const SphereMath& sphere, const OBB& obb) {
+				// 箱の内部を格子状に区切った点で中心との距離の最小値を取る（誤差は格子の対角線の半分）
+				float best = PointOBBDistance(sphere.center, obb) == 0.0f ? 0.0f : 1.0e30f;
+				for (int x = 0; x <= kBoxDivision; ++x) {
+					for (int y = 0; y <= kBoxDivision; ++y) {
+						for (int z = 0; z <= kBoxDivision; ++z) {
+							const Vector3 point = obb.center
+								+ obb.orientations[0] * (obb.size.x * (2.0f * x / kBoxDivision - 1.0f))
+								+ obb.orientations[1] * (obb.size.y * (2.0f * y / kBoxDivision - 1.0f))
+								+ obb.orientations[2] * (obb.size.z * (2.0f * z / kBoxDivision - 1.0f));
+							best = std::min(best, Length(point - sphere.center));
+						}
+					}
+				}
+				return Reference{ best, sphere.radius, Length(obb.size) / kBoxDivision };
+			},
+			[](const SphereMath& sphere, const OBB& obb, bool hit, Random& random) {
+				const Matrix4x4 rotation = random.Rotation();
+				const SphereMath rotated = { RotateVector(sphere.center, rotation), sphere.radius };
+				return Collision::IsCollision(rotated, RotateOBB(obb, rotation)) == hit;
+			});
+
+	case ShapePair::AABBOBB:
+		return RunPair<AABB, OBB>(sampleCount, repeatCount,
+			[](Random& random) { return std::make_pair(MakeAABB(random), MakeOBB(random)); },
+			[](const AABB& aabb, const OBB& obb) { return ExactReference(OBBsIntersect(ToOBB(aabb), obb)); },
+			[](const AABB& aabb, const OBB& obb, bool, Random&) {
+				// 回転していない OBB なら AABB 同士の判定と一致する
+				OBB aligned = obb;
+				aligned.orientations[0] = { 1.0f, 0.0f, 0.0f };
+				aligned.orientations[1] = { 0.0f, 1.0f, 0.0f };
+				aligned.orientations[2] = { 0.0f, 0.0f, 1.0f };
+				const AABB alignedAABB = { obb.center - obb.size, obb.center + obb.size };
+				return Collision::IsCollision(aabb, aligned) == Collision::IsCollision(aabb, alignedAABB);
+			});
+
+	case ShapePair::OBBOBB:
+		return RunPair<OBB, OBB>(sampleCount, repeatCount,
+			[](Random& random) {
+				const OBB a = MakeOBB(random);
+				// 一部は同じ向きにして、辺が平行な場合（外積の軸が0になる）を通す
+				if (random.Chance(kDegenerateRatio)) {
+					Matrix4x4 rotation = MakeIdentity4x4();
+					for (int i = 0; i < 3; ++i) {
+						rotation.m[i][0] = a.orientations[i].x;
+						rotation.m[i][1] = a.orientations[i].y;
+						rotation.m[i][2] = a.orientations[i].z;
+					}
+					return std::make_pair(a, MakeOBB(random, rotation));
+				}
+				return std::make_pair(a, MakeOBB(random));
+			},
+			[](const OBB& a, const OBB& b) { return ExactReference(OBBsIntersect(a, b)); },
+			[](const OBB& a, const OBB& b, bool hit, Random& random) {
+				const Matrix4x4 rotation = random.Rotation();
+				return Collision::IsCollision(b, a) == hit &&
+					Collision::IsCollision(RotateOBB(a, rotation), RotateOBB(b, rotation)) == hit;
+			});
+
+	case ShapePair::SphereCapsule:
+		return RunPair<SphereMath, CapsuleMath>(sampleCount, repeatCount,
+			[](Random& random) { return std::make_pair(MakeSphere(random), MakeCapsule(random)); },
+			[](const SphereMath& sphere, const CapsuleMath& capsule) {
+				return SampleSegment(capsule.segment, sphere.radius + capsule.radius,
+					[&](const Vector3& point) { return Length(point - sphere.center); });
+			},
+			[](const SphereMath& sphere, const CapsuleMath& capsule, bool hit, Random& random) {
+				const Matrix4x4 rotation = random.Rotation();
+				const SphereMath rotated = { RotateVector(sphere.center, rotation), sphere.radius };
+				return Collision::IsCollision(rotated, RotateCapsule(capsule, rotation)) == hit;
+			});
+
+	case ShapePair::AABBCapsule:
+		return RunPair<AABB, CapsuleMath>(sampleCount, repeatCount,
+			[](Random& random) { return std::make_pair(MakeAABB(random), MakeCapsule(random)); },
+			[](const AABB& aabb, const CapsuleMath& capsule) {
+				const OBB box = ToOBB(aabb);
+				return SampleSegment(capsule.segment, capsule.radius,
+					[&](const Vector3& point) { return PointOBBDistance(point, box); });
+			},
+			[](const AABB& aabb, const CapsuleMath& capsule, bool hit, Random&) {
+				// 回転していない OBB として判定しても一致する
+				return Collision::IsCollision(ToOBB(aabb), capsule) == hit;
+			});
+
+	case ShapePair::OBBCapsule:
+		return RunPair<OBB, CapsuleMath>(sampleCount, repeatCount,
+			[](Random& random) { return std::make_pair(MakeOBB(random), MakeCapsule(random)); },
+			[](const OBB& obb, const CapsuleMath& capsule) {
+				return SampleSegment(capsule.segment, capsule.radius,
+					[&](const Vector3& point) { return PointOBBDistance(point, obb); });
+			},
+			[](const OBB& obb, const CapsuleMath& capsule, bool hit, Random& random) {
+				const Matrix4x4 rotation = random.Rotation();
+				return Collision::IsCollision(RotateOBB(obb, rotation), RotateCapsule(capsule, rotation)) == hit;
+			});
+
+	case ShapePair::CapsuleCapsule:
+		return RunPair<CapsuleMath, CapsuleMath>(sampleCount, repeatCount,
+			[](Random& random) {
+				const CapsuleMath a = MakeCapsule(random);
+				CapsuleMath b = MakeCapsule(random);
+				// 一部は平行にして、分母が0になる場合を通す
+				if (random.Chance(kDegenerateRatio)) {
+					b.segment.diff = a.segment.diff * random.Range(-1.5f, 1.5f);
+				}
+				return std::make_pair(a, b);
+			},
+			[](const CapsuleMath& a, const CapsuleMath& b) {
+				// a の線分上の点ごとに、b の線分も区切って距離を求める（誤差は両方の区切りの分）
+				const Reference outer = SampleSegment(a.segment, a.radius + b.radius, [&](const Vector3& point) {
+					return SampleSegment(b.segment, 0.0f, [&](const Vector3& other) { return Length(point - other); }).distance;
+				});
+				return Reference{ outer.distance, outer.radius, outer.error + Length(b.segment.diff) / (2.0f * kSegmentDivision) };
+			},
+			[](const CapsuleMath& a, const CapsuleMath& b, bool hit, Random&) {
+				return Collision::IsCollision(b, a) == hit;
+			});
+
+	default:
+		return {};
+	}
+}
+
+const char* CollisionNarrowphaseBenchmark::GetName(ShapePair pair) {
+	const int index = static_cast<int>(pair);
+	if (index < 0 || index >= static_cast<int>(ShapePair::Count)) {
+		return "Unknown";
+	}
+	return kShapePairNames[index];
+}
+
+bool CollisionNarrowphaseBenchmark::RunAll(uint32_t sampleCount, uint32_t repeatCount) {
+	bool passed = true;
+	for (int i = 0; i < static_cast<int>(ShapePair::Count); ++i) {
+		const ShapePair pair = static_cast<ShapePair>(i);
+		const Result result = Run(pair, sampleCount, repeatCount);
+		LogResult(pair, result);
+		passed = passed && result.mismatchCount == 0 && result.invarianceCount == 0;
+	}
+
+	Logger::Log(Logger::GetStream(), std::format("CollisionNarrowphaseBenchmark: {}\n", passed ? "PASSED" : "FAILED"));
+	return passed;
+}
+
+void CollisionNarrowphaseBenchmark::LogResult(ShapePair pair, const Result& result) {
+	Logger::Log(Logger::GetStream(),
+		std::format("CollisionNarrowphaseBenchmark [{}]: {} pairs, {} hits, {} mismatches, {} invariance failures, {:.2f} ns/pair\n",
+			GetName(pair), result.sampleCount, result.hitCount, result.mismatchCount, result.invarianceCount, result.nsPerPair));
+}
+
+void CollisionNarrowphaseBenchmark::ImGui() {
+#ifdef USEIMGUI
+	ImGui::DragInt("Pairs", &sampleCount_, 100.0f, 100, 1000000);
+	ImGui::DragInt("Repeats", &repeatCount_, 1.0f, 1, 1000);
+
+	if (ImGui::Button("Run All Shape Pairs")) {
+		for (int i = 0; i < static_cast<int>(ShapePair::Count); ++i) {
+			const ShapePair pair = static_cast<ShapePair>(i);
+			results_[i] = Run(pair, static_cast<uint32_t>(sampleCount_), static_cast<uint32_t>(repeatCount_));
+			LogResult(pair, results_[i]);
+		}
+		hasResult_ = true;
+	}
+
+	if (hasResult_) {
+		for (int i = 0; i < static_cast<int>(ShapePair::Count); ++i) {
+			const Result& result = results_[i];
+			ImGui::Text("%-16s %7.2f ns/pair  hits %u/%u  mismatches %u  invariance %u",
+				GetName(static_cast<ShapePair>(i)), result.nsPerPair, result.hitCount, result.sampleCount,
+				result.mismatchCount, result.invarianceCount);
+		}
+	}
+#endif
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// ナローフェーズ（形状の組み合わせごとの判定関数）の検証とベンチマーク
+/// 描画やシーンに依存せず、乱数で生成した形状の組について
+/// Collision::IsCollision の結果を別の方法（辺の貫通判定・点の標本化）で求めた参照と突き合わせ、1組あたりの時間を計測する
+/// </summary>
+class CollisionNarrowphaseBenchmark {
+public:
+	/// <summary>
+	/// 対象の形状の組み合わせ
+	/// ※ ImGui と名前の配列で使うため連番を維持すること
+	/// </summary>
+	enum class ShapePair {
+		SphereOBB = 0,
+		AABBOBB,
+		OBBOBB,
+		SphereCapsule,
+		AABBCapsule,
+		OBBCapsule,
+		CapsuleCapsule,
+		Count
+	};
+
+	/// <summary>計測結果</summary>
+	struct Result {
+		uint32_t sampleCount = 0;		// 検証した組の数
+		uint32_t hitCount = 0;			// 衝突と判定した組の数
+		uint32_t mismatchCount = 0;		// 参照と食い違った組の数（0であること）
+		uint32_t invarianceCount = 0;	// 引数の入れ替え・全体の回転・特殊な場合で結果が変わった組の数（0であること）
+		double nsPerPair = 0.0;			// 1組あたりの判定時間（ナノ秒）
+	};
+
+	/// <summary>
+	/// 指定した組み合わせを検証・計測する
+	/// </summary>
+	/// <param name="pair">形状の組み合わせ</param>
+	/// <param name="sampleCount">乱数で生成する組の数</param>
+	/// <param name="repeatCount">計測で全ての組を判定する回数</param>
+	static Result Run(ShapePair pair, uint32_t sampleCount, uint32_t repeatCount = 20);
+
+	/// <summary>
+	/// 全組み合わせを検証・計測してログに出す（ImGui を使わないコマンドラインからの実行用）
+	/// </summary>
+	/// <returns>全組み合わせで参照との食い違い・不変性の失敗が0なら true</returns>
+	static bool RunAll(uint32_t sampleCount = 20000, uint32_t repeatCount = 20);
+
+	/// <summary>組み合わせの名前</summary>
+	static const char* GetName(ShapePair pair);
+
+	/// <summary>ImGui（組数の設定と全組み合わせの実行）</summary>
+	void ImGui();
+
+private:
+	/// <summary>結果をログに出力</summary>
+	static void LogResult(ShapePair pair, const Result& result);
+
+	int sampleCount_ = 20000;
+	int repeatCount_ = 20;
+	Result results_[static_cast<int>(ShapePair::Count)];
+	bool hasResult_ = false;
+};
@@ -0,0 +1,426 @@
+#define NOMINMAX
+#include "CollisionQuery.h"
+#include "CollisionColliderStore.h"
+#include "Collision.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace MyMath;
+
+namespace {
+
+	/// <summary>範囲の重なり（接しているものも含む）</summary>
+	bool Overlaps(const AABB& a, const AABB& b) {
+		return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+		       a.min.y <= b.max.y && a.max.y >= b.min.y &&
+		       a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+
+	void Merge(AABB& bounds, const AABB& other) {
+		bounds.min = { std::min(bounds.min.x, other.min.x), std::min(bounds.min.y, other.min.y), std::min(bounds.min.z, other.min.z) };
+		bounds.max = { std::max(bounds.max.x, other.max.x), std::max(bounds.max.y, other.max.y), std::max(bounds.max.z, other.max.z) };
+	}
+
+	float GetAxisValue(const Vector3& v, int axis) {
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	/// <summary>インデックスに入れる型（型ごとの形状を持つもの）</summary>
+	bool IsQueryable(ColliderType type) {
+		return type == ColliderType::SPHERE || type == ColliderType::AABB ||
+		       type == ColliderType::OBB || type == ColliderType::CAPSULE || type == ColliderType::MESH;
+	}
+
+	/// <summary>ノード判定用の線分（逆数を先に求めておく）</summary>
+	struct SegmentSlab {
+		Vector3 origin;
+		Vector3 inverse;
+
+		explicit SegmentSlab(const Segment& segment) : origin(segment.origin) {
+			// 0 除算で NaN が出ないよう、成分0は十分小さな値で割る
+			auto invert = [](float d) { return 1.0f / (d != 0.0f ? d : 1.0e-30f); };
+			inverse = { invert(segment.diff.x), invert(segment.diff.y), invert(segment.diff.z) };
+		}
+
+		/// <summary>範囲に入る t（0～tLimit の間で当たらなければ false）</summary>
+		bool Enter(const AABB& bounds, float tLimit, float& outT) const {
+			const float tx0 = (bounds.min.x - origin.x) * inverse.x;
+			const float tx1 = (bounds.max.x - origin.x) * inverse.x;
+			const float ty0 = (bounds.min.y - origin.y) * inverse.y;
+			const float ty1 = (bounds.max.y - origin.y) * inverse.y;
+			const float tz0 = (bounds.min.z - origin.z) * inverse.z;
+			const float tz1 = (bounds.max.z - origin.z) * inverse.z;
+			const float tEnter = std::max({ std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), 0.0f });
+			const float tExit = std::min({ std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), tLimit });
+			outT = tEnter;
+			return tEnter <= tExit;
+		}
+	};
+
+	/// <summary>store の形状と線分の交点</summary>
+	bool RaycastShape(const CollisionColliderStore& store, uint32_t index, const Segment& segment, float& outT, Vector3& outNormal) {
+		switch (store.GetType(index)) {
+		case ColliderType::SPHERE: return Collision::Raycast(segment, store.GetSphere(index), outT, outNormal);
+		case ColliderType::AABB: return Collision::Raycast(segment, store.GetAABB(index), outT, outNormal);
+		case ColliderType::OBB: return Collision::Raycast(segment, store.GetOBB(index), outT, outNormal);
+		case ColliderType::CAPSULE: return Collision::Raycast(segment, store.GetCapsule(index), outT, outNormal);
+		case ColliderType::MESH: return store.GetMesh(index).Raycast(segment, outT, outNormal);
+		default: return false;
+		}
+	}
+
+	/// <summary>向きと距離から線分を作る（向きが長さ0・距離が負なら false）</summary>
+	bool MakeSegment(const Vector3& origin, const Vector3& direction, float maxDistance, Segment& outSegment) {
+		const float length = Length(direction);
+		if (!(length > 0.0f) || !(maxDistance >= 0.0f)) {
+			return false;
+		}
+		outSegment.origin = origin;
+		outSegment.diff = direction * (maxDistance / length);
+		return true;
+	}
+
+	CollisionRaycastHit MakeHit(ICollider* collider, const Segment& segment, float maxDistance, float t, const Vector3& normal) {
+		CollisionRaycastHit hit;
+		hit.collider = collider;
+		hit.distance = t * maxDistance;
+		hit.point = segment.origin + segment.diff * t;
+		hit.normal = normal;
+		return hit;
+	}
+}
+
+CollisionQueryFilter CollisionQueryFilter::FromCollider(const ICollider* self) {
+	CollisionQueryFilter filter;
+	filter.mask = self ? self->GetCollisionMask() : 0xFFFFFFFF;
+	filter.ignore = self;
+	return filter;
+}
+
+void CollisionQueryIndex::Build(const CollisionColliderStore& store) {
+	const bool sameLayout = store_ == &store && IsSameLayout(store);
+	store_ = &store;
+
+	// 顔ぶれが同じなら範囲の更新だけで済ませる（物体はフレーム間で少ししか動かない）
+	if (sameLayout && !nodes_.empty() && Refit() <= builtCost_ * kRebuildCostRatio) {
+		wasLastRebuild_ = false;
+		return;
+	}
+	Rebuild();
+}
+
+void CollisionQueryIndex::Clear() {
+	store_ = nullptr;
+	nodes_.clear();
+	items_.clear();
+	builtColliders_.clear();
+	builtTypes_.clear();
+	builtCost_ = 0.0f;
+}
+
+bool CollisionQueryIndex::IsSameLayout(const CollisionColliderStore& store) const {
+	const uint32_t count = store.GetCount();
+	if (count != builtColliders_.size()) {
+		return false;
+	}
+	const std::vector<ICollider*>& colliders = store.GetColliders();
+	for (uint32_t i = 0; i < count; ++i) {
+		if (colliders[i] != builtColliders_[i] || store.GetType(i) != builtTypes_[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void CollisionQueryIndex::Rebuild() {
+	wasLastRebuild_ = true;
+	nodes_.clear();
+	items_.clear();
+	buildItems_.clear();
+
+	const uint32_t count = store_->GetCount();
+	const std::vector<AABB>& bounds = store_->GetBounds();
+	builtColliders_.assign(store_->GetColliders().begin(), store_->GetColliders().end());
+	builtTypes_.resize(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		builtTypes_[i] = store_->GetType(i);
+		if (IsQueryable(builtTypes_[i])) {
+			buildItems_.push_back({ (bounds[i].min + bounds[i].max) * 0.5f, i });
+		}
+	}
+
+	if (buildItems_.empty()) {
+		builtCost_ = 0.0f;
+		return;
+	}
+	// 葉が半分埋まっていても収まる数を確保（作成中に再確保しないように）
+	nodes_.reserve(buildItems_.size() / kLeafSize * 4 + 1);
+	BuildNode(0, static_cast<uint32_t>(buildItems_.size()));
+
+	items_.resize(buildItems_.size());
+	for (size_t i = 0; i < buildItems_.size(); ++i) {
+		items_[i] = buildItems_[i].index;
+	}
+
+	// 作った直後の表面積を基準にする（範囲は BuildNode で求め済みなので refit と同じ値になる）
+	builtCost_ = Refit();
+}
+
+float CollisionQueryIndex::Refit() {
+	const std::vector<AABB>& bounds = store_->GetBounds();
+	float cost = 0.0f;
+
+	// 子は必ず親より後ろにあるので、後ろから順に更新すれば子が先に終わる
+	for (size_t n = nodes_.size(); n-- > 0;) {
+		Node& node = nodes_[n];
+		if (node.count > 0) {
+			node.bounds = bounds[items_[node.offset]];
+			for (uint32_t i = node.offset + 1; i < node.offset + node.count; ++i) {
+				Merge(node.bounds, bounds[items_[i]]);
+			}
+			continue;
+		}
+		node.bounds = nodes_[n + 1].bounds;
+		Merge(node.bounds, nodes_[node.offset].bounds);
+		const Vector3 size = node.bounds.max - node.bounds.min;
+		cost += size.x * size.y + size.y * size.z + size.z * size.x;
+	}
+	return cost;
+}
+
+uint32_t CollisionQueryIndex::BuildNode(uint32_t begin, uint32_t end) {
+	const uint32_t nodeIndex = static_cast<uint32_t>(nodes_.size());
+	nodes_.push_back({});
+
+	// 1. 中心の範囲
+	AABB centroidBounds = { buildItems_[begin].centroid, buildItems_[begin].centroid };
+	for (uint32_t i = begin + 1; i < end; ++i) {
+		const Vector3& c = buildItems_[i].centroid;
+		Merge(centroidBounds, { c, c });
+	}
+
+	// 2. 中心の広がりが最も大きい軸で分ける（全て同じ位置なら分けられないので葉にする）
+	const Vector3 extent = centroidBounds.max - centroidBounds.min;
+	const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+	const uint32_t count = end - begin;
+	if (count <= kLeafSize || !(GetAxisValue(extent, axis) > 0.0f)) {
+		nodes_[nodeIndex].offset = begin;
+		nodes_[nodeIndex].count = count;
+		return nodeIndex;
+	}
+
+	// 3. 中心の範囲の中点で分ける（1回の走査で済む）、片側に寄りすぎたら要素数の中央値で分け直す
+	const float middleValue = (GetAxisValue(centroidBounds.min, axis) + GetAxisValue(centroidBounds.max, axis)) * 0.5f;
+	auto split = std::partition(buildItems_.begin() + begin, buildItems_.begin() + end,
+		[axis, middleValue](const BuildItem& item) { return GetAxisValue(item.centroid, axis) < middleValue; });
+	uint32_t middle = static_cast<uint32_t>(split - buildItems_.begin());
+	if (middle - begin < count / 4 || end - middle < count / 4) {
+		middle = begin + count / 2;
+		std::nth_element(buildItems_.begin() + begin, buildItems_.begin() + middle, buildItems_.begin() + end,
+			[axis](const BuildItem& a, const BuildItem& b) { return GetAxisValue(a.centroid, axis) < GetAxisValue(b.centroid, axis); });
+	}
+
+	BuildNode(begin, middle);
+	const uint32_t right = BuildNode(middle, end);
+	nodes_[nodeIndex].offset = right;
+	nodes_[nodeIndex].count = 0;
+	return nodeIndex;
+}
+
+bool CollisionQueryIndex::PassesFilter(uint32_t index, const CollisionQueryFilter& filter) const {
+	return (store_->GetAttribute(index) & filter.mask) != 0 && store_->GetCollider(index) != filter.ignore;
+}
+
+template<class HitFunc>
+void CollisionQueryIndex::TraverseSegment(const Segment& segment, const CollisionQueryFilter& filter, HitFunc onHit) const {
+	if (nodes_.empty()) {
+		return;
+	}
+
+	struct StackEntry {
+		uint32_t node;
+		float t;	// ノードに入る位置
+	};
+	StackEntry stack[kStackSize];
+	uint32_t stackSize = 0;
+
+	const SegmentSlab slab(segment);
+	float tLimit = 1.0f;
+	float tRoot = 0.0f;
+	if (!slab.Enter(nodes_[0].bounds, tLimit, tRoot)) {
+		return;
+	}
+	stack[stackSize++] = { 0, tRoot };
+
+	while (stackSize > 0) {
+		const StackEntry entry = stack[--stackSize];
+		if (entry.t > tLimit) {
+			// 積んだ後に見つかった交点より遠い
+			continue;
+		}
+		const Node& node = nodes_[entry.node];
+
+		if (node.count > 0) {
+			for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+				const uint32_t index = items_[i];
+				if (PassesFilter(index, filter)) {
+					onHit(index, tLimit);
+				}
+			}
+			continue;
+		}
+
+		// 2つの子のうち近い方を後に積んで先に調べる
+		const uint32_t left = entry.node + 1;
+		const uint32_t right = node.offset;
+		float tLeft = 0.0f;
+		float tRight = 0.0f;
+		const bool hitLeft = slab.Enter(nodes_[left].bounds, tLimit, tLeft);
+		const bool hitRight = slab.Enter(nodes_[right].bounds, tLimit, tRight);
+		if (hitLeft && hitRight) {
+			if (tLeft <= tRight) {
+				stack[stackSize++] = { right, tRight };
+				stack[stackSize++] = { left, tLeft };
+			} else {
+				stack[stackSize++] = { left, tLeft };
+				stack[stackSize++] = { right, tRight };
+			}
+		} else if (hitLeft) {
+			stack[stackSize++] = { left, tLeft };
+		} else if (hitRight) {
+			stack[stackSize++] = { right, tRight };
+		}
+	}
+}
+
+template<class VisitFunc>
+void CollisionQueryIndex::TraverseBounds(const AABB& bounds, const CollisionQueryFilter& filter, VisitFunc visit) const {
+	if (nodes_.empty()) {
+		return;
+	}
+
+	uint32_t stack[kStackSize];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const uint32_t nodeIndex = stack[--stackSize];
+		const Node& node = nodes_[nodeIndex];
+		if (!Overlaps(node.bounds, bounds)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+				const uint32_t index = items_[i];
+				if (Overlaps(store_->GetBounds()[index], bounds) && PassesFilter(index, filter)) {
+					visit(index);
+				}
+			}
+			continue;
+		}
+		stack[stackSize++] = node.offset;
+		stack[stackSize++] = nodeIndex + 1;
+	}
+}
+
+bool CollisionQueryIndex::Raycast(const Vector3& origin, const Vector3& direction, float maxDistance,
+	CollisionRaycastHit& outHit, const CollisionQueryFilter& filter) const {
+	Segment segment;
+	if (!MakeSegment(origin, direction, maxDistance, segment)) {
+		return false;
+	}
+
+	// 見つかるたびに tLimit を縮めて、それより遠いノードを飛ばす
+	uint32_t bestIndex = 0;
+	float bestT = 0.0f;
+	Vector3 bestNormal = {};
+	bool found = false;
+	TraverseSegment(segment, filter, [&](uint32_t index, float& tLimit) {
+		float t = 0.0f;
+		Vector3 normal;
+		if (RaycastShape(*store_, index, segment, t, normal) && t <= tLimit) {
+			tLimit = t;
+			bestIndex = index;
+			bestT = t;
+			bestNormal = normal;
+			found = true;
+		}
+	});
+
+	if (!found) {
+		return false;
+	}
+	outHit = MakeHit(store_->GetCollider(bestIndex), segment, maxDistance, bestT, bestNormal);
+	return true;
+}
+
+uint32_t CollisionQueryIndex::RaycastAll(const Vector3& origin, const Vector3& direction, float maxDistance,
+	std::vector<CollisionRaycastHit>& outHits, const CollisionQueryFilter& filter) const {
+	outHits.clear();
+	Segment segment;
+	if (!MakeSegment(origin, direction, maxDistance, segment)) {
+		return 0;
+	}
+
+	TraverseSegment(segment, filter, [&](uint32_t index, float&) {
+		float t = 0.0f;
+		Vector3 normal;
+		if (RaycastShape(*store_, index, segment, t, normal)) {
+			outHits.push_back(MakeHit(store_->GetCollider(index), segment, maxDistance, t, normal));
+		}
+	});
+
+	std::sort(outHits.begin(), outHits.end(), [](const CollisionRaycastHit& a, const CollisionRaycastHit& b) {
+		return a.distance < b.distance;
+	});
+	return static_cast<uint32_t>(outHits.size());
+}
+
+uint32_t CollisionQueryIndex::OverlapSphere(const SphereMath& sphere, std::vector<ICollider*>& outColliders,
+	const CollisionQueryFilter& filter) const {
+	outColliders.clear();
+	if (!(sphere.radius >= 0.0f)) {
+		return 0;
+	}
+
+	const float r = sphere.radius;
+	const AABB bounds = { { sphere.center.x - r, sphere.center.y - r, sphere.center.z - r },
+	                      { sphere.center.x + r, sphere.center.y + r, sphere.center.z + r } };
+	TraverseBounds(bounds, filter, [&](uint32_t index) {
+		bool hit = false;
+		switch (store_->GetType(index)) {
+		case ColliderType::SPHERE: hit = Collision::IsCollision(sphere, store_->GetSphere(index)); break;
+		case ColliderType::AABB: hit = Collision::IsCollision(sphere, store_->GetAABB(index)); break;
+		case ColliderType::OBB: hit = Collision::IsCollision(sphere, store_->GetOBB(index)); break;
+		case ColliderType::CAPSULE: hit = Collision::IsCollision(sphere, store_->GetCapsule(index)); break;
+		case ColliderType::MESH: hit = store_->GetMesh(index).IsCollision(sphere); break;
+		default: break;
+		}
+		if (hit) {
+			outColliders.push_back(store_->GetCollider(index));
+		}
+	});
+	return static_cast<uint32_t>(outColliders.size());
+}
+
+uint32_t CollisionQueryIndex::OverlapAABB(const AABB& aabb, std::vector<ICollider*>& outColliders,
+	const CollisionQueryFilter& filter) const {
+	outColliders.clear();
+
+	TraverseBounds(aabb, filter, [&](uint32_t index) {
+		bool hit = false;
+		switch (store_->GetType(index)) {
+		case ColliderType::SPHERE: hit = Collision::IsCollision(store_->GetSphere(index), aabb); break;
+		case ColliderType::AABB: hit = true; break;	// 範囲の重なりで確定済み
+		case ColliderType::OBB: hit = Collision::IsCollision(aabb, store_->GetOBB(index)); break;
+		case ColliderType::CAPSULE: hit = Collision::IsCollision(aabb, store_->GetCapsule(index)); break;
+		case ColliderType::MESH: hit = store_->GetMesh(index).IsCollision(aabb); break;
+		default: break;
+		}
+		if (hit) {
+			outColliders.push_back(store_->GetCollider(index));
+		}
+	});
+	return static_cast<uint32_t>(outColliders.size());
+}
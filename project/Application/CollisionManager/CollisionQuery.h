@@ -0,0 +1,145 @@
+#pragma once
+#include "Collider/ICollider.h"
+#include "Engine/MyMath/MyFunction.h"
+#include <cstdint>
+#include <vector>
+
+class CollisionColliderStore;
+
+/// <summary>
+/// クエリの対象を絞る条件
+/// </summary>
+struct CollisionQueryFilter {
+	uint32_t mask = 0xFFFFFFFF;			// 対象にする collisionAttribute（コライダーの属性と AND して0なら除外）
+	const ICollider* ignore = nullptr;	// 除外するコライダー（自分自身など）
+
+	/// <summary>コライダーの衝突マスクをそのまま使う（自分自身は除外）</summary>
+	static CollisionQueryFilter FromCollider(const ICollider* self);
+};
+
+/// <summary>
+/// レイキャストの結果
+/// </summary>
+struct CollisionRaycastHit {
+	ICollider* collider = nullptr;	// 当たったコライダー
+	float distance = 0.0f;			// 始点からの距離（始点が内側なら0）
+	Vector3 point = {};				// 交点
+	Vector3 normal = {};			// 交点の法線（始点が内側ならレイの逆向き）
+};
+
+/// <summary>
+/// レイキャスト・重なりのクエリ用の空間インデックス（コライダーの範囲の BVH）
+/// CollisionManager::Update で CollisionColliderStore を詰め直した直後に更新し、次の Update まで使う
+/// コライダーの顔ぶれが前回と同じなら木の形はそのままで範囲だけ更新（refit）し、質が落ちたら作り直す
+/// クエリは const で作業領域をスタックに持つので、Update と同時でなければ複数のジョブから並列に呼んでよい
+/// 対象は型ごとの形状を持つ 球・AABB・OBB・カプセル・メッシュ（それ以外の型はインデックスに入れない）
+/// </summary>
+class CollisionQueryIndex {
+public:
+	/// <summary>store の今フレームの形状でインデックスを更新する（store はクエリの間も生きていること）</summary>
+	void Build(const CollisionColliderStore& store);
+
+	/// <summary>インデックスを空にする</summary>
+	void Clear();
+
+	/// <summary>
+	/// 最も近い交点を求める
+	/// </summary>
+	/// <param name="origin">始点</param>
+	/// <param name="direction">向き（正規化していなくてよい、長さ0なら当たらない）</param>
+	/// <param name="maxDistance">最大距離</param>
+	/// <param name="outHit">当たった時の結果</param>
+	/// <param name="filter">対象の条件</param>
+	/// <returns>当たったか</returns>
+	bool Raycast(const Vector3& origin, const Vector3& direction, float maxDistance,
+		CollisionRaycastHit& outHit, const CollisionQueryFilter& filter = {}) const;
+
+	/// <summary>全ての交点を近い順に求める（outHits はクリアしてから追加する）</summary>
+	/// <returns>当たった数</returns>
+	uint32_t RaycastAll(const Vector3& origin, const Vector3& direction, float maxDistance,
+		std::vector<CollisionRaycastHit>& outHits, const CollisionQueryFilter& filter = {}) const;
+
+	/// <summary>球と重なるコライダーを求める（outColliders はクリアしてから追加する、順序は不定）</summary>
+	/// <returns>重なった数</returns>
+	uint32_t OverlapSphere(const SphereMath& sphere, std::vector<ICollider*>& outColliders,
+		const CollisionQueryFilter& filter = {}) const;
+
+	/// <summary>AABBと重なるコライダーを求める（outColliders はクリアしてから追加する、順序は不定）</summary>
+	/// <returns>重なった数</returns>
+	uint32_t OverlapAABB(const AABB& aabb, std::vector<ICollider*>& outColliders,
+		const CollisionQueryFilter& filter = {}) const;
+
+	/// <summary>インデックスに入っているコライダー数</summary>
+	uint32_t GetItemCount() const { return static_cast<uint32_t>(items_.size()); }
+
+	/// <summary>ノード数</summary>
+	uint32_t GetNodeCount() const { return static_cast<uint32_t>(nodes_.size()); }
+
+	/// <summary>直近の Build で木を作り直したか（false なら範囲の更新だけ）</summary>
+	bool WasLastRebuild() const { return wasLastRebuild_; }
+
+private:
+	// 葉に入れる最大のコライダー数
+	static constexpr uint32_t kLeafSize = 4;
+
+	// 走査のスタックの深さ（分割は必ず両側に1/4以上残すので、深さは log(n) / log(4/3) 以下）
+	static constexpr uint32_t kStackSize = 64;
+
+	// refit で内部ノードの表面積の合計が作った時のこの倍を超えたら作り直す
+	static constexpr float kRebuildCostRatio = 1.5f;
+
+	/// <summary>
+	/// ノード（深さ優先の順に並べ、左の子は常に直後）
+	/// count > 0 なら葉で items_[offset, offset + count)、0なら内部ノードで offset は右の子
+	/// </summary>
+	struct Node {
+		AABB bounds;
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	/// <summary>作成時の要素（範囲の中心と store のインデックス、並べ替えで一緒に動かす）</summary>
+	struct BuildItem {
+		Vector3 centroid;
+		uint32_t index;
+	};
+
+	/// <summary>前回作った時とコライダー・型の並びが同じか（同じなら refit できる）</summary>
+	bool IsSameLayout(const CollisionColliderStore& store) const;
+
+	/// <summary>木を作り直す</summary>
+	void Rebuild();
+
+	/// <summary>木の形はそのままで範囲を更新し、内部ノードの表面積の合計を返す</summary>
+	float Refit();
+
+	/// <summary>buildItems_[begin, end) から部分木を作り、ノード番号を返す</summary>
+	uint32_t BuildNode(uint32_t begin, uint32_t end);
+
+	/// <summary>
+	/// 線分でノードを近い順に走査し、フィルタを通った葉のコライダーごとに onHit(index, tLimit) を呼ぶ
+	/// onHit が tLimit（線分上の位置 0～1）を縮めると、それより遠いノードは走査しない
+	/// </summary>
+	template<class HitFunc>
+	void TraverseSegment(const Segment& segment, const CollisionQueryFilter& filter, HitFunc onHit) const;
+
+	/// <summary>範囲でノードを走査し、範囲が重なりフィルタを通った葉のコライダーごとに visit(index) を呼ぶ</summary>
+	template<class VisitFunc>
+	void TraverseBounds(const AABB& bounds, const CollisionQueryFilter& filter, VisitFunc visit) const;
+
+	/// <summary>フィルタを通るか</summary>
+	bool PassesFilter(uint32_t index, const CollisionQueryFilter& filter) const;
+
+	const CollisionColliderStore* store_ = nullptr;
+	std::vector<Node> nodes_;
+	std::vector<uint32_t> items_;		// store のインデックス（葉ごとに連続）
+	bool wasLastRebuild_ = false;
+	float builtCost_ = 0.0f;			// 作った時の内部ノードの表面積の合計
+
+	// 作った時のコライダーと型の並び（refit できるかの確認用）
+	std::vector<ICollider*> builtColliders_;
+	std::vector<ColliderType> builtTypes_;
+
+	// 作成時の作業領域（毎回再確保しないよう保持）
+	std::vector<BuildItem> buildItems_;
+};
@@ -29,6 +29,9 @@ void TestBullet::Setup(DirectXCommon* dxCommon,
 	SetRadius(radius);
 	SetCollisionAttribute(kCollisionAttributePlayerBullet);
 	SetCollisionMask(kCollisionAttributePlayer);	// プレイヤーにのみ当たる
+	// 速い弾は1フレームで薄い相手をすり抜けるので、前フレームからの移動全体で判定する
+	// （再利用時も移動の履歴がリセットされ、前の位置から線を引かない）
+	SetContinuous(true);
 }
 
 void TestBullet::Update()
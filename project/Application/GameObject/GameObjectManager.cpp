@@ -9,6 +9,7 @@ void GameObjectManager::AddObject(std::unique_ptr<GameObject> obj)
 		// Update中は pending に積んで次フレームに統合
 		pendingObjects_.push_back(std::move(obj));
 	} else {
+		RegisterCollider(obj.get());
 		objects_.push_back(std::move(obj));
 	}
 }
@@ -49,13 +50,14 @@ void GameObjectManager::Update()
 	MergePending();
 }
 
-void GameObjectManager::AddAllCollidersToManager(CollisionManager* cm)
+void GameObjectManager::SetCollisionManager(CollisionManager* cm)
 {
-	if (!cm) return;
 	for (auto& obj : objects_) {
-		if (auto* collider = dynamic_cast<ICollider*>(obj.get())) {
-			cm->AddCollider(collider);
-		}
+		UnregisterCollider(obj.get());
+	}
+	collisionManager_ = cm;
+	for (auto& obj : objects_) {
+		RegisterCollider(obj.get());
 	}
 }
 
@@ -98,6 +100,7 @@ void GameObjectManager::Clear()
 {
 	for (auto& obj : objects_) {
 		obj->Finalize();
+		UnregisterCollider(obj.get());
 	}
 	objects_.clear();
 	pendingObjects_.clear();
@@ -108,6 +111,7 @@ void GameObjectManager::MergePending()
 	if (pendingObjects_.empty()) return;
 
 	for (auto& obj : pendingObjects_) {
+		RegisterCollider(obj.get());
 		objects_.push_back(std::move(obj));
 	}
 	pendingObjects_.clear();
@@ -118,6 +122,7 @@ void GameObjectManager::RemoveDestroyed()
 	for (auto& obj : objects_) {
 		if (obj->IsDestroyed()) {
 			obj->Finalize();
+			UnregisterCollider(obj.get());
 		}
 	}
 
@@ -129,3 +134,19 @@ void GameObjectManager::RemoveDestroyed()
 		objects_.end()
 	);
 }
+
+void GameObjectManager::RegisterCollider(GameObject* obj)
+{
+	if (!collisionManager_) return;
+	if (auto* collider = dynamic_cast<ICollider*>(obj)) {
+		collisionManager_->RegisterCollider(collider);
+	}
+}
+
+void GameObjectManager::UnregisterCollider(GameObject* obj)
+{
+	if (!collisionManager_) return;
+	if (auto* collider = dynamic_cast<ICollider*>(obj)) {
+		collisionManager_->UnregisterCollider(collider);
+	}
+}
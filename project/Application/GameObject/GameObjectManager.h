@@ -34,10 +34,11 @@ public:
 	void Update();
 
 	/// <summary>
-	/// ICollider を継承するオブジェクトを CollisionManager に登録する
-	/// BaseScene::HandleCollisions() から毎フレーム呼ばれる
+	/// ICollider を継承するオブジェクトを登録する CollisionManager を設定する
+	/// 追加時に一度だけ登録し、破棄時に登録を解除する（毎フレームの dynamic_cast・再登録はしない）
+	/// BaseScene のコンストラクタから呼ばれる
 	/// </summary>
-	void AddAllCollidersToManager(CollisionManager* cm);
+	void SetCollisionManager(CollisionManager* cm);
 
 	/// <summary>
 	/// 全オブジェクトの 3D 描画（DrawOffscreen を呼ぶ）
@@ -65,7 +66,12 @@ private:
 	void MergePending();
 	void RemoveDestroyed();
 
+	/// <summary>ICollider を継承していれば CollisionManager に登録・解除する</summary>
+	void RegisterCollider(GameObject* obj);
+	void UnregisterCollider(GameObject* obj);
+
 	std::vector<std::unique_ptr<GameObject>> objects_;
 	std::vector<std::unique_ptr<GameObject>> pendingObjects_;  // Update中の追加バッファ
 	bool isUpdating_ = false;
+	CollisionManager* collisionManager_ = nullptr;
 };
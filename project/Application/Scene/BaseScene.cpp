@@ -3,6 +3,8 @@
 BaseScene::BaseScene(const std::string& sceneName)
 	: sceneName_(sceneName)
 {
+	// Manager内の ICollider は追加時に登録、破棄時に解除される
+	gameObjectManager_.SetCollisionManager(&collisionManager_);
 }
 
 void BaseScene::Initialize()
@@ -52,6 +54,9 @@ void BaseScene::ImGui()
 
 	// Manager外オブジェクトの ImGui
 	OnImGui();
+
+	// 衝突判定（ブロードフェーズの切り替え・統計）
+	collisionManager_.ImGui();
 }
 
 void BaseScene::Finalize()
@@ -62,18 +67,15 @@ void BaseScene::Finalize()
 	// 全GameObject::Finalize()とメモリ解放
 	gameObjectManager_.Clear();
 
-	// prevPairs/currentPairs のリセット（シーン使い回し対策）
+	// 登録と接触の表のリセット（シーン使い回し対策）
 	collisionManager_.Initialize();
 }
 
 void BaseScene::HandleCollisions()
 {
-	// 毎フレームリストをクリアしてから再登録（解放済みポインタの混入防止）
+	// 今フレームだけのコライダーをクリア（Manager内のものは追加時に登録済み）
 	collisionManager_.ClearColliderList();
 
-	// Manager内の ICollider を継承するオブジェクトを全登録
-	gameObjectManager_.AddAllCollidersToManager(&collisionManager_);
-
 	// Manager外コライダーの追加登録（必要なシーンのみ override）
 	OnHandleCollisions();
 
@@ -108,8 +108,8 @@ protected:
 	virtual void OnFinalize() {}
 
 	/// <summary>
-	/// Manager外コライダーの追加登録
-	/// SyncColliders 直後・CollisionManager::Update() 直前に呼ばれる
+	/// Manager外コライダーの追加登録（AddCollider で今フレームだけ追加する）
+	/// CollisionManager::Update() 直前に呼ばれる
 	/// Boss の複数コライダー等が必要なシーンのみ override する
 	/// </summary>
 	virtual void OnHandleCollisions() {}
@@ -120,7 +120,7 @@ protected:
 
 private:
 	/// <summary>
-	/// コライダーリストをクリア → Manager内を登録 → OnHandleCollisions() → 衝突判定
+	/// 今フレームだけのコライダーをクリア → OnHandleCollisions() → 衝突判定
 	/// BaseScene::Update() final から毎フレーム呼ばれる
 	/// </summary>
 	void HandleCollisions();
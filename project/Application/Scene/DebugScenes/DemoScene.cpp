@@ -107,6 +107,7 @@ void DemoScene::OnUpdate()
 	plane_->Update(viewProjectionMatrix_);
 	modelMultiMesh_->Update(viewProjectionMatrix_);
 	modelMultiMaterial_->Update(viewProjectionMatrix_);
+	particleEditor_->Update();
 	particleSystem_->Update(viewProjectionMatrix_);
 
 }
@@ -1,4 +1,5 @@
 #include "Camera.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h"
 #include <numbers>
 
@@ -1,4 +1,5 @@
 #include "DebugCamera.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h"
 #include <cmath>
 #include <numbers>
@@ -0,0 +1,13 @@
+#pragma once
+
+///DirectX12
+#include<d3d12.h>
+#include<wrl.h>
+
+/// <summary>
+/// アップロードヒープにバッファリソースを作成する
+/// </summary>
+/// <param name="device">デバイス</param>
+/// <param name="sizeInBytes">バッファの大きさ（バイト）</param>
+/// <returns>作成したリソース</returns>
+Microsoft::WRL::ComPtr <ID3D12Resource> CreateBufferResource(Microsoft::WRL::ComPtr<ID3D12Device> device, size_t sizeInBytes);
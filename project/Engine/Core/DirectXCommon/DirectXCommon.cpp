@@ -130,6 +130,9 @@ void DirectXCommon::Initialize(WinApp* winApp) {
 	// パーティクル用のPSO
 	MakeParticlePSO();
 
+	// パーティクルの軌跡用のPSO
+	MakeParticleTrailPSO();
+
 	///*-----------------------------------------------------------------------*///
 	//																			//
 	///							ViewportとScissor							   ///
@@ -522,8 +525,9 @@ void DirectXCommon::MakeParticlePSO()
 	// RootSignatureを構築
 	RootSignatureBuilder rsBuilder;
 	rsBuilder.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)		// Material (b0)PS
-		.AddSRV(0, 1, D3D12_SHADER_VISIBILITY_VERTEX)		// Transform (t0)VS
+		.AddRootSRV(0, D3D12_SHADER_VISIBILITY_VERTEX)		// Transform (t0)VS（共有アリーナをオフセット付きアドレスでバインド）
 		.AddSRV(0, 1, D3D12_SHADER_VISIBILITY_PIXEL)		// Texture (t0)PS
+		.AddCBV(0, D3D12_SHADER_VISIBILITY_VERTEX)			// View (b0)VS（ビュープロジェクション・ビルボード行列）
 		.AddStaticSampler(0);								// Sampler (s0)
 
 	// PSO設定を構築（プリセット使用）
@@ -545,6 +549,33 @@ void DirectXCommon::MakeParticlePSO()
 
 }
 
+void DirectXCommon::MakeParticleTrailPSO()
+{
+	// RootSignatureを構築（頂点はワールド座標で作ってあるので、ビュー情報だけ渡す）
+	RootSignatureBuilder rsBuilder;
+	rsBuilder.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)		// Material (b0)PS
+		.AddCBV(0, D3D12_SHADER_VISIBILITY_VERTEX)			// View (b0)VS（ビュープロジェクション行列）
+		.AddSRV(0, 1, D3D12_SHADER_VISIBILITY_PIXEL)		// Texture (t0)PS
+		.AddStaticSampler(0);								// Sampler (s0)
+
+	// PSO設定を構築（プリセット使用）
+	auto psoDesc = PSODescriptor::CreateParticleTrail()
+		.SetVertexShader(L"resources/Shader/Particle/ParticleTrail.VS.hlsl")
+		.SetPixelShader(L"resources/Shader/Particle/ParticleTrail.PS.hlsl");
+
+	// PSO生成
+	auto psoInfo = psoFactory_->CreatePSO(psoDesc, rsBuilder);
+	if (!psoInfo.IsValid()) {
+		Logger::Log(Logger::GetStream(), "DirectXCommon: Failed to create Particle Trail PSO\n");
+		assert(false);
+	}
+
+	particleTrailRootSignature = psoInfo.rootSignature;
+	particleTrailPipelineState = psoInfo.pipelineState;
+
+	Logger::Log(Logger::GetStream(), "Complete create Particle Trail PSO using PSOFactory!!\n");
+}
+
 DirectXCommon::ComPtr<IDxcBlob>DirectXCommon::CompileShader(
 	const std::wstring& filePath,
 	const wchar_t* profile,
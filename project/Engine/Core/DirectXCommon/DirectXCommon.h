@@ -75,6 +75,8 @@ public:
 	ID3D12PipelineState* GetLinePipelineState() const { return linePipelineState.Get(); }
 	ID3D12RootSignature* GetParticleRootSignature() const { return particleRootSignature.Get(); }
 	ID3D12PipelineState* GetParticlePipelineState() const { return particlePipelineState.Get(); }
+	ID3D12RootSignature* GetParticleTrailRootSignature() const { return particleTrailRootSignature.Get(); }
+	ID3D12PipelineState* GetParticleTrailPipelineState() const { return particleTrailPipelineState.Get(); }
 	///参照で返すゲッター？
 	const ComPtr<ID3D12Device>& GetDeviceComPtr() const { return device; }
 	const ComPtr<ID3D12GraphicsCommandList>& GetCommandListComPtr() const { return commandList; }
@@ -168,6 +170,11 @@ private:
 	/// </summary>
 	void MakeParticlePSO();
 
+	/// <summary>
+	/// パーティクルの軌跡描画用のPSOを作成する
+	/// </summary>
+	void MakeParticleTrailPSO();
+
 
 	/// <summary>
 	/// ViewportとScissor
@@ -241,6 +248,10 @@ private:
 	ComPtr<ID3D12RootSignature> particleRootSignature;
 	ComPtr<ID3D12PipelineState> particlePipelineState;
 
+	//パーティクルの軌跡用PSO
+	ComPtr<ID3D12RootSignature> particleTrailRootSignature;
+	ComPtr<ID3D12PipelineState> particleTrailPipelineState;
+
 	//ビューポート
 	D3D12_VIEWPORT viewport{};
 	//シザー矩形
@@ -90,6 +90,27 @@ PSODescriptor PSODescriptor::CreateParticle()
 	return desc;
 }
 
+PSODescriptor PSODescriptor::CreateParticleTrail()
+{
+	PSODescriptor desc;
+
+	// 軌跡用のデフォルト設定（帯は裏返るので両面描画）
+	desc.SetVertexShader(L"resources/Shader/Particle/ParticleTrail.VS.hlsl", L"main")
+		.SetPixelShader(L"resources/Shader/Particle/ParticleTrail.PS.hlsl", L"main")
+		.SetBlendMode(BlendMode::Add)
+		.SetCullMode(CullMode::None)
+		.EnableDepth(true)
+		.EnableDepthWrite(false)
+		.SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE);
+
+	// 軌跡用頂点レイアウト（CPUで組み立てたワールド座標、色はRGBA8）
+	desc.AddInputElement({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT })
+		.AddInputElement({ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM })
+		.AddInputElement({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT });
+
+	return desc;
+}
+
 PSODescriptor PSODescriptor::CreatePostEffect() {
 	PSODescriptor desc;
 
@@ -79,6 +79,11 @@ public:
 	/// <returns></returns>
 	static PSODescriptor CreateParticle();
 
+	/// <summary>
+	/// パーティクルの軌跡（リボン）用のデフォルト設定を作成
+	/// </summary>
+	static PSODescriptor CreateParticleTrail();
+
 	/// <summary>
 	/// ポストエフェクト用のデフォルト設定を作成
 	/// </summary>
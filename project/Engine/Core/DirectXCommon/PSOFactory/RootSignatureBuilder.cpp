@@ -53,6 +53,23 @@ RootSignatureBuilder& RootSignatureBuilder::AddSRV(uint32_t baseShaderRegister,
 	return *this;
 }
 
+RootSignatureBuilder& RootSignatureBuilder::AddRootSRV(uint32_t shaderRegister,
+	D3D12_SHADER_VISIBILITY visibility) {
+	D3D12_ROOT_PARAMETER param{};
+	param.ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	param.Descriptor.ShaderRegister = shaderRegister;
+	param.Descriptor.RegisterSpace = 0;  // デフォルトのレジスタスペース
+	param.ShaderVisibility = visibility;
+
+	rootParameters_.push_back(param);
+
+	Logger::Log(Logger::GetStream(),
+		std::format("RootSignatureBuilder: Added root SRV (t{}) at parameter index {}\n",
+			shaderRegister, rootParameters_.size() - 1));
+
+	return *this;
+}
+
 RootSignatureBuilder& RootSignatureBuilder::AddUAV(uint32_t baseShaderRegister,
 	uint32_t count,
 	D3D12_SHADER_VISIBILITY visibility) {
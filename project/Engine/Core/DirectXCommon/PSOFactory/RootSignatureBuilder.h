@@ -32,6 +32,15 @@ public:
 		uint32_t count,
 		D3D12_SHADER_VISIBILITY visibility);
 
+	/// <summary>
+	/// ShaderResourceViewをルートディスクリプタとして追加
+	/// <para>ディスクリプタヒープを使わず、バッファのGPUアドレスを直接バインドする（構造化バッファ向け）</para>
+	/// </summary>
+	/// <param name="shaderRegister">シェーダーレジスタ番号（t0, t1など）</param>
+	/// <param name="visibility">シェーダーの可視性</param>
+	RootSignatureBuilder& AddRootSRV(uint32_t shaderRegister,
+		D3D12_SHADER_VISIBILITY visibility);
+
 	/// <summary>
 	/// UnorderedAccessViewのDescriptorTableを追加
 	/// </summary>
@@ -0,0 +1,196 @@
+#define NOMINMAX
+#include "JobSystem.h"
+#ifdef USEIMGUI
+#include "ImGui/ImGuiManager.h"
+#endif
+#include "Logger.h"
+#include <algorithm>
+
+namespace {
+	// ジョブ実行中のスレッドか（入れ子のParallelForを逐次実行にするため）
+	thread_local bool tlsInsideJob = false;
+}
+
+JobSystem* JobSystem::GetInstance()
+{
+	static JobSystem instance;
+	return &instance;
+}
+
+JobSystem::~JobSystem()
+{
+	StopWorkers();
+}
+
+void JobSystem::Initialize(uint32_t workerCount)
+{
+	if (isInitialized_) {
+		return;
+	}
+
+	if (workerCount == kAutoWorkerCount) {
+		// メインスレッドも処理に参加するので、コア数-1をワーカーにする
+		uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	StartWorkers(workerCount);
+	isInitialized_ = true;
+
+	Logger::Log(Logger::GetStream(),
+		std::format("JobSystem: Initialized with {} worker threads\n", workerCount));
+}
+
+void JobSystem::Finalize()
+{
+	StopWorkers();
+	isInitialized_ = false;
+}
+
+void JobSystem::SetWorkerCount(uint32_t workerCount)
+{
+	// 実行中のバッチが無いことを保証してから作り直す
+	std::lock_guard<std::mutex> dispatchLock(dispatchMutex_);
+
+	StopWorkers();
+	StartWorkers(workerCount);
+	isInitialized_ = true;
+
+	Logger::Log(Logger::GetStream(),
+		std::format("JobSystem: Worker count changed to {}\n", workerCount));
+}
+
+void JobSystem::ParallelFor(uint32_t count, const std::function<void(uint32_t)>& job)
+{
+	if (count == 0) {
+		return;
+	}
+
+	// 未初期化で呼ばれた場合（ヘッドレス実行など）は自動設定で起動
+	if (!isInitialized_) {
+		Initialize();
+	}
+
+	// ワーカーが居ない・1件だけ・ジョブの中からの呼び出しはその場で実行
+	if (workers_.empty() || count == 1 || tlsInsideJob) {
+		for (uint32_t i = 0; i < count; ++i) {
+			job(i);
+		}
+		return;
+	}
+
+	std::lock_guard<std::mutex> dispatchLock(dispatchMutex_);
+
+	// バッチを公開してワーカーを起こす
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		job_ = &job;
+		jobCount_ = count;
+		nextIndex_.store(0, std::memory_order_relaxed);
+		batchOpen_ = true;
+		++generation_;
+	}
+	wakeCondition_.notify_all();
+
+	// 呼び出し元も処理に参加
+	tlsInsideJob = true;
+	RunBatch();
+	tlsInsideJob = false;
+
+	// すべてのインデックスは取り出し済みなので、処理中のワーカーが終わるのを待つ
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		doneCondition_.wait(lock, [this] { return activeWorkers_ == 0; });
+		batchOpen_ = false;
+		job_ = nullptr;
+	}
+}
+
+void JobSystem::RunBatch()
+{
+	while (true) {
+		uint32_t index = nextIndex_.fetch_add(1, std::memory_order_relaxed);
+		if (index >= jobCount_) {
+			break;
+		}
+		(*job_)(index);
+	}
+}
+
+void JobSystem::WorkerLoop()
+{
+	tlsInsideJob = true;
+
+	uint64_t seenGeneration = 0;
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	while (true) {
+		// 新しいバッチが公開されるか、停止要求が来るまで待機
+		wakeCondition_.wait(lock, [&] {
+			return stop_ || (batchOpen_ && generation_ != seenGeneration);
+		});
+
+		if (stop_) {
+			break;
+		}
+
+		// バッチに参加（参加はロック中のみ行うので、閉じたバッチには入らない）
+		seenGeneration = generation_;
+		++activeWorkers_;
+		lock.unlock();
+
+		RunBatch();
+
+		lock.lock();
+		--activeWorkers_;
+		if (activeWorkers_ == 0) {
+			doneCondition_.notify_all();
+		}
+	}
+}
+
+void JobSystem::StartWorkers(uint32_t workerCount)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = false;
+	}
+
+	workers_.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back(&JobSystem::WorkerLoop, this);
+	}
+}
+
+void JobSystem::StopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	wakeCondition_.notify_all();
+
+	for (auto& worker : workers_) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+	workers_.clear();
+}
+
+void JobSystem::ImGui()
+{
+#ifdef USEIMGUI
+	if (editWorkerCount_ < 0) {
+		editWorkerCount_ = static_cast<int>(GetWorkerCount());
+	}
+
+	ImGui::Text("Worker Threads: %u (+ main thread)", GetWorkerCount());
+	ImGui::SliderInt("Workers", &editWorkerCount_, 0,
+		static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+	ImGui::SameLine();
+	if (ImGui::Button("Apply")) {
+		SetWorkerCount(static_cast<uint32_t>(editWorkerCount_));
+	}
+#endif
+}
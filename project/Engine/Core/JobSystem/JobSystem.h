@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// ジョブシステム（シングルトン）
+/// <para>ワーカースレッドを常駐させ、ParallelForでインデックス単位の処理を分散する</para>
+/// <para>呼び出し元のスレッドも処理に参加し、全インデックスの完了まで戻らない</para>
+/// </summary>
+class JobSystem
+{
+public:
+	// シングルトンインスタンス取得
+	static JobSystem* GetInstance();
+
+	// コピー・ムーブ禁止
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+	JobSystem(JobSystem&&) = delete;
+	JobSystem& operator=(JobSystem&&) = delete;
+
+	/// <summary>
+	/// 初期化（ワーカースレッドを起動）
+	/// </summary>
+	/// <param name="workerCount">ワーカー数（kAutoWorkerCountでコア数-1）</param>
+	void Initialize(uint32_t workerCount = kAutoWorkerCount);
+
+	/// <summary>
+	/// 終了処理（ワーカースレッドを停止）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// [0, count)の各インデックスに対してjobを並列実行し、完了まで待つ
+	/// <para>ジョブの中から呼ばれた場合は入れ子にせずその場で逐次実行する</para>
+	/// </summary>
+	/// <param name="count">インデックス数</param>
+	/// <param name="job">各インデックスで実行する処理</param>
+	void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& job);
+
+	/// <summary>
+	/// ワーカー数を変更（スレッドを作り直す）
+	/// </summary>
+	/// <param name="workerCount">ワーカー数（0で呼び出し元のみの逐次実行）</param>
+	void SetWorkerCount(uint32_t workerCount);
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+	/// <summary>
+	/// ImGui用のデバッグ表示
+	/// </summary>
+	void ImGui();
+
+	// ワーカー数の自動設定（ハードウェアスレッド数-1）
+	static constexpr uint32_t kAutoWorkerCount = UINT32_MAX;
+
+private:
+	JobSystem() = default;
+	~JobSystem();
+
+	/// <summary>
+	/// ワーカースレッドのメインループ
+	/// </summary>
+	void WorkerLoop();
+
+	/// <summary>
+	/// 現在のバッチからインデックスを取り出して実行（取り出せなくなるまで）
+	/// </summary>
+	void RunBatch();
+
+	/// <summary>
+	/// ワーカースレッドを起動
+	/// </summary>
+	void StartWorkers(uint32_t workerCount);
+
+	/// <summary>
+	/// ワーカースレッドを停止
+	/// </summary>
+	void StopWorkers();
+
+	// ワーカースレッド
+	std::vector<std::thread> workers_;
+	bool isInitialized_ = false;
+
+	// ParallelForの同時呼び出しを直列化する
+	std::mutex dispatchMutex_;
+
+	// バッチ状態（mutex_で保護）
+	std::mutex mutex_;
+	std::condition_variable wakeCondition_;		// ワーカーを起こす
+	std::condition_variable doneCondition_;		// 呼び出し元に完了を通知
+	uint64_t generation_ = 0;					// バッチ毎に進める世代
+	uint32_t activeWorkers_ = 0;				// バッチを処理中のワーカー数
+	bool batchOpen_ = false;					// ワーカーが参加できるか
+	bool stop_ = false;							// 停止要求
+
+	// 実行中のバッチ（batchOpen_の間だけ有効）
+	const std::function<void(uint32_t)>* job_ = nullptr;
+	uint32_t jobCount_ = 0;
+	std::atomic<uint32_t> nextIndex_ = 0;
+
+#ifdef USEIMGUI
+	int editWorkerCount_ = -1;	// ImGuiで編集中のワーカー数
+#endif
+};
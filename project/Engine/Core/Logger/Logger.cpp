@@ -1,7 +1,24 @@
 #include "Logger.h"
 #include "StringUtility.h"
+#ifdef _WIN32
 #include <Windows.h>
 #include <strsafe.h>
+#else
+#include <iostream>
+#endif
+
+namespace {
+	/// <summary>
+	/// 出力ウィンドウに出力（Windows 以外のヘッドレス実行では標準エラーに出す）
+	/// </summary>
+	void OutputDebugMessage(const std::string& message) {
+#ifdef _WIN32
+		OutputDebugStringA(message.c_str());
+#else
+		std::cerr << message;
+#endif
+	}
+}
 
 //変数の定義
 std::ofstream Logger::logFileStream_;
@@ -33,7 +50,7 @@ void Logger::Initialize()
 
 	// ファイルが正常に開かれたかチェック
 	if (!logFileStream_.is_open()) {
-		OutputDebugStringA("Error: Could not open log file\n");
+		OutputDebugMessage("Error: Could not open log file\n");
 		return;
 	}
 
@@ -56,7 +73,7 @@ void Logger::Log(const std::string& message) {
 	}
 
 	// 出力ウィンドウに出力
-	OutputDebugStringA(message.c_str());
+	OutputDebugMessage(message);
 
 	// ログファイルに出力
 	if (logFileStream_.is_open()) {
@@ -90,5 +107,5 @@ void Logger::Log(std::ostream& os, const std::string& message) {
 	}
 
 	// 出力ウィンドウにも出力
-	OutputDebugStringA(message.c_str());
+	OutputDebugMessage(message);
 }
\ No newline at end of file
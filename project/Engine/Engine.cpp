@@ -33,6 +33,9 @@ void Engine::InitializeBase(const std::wstring& title) {
 void Engine::InitializeManagers() {
 
 
+	// ジョブシステム初期化（ワーカー数はコア数から自動設定）
+	JobSystem::GetInstance()->Initialize();
+
 	// 入力マネージャー初期化
 	inputManager_ = Input::GetInstance();
 	inputManager_->Initialize(winApp_.get());
@@ -284,6 +287,9 @@ void Engine::Finalize() {
 		inputManager_->Finalize();
 	}
 
+	// ジョブシステム終了処理（ワーカースレッドを停止）
+	JobSystem::GetInstance()->Finalize();
+
 	// モデル終了処理
 	if (modelManager_) {
 		modelManager_->Finalize();
@@ -7,6 +7,7 @@
 #include "WinApp.h"
 #include "DirectXCommon.h"
 #include "Dump.h"
+#include "JobSystem.h"
 
 ///Managers
 #include "Input.h"
@@ -4,7 +4,8 @@
 #include <cassert>
 
 #include "DirectXCommon.h"
-#include "MyFunction.h" // CreateBufferResource用
+#include "MyFunction.h"
+#include "BufferResource.h" // CreateBufferResource用
 
 
 class DirectXCommon; // 前方宣言
@@ -3,7 +3,6 @@
 #include<cassert>
 #include <numbers>
 #include<algorithm>
-#pragma comment(lib,"d3d12.lib")
 /*-----------------------------------------------------------------------*/
 //
 //								計算関数
@@ -11,39 +10,6 @@
 /*-----------------------------------------------------------------------*/
 
 
-Microsoft::WRL::ComPtr <ID3D12Resource> CreateBufferResource(Microsoft::WRL::ComPtr <ID3D12Device> device, size_t sizeInBytes)
-{
-	//リソース用のヒープの設定
-	D3D12_HEAP_PROPERTIES uploadHeapProperties{};
-	uploadHeapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;//UploadHeapを使う
-	//リソースの設定
-	D3D12_RESOURCE_DESC ResourceDesc{};
-	//バッファリソース。テクスチャの場合はまた別の設定をする
-	ResourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-	ResourceDesc.Width = sizeInBytes;//リソースサイズ
-	//バッファの場合はこれらは1にする決まり
-	ResourceDesc.Height = 1;
-	ResourceDesc.DepthOrArraySize = 1;
-	ResourceDesc.MipLevels = 1;
-	ResourceDesc.SampleDesc.Count = 1;
-	//バッファの場合はこれにする決まり
-	ResourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-	//実際にリソースを生成
-	Microsoft::WRL::ComPtr<ID3D12Resource> Resource = nullptr;
-	HRESULT hr = device->CreateCommittedResource(
-		&uploadHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&ResourceDesc,
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(&Resource)
-	);
-	assert(SUCCEEDED(hr));
-
-
-	return Resource;
-}
-
 //	正射影ベクトルを求める関数
 Vector3 Project(const Vector3& v1, const Vector3& v2) {
 	Vector3 project = Multiply(Normalize(v2), Dot(v1, Normalize(v2)));
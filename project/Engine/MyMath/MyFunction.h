@@ -1,10 +1,6 @@
 #pragma once
 #include "MyMath.h"
 
-///DirectX12
-#include<d3d12.h>
-#include<wrl.h>
-
 using namespace MyMath;
 
 /// <summary>
@@ -64,6 +60,23 @@ struct AABB {
 
 };
 
+/// <summary>
+/// OBB(有向境界箱)
+/// </summary>
+struct OBB {
+	Vector3 center;				//中心点
+	Vector3 orientations[3];	//座標軸（正規化・直交）
+	Vector3 size;				//座標軸方向の長さの半分
+};
+
+/// <summary>
+/// カプセル（線分を中心に半径を持たせたもの）
+/// </summary>
+struct CapsuleMath {
+	Segment segment;	//中心線
+	float radius;		//半径
+};
+
 /// <summary>
 /// 座標変換行列
 /// </summary>
@@ -75,9 +88,6 @@ struct TransformationMatrix
 };
 
 
-Microsoft::WRL::ComPtr <ID3D12Resource> CreateBufferResource(Microsoft::WRL::ComPtr<ID3D12Device> device, size_t sizeInBytes);
-
-
 /*-----------------------------------------------------------------------*/
 //
 //								計算関数
@@ -0,0 +1,17 @@
+#include "CounterRandom.h"
+
+uint64_t CounterRandom::HashString(std::string_view text)
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (char c : text) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x100000001B3ull;
+	}
+	return hash;
+}
+
+uint64_t CounterRandom::CombineSeed(uint64_t seed, uint64_t salt)
+{
+	// 似たシード同士でも列が偏らないよう、混ぜてから合成する
+	return Mix(seed ^ Mix(salt + kGoldenGamma));
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+/// <summary>
+/// カウンターベースの乱数生成器（SplitMix64）
+/// <para>値は (シード, カウンター) だけで決まるので、同じシードなら必ず同じ列になる</para>
+/// <para>状態を共有しないためロック不要。シードの合成や、途中から再開したい列に使う</para>
+/// </summary>
+class CounterRandom
+{
+public:
+	CounterRandom() = default;
+	explicit CounterRandom(uint64_t seed) : seed_(seed) {}
+
+	/// <summary>
+	/// シードを設定してカウンターを0に戻す
+	/// </summary>
+	void SetSeed(uint64_t seed) { seed_ = seed; counter_ = 0; }
+	uint64_t GetSeed() const { return seed_; }
+
+	/// <summary>
+	/// カウンター（これまでに生成した数）の取得・設定（リプレイの途中再開用）
+	/// </summary>
+	uint64_t GetCounter() const { return counter_; }
+	void SetCounter(uint64_t counter) { counter_ = counter; }
+
+	/// <summary>
+	/// 64bitの乱数を生成
+	/// </summary>
+	uint64_t NextUInt64() { return At(seed_, counter_++); }
+
+	/// <summary>
+	/// 32bitの乱数を生成
+	/// </summary>
+	uint32_t NextUInt32() { return static_cast<uint32_t>(NextUInt64() >> 32); }
+
+	/// <summary>
+	/// 0.0f以上1.0f未満の乱数を生成
+	/// </summary>
+	float NextFloat() { return static_cast<float>(NextUInt32() >> 8) * (1.0f / 16777216.0f); }
+
+	/// <summary>
+	/// 指定範囲のfloat乱数を生成（min > maxでもよい）
+	/// </summary>
+	float NextFloat(float min, float max) { return min + (max - min) * NextFloat(); }
+
+	/// <summary>
+	/// シードとカウンターから直接値を求める
+	/// </summary>
+	static uint64_t At(uint64_t seed, uint64_t counter) {
+		return Mix(seed + (counter + 1) * kGoldenGamma);
+	}
+
+	/// <summary>
+	/// SplitMix64の混合関数
+	/// </summary>
+	static uint64_t Mix(uint64_t value) {
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+
+	/// <summary>
+	/// 文字列から64bitのハッシュを作る（FNV-1a、名前からシードを作る用）
+	/// </summary>
+	static uint64_t HashString(std::string_view text);
+
+	/// <summary>
+	/// 基準のシードと識別値から別のシードを作る
+	/// </summary>
+	static uint64_t CombineSeed(uint64_t seed, uint64_t salt);
+
+private:
+	static constexpr uint64_t kGoldenGamma = 0x9E3779B97F4A7C15ull;
+
+	uint64_t seed_ = 0;
+	uint64_t counter_ = 0;
+};
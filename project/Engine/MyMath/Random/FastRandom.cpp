@@ -0,0 +1,152 @@
+#define NOMINMAX
+#include "FastRandom.h"
+#include "CounterRandom.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <emmintrin.h>
+
+namespace {
+
+	/// <summary>
+	/// 32bit各レーンの左回転
+	/// </summary>
+	template<int kShift>
+	__m128i RotateLeft(__m128i value) {
+		return _mm_or_si128(_mm_slli_epi32(value, kShift), _mm_srli_epi32(value, 32 - kShift));
+	}
+
+	/// <summary>
+	/// xoshiro128+ を4レーン同時に1ステップ進め、出力を返す
+	/// </summary>
+	__m128i Step(__m128i& s0, __m128i& s1, __m128i& s2, __m128i& s3) {
+		const __m128i result = _mm_add_epi32(s0, s3);
+		const __m128i t = _mm_slli_epi32(s1, 9);
+
+		s2 = _mm_xor_si128(s2, s0);
+		s3 = _mm_xor_si128(s3, s1);
+		s1 = _mm_xor_si128(s1, s2);
+		s0 = _mm_xor_si128(s0, s3);
+		s2 = _mm_xor_si128(s2, t);
+		s3 = RotateLeft<11>(s3);
+
+		return result;
+	}
+
+	/// <summary>
+	/// 上位24bitから[0, 1)のfloatを作る（4レーン）
+	/// </summary>
+	__m128 ToFloat(__m128i value) {
+		return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(value, 8)), _mm_set1_ps(1.0f / 16777216.0f));
+	}
+
+	/// <summary>
+	/// 軸に直交する2軸を作る（Duffらの分岐無しの方法）
+	/// </summary>
+	void MakeBasis(const Vector3& axis, Vector3& tangent, Vector3& bitangent) {
+		const float sign = std::copysign(1.0f, axis.z);
+		const float a = -1.0f / (sign + axis.z);
+		const float b = axis.x * axis.y * a;
+		tangent = { 1.0f + sign * axis.x * axis.x * a, sign * b, -sign * axis.x };
+		bitangent = { b, sign + axis.y * axis.y * a, -axis.y };
+	}
+}
+
+void FastRandom::SetSeed(uint64_t seed)
+{
+	seed_ = seed;
+
+	// SplitMix64の列で状態を埋める（全て0の状態を避ける）
+	CounterRandom seeder(seed);
+	for (uint32_t lane = 0; lane < kLaneCount; ++lane) {
+		for (uint32_t i = 0; i < 4; i += 2) {
+			const uint64_t value = seeder.NextUInt64();
+			state_[i][lane] = static_cast<uint32_t>(value);
+			state_[i + 1][lane] = static_cast<uint32_t>(value >> 32);
+		}
+	}
+	bufferIndex_ = kLaneCount;
+}
+
+void FastRandom::Refill()
+{
+	__m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(state_[0]));
+	__m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(state_[1]));
+	__m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(state_[2]));
+	__m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(state_[3]));
+
+	_mm_store_si128(reinterpret_cast<__m128i*>(buffer_), Step(s0, s1, s2, s3));
+
+	_mm_store_si128(reinterpret_cast<__m128i*>(state_[0]), s0);
+	_mm_store_si128(reinterpret_cast<__m128i*>(state_[1]), s1);
+	_mm_store_si128(reinterpret_cast<__m128i*>(state_[2]), s2);
+	_mm_store_si128(reinterpret_cast<__m128i*>(state_[3]), s3);
+	bufferIndex_ = 0;
+}
+
+void FastRandom::FillFloat(float* out, uint32_t count, float min, float max)
+{
+	const float range = max - min;
+	uint32_t i = 0;
+
+	// バッファに残っている分を先に使い切る（1つずつ取り出した場合と列を揃える）
+	while (i < count && bufferIndex_ < kLaneCount) {
+		out[i++] = min + range * ToFloat(buffer_[bufferIndex_++]);
+	}
+
+	// 4つずつ生成
+	if (count - i >= kLaneCount) {
+		__m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(state_[0]));
+		__m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(state_[1]));
+		__m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(state_[2]));
+		__m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(state_[3]));
+
+		const __m128 minValue = _mm_set1_ps(min);
+		const __m128 rangeValue = _mm_set1_ps(range);
+		for (; i + kLaneCount <= count; i += kLaneCount) {
+			__m128 value = ::ToFloat(Step(s0, s1, s2, s3));
+			_mm_storeu_ps(out + i, _mm_add_ps(minValue, _mm_mul_ps(rangeValue, value)));
+		}
+
+		_mm_store_si128(reinterpret_cast<__m128i*>(state_[0]), s0);
+		_mm_store_si128(reinterpret_cast<__m128i*>(state_[1]), s1);
+		_mm_store_si128(reinterpret_cast<__m128i*>(state_[2]), s2);
+		_mm_store_si128(reinterpret_cast<__m128i*>(state_[3]), s3);
+	}
+
+	// 端数
+	for (; i < count; ++i) {
+		out[i] = NextFloat(min, max);
+	}
+}
+
+Vector3 FastRandom::NextUnitVectorInCone(const Vector3& axis, float halfAngle)
+{
+	Vector3 result;
+	FillUnitVectorsInCone(&result.x, &result.y, &result.z, 1, axis, halfAngle);
+	return result;
+}
+
+void FastRandom::FillUnitVectorsInCone(float* outX, float* outY, float* outZ, uint32_t count,
+	const Vector3& axis, float halfAngle)
+{
+	// cosθ を [cos(半角), 1] で一様にすると球冠上で一様になる
+	FillFloat(outZ, count, 1.0f, std::cos(halfAngle));
+	FillFloat(outY, count, 0.0f, 2.0f * std::numbers::pi_v<float>);
+
+	Vector3 tangent;
+	Vector3 bitangent;
+	MakeBasis(axis, tangent, bitangent);
+
+	for (uint32_t i = 0; i < count; ++i) {
+		const float cosTheta = outZ[i];
+		const float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+		const float phi = outY[i];
+		const float localX = sinTheta * std::cos(phi);
+		const float localY = sinTheta * std::sin(phi);
+
+		outX[i] = tangent.x * localX + bitangent.x * localY + axis.x * cosTheta;
+		outY[i] = tangent.y * localX + bitangent.y * localY + axis.y * cosTheta;
+		outZ[i] = tangent.z * localX + bitangent.z * localY + axis.z * cosTheta;
+	}
+}
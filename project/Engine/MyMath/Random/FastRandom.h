@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include "MyMath.h"
+using namespace MyMath;
+
+/// <summary>
+/// 高速な乱数生成器（xoshiro128+ を4レーン並列で回す）
+/// <para>状態を共有しないのでロック不要。エミッター毎、またはスレッド毎に持たせて使う</para>
+/// <para>Fill系はSSEで4つずつ生成する。1つずつ取り出した場合と同じ列になる</para>
+/// </summary>
+class FastRandom
+{
+public:
+	// std::uniform_int_distribution などに渡せるようにする
+	using result_type = uint32_t;
+
+	FastRandom() { SetSeed(0); }
+	explicit FastRandom(uint64_t seed) { SetSeed(seed); }
+
+	/// <summary>
+	/// シードを設定（SplitMix64で4レーン分の状態に展開する）
+	/// </summary>
+	void SetSeed(uint64_t seed);
+	uint64_t GetSeed() const { return seed_; }
+
+	/// <summary>
+	/// 32bitの乱数を生成
+	/// </summary>
+	uint32_t NextUInt32() {
+		if (bufferIndex_ >= kLaneCount) {
+			Refill();
+		}
+		return buffer_[bufferIndex_++];
+	}
+
+	/// <summary>
+	/// 0.0f以上1.0f未満の乱数を生成
+	/// </summary>
+	float NextFloat() { return ToFloat(NextUInt32()); }
+
+	/// <summary>
+	/// 指定範囲のfloat乱数を生成（min > maxでもよい）
+	/// </summary>
+	float NextFloat(float min, float max) { return min + (max - min) * NextFloat(); }
+
+	/// <summary>
+	/// 軸を中心とした円錐内の単位ベクトルを1つ生成
+	/// </summary>
+	/// <param name="axis">円錐の軸（正規化済み）</param>
+	/// <param name="halfAngle">円錐の半角（ラジアン）</param>
+	Vector3 NextUnitVectorInCone(const Vector3& axis, float halfAngle);
+
+	/// <summary>
+	/// 指定範囲のfloat乱数をcount個まとめて生成
+	/// </summary>
+	/// <param name="out">出力先（count個）</param>
+	void FillFloat(float* out, uint32_t count, float min, float max);
+
+	/// <summary>
+	/// 軸を中心とした円錐内の単位ベクトルをcount個まとめて生成（SoAで出力）
+	/// <para>円錐の底面（球冠）上で一様に分布する</para>
+	/// </summary>
+	/// <param name="outX">X成分の出力先（count個）</param>
+	/// <param name="outY">Y成分の出力先（count個）</param>
+	/// <param name="outZ">Z成分の出力先（count個）</param>
+	/// <param name="axis">円錐の軸（正規化済み）</param>
+	/// <param name="halfAngle">円錐の半角（ラジアン）</param>
+	void FillUnitVectorsInCone(float* outX, float* outY, float* outZ, uint32_t count,
+		const Vector3& axis, float halfAngle);
+
+	// UniformRandomBitGenerator
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+	result_type operator()() { return NextUInt32(); }
+
+private:
+	static constexpr uint32_t kLaneCount = 4;
+
+	/// <summary>
+	/// 上位24bitから[0, 1)のfloatを作る
+	/// </summary>
+	static float ToFloat(uint32_t value) { return static_cast<float>(value >> 8) * (1.0f / 16777216.0f); }
+
+	/// <summary>
+	/// 全レーンを1ステップ進めてバッファを満たす
+	/// </summary>
+	void Refill();
+
+	// xoshiro128+ の状態（state_[i][lane]）
+	alignas(16) uint32_t state_[4][kLaneCount] = {};
+	// 1つずつ取り出す用のバッファ
+	alignas(16) uint32_t buffer_[kLaneCount] = {};
+	uint32_t bufferIndex_ = kLaneCount;
+
+	uint64_t seed_ = 0;
+};
@@ -9,15 +9,27 @@ Random& Random::GetInstance() {
 }
 
 float Random::GenerateFloat(float min, float max) {
-	std::lock_guard<std::mutex> lock(mutex_);
-	std::uniform_real_distribution<float> distribution(min, max);
-	return distribution(randomEngine_);
+	return GetThreadRandom().NextFloat(min, max);
 }
 
 int Random::GenerateInt(int min, int max) {
-	std::lock_guard<std::mutex> lock(mutex_);
 	std::uniform_int_distribution<int> distribution(min, max);
-	return distribution(randomEngine_);
+	return distribution(GetThreadRandom());
+}
+
+uint64_t Random::GenerateSeed() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return randomEngine_();
+}
+
+void Random::GenerateFloats(float* out, uint32_t count, float min, float max) {
+	GetThreadRandom().FillFloat(out, count, min, max);
+}
+
+FastRandom& Random::GetThreadRandom() {
+	// スレッド毎に1つ。初回だけシード生成のためにロックする
+	thread_local FastRandom threadRandom(GenerateSeed());
+	return threadRandom;
 }
 
 float Random::GenerateNormalized() {
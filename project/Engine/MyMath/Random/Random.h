@@ -2,9 +2,11 @@
 #include <random>
 #include <mutex>
 #include "MyMath.h"
+#include "FastRandom.h"
 using namespace MyMath;
 /// <summary>
 /// 乱数生成クラス（シングルトン）
+/// <para>Generate系はスレッド毎の生成器を使うのでロックしない（シードの生成のみロックする）</para>
 /// </summary>
 class Random {
 public:
@@ -81,6 +83,27 @@ public:
 	/// <returns>ランダムなRGB値と指定されたA値を持つカラー</returns>
 	Vector4 GenerateRandomVector4(float alpha = 1.0f);
 
+	/// <summary>
+	/// 64bitのシード値を生成（CounterRandomなど別の生成器の初期化用）
+	/// </summary>
+	/// <returns>シード値</returns>
+	uint64_t GenerateSeed();
+
+	/// <summary>
+	/// 指定範囲のfloat乱数をcount個まとめて生成（スレッド毎の生成器を使う）
+	/// </summary>
+	/// <param name="out">出力先（count個）</param>
+	/// <param name="count">個数</param>
+	/// <param name="min">最小値</param>
+	/// <param name="max">最大値</param>
+	void GenerateFloats(float* out, uint32_t count, float min, float max);
+
+	/// <summary>
+	/// 呼び出したスレッド専用の生成器を取得（初回にGenerateSeedでシードを設定）
+	/// <para>まとめて生成するFill系を直接使いたい場合に使う</para>
+	/// </summary>
+	FastRandom& GetThreadRandom();
+
 private:
 	Random();
 	~Random() = default;
@@ -95,7 +118,6 @@ private:
 	std::random_device seedGenerator_;
 	std::mt19937_64 randomEngine_;
 
-	// スレッドセーフティのためのミューテックス
-	//マルチスレッド環境で安全にするためのものらしい?
+	// シード生成用エンジンを守るミューテックス（スレッド毎の生成器の初期化時のみ使う）
 	std::mutex mutex_;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #define NOMINMAX
 #include "LightManager.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h"
 #include <format>
 #include <algorithm>
@@ -1,4 +1,5 @@
 #include "LineRenderer.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h"
 #include "Logger.h"
 #include <algorithm>
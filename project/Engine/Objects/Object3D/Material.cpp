@@ -1,4 +1,5 @@
 #include "Material.h"
+#include "BufferResource.h"
 
 void Material::Initialize(DirectXCommon* dxCommon) {
 	// マテリアル用のリソースを作成
@@ -1,4 +1,5 @@
 #include "Mesh.h"
+#include "BufferResource.h"
 #include<numbers>
 void Mesh::Initialize(DirectXCommon* dxCommon, MeshType meshType)
 {
@@ -1,4 +1,5 @@
 #include "Transform3D.h"
+#include "BufferResource.h"
 #include "GameTimer.h"
 
 void Transform3D::Initialize(DirectXCommon* dxCommon)
@@ -14,15 +14,10 @@ void AccelerationField::Initialize(DirectXCommon* dxCommon)
 	debugColor_ = { 0.0f, 1.0f, 0.0f, 1.0f };
 }
 
-bool AccelerationField::ApplyEffect(ParticleState& particle, float deltaTime)
+void AccelerationField::ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const
 {
-	// パーティクルに加速度を適用
-	particle.velocity.x += acceleration_.x * deltaTime;
-	particle.velocity.y += acceleration_.y * deltaTime;
-	particle.velocity.z += acceleration_.z * deltaTime;
-
-	// 加速度フィールドではパーティクルを削除しない
-	return false;
+	// AABB内判定と加速度の加算をまとめて行う
+	FieldKernels::ApplyAcceleration(span, GetWorldAABB(), acceleration_, deltaTime);
 }
 
 bool AccelerationField::IsInField(const Vector3& point) const
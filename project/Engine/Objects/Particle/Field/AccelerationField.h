@@ -19,12 +19,16 @@ public:
 	void Initialize(DirectXCommon* dxCommon) override;
 
 	/// <summary>
-	/// パーティクルに効果を適用
+	/// AABB内のパーティクルにまとめて加速度を適用（削除はしない）
 	/// </summary>
-	/// <param name="particle">対象のパーティクル</param>
+	/// <param name="span">対象のパーティクル範囲</param>
 	/// <param name="deltaTime">デルタタイム</param>
-	/// <returns>パーティクルを削除すべき場合true（加速度フィールドは常にfalse）</returns>
-	bool ApplyEffect(ParticleState& particle, float deltaTime) override;
+	void ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const override;
+
+	/// <summary>
+	/// 効果範囲（ワールド座標のAABB）
+	/// </summary>
+	AABB GetWorldBounds() const override { return GetWorldAABB(); }
 
 	/// <summary>
 	/// 指定した点がフィールド内にあるかチェック
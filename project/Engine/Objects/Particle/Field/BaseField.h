@@ -6,10 +6,21 @@
 #include "Transform3D.h"
 #include "ParticleState.h"
 #include "MyFunction.h"
+#include "FieldKernels.h"
 #include "DebugDrawLineSystem.h"
 
 using json = nlohmann::json;
 
+class BaseField;
+
+/// <summary>
+/// ブロードフェーズ用のフィールド情報（境界はフレーム毎に一度だけ計算する）
+/// </summary>
+struct FieldBroadphaseEntry {
+	const BaseField* field = nullptr;
+	AABB bounds;
+};
+
 /// <summary>
 /// フィールドの基底クラス
 /// <para>パーティクルに影響を与えるフィールドの共通インターフェース</para>
@@ -33,12 +44,20 @@ public:
 	virtual void Update(float deltaTime);
 
 	/// <summary>
-	/// パーティクルに効果を適用（純粋仮想関数）
+	/// 範囲内のパーティクルにまとめて効果を適用（純粋仮想関数）
+	/// <para>パーティクル毎ではなくフィールド1つにつき1回呼ばれ、範囲判定も含めて型ごとのカーネルで処理する</para>
+	/// <para>削除すべきパーティクルにはspan.killFlagsを立てる。既にフラグが立っているものは対象外</para>
+	/// <para>ワーカースレッドから並列に呼ばれるため、フィールド自身の状態は書き換えないこと</para>
 	/// </summary>
-	/// <param name="particle">対象のパーティクル</param>
+	/// <param name="span">対象のパーティクル範囲</param>
 	/// <param name="deltaTime">デルタタイム</param>
-	/// <returns>パーティクルを削除すべき場合true</returns>
-	virtual bool ApplyEffect(ParticleState& particle, float deltaTime) = 0;
+	virtual void ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const = 0;
+
+	/// <summary>
+	/// 効果範囲を含むワールド座標のAABB（純粋仮想関数）
+	/// <para>ブロードフェーズでグループ・チャンク単位の判定に使う</para>
+	/// </summary>
+	virtual AABB GetWorldBounds() const = 0;
 
 	/// <summary>
 	/// 指定した点がフィールド内にあるかチェック（純粋仮想関数）
@@ -0,0 +1,140 @@
+#define NOMINMAX
+#include "CurlNoiseVolume.h"
+#include "Random/CounterRandom.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+	// ポテンシャル場の粗い格子の1辺（kResolutionを割り切る数、細かさの基準）
+	constexpr uint32_t kLatticeSize = 8;
+	constexpr uint32_t kCellsPerLattice = CurlNoiseVolume::kResolution / kLatticeSize;
+
+	size_t CellIndex(uint32_t x, uint32_t y, uint32_t z) {
+		return (static_cast<size_t>(z & CurlNoiseVolume::kMask) * CurlNoiseVolume::kResolution + (y & CurlNoiseVolume::kMask))
+			* CurlNoiseVolume::kResolution + (x & CurlNoiseVolume::kMask);
+	}
+
+	float SmoothStep(float t) {
+		return t * t * (3.0f - 2.0f * t);
+	}
+
+	/// <summary>
+	/// 周期的なバリューノイズ（粗い格子の乱数を滑らかに補間）
+	/// </summary>
+	float ValueNoise(const std::vector<float>& lattice, uint32_t x, uint32_t y, uint32_t z) {
+		const uint32_t lx = x / kCellsPerLattice;
+		const uint32_t ly = y / kCellsPerLattice;
+		const uint32_t lz = z / kCellsPerLattice;
+		const float fx = SmoothStep(static_cast<float>(x % kCellsPerLattice) / kCellsPerLattice);
+		const float fy = SmoothStep(static_cast<float>(y % kCellsPerLattice) / kCellsPerLattice);
+		const float fz = SmoothStep(static_cast<float>(z % kCellsPerLattice) / kCellsPerLattice);
+
+		auto at = [&](uint32_t ix, uint32_t iy, uint32_t iz) {
+			return lattice[((iz % kLatticeSize) * kLatticeSize + (iy % kLatticeSize)) * kLatticeSize + (ix % kLatticeSize)];
+		};
+		auto lerp = [](float a, float b, float t) { return a + (b - a) * t; };
+
+		const float x00 = lerp(at(lx, ly, lz), at(lx + 1, ly, lz), fx);
+		const float x10 = lerp(at(lx, ly + 1, lz), at(lx + 1, ly + 1, lz), fx);
+		const float x01 = lerp(at(lx, ly, lz + 1), at(lx + 1, ly, lz + 1), fx);
+		const float x11 = lerp(at(lx, ly + 1, lz + 1), at(lx + 1, ly + 1, lz + 1), fx);
+		return lerp(lerp(x00, x10, fy), lerp(x01, x11, fy), fz);
+	}
+}
+
+void CurlNoiseVolume::Build(uint64_t seed)
+{
+	seed_ = seed;
+	constexpr uint32_t n = kResolution;
+	constexpr size_t cellCount = static_cast<size_t>(n) * n * n;
+
+	// ポテンシャル場（3成分それぞれ別の乱数列）
+	std::vector<float> potential[3];
+	std::vector<float> lattice(kLatticeSize * kLatticeSize * kLatticeSize);
+	for (uint32_t axis = 0; axis < 3; ++axis) {
+		for (size_t i = 0; i < lattice.size(); ++i) {
+			const uint64_t bits = CounterRandom::At(CounterRandom::CombineSeed(seed, axis), i);
+			lattice[i] = static_cast<float>(bits >> 40) * (2.0f / 16777216.0f) - 1.0f;
+		}
+
+		potential[axis].resize(cellCount);
+		for (uint32_t z = 0; z < n; ++z) {
+			for (uint32_t y = 0; y < n; ++y) {
+				for (uint32_t x = 0; x < n; ++x) {
+					potential[axis][CellIndex(x, y, z)] = ValueNoise(lattice, x, y, z);
+				}
+			}
+		}
+	}
+
+	// 中心差分で回転を計算（格子は周期的なので端は反対側を参照）
+	cells_.assign(cellCount * 4, 0.0f);
+	float maxLengthSq = 0.0f;
+	for (uint32_t z = 0; z < n; ++z) {
+		for (uint32_t y = 0; y < n; ++y) {
+			for (uint32_t x = 0; x < n; ++x) {
+				auto derivative = [&](uint32_t axis, int dx, int dy, int dz) {
+					return (potential[axis][CellIndex(x + dx, y + dy, z + dz)] - potential[axis][CellIndex(x - dx, y - dy, z - dz)]) * 0.5f;
+				};
+				float* cell = cells_.data() + CellIndex(x, y, z) * 4;
+				cell[0] = derivative(2, 0, 1, 0) - derivative(1, 0, 0, 1);
+				cell[1] = derivative(0, 0, 0, 1) - derivative(2, 1, 0, 0);
+				cell[2] = derivative(1, 1, 0, 0) - derivative(0, 0, 1, 0);
+				maxLengthSq = std::max(maxLengthSq, cell[0] * cell[0] + cell[1] * cell[1] + cell[2] * cell[2]);
+			}
+		}
+	}
+
+	// 強さをパラメータで扱いやすいよう正規化
+	if (maxLengthSq > 0.0f) {
+		const float scale = 1.0f / std::sqrt(maxLengthSq);
+		for (float& value : cells_) {
+			value *= scale;
+		}
+	}
+}
+
+void CurlNoiseVolume::Sample(float x, float y, float z, float out[3]) const
+{
+	const float fx = std::floor(x);
+	const float fy = std::floor(y);
+	const float fz = std::floor(z);
+	const float tx = x - fx;
+	const float ty = y - fy;
+	const float tz = z - fz;
+	const uint32_t ix = static_cast<uint32_t>(static_cast<int32_t>(fx));
+	const uint32_t iy = static_cast<uint32_t>(static_cast<int32_t>(fy));
+	const uint32_t iz = static_cast<uint32_t>(static_cast<int32_t>(fz));
+
+	out[0] = out[1] = out[2] = 0.0f;
+	for (uint32_t corner = 0; corner < 8; ++corner) {
+		const uint32_t cx = corner & 1;
+		const uint32_t cy = (corner >> 1) & 1;
+		const uint32_t cz = (corner >> 2) & 1;
+		const float weight = (cx ? tx : 1.0f - tx) * (cy ? ty : 1.0f - ty) * (cz ? tz : 1.0f - tz);
+		const float* cell = cells_.data() + CellIndex(ix + cx, iy + cy, iz + cz) * 4;
+		out[0] += cell[0] * weight;
+		out[1] += cell[1] * weight;
+		out[2] += cell[2] * weight;
+	}
+}
+
+std::shared_ptr<const CurlNoiseVolume> CurlNoiseVolume::GetShared(uint64_t seed)
+{
+	// 同じシードのフィールドは1つの格子を共有する（1つ約512KB）
+	static std::mutex mutex;
+	static std::unordered_map<uint64_t, std::weak_ptr<const CurlNoiseVolume>> cache;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (auto existing = cache[seed].lock()) {
+		return existing;
+	}
+
+	auto volume = std::make_shared<CurlNoiseVolume>();
+	volume->Build(seed);
+	cache[seed] = volume;
+	return volume;
+}
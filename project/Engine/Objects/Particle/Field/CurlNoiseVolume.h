@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// カールノイズの3Dテクスチャ（CPU側で事前計算する周期的な格子）
+/// <para>ポテンシャル場の回転（curl）なので発散がなく、パーティクルが渦を巻くように流れる</para>
+/// <para>各セルはx,y,z,0の4要素で並べ、SIMDで1セルずつ読めるようにしている</para>
+/// <para>DirectXに依存しないので、ヘッドレスでも使用できる</para>
+/// </summary>
+class CurlNoiseVolume
+{
+public:
+	// 1辺のセル数（2の累乗、端は反対側とつながる）
+	static constexpr uint32_t kResolution = 32;
+	static constexpr uint32_t kMask = kResolution - 1;
+
+	/// <summary>
+	/// シードから格子を作成（最大の長さが1になるよう正規化する）
+	/// </summary>
+	/// <param name="seed">乱数シード</param>
+	void Build(uint64_t seed);
+
+	/// <summary>
+	/// セルの先頭（x + y * kResolution + z * kResolution^2 番目のセルが4要素）
+	/// </summary>
+	const float* GetCells() const { return cells_.data(); }
+
+	/// <summary>
+	/// 格子座標での値をスカラーで補間（確認・デバッグ用）
+	/// </summary>
+	void Sample(float x, float y, float z, float out[3]) const;
+
+	uint64_t GetSeed() const { return seed_; }
+
+	/// <summary>
+	/// シード毎に共有する格子を取得（初回のみ作成、メインスレッドから呼ぶ）
+	/// </summary>
+	static std::shared_ptr<const CurlNoiseVolume> GetShared(uint64_t seed);
+
+private:
+	std::vector<float> cells_;	// 4要素 × kResolution^3
+	uint64_t seed_ = 0;
+};
@@ -0,0 +1,98 @@
+#include "DragField.h"
+#include "ImGui/ImGuiManager.h"
+#include "Collision.h"
+#include <cmath>
+
+void DragField::Initialize(DirectXCommon* dxCommon)
+{
+	// 基底クラスの初期化を呼ぶ
+	BaseField::Initialize(dxCommon);
+
+	// AABBを正しい状態に
+	FixAABBMinMax(area_);
+
+	// デフォルトのデバッグカラー（灰色）
+	debugColor_ = { 0.6f, 0.6f, 0.6f, 1.0f };
+}
+
+void DragField::ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const
+{
+	// AABB内判定と速度の減衰をまとめて行う
+	FieldKernels::ApplyDrag(span, GetWorldAABB(), coefficient_, deltaTime);
+}
+
+bool DragField::IsInField(const Vector3& point) const
+{
+	// 点がAABB内にあるかチェック
+	return Collision::IsCollision(GetWorldAABB(), point);
+}
+
+AABB DragField::GetWorldAABB() const
+{
+	// ローカル座標のAABBをワールド座標に変換
+	Vector3 fieldPos = fieldTransform_.GetPosition();
+	AABB worldAABB;
+	worldAABB.min = { fieldPos.x + area_.min.x, fieldPos.y + area_.min.y, fieldPos.z + area_.min.z };
+	worldAABB.max = { fieldPos.x + area_.max.x, fieldPos.y + area_.max.y, fieldPos.z + area_.max.z };
+	return worldAABB;
+}
+
+void DragField::CreateDebugShape()
+{
+	debugDrawLineSystem_->DrawAABB(GetWorldAABB(), debugColor_);
+}
+
+void DragField::ImGui()
+{
+#ifdef USEIMGUI
+	if (ImGui::TreeNode(name_.c_str())) {
+		// 基底クラスのImGuiを呼ぶ（共通設定）
+		BaseField::ImGui();
+
+		// 抵抗フィールド固有の設定
+		if (ImGui::CollapsingHeader("Drag Settings", ImGuiTreeNodeFlags_DefaultOpen)) {
+			ImGui::DragFloat("Coefficient", &coefficient_, 0.01f, 0.0f, 50.0f);
+			ImGui::Text("Speed after 1s: x%.3f", std::exp(-coefficient_));
+			ImGui::Separator();
+		}
+
+		// AABB範囲設定
+		if (ImGui::CollapsingHeader("Area (AABB)")) {
+			bool aabbChanged = false;
+			aabbChanged |= ImGui::DragFloat3("Min", &area_.min.x, 0.1f);
+			aabbChanged |= ImGui::DragFloat3("Max", &area_.max.x, 0.1f);
+			if (aabbChanged) {
+				FixAABBMinMax(area_);
+			}
+		}
+
+		ImGui::TreePop();
+	}
+#endif
+}
+
+json DragField::SerializeParameters() const
+{
+	return json{
+		{"coefficient", coefficient_},
+		{"areaMin", {area_.min.x, area_.min.y, area_.min.z}},
+		{"areaMax", {area_.max.x, area_.max.y, area_.max.z}}
+	};
+}
+
+void DragField::DeserializeParameters(const json& j)
+{
+	coefficient_ = j.value("coefficient", coefficient_);
+
+	if (j.contains("areaMin")) {
+		auto minVec = j["areaMin"];
+		area_.min = { minVec[0], minVec[1], minVec[2] };
+	}
+
+	if (j.contains("areaMax")) {
+		auto maxVec = j["areaMax"];
+		area_.max = { maxVec[0], maxVec[1], maxVec[2] };
+	}
+
+	FixAABBMinMax(area_);
+}
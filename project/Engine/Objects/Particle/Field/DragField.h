@@ -0,0 +1,88 @@
+#pragma once
+#include "BaseField.h"
+#include "DebugDrawLineSystem.h"
+
+/// <summary>
+/// 抵抗フィールド
+/// <para>AABB範囲内のパーティクルの速度を減衰させる（煙・水中の表現用）</para>
+/// </summary>
+class DragField : public BaseField
+{
+public:
+	DragField() = default;
+	~DragField() override = default;
+
+	/// <summary>
+	/// フィールドの初期化
+	/// </summary>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	void Initialize(DirectXCommon* dxCommon) override;
+
+	/// <summary>
+	/// AABB内のパーティクルの速度をまとめて減衰（削除はしない）
+	/// </summary>
+	/// <param name="span">対象のパーティクル範囲</param>
+	/// <param name="deltaTime">デルタタイム</param>
+	void ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const override;
+
+	/// <summary>
+	/// 効果範囲（ワールド座標のAABB）
+	/// </summary>
+	AABB GetWorldBounds() const override { return GetWorldAABB(); }
+
+	/// <summary>
+	/// 指定した点がフィールド内にあるかチェック
+	/// </summary>
+	/// <param name="point">チェックする点の座標</param>
+	/// <returns>範囲内ならtrue</returns>
+	bool IsInField(const Vector3& point) const override;
+
+	/// <summary>
+	/// ImGui用のデバッグ表示
+	/// </summary>
+	void ImGui() override;
+
+	/// <summary>
+	/// フィールドタイプ名
+	/// </summary>
+	const char* GetTypeName() const override { return "DragField"; }
+
+	/// <summary>
+	/// パラメータをJSONにシリアライズ
+	/// </summary>
+	json SerializeParameters() const override;
+
+	/// <summary>
+	/// JSONからパラメータをデシリアライズ
+	/// </summary>
+	void DeserializeParameters(const json& j) override;
+
+	// 減衰係数（1秒あたり、速度は exp(-係数 * 秒) 倍になる）
+	void SetCoefficient(float coefficient) { coefficient_ = coefficient; }
+	float GetCoefficient() const { return coefficient_; }
+
+	// 効果範囲（AABB）の設定（ローカル座標）
+	void SetArea(const AABB& aabb) { area_ = aabb; FixAABBMinMax(area_); }
+	const AABB& GetArea() const { return area_; }
+
+	/// <summary>
+	/// ワールド座標でのAABBを取得
+	/// </summary>
+	AABB GetWorldAABB() const;
+
+protected:
+	/// <summary>
+	/// AABBのデバッグ線を作成
+	/// </summary>
+	void CreateDebugShape() override;
+
+private:
+	// 抵抗フィールド固有のパラメータ
+	float coefficient_ = 1.0f;	// 減衰係数
+
+	// 効果範囲（ローカル座標でのAABB）
+	AABB area_ = {
+		{-2.0f, -2.0f, -2.0f},	// min
+		{2.0f, 2.0f, 2.0f}		// max
+	};
+};
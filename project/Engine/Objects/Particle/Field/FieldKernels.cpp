@@ -0,0 +1,372 @@
+#define NOMINMAX
+#include "FieldKernels.h"
+#include "CurlNoiseVolume.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <emmintrin.h>
+
+namespace {
+
+	// SIMDで一度に処理する要素数（SSE: float x4）
+	constexpr uint32_t kSimdWidth = 4;
+
+	/// <summary>
+	/// 処理終端をSIMD幅に切り上げる
+	/// </summary>
+	uint32_t AlignedEnd(uint32_t end) {
+		return (end + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+	}
+
+	/// <summary>
+	/// 死亡フラグが立っていないレーンを全ビット1にしたマスク
+	/// </summary>
+	__m128 AliveMask(const uint8_t* killFlags, uint32_t i) {
+		__m128 flags = _mm_set_ps(killFlags[i + 3], killFlags[i + 2], killFlags[i + 1], killFlags[i + 0]);
+		return _mm_cmpeq_ps(flags, _mm_setzero_ps());
+	}
+
+	/// <summary>
+	/// マスクが立っているレーンの死亡フラグを1にする
+	/// </summary>
+	void WriteKillMask(uint8_t* killFlags, uint32_t i, __m128 mask) {
+		int bits = _mm_movemask_ps(mask);
+		if (bits == 0) {
+			return;
+		}
+		for (uint32_t lane = 0; lane < kSimdWidth; ++lane) {
+			if (bits & (1 << lane)) {
+				killFlags[i + lane] = 1;
+			}
+		}
+	}
+
+	/// <summary>
+	/// v += mask ? add : 0
+	/// </summary>
+	void MaskedAdd(float* v, uint32_t i, __m128 add, __m128 mask) {
+		_mm_storeu_ps(v + i, _mm_add_ps(_mm_loadu_ps(v + i), _mm_and_ps(add, mask)));
+	}
+}
+
+void FieldKernels::ApplyAcceleration(const ParticleFieldSpan& span, const AABB& area, const Vector3& acceleration, float deltaTime)
+{
+	const __m128 minX = _mm_set1_ps(area.min.x);
+	const __m128 minY = _mm_set1_ps(area.min.y);
+	const __m128 minZ = _mm_set1_ps(area.min.z);
+	const __m128 maxX = _mm_set1_ps(area.max.x);
+	const __m128 maxY = _mm_set1_ps(area.max.y);
+	const __m128 maxZ = _mm_set1_ps(area.max.z);
+
+	// 加速度 * デルタタイム は全パーティクル共通
+	const __m128 addX = _mm_set1_ps(acceleration.x * deltaTime);
+	const __m128 addY = _mm_set1_ps(acceleration.y * deltaTime);
+	const __m128 addZ = _mm_set1_ps(acceleration.z * deltaTime);
+
+	const uint32_t end = AlignedEnd(span.end);
+	for (uint32_t i = span.begin; i < end; i += kSimdWidth) {
+		__m128 x = _mm_loadu_ps(span.positionX + i);
+		__m128 y = _mm_loadu_ps(span.positionY + i);
+		__m128 z = _mm_loadu_ps(span.positionZ + i);
+
+		// AABB内か（境界を含む）
+		__m128 inside = _mm_and_ps(_mm_cmpge_ps(x, minX), _mm_cmple_ps(x, maxX));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(y, minY), _mm_cmple_ps(y, maxY)));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(z, minZ), _mm_cmple_ps(z, maxZ)));
+
+		__m128 mask = _mm_and_ps(inside, AliveMask(span.killFlags, i));
+		if (_mm_movemask_ps(mask) == 0) {
+			continue;
+		}
+
+		MaskedAdd(span.velocityX, i, addX, mask);
+		MaskedAdd(span.velocityY, i, addY, mask);
+		MaskedAdd(span.velocityZ, i, addZ, mask);
+	}
+}
+
+void FieldKernels::ApplyGravity(const ParticleFieldSpan& span, const Vector3& center, float strength,
+	float effectRadius, float deleteRadius, float deltaTime)
+{
+	const __m128 centerX = _mm_set1_ps(center.x);
+	const __m128 centerY = _mm_set1_ps(center.y);
+	const __m128 centerZ = _mm_set1_ps(center.z);
+	const __m128 effect = _mm_set1_ps(effectRadius);
+	const __m128 invEffect = _mm_set1_ps(effectRadius > 0.0f ? 1.0f / effectRadius : 0.0f);
+	const __m128 remove = _mm_set1_ps(deleteRadius);
+	const __m128 strengthDt = _mm_set1_ps(strength * deltaTime);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+
+	const uint32_t end = AlignedEnd(span.end);
+	for (uint32_t i = span.begin; i < end; i += kSimdWidth) {
+		// パーティクルからフィールド中心へのベクトル
+		__m128 toX = _mm_sub_ps(centerX, _mm_loadu_ps(span.positionX + i));
+		__m128 toY = _mm_sub_ps(centerY, _mm_loadu_ps(span.positionY + i));
+		__m128 toZ = _mm_sub_ps(centerZ, _mm_loadu_ps(span.positionZ + i));
+
+		__m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(toX, toX), _mm_mul_ps(toY, toY)), _mm_mul_ps(toZ, toZ));
+		__m128 distance = _mm_sqrt_ps(distanceSq);
+
+		// 効果範囲内かつ生存しているレーン
+		__m128 inside = _mm_and_ps(_mm_cmple_ps(distance, effect), AliveMask(span.killFlags, i));
+		if (_mm_movemask_ps(inside) == 0) {
+			continue;
+		}
+
+		// 削除範囲内は削除
+		__m128 kill = _mm_and_ps(inside, _mm_cmplt_ps(distance, remove));
+		WriteKillMask(span.killFlags, i, kill);
+
+		// 残りに重力を加える（距離0は方向が定まらないので除外）
+		__m128 apply = _mm_andnot_ps(kill, _mm_and_ps(inside, _mm_cmpgt_ps(distance, zero)));
+		if (_mm_movemask_ps(apply) == 0) {
+			continue;
+		}
+
+		// 距離に応じた重力の強さ（中心に近いほど強い）
+		__m128 factor = _mm_sub_ps(one, _mm_mul_ps(distance, invEffect));
+		__m128 force = _mm_mul_ps(strengthDt, _mm_mul_ps(factor, factor));
+
+		// 正規化した方向 * 力（0除算のレーンはマスクで捨てる）
+		__m128 scale = _mm_div_ps(force, distance);
+		MaskedAdd(span.velocityX, i, _mm_mul_ps(toX, scale), apply);
+		MaskedAdd(span.velocityY, i, _mm_mul_ps(toY, scale), apply);
+		MaskedAdd(span.velocityZ, i, _mm_mul_ps(toZ, scale), apply);
+	}
+}
+
+void FieldKernels::ApplyVortex(const ParticleFieldSpan& span, const Vector3& center, const Vector3& axis, float strength,
+	float pullStrength, float radius, float halfHeight, float deltaTime)
+{
+	const __m128 centerX = _mm_set1_ps(center.x);
+	const __m128 centerY = _mm_set1_ps(center.y);
+	const __m128 centerZ = _mm_set1_ps(center.z);
+	const __m128 axisX = _mm_set1_ps(axis.x);
+	const __m128 axisY = _mm_set1_ps(axis.y);
+	const __m128 axisZ = _mm_set1_ps(axis.z);
+	const __m128 radiusSq = _mm_set1_ps(radius * radius);
+	const __m128 invRadius = _mm_set1_ps(radius > 0.0f ? 1.0f / radius : 0.0f);
+	const __m128 height = _mm_set1_ps(halfHeight);
+	const __m128 strengthDt = _mm_set1_ps(strength * deltaTime);
+	const __m128 pullDt = _mm_set1_ps(pullStrength * deltaTime);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+
+	const uint32_t end = AlignedEnd(span.end);
+	for (uint32_t i = span.begin; i < end; i += kSimdWidth) {
+		// 中心からのベクトルを軸方向と軸に垂直な成分に分ける
+		__m128 toX = _mm_sub_ps(_mm_loadu_ps(span.positionX + i), centerX);
+		__m128 toY = _mm_sub_ps(_mm_loadu_ps(span.positionY + i), centerY);
+		__m128 toZ = _mm_sub_ps(_mm_loadu_ps(span.positionZ + i), centerZ);
+		__m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(toX, axisX), _mm_mul_ps(toY, axisY)), _mm_mul_ps(toZ, axisZ));
+		__m128 radialX = _mm_sub_ps(toX, _mm_mul_ps(axisX, along));
+		__m128 radialY = _mm_sub_ps(toY, _mm_mul_ps(axisY, along));
+		__m128 radialZ = _mm_sub_ps(toZ, _mm_mul_ps(axisZ, along));
+		__m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(radialX, radialX), _mm_mul_ps(radialY, radialY)), _mm_mul_ps(radialZ, radialZ));
+
+		// 円柱内（軸上は方向が定まらないので除外）かつ生存しているレーン
+		__m128 inside = _mm_and_ps(_mm_cmple_ps(distanceSq, radiusSq), _mm_cmple_ps(_mm_andnot_ps(signMask, along), height));
+		inside = _mm_and_ps(inside, _mm_cmpgt_ps(distanceSq, zero));
+		__m128 mask = _mm_and_ps(inside, AliveMask(span.killFlags, i));
+		if (_mm_movemask_ps(mask) == 0) {
+			continue;
+		}
+
+		__m128 distance = _mm_sqrt_ps(distanceSq);
+		__m128 invDistance = _mm_div_ps(one, _mm_max_ps(distance, _mm_set1_ps(1.0e-6f)));
+		__m128 falloff = _mm_max_ps(_mm_sub_ps(one, _mm_mul_ps(distance, invRadius)), zero);
+
+		// 接線方向 = 軸 × 軸からの方向
+		__m128 swirl = _mm_mul_ps(_mm_mul_ps(strengthDt, falloff), invDistance);
+		__m128 pull = _mm_mul_ps(_mm_mul_ps(pullDt, falloff), invDistance);
+		__m128 tangentX = _mm_sub_ps(_mm_mul_ps(axisY, radialZ), _mm_mul_ps(axisZ, radialY));
+		__m128 tangentY = _mm_sub_ps(_mm_mul_ps(axisZ, radialX), _mm_mul_ps(axisX, radialZ));
+		__m128 tangentZ = _mm_sub_ps(_mm_mul_ps(axisX, radialY), _mm_mul_ps(axisY, radialX));
+
+		MaskedAdd(span.velocityX, i, _mm_sub_ps(_mm_mul_ps(tangentX, swirl), _mm_mul_ps(radialX, pull)), mask);
+		MaskedAdd(span.velocityY, i, _mm_sub_ps(_mm_mul_ps(tangentY, swirl), _mm_mul_ps(radialY, pull)), mask);
+		MaskedAdd(span.velocityZ, i, _mm_sub_ps(_mm_mul_ps(tangentZ, swirl), _mm_mul_ps(radialZ, pull)), mask);
+	}
+}
+
+void FieldKernels::ApplyTurbulence(const ParticleFieldSpan& span, const AABB& area, const CurlNoiseVolume& volume,
+	float frequency, const Vector3& offset, float strength, float deltaTime)
+{
+	const __m128 minX = _mm_set1_ps(area.min.x);
+	const __m128 minY = _mm_set1_ps(area.min.y);
+	const __m128 minZ = _mm_set1_ps(area.min.z);
+	const __m128 maxX = _mm_set1_ps(area.max.x);
+	const __m128 maxY = _mm_set1_ps(area.max.y);
+	const __m128 maxZ = _mm_set1_ps(area.max.z);
+	const __m128 scale = _mm_set1_ps(frequency);
+	const __m128 offsetX = _mm_set1_ps(offset.x);
+	const __m128 offsetY = _mm_set1_ps(offset.y);
+	const __m128 offsetZ = _mm_set1_ps(offset.z);
+	const __m128 strengthDt = _mm_set1_ps(strength * deltaTime);
+	const __m128i wrap = _mm_set1_epi32(CurlNoiseVolume::kMask);
+	const float* cells = volume.GetCells();
+
+	// セル1つが4要素、行がkResolutionセル、面がkResolution^2セル
+	static_assert(CurlNoiseVolume::kResolution == 32, "element shifts assume a 32^3 volume");
+	constexpr int kElementShiftX = 2;
+	constexpr int kElementShiftY = 2 + 5;
+	constexpr int kElementShiftZ = 2 + 10;
+
+	alignas(16) int32_t cellX0[4], cellX1[4], cellY0[4], cellY1[4], cellZ0[4], cellZ1[4];
+	alignas(16) float weightX[4], weightY[4], weightZ[4];
+	alignas(16) float accelX[4], accelY[4], accelZ[4];
+
+	const uint32_t end = AlignedEnd(span.end);
+	for (uint32_t i = span.begin; i < end; i += kSimdWidth) {
+		__m128 x = _mm_loadu_ps(span.positionX + i);
+		__m128 y = _mm_loadu_ps(span.positionY + i);
+		__m128 z = _mm_loadu_ps(span.positionZ + i);
+
+		// AABB内か（境界を含む）
+		__m128 inside = _mm_and_ps(_mm_cmpge_ps(x, minX), _mm_cmple_ps(x, maxX));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(y, minY), _mm_cmple_ps(y, maxY)));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(z, minZ), _mm_cmple_ps(z, maxZ)));
+		__m128 mask = _mm_and_ps(inside, AliveMask(span.killFlags, i));
+		if (_mm_movemask_ps(mask) == 0) {
+			continue;
+		}
+
+		// 格子座標の整数部（負の値も切り捨てになるよう調整）と小数部
+		// 整数部は周期で折り返し、軸毎の要素位置（セル番号×4、2の累乗なのでシフト）にしておく
+		auto split = [&](__m128 position, __m128 shift, int32_t* cell0, int32_t* cell1, float* weight, int elementShift) {
+			const __m128 coordinate = _mm_add_ps(_mm_mul_ps(position, scale), shift);
+			const __m128i truncated = _mm_cvttps_epi32(coordinate);
+			const __m128i floor = _mm_add_epi32(truncated, _mm_castps_si128(_mm_cmplt_ps(coordinate, _mm_cvtepi32_ps(truncated))));
+			_mm_store_ps(weight, _mm_sub_ps(coordinate, _mm_cvtepi32_ps(floor)));
+			const __m128i count = _mm_cvtsi32_si128(elementShift);
+			_mm_store_si128(reinterpret_cast<__m128i*>(cell0), _mm_sll_epi32(_mm_and_si128(floor, wrap), count));
+			_mm_store_si128(reinterpret_cast<__m128i*>(cell1), _mm_sll_epi32(_mm_and_si128(_mm_add_epi32(floor, _mm_set1_epi32(1)), wrap), count));
+		};
+		split(x, offsetX, cellX0, cellX1, weightX, kElementShiftX);
+		split(y, offsetY, cellY0, cellY1, weightY, kElementShiftY);
+		split(z, offsetZ, cellZ0, cellZ1, weightZ, kElementShiftZ);
+
+		// レーン毎に8セルを読み、x,y,zの3成分をまとめて補間する
+		const int bits = _mm_movemask_ps(mask);
+		for (uint32_t lane = 0; lane < kSimdWidth; ++lane) {
+			if (!(bits & (1 << lane))) {
+				accelX[lane] = accelY[lane] = accelZ[lane] = 0.0f;
+				continue;
+			}
+			const __m128 tx = _mm_set1_ps(weightX[lane]);
+			const __m128 ty = _mm_set1_ps(weightY[lane]);
+			const __m128 tz = _mm_set1_ps(weightZ[lane]);
+			auto lerp = [](__m128 a, __m128 b, __m128 t) { return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)); };
+			auto row = [&](int32_t yz) {
+				return lerp(_mm_loadu_ps(cells + yz + cellX0[lane]), _mm_loadu_ps(cells + yz + cellX1[lane]), tx);
+			};
+			const __m128 nearSlice = lerp(row(cellY0[lane] + cellZ0[lane]), row(cellY1[lane] + cellZ0[lane]), ty);
+			const __m128 farSlice = lerp(row(cellY0[lane] + cellZ1[lane]), row(cellY1[lane] + cellZ1[lane]), ty);
+			alignas(16) float value[4];
+			_mm_store_ps(value, lerp(nearSlice, farSlice, tz));
+			accelX[lane] = value[0];
+			accelY[lane] = value[1];
+			accelZ[lane] = value[2];
+		}
+
+		MaskedAdd(span.velocityX, i, _mm_mul_ps(_mm_load_ps(accelX), strengthDt), mask);
+		MaskedAdd(span.velocityY, i, _mm_mul_ps(_mm_load_ps(accelY), strengthDt), mask);
+		MaskedAdd(span.velocityZ, i, _mm_mul_ps(_mm_load_ps(accelZ), strengthDt), mask);
+	}
+}
+
+void FieldKernels::ApplyDrag(const ParticleFieldSpan& span, const AABB& area, float coefficient, float deltaTime)
+{
+	const __m128 minX = _mm_set1_ps(area.min.x);
+	const __m128 minY = _mm_set1_ps(area.min.y);
+	const __m128 minZ = _mm_set1_ps(area.min.z);
+	const __m128 maxX = _mm_set1_ps(area.max.x);
+	const __m128 maxY = _mm_set1_ps(area.max.y);
+	const __m128 maxZ = _mm_set1_ps(area.max.z);
+
+	// 減衰率はフレームレートに依存しないよう指数で計算（全パーティクル共通）
+	const __m128 damping = _mm_set1_ps(std::exp(-std::max(coefficient, 0.0f) * deltaTime));
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	const uint32_t end = AlignedEnd(span.end);
+	for (uint32_t i = span.begin; i < end; i += kSimdWidth) {
+		__m128 x = _mm_loadu_ps(span.positionX + i);
+		__m128 y = _mm_loadu_ps(span.positionY + i);
+		__m128 z = _mm_loadu_ps(span.positionZ + i);
+
+		// AABB内か（境界を含む）
+		__m128 inside = _mm_and_ps(_mm_cmpge_ps(x, minX), _mm_cmple_ps(x, maxX));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(y, minY), _mm_cmple_ps(y, maxY)));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(z, minZ), _mm_cmple_ps(z, maxZ)));
+
+		__m128 mask = _mm_and_ps(inside, AliveMask(span.killFlags, i));
+		if (_mm_movemask_ps(mask) == 0) {
+			continue;
+		}
+
+		// 範囲外のレーンは1を掛ける
+		__m128 factor = _mm_or_ps(_mm_and_ps(mask, damping), _mm_andnot_ps(mask, one));
+		_mm_storeu_ps(span.velocityX + i, _mm_mul_ps(_mm_loadu_ps(span.velocityX + i), factor));
+		_mm_storeu_ps(span.velocityY + i, _mm_mul_ps(_mm_loadu_ps(span.velocityY + i), factor));
+		_mm_storeu_ps(span.velocityZ + i, _mm_mul_ps(_mm_loadu_ps(span.velocityZ + i), factor));
+	}
+}
+
+void FieldKernels::ApplyKillPlane(const ParticleFieldSpan& span, const Vector3& point, const Vector3& normal)
+{
+	const __m128 normalX = _mm_set1_ps(normal.x);
+	const __m128 normalY = _mm_set1_ps(normal.y);
+	const __m128 normalZ = _mm_set1_ps(normal.z);
+	const __m128 planeDistance = _mm_set1_ps(normal.x * point.x + normal.y * point.y + normal.z * point.z);
+
+	const uint32_t end = AlignedEnd(span.end);
+	for (uint32_t i = span.begin; i < end; i += kSimdWidth) {
+		__m128 distance = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_loadu_ps(span.positionX + i), normalX),
+			_mm_mul_ps(_mm_loadu_ps(span.positionY + i), normalY)),
+			_mm_mul_ps(_mm_loadu_ps(span.positionZ + i), normalZ));
+
+		// 裏側に出た生存レーンを削除
+		__m128 kill = _mm_and_ps(_mm_cmplt_ps(distance, planeDistance), AliveMask(span.killFlags, i));
+		WriteKillMask(span.killFlags, i, kill);
+	}
+}
+
+AABB FieldKernels::EmptyBounds()
+{
+	AABB bounds;
+	bounds.min = { FLT_MAX, FLT_MAX, FLT_MAX };
+	bounds.max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	return bounds;
+}
+
+AABB FieldKernels::InfiniteBounds()
+{
+	AABB bounds;
+	bounds.min = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	bounds.max = { FLT_MAX, FLT_MAX, FLT_MAX };
+	return bounds;
+}
+
+void FieldKernels::Expand(AABB& bounds, const Vector3& point)
+{
+	bounds.min.x = std::min(bounds.min.x, point.x);
+	bounds.min.y = std::min(bounds.min.y, point.y);
+	bounds.min.z = std::min(bounds.min.z, point.z);
+	bounds.max.x = std::max(bounds.max.x, point.x);
+	bounds.max.y = std::max(bounds.max.y, point.y);
+	bounds.max.z = std::max(bounds.max.z, point.z);
+}
+
+void FieldKernels::Expand(AABB& bounds, const AABB& other)
+{
+	// 空のAABB（min > max）を渡しても広がらないよう、minとmaxを別々に取る
+	bounds.min.x = std::min(bounds.min.x, other.min.x);
+	bounds.min.y = std::min(bounds.min.y, other.min.y);
+	bounds.min.z = std::min(bounds.min.z, other.min.z);
+	bounds.max.x = std::max(bounds.max.x, other.max.x);
+	bounds.max.y = std::max(bounds.max.y, other.max.y);
+	bounds.max.z = std::max(bounds.max.z, other.max.z);
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstdint>
+#include "MyFunction.h"
+
+class CurlNoiseVolume;
+
+/// <summary>
+/// フィールドが一度に処理するパーティクル範囲（SoAストリームへのポインタ）
+/// <para>位置は読み取りのみ、速度と死亡フラグを書き換える</para>
+/// </summary>
+struct ParticleFieldSpan {
+	const float* positionX = nullptr;
+	const float* positionY = nullptr;
+	const float* positionZ = nullptr;
+	float* velocityX = nullptr;
+	float* velocityY = nullptr;
+	float* velocityZ = nullptr;
+	uint8_t* killFlags = nullptr;	// 1なら対象外（既に削除予定）、削除するフィールドは1を書き込む
+	uint32_t begin = 0;
+	uint32_t end = 0;				// SIMD幅に切り上げて処理するため、ストリームはパディング込みで確保されていること
+};
+
+/// <summary>
+/// フィールドの種類ごとの一括処理カーネル（SSE）
+/// <para>パーティクル毎の仮想呼び出しをせず、フィールド1つにつき範囲をまとめて処理する</para>
+/// <para>DirectXに依存しないため、デバイス無しでも呼べる</para>
+/// </summary>
+namespace FieldKernels {
+
+	/// <summary>
+	/// AABB内のパーティクルに加速度を加える
+	/// </summary>
+	/// <param name="area">ワールド座標の効果範囲</param>
+	/// <param name="acceleration">加速度</param>
+	void ApplyAcceleration(const ParticleFieldSpan& span, const AABB& area, const Vector3& acceleration, float deltaTime);
+
+	/// <summary>
+	/// 球内のパーティクルを中心へ引き寄せ、削除範囲に入ったものを削除する
+	/// <para>力 = strength * (1 - 距離/効果半径)^2</para>
+	/// </summary>
+	/// <param name="center">中心</param>
+	/// <param name="strength">重力の強さ</param>
+	/// <param name="effectRadius">効果半径</param>
+	/// <param name="deleteRadius">削除半径</param>
+	void ApplyGravity(const ParticleFieldSpan& span, const Vector3& center, float strength,
+		float effectRadius, float deleteRadius, float deltaTime);
+
+	/// <summary>
+	/// 円柱内のパーティクルを軸の周りに回し、軸へ引き寄せる
+	/// <para>力 = (接線方向 * strength - 軸への方向 * pullStrength) * (1 - 軸からの距離/半径)</para>
+	/// </summary>
+	/// <param name="center">円柱の中心</param>
+	/// <param name="axis">回転軸（正規化済み、右ねじの向きに回る）</param>
+	/// <param name="strength">接線方向の加速度</param>
+	/// <param name="pullStrength">軸へ引き寄せる加速度（負で外へ押し出す）</param>
+	/// <param name="radius">円柱の半径</param>
+	/// <param name="halfHeight">円柱の高さの半分</param>
+	void ApplyVortex(const ParticleFieldSpan& span, const Vector3& center, const Vector3& axis, float strength,
+		float pullStrength, float radius, float halfHeight, float deltaTime);
+
+	/// <summary>
+	/// AABB内のパーティクルにカールノイズの加速度を加える
+	/// <para>格子座標 = 位置 * frequency + offset として、事前計算した格子を3線形補間する</para>
+	/// </summary>
+	/// <param name="area">ワールド座標の効果範囲</param>
+	/// <param name="volume">カールノイズの格子</param>
+	/// <param name="frequency">1ワールド単位あたりの格子数</param>
+	/// <param name="offset">格子座標のずらし（時間でスクロールさせる）</param>
+	/// <param name="strength">加速度の大きさ</param>
+	void ApplyTurbulence(const ParticleFieldSpan& span, const AABB& area, const CurlNoiseVolume& volume,
+		float frequency, const Vector3& offset, float strength, float deltaTime);
+
+	/// <summary>
+	/// AABB内のパーティクルの速度を減衰させる（v *= exp(-coefficient * deltaTime)）
+	/// </summary>
+	/// <param name="area">ワールド座標の効果範囲</param>
+	/// <param name="coefficient">減衰係数（1秒あたり）</param>
+	void ApplyDrag(const ParticleFieldSpan& span, const AABB& area, float coefficient, float deltaTime);
+
+	/// <summary>
+	/// 平面の裏側（法線と逆側）に出たパーティクルを削除する
+	/// </summary>
+	/// <param name="point">平面上の点</param>
+	/// <param name="normal">平面の法線（正規化済み、表側を向く）</param>
+	void ApplyKillPlane(const ParticleFieldSpan& span, const Vector3& point, const Vector3& normal);
+
+	/// <summary>
+	/// AABB同士が重なっているか（ブロードフェーズ用）
+	/// </summary>
+	inline bool Overlaps(const AABB& a, const AABB& b) {
+		return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+			a.min.y <= b.max.y && a.max.y >= b.min.y &&
+			a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+
+	/// <summary>
+	/// 何も含まないAABB（Expandで広げていく初期値）
+	/// </summary>
+	AABB EmptyBounds();
+
+	/// <summary>
+	/// 全空間を含むAABB（範囲の無いフィールド用）
+	/// </summary>
+	AABB InfiniteBounds();
+
+	/// <summary>
+	/// AABBを点を含むように広げる
+	/// </summary>
+	void Expand(AABB& bounds, const Vector3& point);
+
+	/// <summary>
+	/// AABBを別のAABBを含むように広げる
+	/// </summary>
+	void Expand(AABB& bounds, const AABB& other);
+}
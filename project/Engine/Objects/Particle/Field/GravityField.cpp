@@ -10,44 +10,21 @@ void GravityField::Initialize(DirectXCommon* dxCommon)
 	debugColor_ = { 1.0f, 0.0f, 1.0f, 1.0f };
 }
 
-bool GravityField::ApplyEffect(ParticleState& particle, float deltaTime)
+void GravityField::ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const
 {
-	// フィールドの中心位置を取得
-	Vector3 fieldCenter = fieldTransform_.GetPosition();
-
-	// パーティクルからフィールド中心へのベクトル
-	Vector3 toCenter = {
-		fieldCenter.x - particle.transform.translate.x,
-		fieldCenter.y - particle.transform.translate.y,
-		fieldCenter.z - particle.transform.translate.z
-	};
-
-	// 距離を計算
-	float distance = Length(toCenter);
-
-	// 削除範囲内の場合、パーティクルを削除
-	if (distance < deleteRadius_) {
-		return true;
-	}
-
-	// 効果範囲外の場合は何もしない
-	if (distance > effectRadius_) {
-		return false;
-	}
-
-	// 方向を正規化
-	Vector3 direction = Normalize(toCenter);
-
-	// 距離に応じた重力の強さ（距離の2乗に反比例）
-	float distanceFactor = 1.0f - (distance / effectRadius_);
-	float gravityForce = gravityStrength_ * distanceFactor * distanceFactor;
-
-	// 重力を速度に加算
-	particle.velocity.x += direction.x * gravityForce * deltaTime;
-	particle.velocity.y += direction.y * gravityForce * deltaTime;
-	particle.velocity.z += direction.z * gravityForce * deltaTime;
+	// 範囲判定・削除・引き寄せをまとめて行う
+	FieldKernels::ApplyGravity(span, fieldTransform_.GetPosition(),
+		gravityStrength_, effectRadius_, deleteRadius_, deltaTime);
+}
 
-	return false;
+AABB GravityField::GetWorldBounds() const
+{
+	// 効果範囲の球を囲むAABB
+	Vector3 center = fieldTransform_.GetPosition();
+	AABB bounds;
+	bounds.min = { center.x - effectRadius_, center.y - effectRadius_, center.z - effectRadius_ };
+	bounds.max = { center.x + effectRadius_, center.y + effectRadius_, center.z + effectRadius_ };
+	return bounds;
 }
 
 bool GravityField::IsInField(const Vector3& point) const
@@ -19,12 +19,16 @@ public:
 	void Initialize(DirectXCommon* dxCommon) override;
 
 	/// <summary>
-	/// パーティクルに効果を適用
+	/// 効果範囲内のパーティクルをまとめて中心へ引き寄せ、削除範囲内のものを削除
 	/// </summary>
-	/// <param name="particle">対象のパーティクル</param>
+	/// <param name="span">対象のパーティクル範囲</param>
 	/// <param name="deltaTime">デルタタイム</param>
-	/// <returns>パーティクルを削除すべき場合true</returns>
-	bool ApplyEffect(ParticleState& particle, float deltaTime) override;
+	void ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const override;
+
+	/// <summary>
+	/// 効果範囲の球を囲むAABB
+	/// </summary>
+	AABB GetWorldBounds() const override;
 
 	/// <summary>
 	/// 指定した点がフィールド内にあるかチェック
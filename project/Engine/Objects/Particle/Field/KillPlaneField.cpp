@@ -0,0 +1,110 @@
+#include "KillPlaneField.h"
+#include "ImGui/ImGuiManager.h"
+#include <cfloat>
+#include <cmath>
+
+void KillPlaneField::Initialize(DirectXCommon* dxCommon)
+{
+	// 基底クラスの初期化を呼ぶ
+	BaseField::Initialize(dxCommon);
+
+	// デフォルトのデバッグカラー（赤色）
+	debugColor_ = { 1.0f, 0.0f, 0.0f, 1.0f };
+}
+
+void KillPlaneField::ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const
+{
+	// 削除のみなのでデルタタイムは使わない
+	(void)deltaTime;
+	FieldKernels::ApplyKillPlane(span, fieldTransform_.GetPosition(), normal_);
+}
+
+AABB KillPlaneField::GetWorldBounds() const
+{
+	AABB bounds = FieldKernels::InfiniteBounds();
+
+	// 法線が軸に沿っていれば、裏側だけに絞れる（ブロードフェーズで表側のグループを除外できる）
+	const Vector3 position = fieldTransform_.GetPosition();
+	const float* normal = &normal_.x;
+	const float* point = &position.x;
+	float* boundsMin = &bounds.min.x;
+	float* boundsMax = &bounds.max.x;
+	for (int axis = 0; axis < 3; ++axis) {
+		if (normal[axis] >= 1.0f - FLT_EPSILON) {
+			boundsMax[axis] = point[axis];
+		} else if (normal[axis] <= -1.0f + FLT_EPSILON) {
+			boundsMin[axis] = point[axis];
+		}
+	}
+	return bounds;
+}
+
+bool KillPlaneField::IsInField(const Vector3& point) const
+{
+	const Vector3 position = fieldTransform_.GetPosition();
+	const Vector3 toPoint = { point.x - position.x, point.y - position.y, point.z - position.z };
+	return Dot(toPoint, normal_) < 0.0f;
+}
+
+void KillPlaneField::SetNormal(const Vector3& normal)
+{
+	// 長さ0の法線は無視する
+	if (Length(normal) > 0.0f) {
+		normal_ = Normalize(normal);
+	}
+}
+
+void KillPlaneField::CreateDebugShape()
+{
+	// 平面上の2方向
+	const Vector3 reference = std::abs(normal_.y) < 0.99f ? Vector3{ 0.0f, 1.0f, 0.0f } : Vector3{ 1.0f, 0.0f, 0.0f };
+	const Vector3 tangent = Normalize(Cross(normal_, reference));
+	const Vector3 bitangent = Cross(normal_, tangent);
+	const Vector3 center = fieldTransform_.GetPosition();
+
+	debugDrawLineSystem_->DrawRectangle(center, normal_, tangent, bitangent, debugSize_, debugSize_, debugColor_);
+
+	// 表側を示す法線
+	const Vector3 tip = { center.x + normal_.x, center.y + normal_.y, center.z + normal_.z };
+	debugDrawLineSystem_->AddLine(center, tip, debugColor_);
+}
+
+void KillPlaneField::ImGui()
+{
+#ifdef USEIMGUI
+	if (ImGui::TreeNode(name_.c_str())) {
+		// 基底クラスのImGuiを呼ぶ（共通設定）
+		BaseField::ImGui();
+
+		// 削除平面フィールド固有の設定
+		if (ImGui::CollapsingHeader("Kill Plane Settings", ImGuiTreeNodeFlags_DefaultOpen)) {
+			Vector3 normal = normal_;
+			if (ImGui::DragFloat3("Normal", &normal.x, 0.01f, -1.0f, 1.0f)) {
+				SetNormal(normal);
+			}
+			ImGui::DragFloat("Debug Size", &debugSize_, 0.1f, 0.1f, 100.0f);
+			ImGui::Separator();
+		}
+
+		ImGui::TreePop();
+	}
+#endif
+}
+
+json KillPlaneField::SerializeParameters() const
+{
+	return json{
+		{"normal", {normal_.x, normal_.y, normal_.z}},
+		{"debugSize", debugSize_}
+	};
+}
+
+void KillPlaneField::DeserializeParameters(const json& j)
+{
+	if (j.contains("normal")) {
+		auto normal = j["normal"];
+		SetNormal({ normal[0], normal[1], normal[2] });
+	}
+
+	debugSize_ = j.value("debugSize", debugSize_);
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "BaseField.h"
+#include "DebugDrawLineSystem.h"
+
+/// <summary>
+/// 削除平面フィールド
+/// <para>フィールドの位置を通る平面の裏側（法線と逆側）に出たパーティクルを削除する（地面・水面の下など）</para>
+/// </summary>
+class KillPlaneField : public BaseField
+{
+public:
+	KillPlaneField() = default;
+	~KillPlaneField() override = default;
+
+	/// <summary>
+	/// フィールドの初期化
+	/// </summary>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	void Initialize(DirectXCommon* dxCommon) override;
+
+	/// <summary>
+	/// 平面の裏側のパーティクルをまとめて削除
+	/// </summary>
+	/// <param name="span">対象のパーティクル範囲</param>
+	/// <param name="deltaTime">デルタタイム</param>
+	void ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const override;
+
+	/// <summary>
+	/// 裏側の半空間を囲むAABB（軸に沿った法線なら片側だけ、それ以外は全空間）
+	/// </summary>
+	AABB GetWorldBounds() const override;
+
+	/// <summary>
+	/// 指定した点が平面の裏側にあるかチェック
+	/// </summary>
+	/// <param name="point">チェックする点の座標</param>
+	/// <returns>裏側ならtrue</returns>
+	bool IsInField(const Vector3& point) const override;
+
+	/// <summary>
+	/// ImGui用のデバッグ表示
+	/// </summary>
+	void ImGui() override;
+
+	/// <summary>
+	/// フィールドタイプ名
+	/// </summary>
+	const char* GetTypeName() const override { return "KillPlaneField"; }
+
+	/// <summary>
+	/// パラメータをJSONにシリアライズ
+	/// </summary>
+	json SerializeParameters() const override;
+
+	/// <summary>
+	/// JSONからパラメータをデシリアライズ
+	/// </summary>
+	void DeserializeParameters(const json& j) override;
+
+	// 平面の法線（表側を向く、設定時に正規化）
+	void SetNormal(const Vector3& normal);
+	const Vector3& GetNormal() const { return normal_; }
+
+protected:
+	/// <summary>
+	/// 平面のデバッグ線を作成
+	/// </summary>
+	void CreateDebugShape() override;
+
+private:
+	// 削除平面フィールド固有のパラメータ
+	Vector3 normal_ = { 0.0f, 1.0f, 0.0f };	// 平面の法線（正規化済み）
+	float debugSize_ = 4.0f;				// デバッグ表示の大きさ
+};
@@ -0,0 +1,135 @@
+#include "TurbulenceField.h"
+#include "ImGui/ImGuiManager.h"
+#include "Collision.h"
+
+void TurbulenceField::Initialize(DirectXCommon* dxCommon)
+{
+	// 基底クラスの初期化を呼ぶ
+	BaseField::Initialize(dxCommon);
+
+	// AABBを正しい状態に
+	FixAABBMinMax(area_);
+
+	// ノイズの格子（初回のみ作成）
+	volume_ = CurlNoiseVolume::GetShared(seed_);
+
+	// デフォルトのデバッグカラー（橙色）
+	debugColor_ = { 1.0f, 0.5f, 0.0f, 1.0f };
+}
+
+void TurbulenceField::Update(float deltaTime)
+{
+	BaseField::Update(deltaTime);
+
+	// ApplyBatchはワーカースレッドから呼ばれるので、時間はここで進める
+	time_ += deltaTime;
+}
+
+void TurbulenceField::ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const
+{
+	if (!volume_) {
+		return;
+	}
+
+	// AABB内判定とノイズの補間・加算をまとめて行う
+	const Vector3 offset = { scrollSpeed_.x * time_, scrollSpeed_.y * time_, scrollSpeed_.z * time_ };
+	FieldKernels::ApplyTurbulence(span, GetWorldAABB(), *volume_, frequency_, offset, strength_, deltaTime);
+}
+
+bool TurbulenceField::IsInField(const Vector3& point) const
+{
+	// 点がAABB内にあるかチェック
+	return Collision::IsCollision(GetWorldAABB(), point);
+}
+
+void TurbulenceField::SetSeed(uint32_t seed)
+{
+	seed_ = seed;
+	volume_ = CurlNoiseVolume::GetShared(seed_);
+}
+
+AABB TurbulenceField::GetWorldAABB() const
+{
+	// ローカル座標のAABBをワールド座標に変換
+	Vector3 fieldPos = fieldTransform_.GetPosition();
+	AABB worldAABB;
+	worldAABB.min = { fieldPos.x + area_.min.x, fieldPos.y + area_.min.y, fieldPos.z + area_.min.z };
+	worldAABB.max = { fieldPos.x + area_.max.x, fieldPos.y + area_.max.y, fieldPos.z + area_.max.z };
+	return worldAABB;
+}
+
+void TurbulenceField::CreateDebugShape()
+{
+	debugDrawLineSystem_->DrawAABB(GetWorldAABB(), debugColor_);
+}
+
+void TurbulenceField::ImGui()
+{
+#ifdef USEIMGUI
+	if (ImGui::TreeNode(name_.c_str())) {
+		// 基底クラスのImGuiを呼ぶ（共通設定）
+		BaseField::ImGui();
+
+		// 乱流フィールド固有の設定
+		if (ImGui::CollapsingHeader("Turbulence Settings", ImGuiTreeNodeFlags_DefaultOpen)) {
+			ImGui::DragFloat("Strength", &strength_, 0.1f, 0.0f, 50.0f);
+			ImGui::DragFloat("Frequency", &frequency_, 0.01f, 0.01f, 16.0f);
+			ImGui::DragFloat3("Scroll Speed", &scrollSpeed_.x, 0.01f, -10.0f, 10.0f);
+			int seed = static_cast<int>(seed_);
+			if (ImGui::InputInt("Seed", &seed)) {
+				SetSeed(static_cast<uint32_t>(seed));
+			}
+			ImGui::Separator();
+		}
+
+		// AABB範囲設定
+		if (ImGui::CollapsingHeader("Area (AABB)")) {
+			bool aabbChanged = false;
+			aabbChanged |= ImGui::DragFloat3("Min", &area_.min.x, 0.1f);
+			aabbChanged |= ImGui::DragFloat3("Max", &area_.max.x, 0.1f);
+			if (aabbChanged) {
+				FixAABBMinMax(area_);
+			}
+		}
+
+		ImGui::TreePop();
+	}
+#endif
+}
+
+json TurbulenceField::SerializeParameters() const
+{
+	return json{
+		{"strength", strength_},
+		{"frequency", frequency_},
+		{"scrollSpeed", {scrollSpeed_.x, scrollSpeed_.y, scrollSpeed_.z}},
+		{"seed", seed_},
+		{"areaMin", {area_.min.x, area_.min.y, area_.min.z}},
+		{"areaMax", {area_.max.x, area_.max.y, area_.max.z}}
+	};
+}
+
+void TurbulenceField::DeserializeParameters(const json& j)
+{
+	strength_ = j.value("strength", strength_);
+	frequency_ = j.value("frequency", frequency_);
+
+	if (j.contains("scrollSpeed")) {
+		auto speed = j["scrollSpeed"];
+		scrollSpeed_ = { speed[0], speed[1], speed[2] };
+	}
+
+	if (j.contains("areaMin")) {
+		auto minVec = j["areaMin"];
+		area_.min = { minVec[0], minVec[1], minVec[2] };
+	}
+
+	if (j.contains("areaMax")) {
+		auto maxVec = j["areaMax"];
+		area_.max = { maxVec[0], maxVec[1], maxVec[2] };
+	}
+
+	FixAABBMinMax(area_);
+
+	SetSeed(j.value("seed", seed_));
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <memory>
+#include "BaseField.h"
+#include "CurlNoiseVolume.h"
+#include "DebugDrawLineSystem.h"
+
+/// <summary>
+/// 乱流フィールド
+/// <para>AABB範囲内のパーティクルに、事前計算したカールノイズの加速度を与える</para>
+/// <para>ノイズはシード毎に共有し、時間でスクロールさせて流れを変化させる</para>
+/// </summary>
+class TurbulenceField : public BaseField
+{
+public:
+	TurbulenceField() = default;
+	~TurbulenceField() override = default;
+
+	/// <summary>
+	/// フィールドの初期化（ノイズの格子を取得）
+	/// </summary>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	void Initialize(DirectXCommon* dxCommon) override;
+
+	/// <summary>
+	/// 更新処理（ノイズのスクロールを進める）
+	/// </summary>
+	/// <param name="deltaTime">デルタタイム</param>
+	void Update(float deltaTime) override;
+
+	/// <summary>
+	/// AABB内のパーティクルにまとめてノイズの加速度を適用（削除はしない）
+	/// </summary>
+	/// <param name="span">対象のパーティクル範囲</param>
+	/// <param name="deltaTime">デルタタイム</param>
+	void ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const override;
+
+	/// <summary>
+	/// 効果範囲（ワールド座標のAABB）
+	/// </summary>
+	AABB GetWorldBounds() const override { return GetWorldAABB(); }
+
+	/// <summary>
+	/// 指定した点がフィールド内にあるかチェック
+	/// </summary>
+	/// <param name="point">チェックする点の座標</param>
+	/// <returns>範囲内ならtrue</returns>
+	bool IsInField(const Vector3& point) const override;
+
+	/// <summary>
+	/// ImGui用のデバッグ表示
+	/// </summary>
+	void ImGui() override;
+
+	/// <summary>
+	/// フィールドタイプ名
+	/// </summary>
+	const char* GetTypeName() const override { return "TurbulenceField"; }
+
+	/// <summary>
+	/// パラメータをJSONにシリアライズ
+	/// </summary>
+	json SerializeParameters() const override;
+
+	/// <summary>
+	/// JSONからパラメータをデシリアライズ
+	/// </summary>
+	void DeserializeParameters(const json& j) override;
+
+	// 加速度の大きさ
+	void SetStrength(float strength) { strength_ = strength; }
+	float GetStrength() const { return strength_; }
+
+	// 1ワールド単位あたりの格子数（大きいほど細かい乱れ）
+	void SetFrequency(float frequency) { frequency_ = frequency; }
+	float GetFrequency() const { return frequency_; }
+
+	// 1秒あたりのスクロール量（格子単位）
+	void SetScrollSpeed(const Vector3& speed) { scrollSpeed_ = speed; }
+	const Vector3& GetScrollSpeed() const { return scrollSpeed_; }
+
+	// ノイズのシード（変更時に格子を取得し直す）
+	void SetSeed(uint32_t seed);
+	uint32_t GetSeed() const { return seed_; }
+
+	// 効果範囲（AABB）の設定（ローカル座標）
+	void SetArea(const AABB& aabb) { area_ = aabb; FixAABBMinMax(area_); }
+	const AABB& GetArea() const { return area_; }
+
+	/// <summary>
+	/// ワールド座標でのAABBを取得
+	/// </summary>
+	AABB GetWorldAABB() const;
+
+protected:
+	/// <summary>
+	/// AABBのデバッグ線を作成
+	/// </summary>
+	void CreateDebugShape() override;
+
+private:
+	// 乱流フィールド固有のパラメータ
+	float strength_ = 4.0f;						// 加速度の大きさ
+	float frequency_ = 1.0f;					// 1ワールド単位あたりの格子数
+	Vector3 scrollSpeed_ = { 0.0f, 0.5f, 0.0f };	// 1秒あたりのスクロール量（格子単位）
+	uint32_t seed_ = 1;							// ノイズのシード
+
+	// 効果範囲（ローカル座標でのAABB）
+	AABB area_ = {
+		{-2.0f, -2.0f, -2.0f},	// min
+		{2.0f, 2.0f, 2.0f}		// max
+	};
+
+	// 実行時の状態
+	std::shared_ptr<const CurlNoiseVolume> volume_;	// 同じシードのフィールドで共有
+	float time_ = 0.0f;								// スクロール用の経過時間
+};
@@ -0,0 +1,133 @@
+#define NOMINMAX
+#include "VortexField.h"
+#include "ImGui/ImGuiManager.h"
+#include <algorithm>
+#include <cmath>
+
+void VortexField::Initialize(DirectXCommon* dxCommon)
+{
+	// 基底クラスの初期化を呼ぶ
+	BaseField::Initialize(dxCommon);
+
+	// デフォルトのデバッグカラー（水色）
+	debugColor_ = { 0.0f, 1.0f, 1.0f, 1.0f };
+}
+
+void VortexField::ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const
+{
+	// 円柱内判定と回転・引き寄せをまとめて行う
+	FieldKernels::ApplyVortex(span, fieldTransform_.GetPosition(), axis_,
+		strength_, pullStrength_, radius_, height_ * 0.5f, deltaTime);
+}
+
+AABB VortexField::GetWorldBounds() const
+{
+	// 円柱を囲む立方体（軸の向きが変わっても作り直さなくてよいよう大きめに取る）
+	const Vector3 center = fieldTransform_.GetPosition();
+	const float extent = std::sqrt(radius_ * radius_ + height_ * height_ * 0.25f);
+	AABB bounds;
+	bounds.min = { center.x - extent, center.y - extent, center.z - extent };
+	bounds.max = { center.x + extent, center.y + extent, center.z + extent };
+	return bounds;
+}
+
+bool VortexField::IsInField(const Vector3& point) const
+{
+	// 中心からのベクトルを軸方向と軸に垂直な成分に分ける
+	const Vector3 center = fieldTransform_.GetPosition();
+	const Vector3 toPoint = { point.x - center.x, point.y - center.y, point.z - center.z };
+	const float along = Dot(toPoint, axis_);
+	const Vector3 radial = { toPoint.x - axis_.x * along, toPoint.y - axis_.y * along, toPoint.z - axis_.z * along };
+
+	return std::abs(along) <= height_ * 0.5f && Length(radial) <= radius_;
+}
+
+void VortexField::SetAxis(const Vector3& axis)
+{
+	// 長さ0の軸は無視する
+	if (Length(axis) > 0.0f) {
+		axis_ = Normalize(axis);
+	}
+}
+
+void VortexField::CreateDebugShape()
+{
+	const Vector3 center = fieldTransform_.GetPosition();
+	const float halfHeight = height_ * 0.5f;
+
+	// 軸
+	const Vector3 top = { center.x + axis_.x * halfHeight, center.y + axis_.y * halfHeight, center.z + axis_.z * halfHeight };
+	const Vector3 bottom = { center.x - axis_.x * halfHeight, center.y - axis_.y * halfHeight, center.z - axis_.z * halfHeight };
+	debugDrawLineSystem_->AddLine(bottom, top, debugColor_);
+
+	// 軸に垂直な2方向
+	const Vector3 reference = std::abs(axis_.y) < 0.99f ? Vector3{ 0.0f, 1.0f, 0.0f } : Vector3{ 1.0f, 0.0f, 0.0f };
+	const Vector3 tangent = Normalize(Cross(axis_, reference));
+	const Vector3 bitangent = Cross(axis_, tangent);
+
+	// 上下の円と側面の線
+	constexpr uint32_t kSegments = 24;
+	for (uint32_t i = 0; i < kSegments; ++i) {
+		const float angle0 = 6.2831853f * i / kSegments;
+		const float angle1 = 6.2831853f * (i + 1) / kSegments;
+		auto ring = [&](const Vector3& base, float angle) {
+			const float c = std::cos(angle) * radius_;
+			const float s = std::sin(angle) * radius_;
+			return Vector3{ base.x + tangent.x * c + bitangent.x * s, base.y + tangent.y * c + bitangent.y * s, base.z + tangent.z * c + bitangent.z * s };
+		};
+		debugDrawLineSystem_->AddLine(ring(top, angle0), ring(top, angle1), debugColor_);
+		debugDrawLineSystem_->AddLine(ring(bottom, angle0), ring(bottom, angle1), debugColor_);
+		if (i % 6 == 0) {
+			debugDrawLineSystem_->AddLine(ring(bottom, angle0), ring(top, angle0), debugColor_);
+		}
+	}
+}
+
+void VortexField::ImGui()
+{
+#ifdef USEIMGUI
+	if (ImGui::TreeNode(name_.c_str())) {
+		// 基底クラスのImGuiを呼ぶ（共通設定）
+		BaseField::ImGui();
+
+		// 渦フィールド固有の設定
+		if (ImGui::CollapsingHeader("Vortex Settings", ImGuiTreeNodeFlags_DefaultOpen)) {
+			Vector3 axis = axis_;
+			if (ImGui::DragFloat3("Axis", &axis.x, 0.01f, -1.0f, 1.0f)) {
+				SetAxis(axis);
+			}
+			ImGui::DragFloat("Strength", &strength_, 0.1f, -50.0f, 50.0f);
+			ImGui::DragFloat("Pull Strength", &pullStrength_, 0.1f, -50.0f, 50.0f);
+			ImGui::DragFloat("Radius", &radius_, 0.1f, 0.1f, 50.0f);
+			ImGui::DragFloat("Height", &height_, 0.1f, 0.1f, 100.0f);
+			ImGui::Separator();
+		}
+
+		ImGui::TreePop();
+	}
+#endif
+}
+
+json VortexField::SerializeParameters() const
+{
+	return json{
+		{"axis", {axis_.x, axis_.y, axis_.z}},
+		{"strength", strength_},
+		{"pullStrength", pullStrength_},
+		{"radius", radius_},
+		{"height", height_}
+	};
+}
+
+void VortexField::DeserializeParameters(const json& j)
+{
+	if (j.contains("axis")) {
+		auto axis = j["axis"];
+		SetAxis({ axis[0], axis[1], axis[2] });
+	}
+
+	strength_ = j.value("strength", strength_);
+	pullStrength_ = j.value("pullStrength", pullStrength_);
+	radius_ = j.value("radius", radius_);
+	height_ = j.value("height", height_);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "BaseField.h"
+#include "DebugDrawLineSystem.h"
+
+/// <summary>
+/// 渦フィールド
+/// <para>円柱範囲内のパーティクルを軸の周りに回し、軸へ引き寄せる（竜巻・吸い込み用）</para>
+/// </summary>
+class VortexField : public BaseField
+{
+public:
+	VortexField() = default;
+	~VortexField() override = default;
+
+	/// <summary>
+	/// フィールドの初期化
+	/// </summary>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	void Initialize(DirectXCommon* dxCommon) override;
+
+	/// <summary>
+	/// 円柱内のパーティクルにまとめて回転と引き寄せの加速度を適用（削除はしない）
+	/// </summary>
+	/// <param name="span">対象のパーティクル範囲</param>
+	/// <param name="deltaTime">デルタタイム</param>
+	void ApplyBatch(const ParticleFieldSpan& span, float deltaTime) const override;
+
+	/// <summary>
+	/// 円柱を囲むAABB（軸の向きによらず、中心から半径と高さの半分の大きい方）
+	/// </summary>
+	AABB GetWorldBounds() const override;
+
+	/// <summary>
+	/// 指定した点がフィールド内にあるかチェック
+	/// </summary>
+	/// <param name="point">チェックする点の座標</param>
+	/// <returns>範囲内ならtrue</returns>
+	bool IsInField(const Vector3& point) const override;
+
+	/// <summary>
+	/// ImGui用のデバッグ表示
+	/// </summary>
+	void ImGui() override;
+
+	/// <summary>
+	/// フィールドタイプ名
+	/// </summary>
+	const char* GetTypeName() const override { return "VortexField"; }
+
+	/// <summary>
+	/// パラメータをJSONにシリアライズ
+	/// </summary>
+	json SerializeParameters() const override;
+
+	/// <summary>
+	/// JSONからパラメータをデシリアライズ
+	/// </summary>
+	void DeserializeParameters(const json& j) override;
+
+	// 回転軸（設定時に正規化）
+	void SetAxis(const Vector3& axis);
+	const Vector3& GetAxis() const { return axis_; }
+
+	// 接線方向の加速度（負で逆回転）
+	void SetStrength(float strength) { strength_ = strength; }
+	float GetStrength() const { return strength_; }
+
+	// 軸へ引き寄せる加速度（負で外へ押し出す）
+	void SetPullStrength(float strength) { pullStrength_ = strength; }
+	float GetPullStrength() const { return pullStrength_; }
+
+	// 効果範囲（円柱）
+	void SetRadius(float radius) { radius_ = radius; }
+	float GetRadius() const { return radius_; }
+	void SetHeight(float height) { height_ = height; }
+	float GetHeight() const { return height_; }
+
+protected:
+	/// <summary>
+	/// 円柱のデバッグ線を作成
+	/// </summary>
+	void CreateDebugShape() override;
+
+private:
+	// 渦フィールド固有のパラメータ
+	Vector3 axis_ = { 0.0f, 1.0f, 0.0f };	// 回転軸（正規化済み）
+	float strength_ = 5.0f;				// 接線方向の加速度
+	float pullStrength_ = 1.0f;			// 軸へ引き寄せる加速度
+	float radius_ = 3.0f;				// 円柱の半径
+	float height_ = 6.0f;				// 円柱の高さ
+};
@@ -0,0 +1,53 @@
+#include "ParticleArenaAllocator.h"
+
+void ParticleArenaAllocator::Reset(uint32_t capacity)
+{
+	capacity_ = capacity;
+	usedCount_ = 0;
+	allocationCount_ = 0;
+	failedAllocationCount_ = 0;
+}
+
+void ParticleArenaAllocator::BeginFrame()
+{
+	usedCount_ = 0;
+	allocationCount_ = 0;
+	failedAllocationCount_ = 0;
+}
+
+uint32_t ParticleArenaAllocator::Allocate(uint32_t count)
+{
+	if (count == 0) {
+		return kInvalidOffset;
+	}
+
+	// 残り容量と比較する（usedCount_ + count のオーバーフローを避ける）
+	if (count > capacity_ - usedCount_) {
+		++failedAllocationCount_;
+		return kInvalidOffset;
+	}
+
+	uint32_t offset = usedCount_;
+	usedCount_ += count;
+	++allocationCount_;
+
+	if (usedCount_ > peakCount_) {
+		peakCount_ = usedCount_;
+	}
+
+	return offset;
+}
+
+uint32_t ParticleArenaAllocator::ComputeGrowCapacity(uint32_t currentCapacity, uint32_t requiredCount)
+{
+	if (requiredCount <= currentCapacity) {
+		return currentCapacity;
+	}
+
+	// 毎フレーム作り直さないよう倍々で増やす
+	uint64_t capacity = currentCapacity > 0 ? currentCapacity : 1;
+	while (capacity < requiredCount) {
+		capacity *= 2;
+	}
+	return capacity > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(capacity);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// パーティクルのインスタンスアリーナを要素単位で切り分けるCPU側のアロケーター
+/// <para>毎フレームBeginFrameで空にし、各グループのアクティブ数だけ先頭から順に割り当てる</para>
+/// <para>DirectXに依存しないため、デバイス無しで単体テストできる</para>
+/// </summary>
+class ParticleArenaAllocator
+{
+public:
+	// 割り当て失敗を表すオフセット
+	static constexpr uint32_t kInvalidOffset = UINT32_MAX;
+
+	/// <summary>
+	/// 容量を設定して空にする
+	/// </summary>
+	/// <param name="capacity">割り当て可能な要素数</param>
+	void Reset(uint32_t capacity);
+
+	/// <summary>
+	/// フレーム開始（前フレームの割り当てをすべて解放）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 要素を連続で割り当てる
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <returns>先頭のオフセット（0個、または容量不足ならkInvalidOffset）</returns>
+	uint32_t Allocate(uint32_t count);
+
+	/// <summary>
+	/// 必要な要素数を満たす新しい容量を計算（倍々で増やす）
+	/// </summary>
+	/// <param name="currentCapacity">現在の容量</param>
+	/// <param name="requiredCount">必要な要素数</param>
+	/// <returns>新しい容量（足りている場合は現在の容量）</returns>
+	static uint32_t ComputeGrowCapacity(uint32_t currentCapacity, uint32_t requiredCount);
+
+	uint32_t GetCapacity() const { return capacity_; }
+	uint32_t GetUsedCount() const { return usedCount_; }
+	uint32_t GetFreeCount() const { return capacity_ - usedCount_; }
+	uint32_t GetPeakCount() const { return peakCount_; }
+	uint32_t GetAllocationCount() const { return allocationCount_; }
+	uint32_t GetFailedAllocationCount() const { return failedAllocationCount_; }
+
+private:
+	uint32_t capacity_ = 0;
+	uint32_t usedCount_ = 0;				// 今フレームで割り当て済みの要素数
+	uint32_t peakCount_ = 0;				// これまでの最大使用数
+	uint32_t allocationCount_ = 0;			// 今フレームの割り当て回数
+	uint32_t failedAllocationCount_ = 0;	// 今フレームの容量不足の回数
+};
@@ -0,0 +1,864 @@
+#define NOMINMAX
+#include "ParticleBenchmark.h"
+#include "ParticleKernels.h"
+#include "ParticleStorage.h"
+#include "CurlNoiseVolume.h"
+#include "JobSystem.h"
+#ifdef USEIMGUI
+#include "ImGui/ImGuiManager.h"
+#endif
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace {
+
+	// フィールドの計測結果の表示名（ParticleBenchmark::FieldKindの順）
+	constexpr const char* kFieldKindNames[] = { "Acceleration", "Gravity", "Vortex", "Turbulence", "Drag", "KillPlane" };
+
+	// 計測で使う固定のデルタタイム（60fps）
+	constexpr float kDeltaTime = 1.0f / 60.0f;
+
+	// 両方の計測で同じパーティクル列を生成するためのシード
+	constexpr uint32_t kSeed = 12345;
+
+	/// <summary>
+	/// 計測用の色・サイズの参照テーブル（黄→赤のフェードアウト、1→0の縮小）
+	/// </summary>
+	const ParticleLifetimeLut* GetBenchmarkLut()
+	{
+		static const std::shared_ptr<ParticleLifetimeLut> lut = [] {
+			auto baked = std::make_shared<ParticleLifetimeLut>();
+			const ParticleColorGradient gradient = ParticleColorGradient::MakeLinear({ 1.0f, 1.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f, 0.0f });
+			const ParticleSizeCurve curve = ParticleSizeCurve::MakeLinear({ 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f });
+			baked->Bake(&gradient, &curve);
+			return baked;
+		}();
+		return lut.get();
+	}
+
+	/// <summary>
+	/// 計測用のパーティクルを生成（機能の組み合わせが混在するようにする）
+	/// </summary>
+	ParticleState CreateParticle(std::mt19937& engine)
+	{
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> life(0.5f, 2.0f);
+		std::uniform_int_distribution<int> feature(0, 3);
+
+		ParticleState particle;
+		particle.transform.translate = { unit(engine), unit(engine), unit(engine) };
+		particle.velocity = { unit(engine), unit(engine) + 2.0f, unit(engine) };
+		particle.color = { 1.0f, 0.5f, 0.25f, 1.0f };
+		particle.lifeTime = life(engine);
+		particle.currentTime = 0.0f;
+
+		switch (feature(engine)) {
+		case 1:
+			particle.useColorOverLifetime = true;
+			particle.lifetimeLut = GetBenchmarkLut();
+			break;
+		case 2:
+			particle.useSizeOverLifetime = true;
+			particle.lifetimeLut = GetBenchmarkLut();
+			break;
+		case 3:
+			particle.useRotation = true;
+			particle.rotationSpeed = { 0.0f, 0.0f, 180.0f };
+			break;
+		default:
+			break;
+		}
+
+		return particle;
+	}
+
+	/// <summary>
+	/// 従来のGPU転送用データ（CPUで行列を組み立てていた頃の144byteの形式）
+	/// </summary>
+	struct LegacyParticleForGPU {
+		Matrix4x4 WVP;
+		Matrix4x4 World;
+		Vector4 color;
+	};
+
+	/// <summary>
+	/// 従来のGPU書き込み（パーティクル毎にワールド行列とWVP行列をCPUで計算）
+	/// </summary>
+	void WriteLegacyInstances(const ParticleStorage& storage, uint32_t count, LegacyParticleForGPU* instances,
+		const Matrix4x4& viewProjectionMatrix, const Matrix4x4& billboardMatrix, bool useBillboard)
+	{
+		for (uint32_t i = 0; i < count; ++i) {
+			const Vector3 scale = { storage.scaleX[i], storage.scaleY[i], storage.scaleZ[i] };
+			const Vector3 translate = { storage.positionX[i], storage.positionY[i], storage.positionZ[i] };
+
+			if (useBillboard) {
+				instances[i].World = Matrix4x4Multiply(
+					Matrix4x4Multiply(MakeScaleMatrix(scale), billboardMatrix),
+					MakeTranslateMatrix(translate)
+				);
+			} else {
+				const Vector3 rotate = { storage.rotateX[i], storage.rotateY[i], storage.rotateZ[i] };
+				instances[i].World = MakeAffineMatrix(scale, rotate, translate);
+			}
+
+			instances[i].WVP = Matrix4x4Multiply(instances[i].World, viewProjectionMatrix);
+			instances[i].color = { storage.colorR[i], storage.colorG[i], storage.colorB[i], storage.colorA[i] };
+		}
+	}
+
+	/// <summary>
+	/// 従来のParticleGroupの更新処理（フィールド無し）
+	/// </summary>
+	void UpdateAoS(std::vector<ParticleState>& particles, float deltaTime)
+	{
+		size_t writeIndex = 0;
+
+		for (size_t readIndex = 0; readIndex < particles.size(); ++readIndex) {
+			auto& particle = particles[readIndex];
+
+			if (particle.lifeTime <= particle.currentTime) {
+				continue;
+			}
+
+			particle.transform.translate.x += particle.velocity.x * deltaTime;
+			particle.transform.translate.y += particle.velocity.y * deltaTime;
+			particle.transform.translate.z += particle.velocity.z * deltaTime;
+
+			float t = particle.currentTime / particle.lifeTime;
+
+			if (particle.useColorOverLifetime) {
+				particle.color = particle.lifetimeLut->SampleColor(t);
+			} else {
+				particle.color.w = 1.0f - t;
+			}
+
+			if (particle.useSizeOverLifetime) {
+				particle.transform.scale = particle.lifetimeLut->SampleSize(t);
+			}
+
+			if (particle.useRotation) {
+				particle.transform.rotate.x += DegToRad(particle.rotationSpeed.x) * deltaTime;
+				particle.transform.rotate.y += DegToRad(particle.rotationSpeed.y) * deltaTime;
+				particle.transform.rotate.z += DegToRad(particle.rotationSpeed.z) * deltaTime;
+			}
+
+			particle.currentTime += deltaTime;
+
+			if (writeIndex != readIndex) {
+				particles[writeIndex] = std::move(particle);
+			}
+			++writeIndex;
+		}
+
+		particles.resize(writeIndex);
+	}
+
+	/// <summary>
+	/// 経過時間をミリ秒で取得
+	/// </summary>
+	double ElapsedMs(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/// <summary>
+	/// 合計時間から1ミリ秒あたりの更新数を計算
+	/// </summary>
+	void FinalizeResult(ParticleBenchmark::Result& result)
+	{
+		if (result.totalMs > 0.0) {
+			result.particlesPerMs =
+				static_cast<double>(result.particleCount) * result.frameCount / result.totalMs;
+		}
+	}
+}
+
+ParticleBenchmark::Result ParticleBenchmark::RunAoS(uint32_t particleCount, uint32_t frameCount)
+{
+	Result result;
+	result.particleCount = particleCount;
+	result.frameCount = frameCount;
+
+	std::mt19937 engine(kSeed);
+	std::vector<ParticleState> particles;
+	particles.reserve(particleCount);
+
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		// 死んだ分を補充（生成は計測に含めない）
+		while (particles.size() < particleCount) {
+			particles.push_back(CreateParticle(engine));
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		UpdateAoS(particles, kDeltaTime);
+		result.totalMs += ElapsedMs(start);
+	}
+
+	for (const auto& particle : particles) {
+		result.checksum += particle.transform.translate.x + particle.transform.translate.y +
+			particle.transform.translate.z + particle.color.w;
+	}
+
+	FinalizeResult(result);
+	return result;
+}
+
+ParticleBenchmark::Result ParticleBenchmark::RunSoA(uint32_t particleCount, uint32_t frameCount)
+{
+	Result result;
+	result.particleCount = particleCount;
+	result.frameCount = frameCount;
+
+	std::mt19937 engine(kSeed);
+	ParticleStorage storage;
+	storage.Initialize(particleCount);
+
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		// 死んだ分を補充（生成は計測に含めない）
+		while (!storage.IsFull()) {
+			storage.Add(CreateParticle(engine));
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		ParticleKernels::MarkExpired(storage, 0, storage.GetCount());
+		storage.Compact();
+		ParticleKernels::Simulate(storage, 0, storage.GetCount(), kDeltaTime);
+		result.totalMs += ElapsedMs(start);
+	}
+
+	for (uint32_t i = 0; i < storage.GetCount(); ++i) {
+		result.checksum += storage.positionX[i] + storage.positionY[i] +
+			storage.positionZ[i] + storage.colorA[i];
+	}
+
+	FinalizeResult(result);
+	return result;
+}
+
+ParticleBenchmark::Result ParticleBenchmark::RunGroups(uint32_t groupCount, uint32_t particlesPerGroup, uint32_t frameCount, bool useJobSystem)
+{
+	Result result;
+	result.particleCount = groupCount * particlesPerGroup;
+	result.frameCount = frameCount;
+
+	// グループ毎のストレージとGPUバッファの代わり
+	std::vector<ParticleStorage> storages(groupCount);
+	std::vector<std::vector<ParticleForGPU>> instances(groupCount);
+	for (uint32_t g = 0; g < groupCount; ++g) {
+		storages[g].Initialize(particlesPerGroup);
+		instances[g].resize(particlesPerGroup);
+	}
+
+	// 並列か逐次かを切り替えて実行
+	auto dispatch = [useJobSystem](uint32_t count, const std::function<void(uint32_t)>& job) {
+		if (useJobSystem) {
+			JobSystem::GetInstance()->ParallelFor(count, job);
+		} else {
+			for (uint32_t i = 0; i < count; ++i) {
+				job(i);
+			}
+		}
+	};
+
+	struct Task {
+		uint32_t group;
+		uint32_t begin;
+		uint32_t end;
+	};
+	std::vector<Task> tasks;
+
+	// ParticleSystemと同じくグループ×チャンクでジョブを作る
+	auto buildTasks = [&]() {
+		tasks.clear();
+		for (uint32_t g = 0; g < groupCount; ++g) {
+			const uint32_t count = storages[g].GetCount();
+			for (uint32_t begin = 0; begin < count; begin += ParticleKernels::kChunkSize) {
+				tasks.push_back({ g, begin, std::min(begin + ParticleKernels::kChunkSize, count) });
+			}
+		}
+	};
+
+	std::mt19937 engine(kSeed);
+
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		// 死んだ分を補充（発生はメインスレッドで逐次、計測に含めない）
+		for (auto& storage : storages) {
+			while (!storage.IsFull()) {
+				storage.Add(CreateParticle(engine));
+			}
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		buildTasks();
+		dispatch(static_cast<uint32_t>(tasks.size()), [&](uint32_t i) {
+			ParticleKernels::MarkExpired(storages[tasks[i].group], tasks[i].begin, tasks[i].end);
+		});
+
+		dispatch(groupCount, [&](uint32_t g) {
+			storages[g].Compact();
+		});
+
+		buildTasks();
+		dispatch(static_cast<uint32_t>(tasks.size()), [&](uint32_t i) {
+			ParticleStorage& storage = storages[tasks[i].group];
+			ParticleKernels::Simulate(storage, tasks[i].begin, tasks[i].end, kDeltaTime);
+			ParticleKernels::WriteInstances(storage, tasks[i].begin, tasks[i].end,
+				instances[tasks[i].group].data(), true);
+		});
+
+		result.totalMs += ElapsedMs(start);
+	}
+
+	for (uint32_t g = 0; g < groupCount; ++g) {
+		for (uint32_t i = 0; i < storages[g].GetCount(); ++i) {
+			result.checksum += instances[g][i].translate.x + instances[g][i].translate.y +
+				instances[g][i].translate.z + static_cast<float>(instances[g][i].color >> 24) / 255.0f;
+		}
+	}
+
+	FinalizeResult(result);
+	return result;
+}
+
+ParticleBenchmark::Result ParticleBenchmark::RunVisibility(uint32_t particleCount, uint32_t frameCount, bool cull, bool sort)
+{
+	Result result;
+	result.particleCount = particleCount;
+	result.frameCount = frameCount;
+
+	ParticleStorage storage;
+	storage.Initialize(particleCount);
+	std::vector<ParticleForGPU> instances(particleCount);
+	std::vector<uint32_t> visibleIndices(particleCount);
+	std::vector<uint32_t> keys(sort ? particleCount : 0);
+	std::vector<uint32_t> tempKeys(sort ? particleCount : 0);
+	std::vector<uint32_t> tempIndices(sort ? particleCount : 0);
+
+	// パーティクルの塊の端を斜めから見るカメラ（一部だけが視野に入る）
+	const Matrix4x4 view = Matrix4x4Inverse(MakeTranslateMatrix({ 2.0f, 0.0f, -4.0f }));
+	const Matrix4x4 projection = MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f);
+	const Matrix4x4 viewProjection = Matrix4x4Multiply(view, projection);
+	const ParticleFrustum frustum = ParticleKernels::MakeFrustum(viewProjection);
+
+	std::mt19937 engine(kSeed);
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		// 補充とシミュレーションは計測に含めない
+		while (!storage.IsFull()) {
+			storage.Add(CreateParticle(engine));
+		}
+		ParticleKernels::MarkExpired(storage, 0, storage.GetCount());
+		storage.Compact();
+		ParticleKernels::Simulate(storage, 0, storage.GetCount(), kDeltaTime);
+
+		auto start = std::chrono::steady_clock::now();
+
+		const uint32_t count = storage.GetCount();
+		uint32_t visibleCount = count;
+		if (cull || sort) {
+			visibleCount = ParticleKernels::CullVisible(storage, 0, count, cull ? &frustum : nullptr,
+				viewProjection, visibleIndices.data(), sort ? keys.data() : nullptr);
+			if (sort) {
+				ParticleKernels::RadixSort(keys.data(), visibleIndices.data(), visibleCount, tempKeys.data(), tempIndices.data());
+			}
+			ParticleKernels::WriteInstancesIndexed(storage, visibleIndices.data(), 0, visibleCount, instances.data(), true);
+		} else {
+			ParticleKernels::WriteInstances(storage, 0, count, instances.data(), true);
+		}
+
+		result.totalMs += ElapsedMs(start);
+		result.visibleCount = visibleCount;
+	}
+
+	for (uint32_t i = 0; i < result.visibleCount; ++i) {
+		result.checksum += static_cast<float>(instances[i].color >> 24) / 255.0f;
+	}
+
+	FinalizeResult(result);
+	return result;
+}
+
+ParticleBenchmark::Result ParticleBenchmark::RunPacking(uint32_t particleCount, uint32_t frameCount, bool compact, bool useBillboard)
+{
+	Result result;
+	result.particleCount = particleCount;
+	result.frameCount = frameCount;
+
+	ParticleStorage storage;
+	storage.Initialize(particleCount);
+	std::vector<ParticleForGPU> instances(compact ? particleCount : 0);
+	std::vector<LegacyParticleForGPU> legacyInstances(compact ? 0 : particleCount);
+
+	const Matrix4x4 view = Matrix4x4Inverse(MakeTranslateMatrix({ 0.0f, 0.0f, -4.0f }));
+	const Matrix4x4 projection = MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f);
+	const Matrix4x4 viewProjection = Matrix4x4Multiply(view, projection);
+	const Matrix4x4 billboard = MakeRotateYMatrix(0.5f);
+
+	std::mt19937 engine(kSeed);
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		// 補充とシミュレーションは計測に含めない
+		while (!storage.IsFull()) {
+			storage.Add(CreateParticle(engine));
+		}
+		ParticleKernels::MarkExpired(storage, 0, storage.GetCount());
+		storage.Compact();
+		ParticleKernels::Simulate(storage, 0, storage.GetCount(), kDeltaTime);
+
+		auto start = std::chrono::steady_clock::now();
+
+		const uint32_t count = storage.GetCount();
+		if (compact) {
+			ParticleKernels::WriteInstances(storage, 0, count, instances.data(), useBillboard);
+		} else {
+			WriteLegacyInstances(storage, count, legacyInstances.data(), viewProjection, billboard, useBillboard);
+		}
+
+		result.totalMs += ElapsedMs(start);
+		result.visibleCount = count;
+	}
+
+	// 書き込んだ位置の合計（どちらの形式でも同じ値になる）
+	for (uint32_t i = 0; i < result.visibleCount; ++i) {
+		if (compact) {
+			result.checksum += instances[i].translate.x + instances[i].translate.y + instances[i].translate.z;
+		} else {
+			result.checksum += legacyInstances[i].World.m[3][0] + legacyInstances[i].World.m[3][1] + legacyInstances[i].World.m[3][2];
+		}
+	}
+
+	FinalizeResult(result);
+	return result;
+}
+
+ParticleBenchmark::Result ParticleBenchmark::RunTrails(uint32_t particleCount, uint32_t frameCount, uint32_t trailLength, bool useTrail)
+{
+	Result result;
+	result.particleCount = particleCount;
+	result.frameCount = frameCount;
+
+	ParticleTrailSettings settings;
+	settings.enabled = useTrail;
+	settings.length = std::clamp(trailLength, ParticleTrailSettings::kMinLength, ParticleTrailSettings::kMaxLength);
+
+	// 追加パーティクルの場合は履歴の点の数だけパーティクルを増やす
+	const uint32_t storageCount = useTrail ? particleCount : particleCount * (settings.length + 1);
+	ParticleStorage storage;
+	storage.Initialize(storageCount);
+	if (useTrail) {
+		storage.EnableTrail(settings.length);
+	}
+	std::vector<ParticleForGPU> instances(storageCount);
+	std::vector<ParticleTrailVertex> vertices(useTrail ? static_cast<size_t>(particleCount) * settings.GetVertexCountPerTrail() : 0);
+	const Vector3 cameraPosition = { 0.0f, 0.0f, -4.0f };
+
+	std::mt19937 engine(kSeed);
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		// 補充は計測に含めない
+		while (!storage.IsFull()) {
+			storage.Add(CreateParticle(engine));
+		}
+		ParticleKernels::MarkExpired(storage, 0, storage.GetCount());
+		storage.Compact();
+
+		auto start = std::chrono::steady_clock::now();
+
+		const uint32_t count = storage.GetCount();
+		if (useTrail) {
+			storage.AdvanceTrailHead();
+			ParticleKernels::RecordTrail(storage, 0, count);
+		}
+		ParticleKernels::Simulate(storage, 0, count, kDeltaTime);
+		ParticleKernels::WriteInstances(storage, 0, count, instances.data(), true);
+		if (useTrail) {
+			ParticleKernels::WriteTrailVertices(storage, 0, count, settings, cameraPosition, vertices.data());
+		}
+
+		result.totalMs += ElapsedMs(start);
+		result.visibleCount = count;
+	}
+
+	for (uint32_t i = 0; i < result.visibleCount; ++i) {
+		result.checksum += instances[i].translate.x + instances[i].translate.y + instances[i].translate.z;
+	}
+
+	FinalizeResult(result);
+	return result;
+}
+
+ParticleBenchmark::Result ParticleBenchmark::RunField(uint32_t particleCount, uint32_t frameCount, FieldKind kind)
+{
+	Result result;
+	result.particleCount = particleCount;
+	result.frameCount = frameCount;
+
+	ParticleStorage storage;
+	storage.Initialize(particleCount);
+
+	// パーティクルは原点付近の±1に生成されるので、全て範囲に入る大きさにする
+	const AABB area = { { -2.0f, -2.0f, -2.0f }, { 2.0f, 2.0f, 2.0f } };
+	const Vector3 center = { 0.0f, 0.0f, 0.0f };
+	const std::shared_ptr<const CurlNoiseVolume> volume = CurlNoiseVolume::GetShared(1);
+
+	std::mt19937 engine(kSeed);
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		// 補充と寿命チェックは計測に含めない
+		while (!storage.IsFull()) {
+			storage.Add(CreateParticle(engine));
+		}
+		ParticleKernels::MarkExpired(storage, 0, storage.GetCount());
+
+		ParticleFieldSpan span;
+		span.positionX = storage.positionX.data();
+		span.positionY = storage.positionY.data();
+		span.positionZ = storage.positionZ.data();
+		span.velocityX = storage.velocityX.data();
+		span.velocityY = storage.velocityY.data();
+		span.velocityZ = storage.velocityZ.data();
+		span.killFlags = storage.killFlags.data();
+		span.begin = 0;
+		span.end = storage.GetCount();
+
+		auto start = std::chrono::steady_clock::now();
+
+		switch (kind) {
+		case FieldKind::Acceleration:
+			FieldKernels::ApplyAcceleration(span, area, { 0.0f, 1.0f, 0.0f }, kDeltaTime);
+			break;
+		case FieldKind::Gravity:
+			FieldKernels::ApplyGravity(span, center, 5.0f, 3.0f, 0.05f, kDeltaTime);
+			break;
+		case FieldKind::Vortex:
+			FieldKernels::ApplyVortex(span, center, { 0.0f, 1.0f, 0.0f }, 5.0f, 1.0f, 3.0f, 3.0f, kDeltaTime);
+			break;
+		case FieldKind::Turbulence:
+			FieldKernels::ApplyTurbulence(span, area, *volume, 4.0f, { 0.0f, frame * kDeltaTime, 0.0f }, 4.0f, kDeltaTime);
+			break;
+		case FieldKind::Drag:
+			FieldKernels::ApplyDrag(span, area, 1.0f, kDeltaTime);
+			break;
+		case FieldKind::KillPlane:
+			FieldKernels::ApplyKillPlane(span, { 0.0f, -0.9f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+			break;
+		default:
+			break;
+		}
+
+		result.totalMs += ElapsedMs(start);
+
+		storage.Compact();
+		ParticleKernels::Simulate(storage, 0, storage.GetCount(), kDeltaTime);
+		result.visibleCount = storage.GetCount();
+	}
+
+	for (uint32_t i = 0; i < storage.GetCount(); ++i) {
+		result.checksum += storage.velocityX[i] + storage.velocityY[i] + storage.velocityZ[i];
+	}
+
+	FinalizeResult(result);
+	return result;
+}
+
+bool ParticleBenchmark::VerifySubstepKill()
+{
+	constexpr float kDeltaTime = 1.0f / 60.0f;
+	constexpr uint32_t kFrameCount = 60;
+
+	// 1フレーム4刻み、1刻みで0.5進む（削除範囲の直径0.6を飛び越えない）ので、
+	// 多くのパーティクルは2刻み目以降に削除範囲に入る
+	ParticlePresetData preset;
+	preset.presetName = "SubstepKill";
+
+	ParticleGroupData& group = preset.groups.emplace_back();
+	group.groupName = "Group";
+	group.maxParticles = 1024;
+	group.substep.enabled = true;
+	group.substep.step = kDeltaTime / 4.0f;
+	group.substep.maxStepsPerFrame = 8;
+
+	// x = 0～1 から +x へ撃ち出し、数フレームで発生を止める
+	ParticleEmitterData emitter{};
+	emitter.emitterName = "Emitter";
+	emitter.targetGroupName = group.groupName;
+	emitter.emitCount = 64;
+	emitter.emitFrequency = kDeltaTime;
+	emitter.isEmitting = true;
+	emitter.particleLifeTimeMin = 10.0f;
+	emitter.particleLifeTimeMax = 10.0f;
+	emitter.emitDirection = { 1.0f, 0.0f, 0.0f };
+	emitter.initialSpeed = 120.0f;
+	emitter.useDirectionalEmit = true;
+	emitter.particleScaleMin = { 1.0f, 1.0f, 1.0f };
+	emitter.particleScaleMax = { 1.0f, 1.0f, 1.0f };
+	emitter.emitterLifeTime = kDeltaTime * 4.0f;
+	emitter.useEmitterLifeTime = true;
+	emitter.spawnArea = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } };
+	preset.emitters.push_back(emitter);
+
+	// 引き寄せない重力フィールド（削除範囲だけを使う）
+	ParticleFieldData field{};
+	field.fieldName = "Remove";
+	field.fieldType = "GravityField";
+	field.position = { 5.0f, 0.0f, 0.0f };
+	field.isEnabled = true;
+	field.parameters = { { "gravityStrength", 0.0f }, { "effectRadius", 1.0f }, { "deleteRadius", 0.3f } };
+	preset.fields.push_back(field);
+
+	ParticleHeadlessSimulation simulation;
+	simulation.Load(preset, 1);
+	uint32_t maxCount = 0;
+	for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+		simulation.Step(kDeltaTime);
+		maxCount = std::max(maxCount, simulation.GetActiveParticleCount());
+	}
+
+	const uint32_t remaining = simulation.GetActiveParticleCount();
+	Logger::Log(Logger::GetStream(),
+		std::format("Substep Kill: peak {} / remaining {}\n", maxCount, remaining));
+	return maxCount > 0 && remaining == 0;
+}
+
+bool ParticleBenchmark::RunAll(uint32_t particleCount, uint32_t frameCount)
+{
+	// AoS と SoA
+	LogResult("AoS", RunAoS(particleCount, frameCount));
+	LogResult("SoA", RunSoA(particleCount, frameCount));
+
+	// 同じ総数を16グループに分けて逐次・並列で更新（結果は一致するはず）
+	constexpr uint32_t kGroupCount = 16;
+	const uint32_t particlesPerGroup = std::max(particleCount / kGroupCount, 1u);
+	const Result serial = RunGroups(kGroupCount, particlesPerGroup, frameCount, false);
+	const Result parallel = RunGroups(kGroupCount, particlesPerGroup, frameCount, true);
+	LogResult("Serial", serial);
+	LogResult(std::format("Parallel x{}", JobSystem::GetInstance()->GetWorkerCount() + 1).c_str(), parallel);
+
+	// 可視判定・並べ替え
+	LogResult("Write All", RunVisibility(particleCount, frameCount, false, false));
+	LogResult("Cull", RunVisibility(particleCount, frameCount, true, false));
+	LogResult("Cull + Sort", RunVisibility(particleCount, frameCount, true, true));
+
+	// GPU転送用データの書き込み
+	LogResult(std::format("Matrix {} bytes", sizeof(LegacyParticleForGPU)).c_str(), RunPacking(particleCount, frameCount, false, true));
+	LogResult(std::format("Compact {} bytes", sizeof(ParticleForGPU)).c_str(), RunPacking(particleCount, frameCount, true, true));
+
+	// 軌跡と追加パーティクル
+	constexpr uint32_t kTrailLength = 8;
+	const uint32_t headCount = particleCount / (kTrailLength + 1);
+	LogResult("Trail", RunTrails(headCount, frameCount, kTrailLength, true));
+	LogResult("Extra Particles", RunTrails(headCount, frameCount, kTrailLength, false));
+
+	// フィールドの一括カーネル
+	for (size_t kind = 0; kind < static_cast<size_t>(FieldKind::Count); ++kind) {
+		LogResult(kFieldKindNames[kind], RunField(particleCount, frameCount, static_cast<FieldKind>(kind)));
+	}
+
+	// サブステップ中の削除が次のフレームまで残るか
+	const bool substepKillPassed = VerifySubstepKill();
+
+	const bool passed = serial.checksum == parallel.checksum && substepKillPassed;
+	Logger::Log(Logger::GetStream(), std::format("ParticleBenchmark: {}\n", passed ? "PASSED" : "FAILED"));
+	return passed;
+}
+
+void ParticleBenchmark::LogResult(const char* label, const Result& result)
+{
+	Logger::Log(Logger::GetStream(),
+		std::format("ParticleBenchmark [{}]: {} particles x {} frames, {:.3f} ms ({:.1f} particles/ms, checksum {:.3f})\n",
+			label, result.particleCount, result.frameCount, result.totalMs, result.particlesPerMs, result.checksum));
+}
+
+void ParticleBenchmark::ImGui()
+{
+#ifdef USEIMGUI
+	ImGui::DragInt("Particle Count", &particleCount_, 1000.0f, 1000, 1000000);
+	ImGui::DragInt("Frame Count", &frameCount_, 1.0f, 1, 10000);
+
+	if (ImGui::Button("Run AoS vs SoA")) {
+		aosResult_ = RunAoS(static_cast<uint32_t>(particleCount_), static_cast<uint32_t>(frameCount_));
+		soaResult_ = RunSoA(static_cast<uint32_t>(particleCount_), static_cast<uint32_t>(frameCount_));
+		hasResult_ = true;
+
+		LogResult("AoS", aosResult_);
+		LogResult("SoA", soaResult_);
+	}
+
+	if (hasResult_) {
+		ImGui::Text("AoS: %.3f ms (%.1f particles/ms)", aosResult_.totalMs, aosResult_.particlesPerMs);
+		ImGui::Text("SoA: %.3f ms (%.1f particles/ms)", soaResult_.totalMs, soaResult_.particlesPerMs);
+		if (soaResult_.totalMs > 0.0) {
+			ImGui::Text("Speedup: x%.2f", aosResult_.totalMs / soaResult_.totalMs);
+		}
+		ImGui::Text("Checksum: %.3f / %.3f", aosResult_.checksum, soaResult_.checksum);
+	}
+
+	ImGui::Separator();
+
+	// N グループ × M パーティクルの並列更新
+	ImGui::DragInt("Groups", &groupCount_, 1.0f, 1, 256);
+	ImGui::DragInt("Particles / Group", &particlesPerGroup_, 100.0f, 100, 1000000);
+
+	if (ImGui::Button("Run Serial vs Parallel")) {
+		serialResult_ = RunGroups(static_cast<uint32_t>(groupCount_), static_cast<uint32_t>(particlesPerGroup_),
+			static_cast<uint32_t>(frameCount_), false);
+		parallelResult_ = RunGroups(static_cast<uint32_t>(groupCount_), static_cast<uint32_t>(particlesPerGroup_),
+			static_cast<uint32_t>(frameCount_), true);
+		hasGroupResult_ = true;
+
+		LogResult("Serial", serialResult_);
+		LogResult(std::format("Parallel x{}", JobSystem::GetInstance()->GetWorkerCount() + 1).c_str(), parallelResult_);
+	}
+
+	if (hasGroupResult_) {
+		ImGui::Text("Serial:   %.3f ms (%.1f particles/ms)", serialResult_.totalMs, serialResult_.particlesPerMs);
+		ImGui::Text("Parallel: %.3f ms (%.1f particles/ms)", parallelResult_.totalMs, parallelResult_.particlesPerMs);
+		if (parallelResult_.totalMs > 0.0) {
+			ImGui::Text("Speedup: x%.2f", serialResult_.totalMs / parallelResult_.totalMs);
+		}
+		ImGui::Text("Checksum: %.3f / %.3f", serialResult_.checksum, parallelResult_.checksum);
+	}
+
+	ImGui::Separator();
+
+	// 可視判定・並べ替えのコスト（Particle Countのパーティクルで計測）
+	if (ImGui::Button("Run Write All vs Cull vs Cull + Sort")) {
+		writeAllResult_ = RunVisibility(static_cast<uint32_t>(particleCount_), static_cast<uint32_t>(frameCount_), false, false);
+		cullResult_ = RunVisibility(static_cast<uint32_t>(particleCount_), static_cast<uint32_t>(frameCount_), true, false);
+		cullSortResult_ = RunVisibility(static_cast<uint32_t>(particleCount_), static_cast<uint32_t>(frameCount_), true, true);
+		hasVisibilityResult_ = true;
+
+		LogResult("Write All", writeAllResult_);
+		LogResult(std::format("Cull ({} visible)", cullResult_.visibleCount).c_str(), cullResult_);
+		LogResult(std::format("Cull + Sort ({} visible)", cullSortResult_.visibleCount).c_str(), cullSortResult_);
+	}
+
+	if (hasVisibilityResult_) {
+		ImGui::Text("Write All:   %.3f ms (%u written)", writeAllResult_.totalMs, writeAllResult_.visibleCount);
+		ImGui::Text("Cull:        %.3f ms (%u written)", cullResult_.totalMs, cullResult_.visibleCount);
+		ImGui::Text("Cull + Sort: %.3f ms (%u written)", cullSortResult_.totalMs, cullSortResult_.visibleCount);
+	}
+
+	ImGui::Separator();
+
+	// GPU転送用データの書き込みだけのコスト（行列144byte vs 詰めた32byte）
+	ImGui::Checkbox("Packing Billboard", &packingBillboard_);
+	if (ImGui::Button("Run Matrix vs Compact")) {
+		matrixPackingResult_ = RunPacking(static_cast<uint32_t>(particleCount_), static_cast<uint32_t>(frameCount_), false, packingBillboard_);
+		compactPackingResult_ = RunPacking(static_cast<uint32_t>(particleCount_), static_cast<uint32_t>(frameCount_), true, packingBillboard_);
+		hasPackingResult_ = true;
+
+		LogResult(std::format("Matrix {} bytes", sizeof(LegacyParticleForGPU)).c_str(), matrixPackingResult_);
+		LogResult(std::format("Compact {} bytes", sizeof(ParticleForGPU)).c_str(), compactPackingResult_);
+	}
+
+	if (hasPackingResult_) {
+		ImGui::Text("Matrix:  %.3f ms (%zu KB/frame)", matrixPackingResult_.totalMs,
+			sizeof(LegacyParticleForGPU) * matrixPackingResult_.particleCount / 1024);
+		ImGui::Text("Compact: %.3f ms (%zu KB/frame)", compactPackingResult_.totalMs,
+			sizeof(ParticleForGPU) * compactPackingResult_.particleCount / 1024);
+		if (compactPackingResult_.totalMs > 0.0) {
+			ImGui::Text("Speedup: x%.2f", matrixPackingResult_.totalMs / compactPackingResult_.totalMs);
+		}
+		ImGui::Text("Checksum: %.3f / %.3f", matrixPackingResult_.checksum, compactPackingResult_.checksum);
+	}
+
+	ImGui::Separator();
+
+	// 軌跡のコスト（同じ点数を追加のパーティクルで出す場合と比較）
+	ImGui::SliderInt("Trail Length", &trailLength_, ParticleTrailSettings::kMinLength, ParticleTrailSettings::kMaxLength);
+	if (ImGui::Button("Run Trail vs Extra Particles")) {
+		const uint32_t headCount = static_cast<uint32_t>(particleCount_) / static_cast<uint32_t>(trailLength_ + 1);
+		trailResult_ = RunTrails(headCount, static_cast<uint32_t>(frameCount_), static_cast<uint32_t>(trailLength_), true);
+		extraParticleResult_ = RunTrails(headCount, static_cast<uint32_t>(frameCount_), static_cast<uint32_t>(trailLength_), false);
+		hasTrailResult_ = true;
+
+		LogResult("Trail", trailResult_);
+		LogResult("Extra Particles", extraParticleResult_);
+	}
+
+	if (hasTrailResult_) {
+		ImGui::Text("Trail:           %.3f ms (%u heads)", trailResult_.totalMs, trailResult_.visibleCount);
+		ImGui::Text("Extra Particles: %.3f ms (%u particles)", extraParticleResult_.totalMs, extraParticleResult_.visibleCount);
+		if (trailResult_.totalMs > 0.0) {
+			ImGui::Text("Speedup: x%.2f", extraParticleResult_.totalMs / trailResult_.totalMs);
+		}
+	}
+
+	ImGui::Separator();
+
+	// フィールドの種類ごとの一括カーネルのコスト
+	if (ImGui::Button("Run Field Kernels")) {
+		for (size_t kind = 0; kind < static_cast<size_t>(FieldKind::Count); ++kind) {
+			fieldResults_[kind] = RunField(static_cast<uint32_t>(particleCount_), static_cast<uint32_t>(frameCount_),
+				static_cast<FieldKind>(kind));
+			LogResult(kFieldKindNames[kind], fieldResults_[kind]);
+		}
+		hasFieldResult_ = true;
+	}
+
+	if (hasFieldResult_) {
+		for (size_t kind = 0; kind < static_cast<size_t>(FieldKind::Count); ++kind) {
+			ImGui::Text("%-12s %.3f ms (%.1f particles/ms)", kFieldKindNames[kind],
+				fieldResults_[kind].totalMs, fieldResults_[kind].particlesPerMs);
+		}
+	}
+
+	ImGui::Separator();
+
+	// プリセットをGPU無しで固定刻み再生し、フレーム毎のハッシュを基準と比較する
+	ImGui::Text("Headless Replay");
+	ImGui::InputText("Preset", replayPresetName_, sizeof(replayPresetName_));
+	ImGui::InputInt("Seed", &replaySeed_);
+	ImGui::DragInt("Replay Frames", &replayFrameCount_, 1.0f, 1, 100000);
+
+	const std::string presetPath = std::string("resources/ParticlePresets/") + replayPresetName_ + ".json";
+	const std::string baselinePath = std::string("resources/ParticlePresets/") + replayPresetName_ + ".replay.txt";
+
+	if (ImGui::Button("Run Replay")) {
+		hasReplayResult_ = ParticleHeadlessSimulation::RunPresetFile(presetPath, static_cast<uint64_t>(replaySeed_),
+			static_cast<uint32_t>(replayFrameCount_), 1.0f / 60.0f, replayResult_);
+		hasReplayCompare_ = false;
+
+		if (hasReplayResult_) {
+			Logger::Log(Logger::GetStream(),
+				std::format("ParticleBenchmark [Replay {}]: {} frames, {} updates, {:.3f} ms ({:.1f} particles/ms), final hash {:016x}\n",
+					replayPresetName_, replayResult_.frameCount, replayResult_.particleUpdates, replayResult_.totalMs,
+					replayResult_.particlesPerMs, replayResult_.frameHashes.empty() ? 0 : replayResult_.frameHashes.back()));
+		} else {
+			Logger::Log(Logger::GetStream(),
+				std::format("ParticleBenchmark [Replay]: Failed to load preset: {}\n", presetPath));
+		}
+	}
+
+	if (hasReplayResult_) {
+		ImGui::SameLine();
+		if (ImGui::Button("Save Baseline")) {
+			ParticleHeadlessSimulation::SaveHashes(baselinePath, replayResult_);
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Compare Baseline")) {
+			replayCompareResult_ = ParticleHeadlessSimulation::CompareHashes(baselinePath, replayResult_);
+			hasReplayCompare_ = true;
+
+			Logger::Log(Logger::GetStream(),
+				std::format("ParticleBenchmark [Replay {}]: Compare result {}\n", replayPresetName_, replayCompareResult_));
+		}
+
+		ImGui::Text("Replay: %.3f ms (%.1f particles/ms)", replayResult_.totalMs, replayResult_.particlesPerMs);
+		if (!replayResult_.frameHashes.empty()) {
+			ImGui::Text("Final Hash: %016llx", static_cast<unsigned long long>(replayResult_.frameHashes.back()));
+		}
+	}
+
+	if (hasReplayCompare_) {
+		if (replayCompareResult_ == -1) {
+			ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f), "Baseline: Match");
+		} else if (replayCompareResult_ == -2) {
+			ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.4f, 1.0f), "Baseline: Not Found");
+		} else {
+			ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Baseline: Mismatch at frame %d", replayCompareResult_);
+		}
+	}
+#endif
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "ParticleHeadlessSimulation.h"
+
+/// <summary>
+/// パーティクル更新のマイクロベンチマーク
+/// <para>DirectXに依存しない更新部分だけを計測する（描画・GPU転送は含まない）</para>
+/// <para>従来のAoS（ParticleState配列）とSoA + SIMDカーネルを同じ入力で比較する</para>
+/// </summary>
+class ParticleBenchmark
+{
+public:
+	/// <summary>
+	/// 計測結果
+	/// </summary>
+	struct Result {
+		uint32_t particleCount = 0;		// パーティクル数
+		uint32_t frameCount = 0;		// 更新フレーム数
+		double totalMs = 0.0;			// 更新にかかった合計時間（ミリ秒）
+		double particlesPerMs = 0.0;	// 1ミリ秒あたりの更新パーティクル数
+		double checksum = 0.0;			// 結果検証用（位置とαの合計）
+		uint32_t visibleCount = 0;		// 最終フレームの可視数（カリングの計測のみ）
+	};
+
+	/// <summary>
+	/// 従来のAoS更新（パーティクル毎にboolで分岐）を計測
+	/// </summary>
+	/// <param name="particleCount">同時に存在するパーティクル数</param>
+	/// <param name="frameCount">更新フレーム数</param>
+	static Result RunAoS(uint32_t particleCount, uint32_t frameCount);
+
+	/// <summary>
+	/// SoA + SIMDカーネル（グループ単位のモード）の更新を計測
+	/// </summary>
+	/// <param name="particleCount">同時に存在するパーティクル数</param>
+	/// <param name="frameCount">更新フレーム数</param>
+	static Result RunSoA(uint32_t particleCount, uint32_t frameCount);
+
+	/// <summary>
+	/// N グループ × M パーティクルを、ParticleSystemと同じフェーズ分割で更新して計測
+	/// <para>GPU書き込みはCPU側の配列で代用する（デバイス不要）</para>
+	/// </summary>
+	/// <param name="groupCount">グループ数</param>
+	/// <param name="particlesPerGroup">1グループあたりのパーティクル数</param>
+	/// <param name="frameCount">更新フレーム数</param>
+	/// <param name="useJobSystem">trueならJobSystemで並列実行、falseなら逐次実行</param>
+	static Result RunGroups(uint32_t groupCount, uint32_t particlesPerGroup, uint32_t frameCount, bool useJobSystem);
+
+	/// <summary>
+	/// シミュレーション後のGPU書き込み（可視判定・並べ替えを含む）だけを計測
+	/// <para>視野の一部だけにパーティクルが入るカメラで、全て書き込む場合と比較する</para>
+	/// </summary>
+	/// <param name="particleCount">パーティクル数</param>
+	/// <param name="frameCount">更新フレーム数</param>
+	/// <param name="cull">視錐台カリングをするか</param>
+	/// <param name="sort">奥から手前の順に並べ替えるか</param>
+	static Result RunVisibility(uint32_t particleCount, uint32_t frameCount, bool cull, bool sort);
+
+	/// <summary>
+	/// GPU転送用データの書き込みだけを計測
+	/// <para>従来の行列2つ＋色（144byte）と、位置・half・RGBA8に詰めた形式（32byte）を比較する</para>
+	/// </summary>
+	/// <param name="particleCount">パーティクル数</param>
+	/// <param name="frameCount">更新フレーム数</param>
+	/// <param name="compact">trueなら詰めた形式、falseなら従来の行列形式</param>
+	/// <param name="useBillboard">ビルボードとして書き込むか</param>
+	static Result RunPacking(uint32_t particleCount, uint32_t frameCount, bool compact, bool useBillboard);
+
+	/// <summary>
+	/// 軌跡（リボン）と、同じ見た目を追加のパーティクルで作る場合のCPU側のコストを比較
+	/// <para>軌跡：N個のシミュレーション＋履歴の記録＋帯の頂点書き込み</para>
+	/// <para>追加パーティクル：N×(点数+1)個のシミュレーション＋インスタンス書き込み</para>
+	/// </summary>
+	/// <param name="particleCount">軌跡の先頭になるパーティクル数</param>
+	/// <param name="frameCount">更新フレーム数</param>
+	/// <param name="trailLength">軌跡の点数</param>
+	/// <param name="useTrail">trueなら軌跡、falseなら追加パーティクル</param>
+	static Result RunTrails(uint32_t particleCount, uint32_t frameCount, uint32_t trailLength, bool useTrail);
+
+	/// <summary>
+	/// 計測するフィールドの種類
+	/// </summary>
+	enum class FieldKind {
+		Acceleration,
+		Gravity,
+		Vortex,
+		Turbulence,
+		Drag,
+		KillPlane,
+		Count
+	};
+
+	/// <summary>
+	/// フィールドの一括カーネルだけを計測（全パーティクルが効果範囲に入る配置）
+	/// </summary>
+	/// <param name="particleCount">パーティクル数</param>
+	/// <param name="frameCount">更新フレーム数</param>
+	/// <param name="kind">フィールドの種類</param>
+	static Result RunField(uint32_t particleCount, uint32_t frameCount, FieldKind kind);
+
+	/// <summary>
+	/// サブステップの途中でフィールドに消されたパーティクルが、次のフレームで復活しないかを確認
+	/// <para>削除範囲を1刻みで飛び越えない速さで撃ち出し、全て通過した後に1個も残っていなければ成功</para>
+	/// </summary>
+	/// <returns>全てのパーティクルが削除範囲で消えていれば true</returns>
+	static bool VerifySubstepKill();
+
+	/// <summary>
+	/// 全ての計測を実行してログに出す（ImGui を使わないコマンドラインからの実行用）
+	/// </summary>
+	/// <param name="particleCount">パーティクル数</param>
+	/// <param name="frameCount">更新フレーム数</param>
+	/// <returns>逐次と並列のグループ更新の結果（チェックサム）が一致し、サブステップの確認も通れば true</returns>
+	static bool RunAll(uint32_t particleCount = 100000, uint32_t frameCount = 300);
+
+	/// <summary>
+	/// ImGui用のデバッグ表示（実行ボタンと結果）
+	/// </summary>
+	void ImGui();
+
+private:
+	/// <summary>
+	/// 結果をログに出力
+	/// </summary>
+	static void LogResult(const char* label, const Result& result);
+
+	int particleCount_ = 100000;	// 計測するパーティクル数
+	int frameCount_ = 300;			// 計測するフレーム数
+	int groupCount_ = 16;			// 並列計測のグループ数
+	int particlesPerGroup_ = 20000;	// 並列計測の1グループあたりのパーティクル数
+
+	Result aosResult_;
+	Result soaResult_;
+	bool hasResult_ = false;
+
+	Result serialResult_;
+	Result parallelResult_;
+	bool hasGroupResult_ = false;
+
+	Result writeAllResult_;
+	Result cullResult_;
+	Result cullSortResult_;
+	bool hasVisibilityResult_ = false;
+
+	Result matrixPackingResult_;
+	Result compactPackingResult_;
+	bool packingBillboard_ = true;
+	bool hasPackingResult_ = false;
+
+	int trailLength_ = 8;
+	Result trailResult_;
+	Result extraParticleResult_;
+	bool hasTrailResult_ = false;
+
+	Result fieldResults_[static_cast<size_t>(FieldKind::Count)];
+	bool hasFieldResult_ = false;
+
+	// ヘッドレス再生（決定論モードの回帰確認）
+	char replayPresetName_[128] = "CenterEffect";
+	int replaySeed_ = 1;
+	int replayFrameCount_ = 600;
+	ParticleHeadlessSimulation::Result replayResult_;
+	bool hasReplayResult_ = false;
+	int32_t replayCompareResult_ = -1;	// CompareHashesの戻り値
+	bool hasReplayCompare_ = false;
+};
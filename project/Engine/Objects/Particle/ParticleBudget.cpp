@@ -0,0 +1,176 @@
+#define NOMINMAX
+#include "ParticleBudget.h"
+#ifdef USEIMGUI
+#include "ImGui/ImGuiManager.h"
+#endif
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+	constexpr const char* kPriorityNames[] = { "Low", "Normal", "High", "Critical" };
+	static_assert(std::size(kPriorityNames) == static_cast<size_t>(ParticlePriority::Count), "kPriorityNames must match ParticlePriority");
+}
+
+const char* ParticlePriorityUtil::GetName(ParticlePriority priority)
+{
+	const size_t index = static_cast<size_t>(priority);
+	return index < std::size(kPriorityNames) ? kPriorityNames[index] : kPriorityNames[1];
+}
+
+ParticlePriority ParticlePriorityUtil::FromName(const std::string& name)
+{
+	for (size_t i = 0; i < std::size(kPriorityNames); ++i) {
+		if (name == kPriorityNames[i]) {
+			return static_cast<ParticlePriority>(i);
+		}
+	}
+	return ParticlePriority::Normal;
+}
+
+void ParticleBudget::BeginFrame()
+{
+	stats_ = ParticleBudgetStats{};
+}
+
+void ParticleBudget::BeginStep(uint32_t liveParticles)
+{
+	requests_.clear();
+	stats_.liveParticles = liveParticles;
+
+	// 生存数の空きと1ステップの上限の小さい方
+	const uint32_t liveRoom = settings_.maxLiveParticles > liveParticles ? settings_.maxLiveParticles - liveParticles : 0;
+	remaining_ = std::min(liveRoom, settings_.maxSpawnPerFrame);
+}
+
+float ParticleBudget::ComputeLodRate(float distance, ParticlePriority priority, bool useDistanceLod) const
+{
+	if (!settings_.useDistanceLod || !useDistanceLod || priority == ParticlePriority::Critical) {
+		return 1.0f;
+	}
+
+	if (settings_.lodCullDistance > 0.0f && distance >= settings_.lodCullDistance) {
+		return 0.0f;
+	}
+	if (distance <= settings_.lodNearDistance) {
+		return 1.0f;
+	}
+	if (distance >= settings_.lodFarDistance || settings_.lodFarDistance <= settings_.lodNearDistance) {
+		return settings_.lodMinRate;
+	}
+
+	// 近距離～遠距離の間は線形に減らす
+	const float t = (distance - settings_.lodNearDistance) / (settings_.lodFarDistance - settings_.lodNearDistance);
+	return 1.0f + (settings_.lodMinRate - 1.0f) * t;
+}
+
+uint32_t ParticleBudget::AddRequest(ParticlePriority priority, uint32_t requested, uint32_t desired)
+{
+	desired = std::min(desired, requested);
+
+	const size_t level = static_cast<size_t>(priority);
+	if (requested > 0) {
+		++stats_.emitterCount;
+	}
+	stats_.requested += requested;
+	stats_.droppedByLod += requested - desired;
+	stats_.requestedByPriority[level] += requested;
+
+	requests_.push_back({ priority, desired, 0 });
+	return static_cast<uint32_t>(requests_.size() - 1);
+}
+
+void ParticleBudget::Resolve()
+{
+	// 優先度の高い方から割り当てる
+	for (size_t level = static_cast<size_t>(ParticlePriority::Count); level-- > 0;) {
+		const ParticlePriority priority = static_cast<ParticlePriority>(level);
+
+		uint64_t total = 0;
+		for (const Request& request : requests_) {
+			if (request.priority == priority) {
+				total += request.desired;
+			}
+		}
+		if (total == 0) {
+			continue;
+		}
+
+		uint32_t levelGranted = 0;
+		if (total <= remaining_) {
+			// 全て割り当てられる
+			for (Request& request : requests_) {
+				if (request.priority == priority) {
+					request.granted = request.desired;
+				}
+			}
+			levelGranted = static_cast<uint32_t>(total);
+		} else {
+			// 足りないので要求数に比例して配分し、端数は要求順に1つずつ配る
+			for (Request& request : requests_) {
+				if (request.priority == priority) {
+					request.granted = static_cast<uint32_t>(request.desired * static_cast<uint64_t>(remaining_) / total);
+					levelGranted += request.granted;
+				}
+			}
+			for (Request& request : requests_) {
+				if (levelGranted >= remaining_) {
+					break;
+				}
+				if (request.priority == priority && request.granted < request.desired) {
+					++request.granted;
+					++levelGranted;
+				}
+			}
+		}
+
+		remaining_ -= levelGranted;
+		stats_.granted += levelGranted;
+		stats_.droppedByBudget += static_cast<uint32_t>(total) - levelGranted;
+		stats_.grantedByPriority[level] += levelGranted;
+	}
+}
+
+void ParticleBudget::ReportSpawned(uint32_t granted, uint32_t spawned)
+{
+	stats_.spawned += spawned;
+	stats_.droppedByGroupFull += granted > spawned ? granted - spawned : 0;
+}
+
+void ParticleBudget::ImGui()
+{
+#ifdef USEIMGUI
+	// 設定
+	int maxLive = static_cast<int>(settings_.maxLiveParticles);
+	if (ImGui::DragInt("Max Live Particles", &maxLive, 64.0f, 0, 1 << 24)) {
+		settings_.maxLiveParticles = static_cast<uint32_t>(std::max(maxLive, 0));
+	}
+	int maxSpawn = static_cast<int>(settings_.maxSpawnPerFrame);
+	if (ImGui::DragInt("Max Spawn / Frame", &maxSpawn, 16.0f, 0, 1 << 20)) {
+		settings_.maxSpawnPerFrame = static_cast<uint32_t>(std::max(maxSpawn, 0));
+	}
+	ImGui::Checkbox("Distance LOD", &settings_.useDistanceLod);
+	if (settings_.useDistanceLod) {
+		ImGui::DragFloat("LOD Near", &settings_.lodNearDistance, 0.5f, 0.0f, settings_.lodFarDistance);
+		ImGui::DragFloat("LOD Far", &settings_.lodFarDistance, 0.5f, settings_.lodNearDistance, 10000.0f);
+		ImGui::SliderFloat("LOD Min Rate", &settings_.lodMinRate, 0.0f, 1.0f);
+		ImGui::DragFloat("LOD Cull (0 = off)", &settings_.lodCullDistance, 1.0f, 0.0f, 10000.0f);
+	}
+
+	ImGui::Separator();
+
+	// 直近フレームの集計
+	const ParticleBudgetStats& stats = stats_;
+	ImGui::Text("Live: %u / %u", stats.liveParticles, settings_.maxLiveParticles);
+	ImGui::Text("Emitters: %u  Requested: %u  Granted: %u  Spawned: %u",
+		stats.emitterCount, stats.requested, stats.granted, stats.spawned);
+	ImGui::Text("Dropped  LOD: %u  Budget: %u  Group Full: %u",
+		stats.droppedByLod, stats.droppedByBudget, stats.droppedByGroupFull);
+	for (size_t level = 0; level < static_cast<size_t>(ParticlePriority::Count); ++level) {
+		if (stats.requestedByPriority[level] == 0) {
+			continue;
+		}
+		ImGui::Text("  %-8s %u / %u", kPriorityNames[level], stats.grantedByPriority[level], stats.requestedByPriority[level]);
+	}
+#endif
+}
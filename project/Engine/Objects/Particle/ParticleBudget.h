@@ -0,0 +1,135 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// エミッターの優先度（予算が足りない時は高い方から割り当てる）
+/// </summary>
+enum class ParticlePriority : uint8_t {
+	Low,
+	Normal,
+	High,
+	Critical,	// 距離LODで減らさない（プレイヤーの攻撃など、消えると困る演出用）
+	Count
+};
+
+namespace ParticlePriorityUtil {
+
+	/// <summary>
+	/// 保存・表示用の名前
+	/// </summary>
+	const char* GetName(ParticlePriority priority);
+
+	/// <summary>
+	/// 名前から優先度を取得（見つからなければNormal）
+	/// </summary>
+	ParticlePriority FromName(const std::string& name);
+}
+
+/// <summary>
+/// 全体のパーティクル予算の設定
+/// </summary>
+struct ParticleBudgetSettings {
+	uint32_t maxLiveParticles = 65536;	// 全グループ合計の生存数の上限
+	uint32_t maxSpawnPerFrame = 4096;	// 1ステップで発生させる数の上限
+
+	// 距離LOD（カメラから遠いエミッターほど発生数を減らす）
+	bool useDistanceLod = true;
+	float lodNearDistance = 30.0f;		// この距離までは減らさない
+	float lodFarDistance = 120.0f;		// この距離で最小倍率になる
+	float lodMinRate = 0.25f;			// 遠距離での発生数の倍率
+	float lodCullDistance = 250.0f;		// この距離より遠いと発生させない（0以下で無効）
+};
+
+/// <summary>
+/// 予算の集計（1フレーム分、決定論モードで複数ステップ進んだ場合は合計）
+/// </summary>
+struct ParticleBudgetStats {
+	uint32_t liveParticles = 0;			// ステップ開始時の生存数
+	uint32_t emitterCount = 0;			// 発生を要求したエミッター数
+	uint32_t requested = 0;				// エミッターが発生させようとした数
+	uint32_t granted = 0;				// 割り当てた数
+	uint32_t spawned = 0;				// 実際に追加できた数
+	uint32_t droppedByLod = 0;			// 距離LODで減らした数
+	uint32_t droppedByBudget = 0;		// 全体の予算が足りず減らした数
+	uint32_t droppedByGroupFull = 0;	// グループが満杯で追加できなかった数
+	std::array<uint32_t, static_cast<size_t>(ParticlePriority::Count)> requestedByPriority{};
+	std::array<uint32_t, static_cast<size_t>(ParticlePriority::Count)> grantedByPriority{};
+};
+
+/// <summary>
+/// 全体のパーティクル予算のスケジューラー
+/// <para>エミッター毎の発生要求を集め、生存数・1ステップの発生数の上限に収まるよう優先度順に割り当てる</para>
+/// <para>同じ優先度で足りない場合は要求数に比例して配分する（端数は要求順）</para>
+/// <para>DirectXに依存しないので、ヘッドレスでも使用できる</para>
+/// </summary>
+class ParticleBudget
+{
+public:
+	/// <summary>
+	/// フレームの開始（集計をリセット）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// ステップの開始（要求をクリアし、今回発生できる残り数を計算）
+	/// </summary>
+	/// <param name="liveParticles">現在の全グループ合計の生存数</param>
+	void BeginStep(uint32_t liveParticles);
+
+	/// <summary>
+	/// カメラからの距離に応じた発生数の倍率（0～1）
+	/// </summary>
+	/// <param name="distance">カメラからエミッターまでの距離</param>
+	/// <param name="priority">優先度（Criticalは減らさない）</param>
+	/// <param name="useDistanceLod">エミッター側で距離LODを使うか</param>
+	float ComputeLodRate(float distance, ParticlePriority priority, bool useDistanceLod) const;
+
+	/// <summary>
+	/// 発生要求を登録
+	/// </summary>
+	/// <param name="priority">優先度</param>
+	/// <param name="requested">エミッターが発生させようとした数</param>
+	/// <param name="desired">距離LODを掛けた後の数</param>
+	/// <returns>割り当て結果の取得に使う番号</returns>
+	uint32_t AddRequest(ParticlePriority priority, uint32_t requested, uint32_t desired);
+
+	/// <summary>
+	/// 登録された要求に割り当てる
+	/// </summary>
+	void Resolve();
+
+	/// <summary>
+	/// 割り当てられた数（Resolve後に使用）
+	/// </summary>
+	uint32_t GetGrant(uint32_t ticket) const { return requests_[ticket].granted; }
+
+	/// <summary>
+	/// 実際に追加できた数を報告（グループ満杯での損失を集計する）
+	/// </summary>
+	void ReportSpawned(uint32_t granted, uint32_t spawned);
+
+	/// <summary>
+	/// ImGui用のデバッグ表示（設定と直近フレームの集計）
+	/// </summary>
+	void ImGui();
+
+	ParticleBudgetSettings& GetSettings() { return settings_; }
+	const ParticleBudgetSettings& GetSettings() const { return settings_; }
+	const ParticleBudgetStats& GetStats() const { return stats_; }
+
+private:
+	// 1エミッター分の要求
+	struct Request {
+		ParticlePriority priority;
+		uint32_t desired;
+		uint32_t granted;
+	};
+
+	ParticleBudgetSettings settings_;
+	ParticleBudgetStats stats_;
+	std::vector<Request> requests_;
+	uint32_t remaining_ = 0;	// 今回のステップで割り当てられる残り数
+};
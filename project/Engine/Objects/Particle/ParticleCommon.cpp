@@ -22,4 +22,12 @@ void ParticleCommon::setCommonRenderSettings()
 	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
 
-
+void ParticleCommon::setTrailRenderSettings()
+{
+	ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+	// 軌跡用のPSOを設定
+	commandList->SetGraphicsRootSignature(dxCommon_->GetParticleTrailRootSignature());
+	commandList->SetPipelineState(dxCommon_->GetParticleTrailPipelineState());
+	// プリミティブトポロジを設定
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
\ No newline at end of file
@@ -27,6 +27,11 @@ public:
 	/// </summary>
 	void setCommonRenderSettings();
 
+	/// <summary>
+	/// 軌跡（リボン）の描画設定
+	/// </summary>
+	void setTrailRenderSettings();
+
 private:
 
 	// コンストラクタ
@@ -1,6 +1,10 @@
 #include "ParticleEditor.h"
 #include "AccelerationField.h"
 #include "GravityField.h"
+#include "VortexField.h"
+#include "TurbulenceField.h"
+#include "DragField.h"
+#include "KillPlaneField.h"
 #include "Logger.h"
 #include "ImGui/ImGuiManager.h"
 #include <format>
@@ -28,6 +32,15 @@ void ParticleEditor::Initialize(DirectXCommon* dxCommon)
 	Logger::Log(Logger::GetStream(), "[ParticleEditor] Initialized\n");
 }
 
+void ParticleEditor::Update()
+{
+	// 外部で書き換えられたプリセットファイルを定期的に検出する
+	if (++presetWatchFrame_ >= kPresetWatchInterval_) {
+		presetWatchFrame_ = 0;
+		RefreshChangedPresets();
+	}
+}
+
 void ParticleEditor::ImGui()
 {
 #ifdef USEIMGUI
@@ -312,7 +325,7 @@ void ParticleEditor::ShowCreateFieldDialog()
 		// フィールドタイプ選択
 		ImGui::Text("Field Type:");
 		ImGui::Combo("##FieldType", &fieldCreationData_.fieldTypeIndex,
-			fieldCreationData_.fieldTypes, 2);
+			fieldCreationData_.fieldTypes, IM_ARRAYSIZE(fieldCreationData_.fieldTypes));
 
 		ImGui::Spacing();
 		ImGui::Separator();
@@ -808,6 +821,38 @@ void ParticleEditor::ShowPresetManagerTab()
 			ImGui::TextWrapped("Creates a new instance that can be "
 				"placed and configured independently.");
 
+			ImGui::Spacing();
+			ImGui::Separator();
+			ImGui::Spacing();
+
+			// インスタンスプール
+			ImGui::Text("Instance Pool");
+			auto poolIt = instancePools_.find(presetName);
+			size_t pooledCount = poolIt != instancePools_.end() ? poolIt->second.size() : 0;
+			ImGui::Text("Pooled: %zu  Cached: %s", pooledCount,
+				presetCache_.contains(presetName) ? "Yes" : "No");
+
+			static int prewarmCount = 4;
+			ImGui::InputInt("Prewarm Count", &prewarmCount);
+			if (prewarmCount < 0) {
+				prewarmCount = 0;
+			}
+			if (ImGui::Button("Prewarm Instances", ImVec2(-1, 0))) {
+				PrewarmInstances(presetName, static_cast<uint32_t>(prewarmCount));
+			}
+			ImGui::TextWrapped("Pre-creates instances so that CreateInstance "
+				"reuses them without loading files or allocating buffers.");
+
+			ImGui::Text("Cache Hits: %u  Misses: %u  Pooled Spawns: %u",
+				presetCacheHitCount_, presetCacheMissCount_, pooledSpawnCount_);
+			if (ImGui::Button("Release Pool")) {
+				ReleaseInstancePool();
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Reload Changed Presets")) {
+				RefreshChangedPresets();
+			}
+
 		}
 		// ========================================
 		// プリセット編集モードの場合
@@ -1056,6 +1101,14 @@ BaseField* ParticleEditor::CreateFieldByTypeName(const std::string& typeName, co
 		return particleSystem_->CreateField<AccelerationField>(fieldName);
 	} else if (typeName == "GravityField") {
 		return particleSystem_->CreateField<GravityField>(fieldName);
+	} else if (typeName == "VortexField") {
+		return particleSystem_->CreateField<VortexField>(fieldName);
+	} else if (typeName == "TurbulenceField") {
+		return particleSystem_->CreateField<TurbulenceField>(fieldName);
+	} else if (typeName == "DragField") {
+		return particleSystem_->CreateField<DragField>(fieldName);
+	} else if (typeName == "KillPlaneField") {
+		return particleSystem_->CreateField<KillPlaneField>(fieldName);
 	}
 
 	Logger::Log(Logger::GetStream(),
@@ -1088,6 +1141,7 @@ bool ParticleEditor::DeletePreset(const std::string& presetName)
 	try {
 		if (std::filesystem::exists(filePath)) {
 			std::filesystem::remove(filePath);
+			InvalidatePreset(presetName);
 			Logger::Log(Logger::GetStream(),
 				std::format("[ParticleEditor] Deleted preset file: {}\n", filePath));
 			return true;
@@ -1111,6 +1165,9 @@ ParticleGroupData ParticleEditor::CreateGroupData(ParticleGroup* group) const
 	data.maxParticles = group->GetMaxParticleCount();
 	data.textureName = group->GetTextureName();
 	data.useBillboard = group->UseBillboard();
+	data.sortBackToFront = group->IsSortBackToFront();
+	data.trail = group->GetTrailSettings();
+	data.substep = group->GetSubstepSettings();
 	return data;
 }
 
@@ -1129,6 +1186,7 @@ ParticleEmitterData ParticleEditor::CreateEmitterData(ParticleEmitter* emitter)
 	data.emitCount = emitter->GetEmitCount();
 	data.emitFrequency = emitter->GetFrequency();
 	data.isEmitting = emitter->IsEmitting();
+	data.useContinuousEmission = emitter->IsUseContinuousEmission();
 
 	// パーティクル寿命を実際の値から取得
 	data.particleLifeTimeMin = emitter->GetParticleLifeTimeMin();
@@ -1163,18 +1221,20 @@ ParticleEmitterData ParticleEditor::CreateEmitterData(ParticleEmitter* emitter)
 
 	// Color Over Lifetime
 	data.enableColorOverLifetime = emitter->IsEnableColorOverLifetime();
-	data.particleStartColor = emitter->GetParticleStartColor();
-	data.particleEndColor = emitter->GetParticleEndColor();
+	data.colorGradient = emitter->GetColorGradient();
 
 	// Size Over Lifetime
 	data.enableSizeOverLifetime = emitter->IsEnableSizeOverLifetime();
-	data.particleStartScale = emitter->GetParticleStartScale();
-	data.particleEndScale = emitter->GetParticleEndScale();
+	data.sizeCurve = emitter->GetSizeCurve();
 
 	// Rotation
 	data.enableRotation = emitter->IsEnableRotation();
 	data.rotationSpeed = emitter->GetRotationSpeed();
 
+	// 予算
+	data.priority = emitter->GetPriority();
+	data.useDistanceLod = emitter->IsUseDistanceLod();
+
 	return data;
 }
 
@@ -1236,7 +1296,12 @@ bool ParticleEditor::SaveCurrentStateAsPreset(const std::string& presetName)
 
 	// ファイルに保存
 	std::string filePath = GetPresetFilePath(presetName);
-	return preset.SaveToFile(filePath);
+	if (!preset.SaveToFile(filePath)) {
+		return false;
+	}
+
+	InvalidatePreset(presetName);
+	return true;
 }
 
 bool ParticleEditor::SaveSelectedAsPreset(const std::string& presetName)
@@ -1315,6 +1380,7 @@ bool ParticleEditor::SaveSelectedAsPreset(const std::string& presetName)
 	bool success = preset.SaveToFile(filePath);
 
 	if (success) {
+		InvalidatePreset(presetName);
 		Logger::Log(Logger::GetStream(),
 			std::format("[ParticleEditor] Saved selected preset '{}': {} groups, {} emitters, {} fields\n",
 				presetName, preset.groups.size(), preset.emitters.size(), preset.fields.size()));
@@ -1328,8 +1394,71 @@ bool ParticleEditor::SaveSelectedAsPreset(const std::string& presetName)
 
 ParticlePresetData ParticleEditor::LoadPreset(const std::string& presetName)
 {
+	const ParticlePresetData* cached = GetCachedPreset(presetName);
+	return cached ? *cached : ParticlePresetData{};
+}
+
+const ParticlePresetData* ParticleEditor::GetCachedPreset(const std::string& presetName)
+{
+	auto it = presetCache_.find(presetName);
+	if (it != presetCache_.end()) {
+		++presetCacheHitCount_;
+		return &it->second.data;
+	}
+
+	// キャッシュに無いのでファイルから読み込む
+	++presetCacheMissCount_;
 	std::string filePath = GetPresetFilePath(presetName);
-	return ParticlePresetData::LoadFromFile(filePath);
+
+	std::error_code ec;
+	std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(filePath, ec);
+
+	ParticlePresetData data = ParticlePresetData::LoadFromFile(filePath);
+	if (ec || data.presetName.empty()) {
+		return nullptr;
+	}
+
+	PresetCacheEntry& entry = presetCache_[presetName];
+	entry.data = std::move(data);
+	entry.lastWriteTime = lastWriteTime;
+	return &entry.data;
+}
+
+void ParticleEditor::InvalidatePreset(const std::string& presetName)
+{
+	presetCache_.erase(presetName);
+
+	// 古いデータで作られた待機中のインスタンスは破棄する（使用中のものはそのまま）
+	auto poolIt = instancePools_.find(presetName);
+	if (poolIt != instancePools_.end()) {
+		for (auto& instance : poolIt->second) {
+			instance->Destroy();
+		}
+		instancePools_.erase(poolIt);
+	}
+
+	Logger::Log(Logger::GetStream(),
+		std::format("[ParticleEditor] Invalidated preset cache: {}\n", presetName));
+}
+
+void ParticleEditor::RefreshChangedPresets()
+{
+	// 変更されたプリセットを先に集める（InvalidatePresetがキャッシュを書き換えるため）
+	std::vector<std::string> changedPresets;
+	for (const auto& [presetName, entry] : presetCache_) {
+		std::error_code ec;
+		std::filesystem::file_time_type lastWriteTime =
+			std::filesystem::last_write_time(GetPresetFilePath(presetName), ec);
+
+		// 削除された場合も破棄する
+		if (ec || lastWriteTime != entry.lastWriteTime) {
+			changedPresets.push_back(presetName);
+		}
+	}
+
+	for (const std::string& presetName : changedPresets) {
+		InvalidatePreset(presetName);
+	}
 }
 
 // ========================================
@@ -1345,21 +1474,51 @@ ParticlePresetInstance* ParticleEditor::CreateInstance(const std::string& preset
 		return nullptr;
 	}
 
-	// プリセットを読み込み
-	ParticlePresetData presetData = LoadPreset(presetName);
-	if (presetData.presetName.empty()) {
+	// プリセットを取得（キャッシュ済みならファイルは読まない）
+	const ParticlePresetData* presetData = GetCachedPreset(presetName);
+	if (!presetData) {
 		Logger::Log(Logger::GetStream(),
 			std::format("[ParticleEditor] Failed to load preset: {}\n", presetName));
 		return nullptr;
 	}
 
-	// インスタンスを作成
+	// プリセット編集用のインスタンスは編集内容が残るのでプールを使わない
+	std::unique_ptr<ParticlePresetInstance> instance;
+	if (instanceName != kPresetEditInstanceName_) {
+		instance = AcquirePooledInstance(presetName);
+	}
+
+	if (instance) {
+		// プールから再利用（グループ・エミッター・フィールドは確保済み）
+		instance->SetInstanceName(instanceName);
+		ResetInstance(instance.get(), *presetData);
+		++pooledSpawnCount_;
+	} else {
+		instance = BuildInstance(*presetData, presetName, MakeUniqueObjectPrefix(instanceName));
+		instance->SetInstanceName(instanceName);
+
+		Logger::Log(Logger::GetStream(),
+			std::format("[ParticleEditor] Successfully created instance '{}' from preset '{}'\n",
+				instanceName, presetName));
+	}
+
+	// インスタンスを登録
+	ParticlePresetInstance* instancePtr = instance.get();
+	instances_[instanceName] = std::move(instance);
+
+	return instancePtr;
+}
+
+std::unique_ptr<ParticlePresetInstance> ParticleEditor::BuildInstance(const ParticlePresetData& presetData,
+	const std::string& presetName, const std::string& objectPrefix)
+{
 	auto instance = std::make_unique<ParticlePresetInstance>();
-	instance->Initialize(instanceName, particleSystem_);
+	instance->Initialize(objectPrefix, particleSystem_);
+	instance->SetPresetName(presetName);
 
 	// グループを作成
 	for (const auto& groupData : presetData.groups) {
-		std::string uniqueName = MakeUniqueName(instanceName, groupData.groupName);
+		std::string uniqueName = MakeUniqueName(objectPrefix, groupData.groupName);
 
 		bool success = particleSystem_->CreateGroup(
 			uniqueName,
@@ -1370,6 +1529,7 @@ ParticlePresetInstance* ParticleEditor::CreateInstance(const std::string& preset
 		);
 
 		if (success) {
+			ApplyGroupData(particleSystem_->GetGroup(uniqueName), groupData);
 			instance->RegisterGroup(groupData.groupName, uniqueName);
 		} else {
 			Logger::Log(Logger::GetStream(),
@@ -1379,8 +1539,8 @@ ParticlePresetInstance* ParticleEditor::CreateInstance(const std::string& preset
 
 	// エミッターを作成
 	for (const auto& emitterData : presetData.emitters) {
-		std::string uniqueName = MakeUniqueName(instanceName, emitterData.emitterName);
-		std::string targetGroupUniqueName = MakeUniqueName(instanceName, emitterData.targetGroupName);
+		std::string uniqueName = MakeUniqueName(objectPrefix, emitterData.emitterName);
+		std::string targetGroupUniqueName = MakeUniqueName(objectPrefix, emitterData.targetGroupName);
 
 		ParticleEmitter* emitter = particleSystem_->CreateEmitter(uniqueName, targetGroupUniqueName);
 		if (emitter) {
@@ -1394,7 +1554,7 @@ ParticlePresetInstance* ParticleEditor::CreateInstance(const std::string& preset
 
 	// フィールドを作成
 	for (const auto& fieldData : presetData.fields) {
-		std::string uniqueName = MakeUniqueName(instanceName, fieldData.fieldName);
+		std::string uniqueName = MakeUniqueName(objectPrefix, fieldData.fieldName);
 
 		BaseField* field = CreateFieldByTypeName(fieldData.fieldType, uniqueName);
 		if (field) {
@@ -1406,15 +1566,116 @@ ParticlePresetInstance* ParticleEditor::CreateInstance(const std::string& preset
 		}
 	}
 
-	// インスタンスを登録
-	ParticlePresetInstance* instancePtr = instance.get();
-	instances_[instanceName] = std::move(instance);
+	return instance;
+}
+
+std::unique_ptr<ParticlePresetInstance> ParticleEditor::AcquirePooledInstance(const std::string& presetName)
+{
+	auto poolIt = instancePools_.find(presetName);
+	if (poolIt == instancePools_.end() || poolIt->second.empty()) {
+		return nullptr;
+	}
+
+	std::unique_ptr<ParticlePresetInstance> instance = std::move(poolIt->second.back());
+	poolIt->second.pop_back();
+	return instance;
+}
+
+void ParticleEditor::ReleaseToPool(std::unique_ptr<ParticlePresetInstance> instance)
+{
+	// プリセット編集用・プリセット不明のインスタンスは再利用しない
+	if (instance->GetInstanceName() == kPresetEditInstanceName_ || instance->GetPresetName().empty()) {
+		instance->Destroy();
+		return;
+	}
+
+	instance->Deactivate();
+	instancePools_[instance->GetPresetName()].push_back(std::move(instance));
+}
+
+void ParticleEditor::ResetInstance(ParticlePresetInstance* instance, const ParticlePresetData& presetData)
+{
+	// 使用中に編集された値をプリセットの値に戻す
+	for (const auto& groupData : presetData.groups) {
+		if (ParticleGroup* group = instance->GetGroup(groupData.groupName)) {
+			ApplyGroupData(group, groupData);
+		}
+	}
+
+	for (const auto& emitterData : presetData.emitters) {
+		if (ParticleEmitter* emitter = instance->GetEmitter(emitterData.emitterName)) {
+			ApplyEmitterData(emitter, emitterData);
+			// 前回の使用時の位置から新しい位置へ補間して尾を引かないよう、前回位置ごと発生タイマーを戻す
+			emitter->ResetSpawnTimer();
+		}
+	}
+
+	for (const auto& fieldData : presetData.fields) {
+		if (BaseField* field = instance->GetField(fieldData.fieldName)) {
+			ApplyFieldData(field, fieldData);
+		}
+	}
+}
+
+std::string ParticleEditor::MakeUniqueObjectPrefix(const std::string& baseName) const
+{
+	auto isUsed = [this](const std::string& prefix) {
+		for (const auto& [name, instance] : instances_) {
+			if (instance->GetObjectPrefix() == prefix) {
+				return true;
+			}
+		}
+		for (const auto& [presetName, pool] : instancePools_) {
+			for (const auto& instance : pool) {
+				if (instance->GetObjectPrefix() == prefix) {
+					return true;
+				}
+			}
+		}
+		return false;
+	};
+
+	if (!isUsed(baseName)) {
+		return baseName;
+	}
+
+	// プールに残っているインスタンスと名前が被る場合は番号を付ける
+	for (uint32_t index = 1;; ++index) {
+		std::string prefix = std::format("{}@{}", baseName, index);
+		if (!isUsed(prefix)) {
+			return prefix;
+		}
+	}
+}
+
+void ParticleEditor::PrewarmInstances(const std::string& presetName, uint32_t count)
+{
+	const ParticlePresetData* presetData = GetCachedPreset(presetName);
+	if (!presetData) {
+		Logger::Log(Logger::GetStream(),
+			std::format("[ParticleEditor] Failed to load preset: {}\n", presetName));
+		return;
+	}
+
+	auto& pool = instancePools_[presetName];
+	while (pool.size() < count) {
+		auto instance = BuildInstance(*presetData, presetName, MakeUniqueObjectPrefix(presetName));
+		instance->Deactivate();
+		pool.push_back(std::move(instance));
+	}
 
 	Logger::Log(Logger::GetStream(),
-		std::format("[ParticleEditor] Successfully created instance '{}' from preset '{}'\n",
-			instanceName, presetName));
+		std::format("[ParticleEditor] Prewarmed {} instance(s) of preset '{}'\n", pool.size(), presetName));
+}
 
-	return instancePtr;
+void ParticleEditor::ReleaseInstancePool()
+{
+	for (auto& [presetName, pool] : instancePools_) {
+		for (auto& instance : pool) {
+			instance->Destroy();
+		}
+	}
+	instancePools_.clear();
 }
 
 ParticlePresetInstance* ParticleEditor::GetInstance(const std::string& instanceName)
@@ -1430,7 +1691,8 @@ void ParticleEditor::DestroyInstance(const std::string& instanceName)
 {
 	auto it = instances_.find(instanceName);
 	if (it != instances_.end()) {
-		it->second->Destroy();
+		// 実際には削除せず、休止させてプールに戻す
+		ReleaseToPool(std::move(it->second));
 		instances_.erase(it);
 		Logger::Log(Logger::GetStream(),
 			std::format("[ParticleEditor] Destroyed instance: {}\n", instanceName));
@@ -1449,6 +1711,9 @@ void ParticleEditor::DestroyAllInstance()
 
 	//全てeraseしてからクリアする
 	instances_.clear();
+
+	//プールに待機中のものも削除
+	ReleaseInstancePool();
 	Logger::Log(Logger::GetStream(),
 		"[ParticleEditor] Destroyed all instances.\n");
 }
@@ -1552,6 +1817,14 @@ void ParticleEditor::NormalizePresetNames(ParticlePresetData& data, const std::s
 // ヘルパー関数: データ適用
 // ========================================
 
+void ParticleEditor::ApplyGroupData(ParticleGroup* group, const ParticleGroupData& data)
+{
+	group->SetSortBackToFront(data.sortBackToFront);
+	// 無効の設定も渡す（使用中に有効にされた軌跡・サブステップを止める）
+	group->SetTrail(data.trail);
+	group->SetSubstep(data.substep);
+}
+
 void ParticleEditor::ApplyEmitterData(ParticleEmitter* emitter, const ParticleEmitterData& data)
 {
 	// Transform設定
@@ -1563,6 +1836,7 @@ void ParticleEditor::ApplyEmitterData(ParticleEmitter* emitter, const ParticleEm
 	emitter->SetEmitCount(data.emitCount);
 	emitter->SetFrequency(data.emitFrequency);
 	emitter->SetEmitEnabled(data.isEmitting);
+	emitter->SetUseContinuousEmission(data.useContinuousEmission);
 	emitter->SetParticleLifeTimeRange(data.particleLifeTimeMin, data.particleLifeTimeMax);
 
 	// 速度設定
@@ -1592,9 +1866,13 @@ void ParticleEditor::ApplyEmitterData(ParticleEmitter* emitter, const ParticleEm
 	emitter->SetDebugAABBColor(data.debugAABBColor);
 
 	// 特殊効果
-	emitter->SetColorOverLifetime(data.enableColorOverLifetime, data.particleStartColor, data.particleEndColor);
-	emitter->SetSizeOverLifetime(data.enableSizeOverLifetime, data.particleStartScale, data.particleEndScale);
+	emitter->SetLifetimeCurves(data.enableColorOverLifetime, data.colorGradient,
+		data.enableSizeOverLifetime, data.sizeCurve, data.lifetimeLut);
 	emitter->SetRotation(data.enableRotation, data.rotationSpeed);
+
+	// 予算
+	emitter->SetPriority(data.priority);
+	emitter->SetUseDistanceLod(data.useDistanceLod);
 }
 
 void ParticleEditor::ApplyFieldData(BaseField* field, const ParticleFieldData& data)
@@ -1731,7 +2009,8 @@ bool ParticleEditor::IsInPresetEditMode() const
 bool ParticleEditor::SaveInstanceAsPreset(const std::string& instanceName, const std::string& presetName)
 {
 	// インスタンスの存在確認
-	if (!GetInstance(instanceName)) {
+	ParticlePresetInstance* instance = GetInstance(instanceName);
+	if (!instance) {
 		Logger::Log(Logger::GetStream(),
 			std::format("[ParticleEditor] Instance '{}' not found\n", instanceName));
 		return false;
@@ -1741,8 +2020,9 @@ bool ParticleEditor::SaveInstanceAsPreset(const std::string& instanceName, const
 	ParticlePresetData preset;
 	preset.presetName = presetName;
 
-	// プレフィックス準備
-	std::string prefix = instanceName + "_";
+	// プレフィックス準備（プールから再利用したインスタンスはインスタンス名とプレフィックスが異なる）
+	const std::string& objectPrefix = instance->GetObjectPrefix();
+	std::string prefix = objectPrefix + "_";
 
 	// インスタンスに属するオブジェクトを収集
 	for (const auto& name : particleSystem_->GetAllGroupNames()) {
@@ -1770,10 +2050,11 @@ bool ParticleEditor::SaveInstanceAsPreset(const std::string& instanceName, const
 	}
 
 	// 名前を正規化
-	NormalizePresetNames(preset, instanceName);
+	NormalizePresetNames(preset, objectPrefix);
 
 	// 保存
 	if (preset.SaveToFile(GetPresetFilePath(presetName))) {
+		InvalidatePreset(presetName);
 		Logger::Log(Logger::GetStream(),
 			std::format("[ParticleEditor] Saved instance '{}' as preset '{}'\n",
 				instanceName, presetName));
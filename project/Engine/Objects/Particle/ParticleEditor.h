@@ -32,6 +32,12 @@ public:
 	/// <param name="dxCommon">DirectXCommonのポインタ</param>
 	void Initialize(DirectXCommon* dxCommon);
 
+	/// <summary>
+	/// 毎フレームの更新（外部で書き換えられたプリセットファイルを定期的に検出する）
+	/// <para>ImGuiの有無に関係なく呼ぶ</para>
+	/// </summary>
+	void Update();
+
 	/// <summary>
 	/// ImGui用のエディタUI
 	/// </summary>
@@ -74,11 +80,42 @@ public:
 
 	/// <summary>
 	/// 全てのインスタンスを削除　　　　　　
+	/// <para>プールに待機中のインスタンスも含めて完全に破棄する</para>
 	/// </summary>
 	/// <param name="instanceName"></param>
 	void DestroyAllInstance();
+
+	/// <summary>
+	/// プリセットのインスタンスを事前に生成してプールに置いておく
+	/// <para>以降のCreateInstanceはプールから取り出すだけになり、ファイル読み込みやバッファ確保が発生しない</para>
+	/// </summary>
+	/// <param name="presetName">プリセット名</param>
+	/// <param name="count">プールに用意しておく数</param>
+	void PrewarmInstances(const std::string& presetName, uint32_t count);
+
+	/// <summary>
+	/// プールに待機中のインスタンスを破棄
+	/// </summary>
+	void ReleaseInstancePool();
+
+	// ========================================
+	// プリセットキャッシュ
+	// ========================================
+
+	/// <summary>
+	/// プリセットのキャッシュを破棄（次回読み込み時にファイルから読み直す）
+	/// <para>古いデータで作られたプール内のインスタンスも破棄する</para>
+	/// </summary>
+	/// <param name="presetName">プリセット名</param>
+	void InvalidatePreset(const std::string& presetName);
+
+	/// <summary>
+	/// キャッシュ済みプリセットのファイル更新日時を確認し、変更されたものを破棄
+	/// </summary>
+	void RefreshChangedPresets();
 	/// <summary>
 	/// プリセットを読み込み
+	/// <para>キャッシュ済みならファイルを読まずにキャッシュのコピーを返す</para>
 	/// </summary>
 	/// <param name="presetName">プリセット名</param>
 	/// <returns>読み込まれたプリセットデータ</returns>
@@ -311,6 +348,48 @@ private:
 	/// <param name="instanceName">除去するインスタンス名</param>
 	void NormalizePresetNames(ParticlePresetData& data, const std::string& instanceName) const;
 
+	/// <summary>
+	/// キャッシュからプリセットを取得（無ければファイルから読み込んでキャッシュする）
+	/// </summary>
+	/// <returns>プリセットデータ（読み込み失敗時nullptr）</returns>
+	const ParticlePresetData* GetCachedPreset(const std::string& presetName);
+
+	/// <summary>
+	/// プリセットデータからグループ・エミッター・フィールドを生成してインスタンスを作る
+	/// </summary>
+	/// <param name="objectPrefix">ParticleSystem上のオブジェクト名に付けるプレフィックス</param>
+	std::unique_ptr<ParticlePresetInstance> BuildInstance(const ParticlePresetData& presetData,
+		const std::string& presetName, const std::string& objectPrefix);
+
+	/// <summary>
+	/// プールからインスタンスを取り出す
+	/// </summary>
+	/// <returns>インスタンス（プールが空ならnullptr）</returns>
+	std::unique_ptr<ParticlePresetInstance> AcquirePooledInstance(const std::string& presetName);
+
+	/// <summary>
+	/// インスタンスを休止させてプールへ戻す
+	/// </summary>
+	void ReleaseToPool(std::unique_ptr<ParticlePresetInstance> instance);
+
+	/// <summary>
+	/// プールから取り出したインスタンスをプリセットの初期状態に戻す
+	/// </summary>
+	void ResetInstance(ParticlePresetInstance* instance, const ParticlePresetData& presetData);
+
+	/// <summary>
+	/// 使用中・待機中のどのインスタンスとも被らないオブジェクト名プレフィックスを作る
+	/// </summary>
+	std::string MakeUniqueObjectPrefix(const std::string& baseName) const;
+
+	/// <summary>
+	/// 作成済みのグループにプリセットデータを適用（並べ替え・軌跡・サブステップ）
+	/// <para>モデル・最大数・テクスチャは作成時に決まるので、ここでは変えない</para>
+	/// </summary>
+	/// <param name="group">グループ</param>
+	/// <param name="data">グループデータ</param>
+	void ApplyGroupData(ParticleGroup* group, const ParticleGroupData& data);
+
 	/// <summary>
 	/// エミッターにプリセットデータを適用
 	/// </summary>
@@ -346,6 +425,25 @@ private:
 	// インスタンス管理
 	std::unordered_map<std::string, std::unique_ptr<ParticlePresetInstance>> instances_;
 
+	// 破棄されたインスタンスの再利用プール（プリセット名 → 待機中のインスタンス）
+	std::unordered_map<std::string, std::vector<std::unique_ptr<ParticlePresetInstance>>> instancePools_;
+
+	// プリセットキャッシュ（ファイルの更新日時が変わったら読み直す）
+	struct PresetCacheEntry {
+		ParticlePresetData data;
+		std::filesystem::file_time_type lastWriteTime;
+	};
+	std::unordered_map<std::string, PresetCacheEntry> presetCache_;
+
+	// ファイル更新の確認間隔（Updateのフレーム数）
+	static constexpr uint32_t kPresetWatchInterval_ = 60;
+	uint32_t presetWatchFrame_ = 0;
+
+	// 統計
+	uint32_t presetCacheHitCount_ = 0;
+	uint32_t presetCacheMissCount_ = 0;
+	uint32_t pooledSpawnCount_ = 0;
+
 	// 編集状態
 	enum class EditingType { None, Group, Emitter, Field };
 	EditingType currentEditingType_ = EditingType::None;
@@ -380,7 +478,7 @@ private:
 	struct FieldCreationData {
 		char name[128] = "NewField";
 		int fieldTypeIndex = 0;
-		const char* fieldTypes[2] = { "AccelerationField", "GravityField" };
+		const char* fieldTypes[6] = { "AccelerationField", "GravityField", "VortexField", "TurbulenceField", "DragField", "KillPlaneField" };
 	};
 	FieldCreationData fieldCreationData_;
 	bool showCreateFieldDialog_ = false;
@@ -1,6 +1,70 @@
 #include "ParticleEmitter.h"
 #include "ParticleGroup.h"
 #include "ImGui/ImGuiManager.h"
+#include <cfloat>
+
+#ifdef USEIMGUI
+namespace {
+
+	/// <summary>
+	/// イージングの選択
+	/// </summary>
+	bool EasingCombo(const char* label, ParticleEasing& easing)
+	{
+		bool changed = false;
+		if (ImGui::BeginCombo(label, ParticleEasingUtil::GetName(easing))) {
+			for (uint8_t i = 0; i < static_cast<uint8_t>(ParticleEasing::Count); ++i) {
+				const ParticleEasing candidate = static_cast<ParticleEasing>(i);
+				if (ImGui::Selectable(ParticleEasingUtil::GetName(candidate), candidate == easing)) {
+					easing = candidate;
+					changed = true;
+				}
+			}
+			ImGui::EndCombo();
+		}
+		return changed;
+	}
+
+	/// <summary>
+	/// キー列の編集（時間・値・次のキーまでのイージング、追加と削除）
+	/// </summary>
+	/// <param name="editValue">bool(Key&) 値の編集UI</param>
+	template<typename Key, typename EditValue>
+	bool EditKeys(std::vector<Key>& keys, EditValue&& editValue)
+	{
+		bool changed = false;
+		int removeIndex = -1;
+
+		for (size_t i = 0; i < keys.size(); ++i) {
+			ImGui::PushID(static_cast<int>(i));
+			ImGui::Text("Key %zu", i);
+			changed |= ImGui::SliderFloat("Time", &keys[i].time, 0.0f, 1.0f);
+			changed |= editValue(keys[i]);
+			changed |= EasingCombo("Easing To Next", keys[i].easing);
+			// キーは最低1つ残す
+			if (keys.size() > 1 && ImGui::Button("Remove Key")) {
+				removeIndex = static_cast<int>(i);
+			}
+			ImGui::Separator();
+			ImGui::PopID();
+		}
+
+		if (removeIndex >= 0) {
+			keys.erase(keys.begin() + removeIndex);
+			changed = true;
+		}
+
+		// 末尾のキーを複製して追加（時間は末尾と1の中間）
+		if (ImGui::Button("Add Key")) {
+			Key key = keys.empty() ? Key{} : keys.back();
+			key.time = keys.empty() ? 0.0f : (key.time + 1.0f) * 0.5f;
+			keys.push_back(key);
+			changed = true;
+		}
+		return changed;
+	}
+}
+#endif
 
 void ParticleEmitter::Initialize(DirectXCommon* dxCommon, const std::string& targetGroupName)
 {
@@ -15,7 +79,13 @@ void ParticleEmitter::Initialize(DirectXCommon* dxCommon, const std::string& tar
 	debugDrawLineSystem_ = DebugDrawLineSystem::GetInstance();
 
 	// 初期状態
-	frequencyTimer_ = 0.0f;
+	spawnTimer_.frequencyTimer = 0.0f;
+
+	// 色・サイズの参照テーブル
+	RebakeLifetimeLut();
+
+	// 乱数のシード（決定論モードではParticleSystemが設定し直す）
+	random_.SetSeed(Random::GetInstance().GenerateSeed());
 
 	// AABBを正しい状態に
 	FixAABBMinMax(spawnArea_);
@@ -28,162 +98,140 @@ void ParticleEmitter::Update(float deltaTime, ParticleGroup* targetGroup)
 		return;
 	}
 
+	// 予算の制限なしで、要求した数をそのまま発生させる
+	Emit(targetGroup, RequestEmission(deltaTime));
+}
+
+uint32_t ParticleEmitter::RequestEmission(float deltaTime)
+{
+	// 前回のステップの位置を残しておく（連続発生で発生時刻の位置を補間する）
+	const Vector3 position = emitterTransform_.GetPosition();
+	previousPosition_ = hasPreviousPosition_ ? currentPosition_ : position;
+	currentPosition_ = position;
+	hasPreviousPosition_ = true;
+
 	// エミッタートランスフォームの更新（ビュープロジェクション行列は不要）
 	Matrix4x4 dummyMatrix = MakeIdentity4x4();
 	emitterTransform_.UpdateMatrix(dummyMatrix);
 
-	// エミッター寿命処理
-	if (useEmitterLifeTime_) {
-		emitterCurrentTime_ += deltaTime;
+	// エミッター寿命の処理と発生数の計算
+	lastRequestedCount_ = ParticleSpawner::AdvanceEmission(BuildSpawnDesc(), spawnTimer_, deltaTime);
+	return lastRequestedCount_;
+}
 
-		// 寿命が尽きた場合
-		if (emitterCurrentTime_ >= emitterLifeTime_) {
-			if (emitterLifeTimeLoop_) {
-				// ループする場合、時間をリセット
-				emitterCurrentTime_ = 0.0f;
-			} else {
-				// ループしない場合、発生を停止
-				isEmitting_ = false;
-				return;
-			}
-		}
+uint32_t ParticleEmitter::ApplyEmissionRate(uint32_t count, float rate)
+{
+	if (rate >= 1.0f) {
+		return count;
 	}
-
-	// パーティクルの発生
-	if (isEmitting_) {
-		EmitParticles(deltaTime, targetGroup);
+	if (rate <= 0.0f) {
+		// 発生させない間は端数も捨てる（近づいた瞬間にまとめて出ないように）
+		emissionCarry_ = 0.0f;
+		return 0;
 	}
+
+	const float scaled = static_cast<float>(count) * rate + emissionCarry_;
+	const uint32_t result = static_cast<uint32_t>(scaled);
+	emissionCarry_ = scaled - static_cast<float>(result);
+	return result;
 }
 
-void ParticleEmitter::EmitParticles(float deltaTime, ParticleGroup* targetGroup)
+uint32_t ParticleEmitter::Emit(ParticleGroup* targetGroup, uint32_t count)
 {
-	// 頻度タイマーを進める
-	frequencyTimer_ += deltaTime;
-
-	// 発生頻度に達したかチェック
-	while (frequencyTimer_ >= emitFrequency_) {
-		frequencyTimer_ -= emitFrequency_;
-
-		// 指定された数のパーティクルを生成
-		for (uint32_t i = 0; i < emitCount_; ++i) {
-			// ターゲットグループに追加を試みる
-			ParticleState newParticle = CreateNewParticle();
+	lastSpawnedCount_ = 0;
+	if (!targetGroup || count == 0) {
+		return 0;
+	}
 
-			if (!targetGroup->AddParticle(newParticle)) {
-				// 追加に失敗した（満杯）場合はこれ以上追加しない
-				break;
-			}
-		}
+	// パーティクルの発生（乱数はエミッター専用の生成器から取る）
+	const ParticleSpawnDesc desc = BuildSpawnDesc();
+	auto addParticle = [targetGroup](const ParticleState& particle) { return targetGroup->AddParticle(particle); };
+	if (desc.useContinuousEmission) {
+		lastSpawnedCount_ = ParticleSpawner::SpawnContinuous(desc, spawnTimer_, previousPosition_, emitterTransform_.GetPosition(),
+			random_, count, addParticle);
+	} else {
+		lastSpawnedCount_ = ParticleSpawner::Spawn(desc, emitterTransform_.GetPosition(), random_, count, addParticle);
 	}
+	return lastSpawnedCount_;
 }
 
-ParticleState ParticleEmitter::CreateNewParticle()
+ParticleSpawnDesc ParticleEmitter::BuildSpawnDesc() const
 {
-	ParticleState state;
-
-	// エミッターの位置を取得
-	Vector3 emitterPos = emitterTransform_.GetPosition();
-
-	// AABBの範囲内でランダムな位置を生成
-	Vector3 randomPosInAABB = {
-		Random::GetInstance().GenerateFloat(spawnArea_.min.x, spawnArea_.max.x),
-		Random::GetInstance().GenerateFloat(spawnArea_.min.y, spawnArea_.max.y),
-		Random::GetInstance().GenerateFloat(spawnArea_.min.z, spawnArea_.max.z)
-	};
-
-	// Scale設定（ランダム範囲）
-	state.transform.scale = {
-		Random::GetInstance().GenerateFloat(particleScaleMin_.x, particleScaleMax_.x),
-		Random::GetInstance().GenerateFloat(particleScaleMin_.y, particleScaleMax_.y),
-		Random::GetInstance().GenerateFloat(particleScaleMin_.z, particleScaleMax_.z)
-	};
+	ParticleSpawnDesc desc;
+
+	// 発生タイミング
+	desc.emitCount = emitCount_;
+	desc.emitFrequency = emitFrequency_;
+	desc.useEmitterLifeTime = useEmitterLifeTime_;
+	desc.emitterLifeTime = emitterLifeTime_;
+	desc.emitterLifeTimeLoop = emitterLifeTimeLoop_;
+	desc.useContinuousEmission = useContinuousEmission_;
+
+	// 初期値
+	desc.lifeTimeMin = particleLifeTimeMin_;
+	desc.lifeTimeMax = particleLifeTimeMax_;
+	desc.useDirectionalEmit = useDirectionalEmit_;
+	desc.emitDirection = emitDirection_;
+	desc.initialSpeed = initialSpeed_;
+	desc.spreadAngle = spreadAngle_;
+	desc.velocityRange = velocityRange_;
+	desc.scaleMin = particleScaleMin_;
+	desc.scaleMax = particleScaleMax_;
+	desc.rotateMin = particleRotateMin_;
+	desc.rotateMax = particleRotateMax_;
+	desc.spawnArea = spawnArea_;
+
+	// 寿命に応じた変化
+	desc.enableColorOverLifetime = enableColorOverLifetime_;
+	desc.enableSizeOverLifetime = enableSizeOverLifetime_;
+	desc.lifetimeLut = lifetimeLut_;
+	desc.enableRotation = enableRotation_;
+	desc.rotationSpeed = rotationSpeed_;
+
+	return desc;
+}
 
-	// Rotate設定（ランダム範囲）
-	state.transform.rotate = {
-		Random::GetInstance().GenerateFloat(particleRotateMin_.x, particleRotateMax_.x),
-		Random::GetInstance().GenerateFloat(particleRotateMin_.y, particleRotateMax_.y),
-		Random::GetInstance().GenerateFloat(particleRotateMin_.z, particleRotateMax_.z)
-	};
+void ParticleEmitter::SetColorOverLifetime(bool enable, const ParticleColorGradient& gradient)
+{
+	enableColorOverLifetime_ = enable;
+	colorGradient_ = gradient;
+	RebakeLifetimeLut();
+}
 
-	// 位置設定
-	state.transform.translate = {
-		emitterPos.x + randomPosInAABB.x,
-		emitterPos.y + randomPosInAABB.y,
-		emitterPos.z + randomPosInAABB.z
-	};
+void ParticleEmitter::SetSizeOverLifetime(bool enable, const ParticleSizeCurve& curve)
+{
+	enableSizeOverLifetime_ = enable;
+	sizeCurve_ = curve;
+	RebakeLifetimeLut();
+}
 
-	// 速度設定（新方式 or 旧方式）
-	if (useDirectionalEmit_) {
-		// 新方式：方向指定発射
-		// 散らばり角度をラジアンに変換
-		float spreadRad = DegToRad(spreadAngle_);
-
-		// ランダムな角度オフセットを生成（-spreadRad/2 ~ +spreadRad/2）
-		float randomTheta = Random::GetInstance().GenerateFloat(-spreadRad / 2.0f, spreadRad / 2.0f);
-		float randomPhi = Random::GetInstance().GenerateFloat(0.0f, 2.0f * std::numbers::pi_v<float>);
-
-		// 散らばりベクトルを生成
-		Vector3 spread = {
-			sinf(randomTheta) * cosf(randomPhi),
-			sinf(randomTheta) * sinf(randomPhi),
-			cosf(randomTheta) - 1.0f
-		};
-
-		// 発射方向に散らばりを加える
-		Vector3 finalDirection = {
-			emitDirection_.x + spread.x,
-			emitDirection_.y + spread.y,
-			emitDirection_.z + spread.z
-		};
-
-		// 正規化して初速度をかける
-		finalDirection = Normalize(finalDirection);
-		state.velocity = {
-			finalDirection.x * initialSpeed_,
-			finalDirection.y * initialSpeed_,
-			finalDirection.z * initialSpeed_
-		};
-	} else {
-		// 旧方式：ランダム速度（互換性のため）
-		state.velocity = Random::GetInstance().GenerateVector3OriginOffset(velocityRange_);
-	}
+void ParticleEmitter::SetLifetimeCurves(bool enableColor, const ParticleColorGradient& gradient,
+	bool enableSize, const ParticleSizeCurve& curve, std::shared_ptr<ParticleLifetimeLut> bakedLut)
+{
+	enableColorOverLifetime_ = enableColor;
+	colorGradient_ = gradient;
+	enableSizeOverLifetime_ = enableSize;
+	sizeCurve_ = curve;
 
-	// ランダムな色を設定
-	state.color = Random::GetInstance().GenerateRandomVector4();
-
-	// 寿命を設定
-	state.lifeTime = Random::GetInstance().GenerateFloat(particleLifeTimeMin_, particleLifeTimeMax_);
-	state.currentTime = 0.0f;
-
-	// ========================================
-	//	時間で色変化(Color Over Lifetime)
-	// ========================================
-	if (enableColorOverLifetime_) {
-		state.useColorOverLifetime = true;
-		state.startColor = particleStartColor_;
-		state.endColor = particleEndColor_;
-		state.color = particleStartColor_;  // 初期色を設定
+	if (!bakedLut) {
+		RebakeLifetimeLut();
+		return;
 	}
 
-	// ========================================
-	// 時間でサイズ変化(Size Over Lifetime)
-	// ========================================
-	if (enableSizeOverLifetime_) {
-		state.useSizeOverLifetime = true;
-		state.startScale = particleStartScale_;
-		state.endScale = particleEndScale_;
-		state.transform.scale = particleStartScale_;  // 初期スケールを設定
-	}
+	// 焼き込み済みのテーブルを共有する（同じプリセットのインスタンス間で1つ）
+	lifetimeLut_ = std::move(bakedLut);
+	ownsLifetimeLut_ = false;
+}
 
-	// ========================================
-	// 回転(Rotation)
-	// ========================================
-	if (enableRotation_) {
-		state.useRotation = true;
-		state.rotationSpeed = rotationSpeed_;
+void ParticleEmitter::RebakeLifetimeLut()
+{
+	// 共有中のテーブルを書き換えると他のエミッターにも影響するので、自分用を作る
+	// （自分用のテーブルはその場で焼き直し、発生済みのパーティクルにも反映する）
+	if (!lifetimeLut_ || !ownsLifetimeLut_) {
+		lifetimeLut_ = std::make_shared<ParticleLifetimeLut>();
+		ownsLifetimeLut_ = true;
 	}
-
-	return state;
+	lifetimeLut_->Bake(&colorGradient_, &sizeCurve_);
 }
 
 void ParticleEmitter::SetSpawnAreaSize(const Vector3& size)
@@ -218,10 +266,10 @@ void ParticleEmitter::ImGui()
 
 			ImGui::Separator();
 
-			if (ImGui::Checkbox("Is Emitting", &isEmitting_)) {
+			if (ImGui::Checkbox("Is Emitting", &spawnTimer_.isEmitting)) {
 				// 発生状態が変わった場合、タイマーをリセット
-				if (isEmitting_) {
-					frequencyTimer_ = 0.0f;
+				if (spawnTimer_.isEmitting) {
+					spawnTimer_.frequencyTimer = 0.0f;
 				}
 			}
 
@@ -239,7 +287,27 @@ void ParticleEmitter::ImGui()
 
 			// 発生頻度
 			ImGui::DragFloat("Emit Frequency (sec)", &emitFrequency_, 0.01f, 0.01f, 10.0f);
-			ImGui::Text("Next emit in: %.2f sec", emitFrequency_ - frequencyTimer_);
+			if (useContinuousEmission_) {
+				ImGui::Text("Rate: %.1f / sec", emitFrequency_ > 0.0f ? static_cast<float>(emitCount_) / emitFrequency_ : 0.0f);
+			} else {
+				ImGui::Text("Next emit in: %.2f sec", emitFrequency_ - spawnTimer_.frequencyTimer);
+			}
+			ImGui::Checkbox("Continuous Emission", &useContinuousEmission_);
+
+			ImGui::Separator();
+
+			// 予算の優先度・距離LOD
+			if (ImGui::BeginCombo("Priority", ParticlePriorityUtil::GetName(priority_))) {
+				for (uint8_t i = 0; i < static_cast<uint8_t>(ParticlePriority::Count); ++i) {
+					const ParticlePriority candidate = static_cast<ParticlePriority>(i);
+					if (ImGui::Selectable(ParticlePriorityUtil::GetName(candidate), candidate == priority_)) {
+						priority_ = candidate;
+					}
+				}
+				ImGui::EndCombo();
+			}
+			ImGui::Checkbox("Distance LOD", &useDistanceLod_);
+			ImGui::Text("Last Step: spawned %u / requested %u", lastSpawnedCount_, lastRequestedCount_);
 
 			ImGui::Separator();
 		}
@@ -253,14 +321,14 @@ void ParticleEmitter::ImGui()
 				ImGui::Checkbox("Loop", &emitterLifeTimeLoop_);
 
 				// 現在の経過時間表示
-				ImGui::ProgressBar(emitterCurrentTime_ / emitterLifeTime_,
+				ImGui::ProgressBar(spawnTimer_.emitterCurrentTime / emitterLifeTime_,
 					ImVec2(-1.0f, 0.0f),
-					std::format("Time: {:.2f} / {:.2f}", emitterCurrentTime_, emitterLifeTime_).c_str());
+					std::format("Time: {:.2f} / {:.2f}", spawnTimer_.emitterCurrentTime, emitterLifeTime_).c_str());
 
 				// リセットボタン
 				if (ImGui::Button("Reset Timer")) {
 					ResetEmitterTime();
-					isEmitting_ = true;  // 発生も再開
+					spawnTimer_.isEmitting = true;  // 発生も再開
 				}
 
 				// 生存状態表示
@@ -359,14 +427,27 @@ void ParticleEmitter::ImGui()
 
 			if (enableColorOverLifetime_) {
 				ImGui::Spacing();
-				ImGui::Text("Color will transition from Start to End over particle lifetime");
+				ImGui::Text("Color follows the gradient keys over particle lifetime");
 				ImGui::Separator();
 
-				ImGui::ColorEdit4("Start Color", &particleStartColor_.x);
-				ImGui::ColorEdit4("End Color", &particleEndColor_.x);
+				ImGui::PushID("ColorGradient");
+				bool changed = EditKeys(colorGradient_.keys, [](ParticleGradientKey& key) {
+					return ImGui::ColorEdit4("Color", &key.color.x);
+				});
+				ImGui::PopID();
+				if (changed) {
+					RebakeLifetimeLut();
+				}
+
+				// 焼き込んだαのプレビュー
+				float alpha[ParticleLifetimeLut::kResolution];
+				for (uint32_t i = 0; i < ParticleLifetimeLut::kResolution; ++i) {
+					alpha[i] = lifetimeLut_->GetColor(i).w;
+				}
+				ImGui::PlotLines("Alpha", alpha, static_cast<int>(ParticleLifetimeLut::kResolution), 0, nullptr, 0.0f, 1.0f, ImVec2(0, 60));
 
 				ImGui::Spacing();
-				ImGui::TextDisabled("Tip: Set End Color alpha to 0 for fade-out effect");
+				ImGui::TextDisabled("Tip: Set the last key alpha to 0 for fade-out effect");
 			}
 
 			ImGui::Separator();
@@ -380,14 +461,27 @@ void ParticleEmitter::ImGui()
 
 			if (enableSizeOverLifetime_) {
 				ImGui::Spacing();
-				ImGui::Text("Size will transition from Start to End over particle lifetime");
+				ImGui::Text("Size follows the curve keys over particle lifetime");
 				ImGui::Separator();
 
-				ImGui::DragFloat3("Start Scale", &particleStartScale_.x, 0.1f, 0.1f, 10.0f);
-				ImGui::DragFloat3("End Scale", &particleEndScale_.x, 0.1f, 0.0f, 10.0f);
+				ImGui::PushID("SizeCurve");
+				bool changed = EditKeys(sizeCurve_.keys, [](ParticleCurveKey& key) {
+					return ImGui::DragFloat3("Scale", &key.value.x, 0.1f, 0.0f, 10.0f);
+				});
+				ImGui::PopID();
+				if (changed) {
+					RebakeLifetimeLut();
+				}
+
+				// 焼き込んだスケールXのプレビュー
+				float scale[ParticleLifetimeLut::kResolution];
+				for (uint32_t i = 0; i < ParticleLifetimeLut::kResolution; ++i) {
+					scale[i] = lifetimeLut_->GetSize(i).x;
+				}
+				ImGui::PlotLines("Scale X", scale, static_cast<int>(ParticleLifetimeLut::kResolution), 0, nullptr, FLT_MAX, FLT_MAX, ImVec2(0, 60));
 
 				ImGui::Spacing();
-				ImGui::TextDisabled("Tip: Set End Scale to (0, 0, 0) to shrink to nothing");
+				ImGui::TextDisabled("Tip: Set the last key scale to (0, 0, 0) to shrink to nothing");
 			}
 
 			ImGui::Separator();
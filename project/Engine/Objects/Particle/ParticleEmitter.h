@@ -5,6 +5,8 @@
 #include "DirectXCommon.h"
 #include "Transform3D.h"
 #include "ParticleState.h"
+#include "ParticleSpawner.h"
+#include "ParticleBudget.h"
 #include "Random/Random.h"
 #include "MyFunction.h"
 #include "DebugDrawLineSystem.h"
@@ -37,6 +39,31 @@ public:
 	/// <param name="targetGroup">ターゲットグループへのポインタ（ParticleSystemから渡される）</param>
 	void Update(float deltaTime, ParticleGroup* targetGroup);
 
+	///*-----------------------------------------------------------------------*///
+	///				予算管理付きの更新（ParticleSystemから段階毎に呼ばれる）			///
+	///*-----------------------------------------------------------------------*///
+
+	/// <summary>
+	/// トランスフォームと発生タイマーを進め、今回発生させたい数を返す（まだ発生させない）
+	/// </summary>
+	/// <param name="deltaTime">デルタタイム</param>
+	uint32_t RequestEmission(float deltaTime);
+
+	/// <summary>
+	/// 発生数に倍率を掛ける（端数は次回に持ち越すので、低い倍率でも少しずつ発生する）
+	/// </summary>
+	/// <param name="count">RequestEmissionの戻り値</param>
+	/// <param name="rate">倍率（0～1）</param>
+	uint32_t ApplyEmissionRate(uint32_t count, float rate);
+
+	/// <summary>
+	/// 割り当てられた数だけ発生させる
+	/// </summary>
+	/// <param name="targetGroup">ターゲットグループ</param>
+	/// <param name="count">発生させる数</param>
+	/// <returns>追加できた数（グループが満杯だとcountより少ない）</returns>
+	uint32_t Emit(ParticleGroup* targetGroup, uint32_t count);
+
 	/// <summary>
 	/// デバッグ描画（AABB表示）
 	/// </summary>
@@ -57,8 +84,15 @@ public:
 	void SetFrequency(float frequency) { emitFrequency_ = frequency; }
 	float GetFrequency() const { return emitFrequency_; }
 
-	void SetEmitEnabled(bool enabled) { isEmitting_ = enabled; emitterCurrentTime_ = 0.0f; }
-	bool IsEmitting() const { return isEmitting_; }
+	/// <summary>
+	/// 連続発生の切り替え（emitFrequency秒あたりemitCount個を、ステップ内の発生時刻に割り振って1個ずつ発生させる）
+	/// <para>発生時刻に合わせてエミッター位置を補間するので、速く動くエミッターでも粒が固まらない</para>
+	/// </summary>
+	void SetUseContinuousEmission(bool use) { useContinuousEmission_ = use; }
+	bool IsUseContinuousEmission() const { return useContinuousEmission_; }
+
+	void SetEmitEnabled(bool enabled) { spawnTimer_.isEmitting = enabled; spawnTimer_.emitterCurrentTime = 0.0f; }
+	bool IsEmitting() const { return spawnTimer_.isEmitting; }
 
 	// パーティクル初期設定
 	void SetParticleLifeTimeRange(float min, float max) {
@@ -108,44 +142,49 @@ public:
 	// ========================================
 
 	/// <summary>
-	/// 色の時間変化を設定
+	/// 色の時間変化を開始色→終了色の線形補間で設定
 	/// </summary>
 	void SetColorOverLifetime(bool enable, const Vector4& startColor, const Vector4& endColor) {
-		enableColorOverLifetime_ = enable;
-		particleStartColor_ = startColor;
-		particleEndColor_ = endColor;
+		SetColorOverLifetime(enable, ParticleColorGradient::MakeLinear(startColor, endColor));
 	}
 
+	/// <summary>
+	/// 色の時間変化をグラデーションで設定（参照テーブルを焼き直す）
+	/// </summary>
+	void SetColorOverLifetime(bool enable, const ParticleColorGradient& gradient);
+
 	void SetEnableColorOverLifetime(bool enable) { enableColorOverLifetime_ = enable; }
 	bool IsEnableColorOverLifetime() const { return enableColorOverLifetime_; }
 
-	void SetParticleStartColor(const Vector4& color) { particleStartColor_ = color; }
-	const Vector4& GetParticleStartColor() const { return particleStartColor_; }
-
-	void SetParticleEndColor(const Vector4& color) { particleEndColor_ = color; }
-	const Vector4& GetParticleEndColor() const { return particleEndColor_; }
+	const ParticleColorGradient& GetColorGradient() const { return colorGradient_; }
 
 	// ========================================
 	// Size Over Lifetime
 	// ========================================
 
 	/// <summary>
-	/// サイズの時間変化を設定
+	/// サイズの時間変化を開始スケール→終了スケールの線形補間で設定
 	/// </summary>
 	void SetSizeOverLifetime(bool enable, const Vector3& startScale, const Vector3& endScale) {
-		enableSizeOverLifetime_ = enable;
-		particleStartScale_ = startScale;
-		particleEndScale_ = endScale;
+		SetSizeOverLifetime(enable, ParticleSizeCurve::MakeLinear(startScale, endScale));
 	}
 
+	/// <summary>
+	/// サイズの時間変化をカーブで設定（参照テーブルを焼き直す）
+	/// </summary>
+	void SetSizeOverLifetime(bool enable, const ParticleSizeCurve& curve);
+
 	void SetEnableSizeOverLifetime(bool enable) { enableSizeOverLifetime_ = enable; }
 	bool IsEnableSizeOverLifetime() const { return enableSizeOverLifetime_; }
 
-	void SetParticleStartScale(const Vector3& scale) { particleStartScale_ = scale; }
-	const Vector3& GetParticleStartScale() const { return particleStartScale_; }
+	const ParticleSizeCurve& GetSizeCurve() const { return sizeCurve_; }
 
-	void SetParticleEndScale(const Vector3& scale) { particleEndScale_ = scale; }
-	const Vector3& GetParticleEndScale() const { return particleEndScale_; }
+	/// <summary>
+	/// 焼き込み済みの参照テーブルごと色・サイズの時間変化を設定（プリセット読み込み時に焼いたものを共有する）
+	/// <para>テーブルは共有したまま使い、ImGuiで編集した時に自分用のテーブルへ焼き直す</para>
+	/// </summary>
+	void SetLifetimeCurves(bool enableColor, const ParticleColorGradient& gradient,
+		bool enableSize, const ParticleSizeCurve& curve, std::shared_ptr<ParticleLifetimeLut> bakedLut);
 
 	// ========================================
 	// Rotation
@@ -194,6 +233,19 @@ public:
 
 	const std::string& GetTargetGroupName() const { return targetGroupName_; }
 
+	// 予算の優先度・距離LOD
+	void SetPriority(ParticlePriority priority) { priority_ = priority; }
+	ParticlePriority GetPriority() const { return priority_; }
+
+	void SetUseDistanceLod(bool use) { useDistanceLod_ = use; }
+	bool IsUseDistanceLod() const { return useDistanceLod_; }
+
+	/// <summary>
+	/// 直近のステップで発生させようとした数と、実際に追加できた数（ImGui表示用）
+	/// </summary>
+	uint32_t GetLastRequestedCount() const { return lastRequestedCount_; }
+	uint32_t GetLastSpawnedCount() const { return lastSpawnedCount_; }
+
 	// エミッター寿命
 	void SetEmitterLifeTime(float time) { emitterLifeTime_ = time; }
 	float GetEmitterLifeTime() const { return emitterLifeTime_; }
@@ -201,37 +253,57 @@ public:
 	void SetEmitterLifeTimeLoop(bool loop) { emitterLifeTimeLoop_ = loop; }
 	bool IsEmitterLifeTimeLoop() const { return emitterLifeTimeLoop_; }
 
-	float GetEmitterCurrentTime() const { return emitterCurrentTime_; }
+	float GetEmitterCurrentTime() const { return spawnTimer_.emitterCurrentTime; }
 	bool IsEmitterAlive() const {
-		return !useEmitterLifeTime_ || emitterLifeTimeLoop_ || emitterCurrentTime_ < emitterLifeTime_;
+		return !useEmitterLifeTime_ || emitterLifeTimeLoop_ || spawnTimer_.emitterCurrentTime < emitterLifeTime_;
 	}
 
 	void SetUseEmitterLifeTime(bool use) { useEmitterLifeTime_ = use; }
 	bool IsUseEmitterLifeTime() const { return useEmitterLifeTime_; }
 
 	// エミッター時間をリセット
-	void ResetEmitterTime() { emitterCurrentTime_ = 0.0f; }
+	void ResetEmitterTime() { spawnTimer_.emitterCurrentTime = 0.0f; }
 
-private:
 	/// <summary>
-	/// パーティクルを発生させる
+	/// 乱数のシードを設定（同じシード・同じ経過時間なら同じパーティクルが発生する）
 	/// </summary>
-	/// <param name="deltaTime">デルタタイム</param>
-	/// <param name="targetGroup">ターゲットグループ</param>
-	void EmitParticles(float deltaTime, ParticleGroup* targetGroup);
+	void SetRandomSeed(uint64_t seed) { random_.SetSeed(seed); }
+	uint64_t GetRandomSeed() const { return random_.GetSeed(); }
 
 	/// <summary>
-	/// 新しいパーティクルを生成
+	/// 発生タイマーを初期状態に戻す（決定論モードの開始時などに使用）
+	/// <para>前回位置も捨てるので、ワープさせた直後に呼べば連続発生の補間で粒が尾を引かない</para>
+	/// <para>発生させるかどうかの設定はそのまま残す</para>
 	/// </summary>
-	/// <returns>生成されたパーティクル</returns>
-	ParticleState CreateNewParticle();
+	void ResetSpawnTimer() {
+		const bool isEmitting = spawnTimer_.isEmitting;
+		spawnTimer_ = ParticleSpawnTimer{};
+		spawnTimer_.isEmitting = isEmitting;
+		hasPreviousPosition_ = false;
+	}
+
+	/// <summary>
+	/// 現在の設定から発生設定を作成
+	/// </summary>
+	ParticleSpawnDesc BuildSpawnDesc() const;
+
+private:
+	/// <summary>
+	/// 現在のグラデーション・カーブを参照テーブルに焼き込む
+	/// <para>共有テーブルを使っている場合は自分用のテーブルを作ってから焼く</para>
+	/// </summary>
+	void RebakeLifetimeLut();
 
 	// エミッター設定
 	Transform3D emitterTransform_;			// エミッターのトランスフォーム
 	uint32_t emitCount_ = 5;				// 1回の発生で生成するパーティクル数
 	float emitFrequency_ = 1.0f;			// 発生頻度（秒）
-	float frequencyTimer_ = 0.0f;			// 発生頻度用タイマー
-	bool isEmitting_ = true;				// パーティクルを発生させるか
+	ParticleSpawnTimer spawnTimer_;			// 発生頻度・エミッター寿命のタイマーと発生状態
+	bool useContinuousEmission_ = false;	// 1個ずつ等間隔に発生させるか
+	Vector3 previousPosition_ = { 0.0f, 0.0f, 0.0f };	// 前回のステップでのエミッター位置（連続発生の補間用）
+	Vector3 currentPosition_ = { 0.0f, 0.0f, 0.0f };	// 今回のステップでのエミッター位置
+	bool hasPreviousPosition_ = false;		// 位置を記録済みか（最初のステップでは補間しない）
+	FastRandom random_;						// エミッター専用の乱数（Initializeでシードを設定）
 
 	// パーティクル初期設定
 	float particleLifeTimeMin_ = 1.0f;		// パーティクル寿命の最小値
@@ -258,15 +330,19 @@ private:
 	// Color Over Lifetime
 	// ========================================
 	bool enableColorOverLifetime_ = false;					// 色変化を使用するか
-	Vector4 particleStartColor_ = { 1.0f, 1.0f, 1.0f, 1.0f };	// 開始色
-	Vector4 particleEndColor_ = { 1.0f, 1.0f, 1.0f, 0.0f };		// 終了色（デフォルト：フェードアウト）
+	ParticleColorGradient colorGradient_ = ParticleColorGradient::MakeLinear(
+		{ 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 0.0f });	// 色のグラデーション（デフォルト：フェードアウト）
 
 	// ========================================
 	// Size Over Lifetime
 	// ========================================
 	bool enableSizeOverLifetime_ = false;				// サイズ変化を使用するか
-	Vector3 particleStartScale_ = { 1.0f, 1.0f, 1.0f };	// 開始スケール
-	Vector3 particleEndScale_ = { 1.0f, 1.0f, 1.0f };		// 終了スケール
+	ParticleSizeCurve sizeCurve_ = ParticleSizeCurve::MakeLinear(
+		{ 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f });		// サイズのカーブ
+
+	// 色・サイズの参照テーブル（発生したパーティクルはこれを参照する）
+	std::shared_ptr<ParticleLifetimeLut> lifetimeLut_;
+	bool ownsLifetimeLut_ = false;	// 自分用のテーブルか（falseならプリセットと共有）
 
 	// ========================================
 	// Rotation
@@ -276,7 +352,6 @@ private:
 
 	// エミッター寿命設定
 	float emitterLifeTime_ = 5.0f;			// エミッター寿命（秒）
-	float emitterCurrentTime_ = 0.0f;		// エミッター経過時間
 	bool emitterLifeTimeLoop_ = false;		// 寿命がループするか
 	bool useEmitterLifeTime_ = false;		// エミッター寿命を使用するか
 
@@ -286,6 +361,13 @@ private:
 		{0.5f, 0.5f, 0.5f}		// max
 	};
 
+	// 予算
+	ParticlePriority priority_ = ParticlePriority::Normal;	// 予算が足りない時の優先度
+	bool useDistanceLod_ = true;			// カメラから遠いと発生数を減らすか
+	float emissionCarry_ = 0.0f;			// 倍率を掛けた時の端数（次回に持ち越す）
+	uint32_t lastRequestedCount_ = 0;		// 直近で発生させようとした数
+	uint32_t lastSpawnedCount_ = 0;			// 直近で追加できた数
+
 	// デバッグ描画
 	bool showDebugAABB_ = false;
 	Vector4 debugAABBColor_ = { 1.0f, 0.0f, 0.0f, 1.0f };	// 赤色
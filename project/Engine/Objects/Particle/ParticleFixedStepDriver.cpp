@@ -0,0 +1,21 @@
+#include "ParticleFixedStepDriver.h"
+
+uint32_t ParticleFixedStepDriver::Advance(float deltaTime)
+{
+	if (deltaTime > 0.0f) {
+		accumulator_ += deltaTime;
+	}
+
+	uint32_t steps = 0;
+	while (accumulator_ >= step_ && steps < maxStepsPerFrame_) {
+		accumulator_ -= step_;
+		++steps;
+	}
+
+	// 追いつけなかった分は捨てる（次フレームに持ち越すと際限なく溜まるため）
+	if (steps == maxStepsPerFrame_ && accumulator_ >= step_) {
+		accumulator_ = 0.0f;
+	}
+
+	return steps;
+}
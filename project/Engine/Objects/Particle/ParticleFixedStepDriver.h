@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// 可変のフレーム時間を固定刻みのステップ数に変換する
+/// <para>フレームレートに関係なく同じ刻みで更新するため、決定論モードで使用する</para>
+/// </summary>
+class ParticleFixedStepDriver
+{
+public:
+	// 既定の刻み（60Hz）
+	static constexpr float kDefaultStep = 1.0f / 60.0f;
+
+	// 1フレームで実行する最大ステップ数（処理落ち時に追いつこうとして更に重くなるのを防ぐ）
+	static constexpr uint32_t kDefaultMaxStepsPerFrame = 4;
+
+	/// <summary>
+	/// フレーム時間を加算し、今回実行するステップ数を返す
+	/// <para>最大ステップ数を超えた分の時間は捨てる</para>
+	/// </summary>
+	/// <param name="deltaTime">フレームの経過時間</param>
+	uint32_t Advance(float deltaTime);
+
+	/// <summary>
+	/// 溜まっている時間を捨てる
+	/// </summary>
+	void Reset() { accumulator_ = 0.0f; }
+
+	void SetStep(float step) { step_ = step > 0.0f ? step : kDefaultStep; }
+	float GetStep() const { return step_; }
+
+	void SetMaxStepsPerFrame(uint32_t maxSteps) { maxStepsPerFrame_ = maxSteps; }
+	uint32_t GetMaxStepsPerFrame() const { return maxStepsPerFrame_; }
+
+	/// <summary>
+	/// 次のステップまでの進み具合（0～1、補間描画用）
+	/// </summary>
+	float GetAlpha() const { return accumulator_ / step_; }
+
+private:
+	float step_ = kDefaultStep;
+	uint32_t maxStepsPerFrame_ = kDefaultMaxStepsPerFrame;
+	float accumulator_ = 0.0f;
+};
@@ -1,26 +1,19 @@
 #define NOMINMAX
 #include "ParticleGroup.h"
+#include "BufferResource.h"
 #include "BaseField.h"
 #include "ImGui/ImGuiManager.h"
 #include "LightManager.h"
+#include "CameraController.h"
 #include "Logger.h"
 #include <algorithm>
+#include <cmath>
 
-// デストラクタでSRVを解放
-ParticleGroup::~ParticleGroup()
-{
-	// SRVが有効な場合のみ解放
-	if (srvHandle_.isValid && descriptorManager_) {
-		descriptorManager_->ReleaseSRV(srvHandle_.index);
-		Logger::Log(Logger::GetStream(),
-			std::format("ParticleGroup '{}': Released SRV at index {}\n", name_, srvHandle_.index));
-	}
-}
-
-void ParticleGroup::Initialize(DirectXCommon* dxCommon, const std::string& modelTag,
+void ParticleGroup::Initialize(DirectXCommon* dxCommon, ParticleInstanceArena* instanceArena, const std::string& modelTag,
 	uint32_t maxParticles, const std::string& textureName, bool useBillboard)
 {
 	dxCommon_ = dxCommon;
+	instanceArena_ = instanceArena;
 	modelTag_ = modelTag;
 	textureName_ = textureName;
 	maxParticles_ = maxParticles;
@@ -28,211 +21,386 @@ void ParticleGroup::Initialize(DirectXCommon* dxCommon, const std::string& model
 
 	activeParticleCount_ = 0;
 
-	// パーティクル配列の予約
-	particles_.reserve(maxParticles_);
+	// パーティクル配列の確保
+	storage_.Initialize(maxParticles_);
 
-	// DescriptorManagerへの参照を保持
-	descriptorManager_ = dxCommon_->GetDescriptorManager();
+	// チャンク毎の範囲（最大数分）
+	chunkBounds_.assign(ParticleKernels::GetChunkCount(maxParticles_), FieldKernels::EmptyBounds());
+	bounds_ = FieldKernels::EmptyBounds();
 
-	// GPU転送用バッファの作成
-	CreateTransformBuffer();
+	// 可視リスト（ソート用の領域はソートを有効にした時に確保する）
+	visibleIndices_.assign(maxParticles_, 0);
+	chunkVisibleCounts_.assign(ParticleKernels::GetChunkCount(maxParticles_), 0);
+	visibleParticleCount_ = 0;
 
 	// モデルとマテリアルを設定
 	SetModel(modelTag, textureName);
 }
 
-void ParticleGroup::CreateTransformBuffer() {
-	// トランスフォーム用のリソースを作成
-	transformResource_ = CreateBufferResource(
-		dxCommon_->GetDevice(),
-		sizeof(ParticleForGPU) * maxParticles_
-	);
+bool ParticleGroup::AddParticle(const ParticleState& particle)
+{
+	// 最大数に達していればストレージ側でfalseが返る
+	const uint32_t index = storage_.GetCount();
+	if (!storage_.Add(particle)) {
+		return false;
+	}
 
-	// トランスフォームデータにマップ
-	transformResource_->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_));
+	// 追加先チャンクとグループの範囲を広げる（次のシミュレーションで計算し直される）
+	FieldKernels::Expand(chunkBounds_[index / ParticleKernels::kChunkSize], particle.transform.translate);
+	FieldKernels::Expand(bounds_, particle.transform.translate);
+	return true;
+}
 
-	// 初期化
-	for (uint32_t i = 0; i < maxParticles_; ++i) {
-		instancingData_[i].World = MakeIdentity4x4();
-		instancingData_[i].WVP = MakeIdentity4x4();
-		instancingData_[i].color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+void ParticleGroup::SetSortBackToFront(bool enabled)
+{
+	sortBackToFront_ = enabled;
+	if (enabled && sortKeys_.size() < maxParticles_) {
+		sortKeys_.assign(maxParticles_, 0);
+		sortTempKeys_.assign(maxParticles_, 0);
+		sortTempIndices_.assign(maxParticles_, 0);
 	}
+}
 
-	// descriptorManager_が既に保持されている前提で使用
-	if (!descriptorManager_) {
-		Logger::Log(Logger::GetStream(),
-			std::format("[ParticleGroup] ERROR: DescriptorManager is null!\n"));
-		assert(false && "DescriptorManager is null");
+void ParticleGroup::SetTrail(const ParticleTrailSettings& settings)
+{
+	const uint32_t previousLength = storage_.GetTrailLength();
+
+	trailSettings_ = settings;
+	trailSettings_.length = std::clamp(settings.length, ParticleTrailSettings::kMinLength, ParticleTrailSettings::kMaxLength);
+	trailSettings_.recordInterval = std::max(settings.recordInterval, 0.0f);
+
+	if (!trailSettings_.enabled) {
+		// 履歴とバッファを解放
+		storage_.EnableTrail(0);
+		trailVertexBuffer_.Reset();
+		trailIndexBuffer_.Reset();
+		trailVertexData_ = nullptr;
+		trailDrawCount_ = 0;
 		return;
 	}
 
-	// 構造化バッファ用のSRVを作成
-	srvHandle_ = descriptorManager_->CreateSRVForStructuredBuffer(
-		transformResource_.Get(),
-		maxParticles_,
-		sizeof(ParticleForGPU)
-	);
-
-	// エラーチェック
-	if (!srvHandle_.isValid) {
-		Logger::Log(Logger::GetStream(),
-			std::format("Failed to create SRV for ParticleGroup '{}' (maxParticles: {})\n",
-				name_, maxParticles_));
-		assert(false && "SRV creation failed");
-	} else {
-		Logger::Log(Logger::GetStream(),
-			std::format("ParticleGroup '{}': Allocated SRV at index {}\n", name_, srvHandle_.index));
+	// 幅や色の倍率だけの変更なら確保し直さない
+	if (previousLength == trailSettings_.length && trailVertexBuffer_) {
+		return;
 	}
+
+	storage_.EnableTrail(trailSettings_.length);
+	trailTimer_ = 0.0f;
+	trailDrawCount_ = 0;
+	CreateTrailBuffers();
 }
 
-bool ParticleGroup::AddParticle(const ParticleState& particle)
+void ParticleGroup::CreateTrailBuffers()
 {
-	// 最大数に達していないかチェック
-	if (particles_.size() >= maxParticles_) {
-		return false;
+	if (!dxCommon_ || maxParticles_ == 0) {
+		return;
 	}
 
-	// パーティクルを追加
-	particles_.push_back(particle);
-	return true;
+	const uint32_t vertexCount = maxParticles_ * trailSettings_.GetVertexCountPerTrail();
+	const uint32_t indexCount = maxParticles_ * trailSettings_.GetIndexCountPerTrail();
+
+	// 頂点バッファ（毎フレーム書き込むのでMapしたままにする）
+	trailVertexBuffer_ = CreateBufferResource(dxCommon_->GetDevice(), sizeof(ParticleTrailVertex) * vertexCount);
+	trailVertexBufferView_.BufferLocation = trailVertexBuffer_->GetGPUVirtualAddress();
+	trailVertexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(ParticleTrailVertex) * vertexCount);
+	trailVertexBufferView_.StrideInBytes = sizeof(ParticleTrailVertex);
+	trailVertexBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&trailVertexData_));
+
+	// インデックスバッファ（全パーティクル共通の並びなので作成時に一度だけ書き込む）
+	trailIndexBuffer_ = CreateBufferResource(dxCommon_->GetDevice(), sizeof(uint32_t) * indexCount);
+	trailIndexBufferView_.BufferLocation = trailIndexBuffer_->GetGPUVirtualAddress();
+	trailIndexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(uint32_t) * indexCount);
+	trailIndexBufferView_.Format = DXGI_FORMAT_R32_UINT;
+	uint32_t* indexData = nullptr;
+	trailIndexBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
+	ParticleKernels::BuildTrailIndices(trailSettings_.length, maxParticles_, indexData);
+	trailIndexBuffer_->Unmap(0, nullptr);
+
+	Logger::Log(Logger::GetStream(),
+		std::format("ParticleGroup '{}': Trail enabled (length {}, {} KB)\n", name_, trailSettings_.length,
+			(sizeof(ParticleTrailVertex) * vertexCount + sizeof(uint32_t) * indexCount) / 1024));
 }
 
 void ParticleGroup::ClearAllParticles()
 {
-	particles_.clear();
+	storage_.Clear();
 	activeParticleCount_ = 0;
+	visibleParticleCount_ = 0;
+	trailDrawCount_ = 0;
+
+	std::fill(chunkBounds_.begin(), chunkBounds_.end(), FieldKernels::EmptyBounds());
+	bounds_ = FieldKernels::EmptyBounds();
 }
 
-void ParticleGroup::Update(const Matrix4x4& viewProjectionMatrix, const Matrix4x4& billboardMatrix, float deltaTime, const std::vector<BaseField*>& fields)
+void ParticleGroup::Update(const Matrix4x4& viewProjectionMatrix, float deltaTime, const std::vector<BaseField*>& fields)
 {
-	// パーティクルの更新
-	UpdateParticles(deltaTime, fields);
+	// 単体で更新する場合は各フェーズを順に実行する
+
+	// 有効なフィールドの範囲を計算してグループと重なるものを残す
+	std::vector<FieldBroadphaseEntry> fieldEntries;
+	for (auto* field : fields) {
+		if (field && field->IsEnabled()) {
+			fieldEntries.push_back({ field, field->GetWorldBounds() });
+		}
+	}
+	CullFields(fieldEntries);
+	AdvanceSubstep(deltaTime);
+
+	// 寿命チェックとフィールド適用
+	const uint32_t expireChunkCount = GetChunkCount();
+	for (uint32_t chunk = 0; chunk < expireChunkCount; ++chunk) {
+		ExpireChunk(chunk, deltaTime);
+	}
+
+	// 死亡パーティクルを除去
+	CompactParticles();
+	AdvanceTrail(deltaTime);
+
+	// シミュレーションと可視判定
+	const ParticleFrustum frustum = ParticleKernels::MakeFrustum(viewProjectionMatrix);
+	const uint32_t simulateChunkCount = GetChunkCount();
+	for (uint32_t chunk = 0; chunk < simulateChunkCount; ++chunk) {
+		SimulateChunk(chunk, &frustum, viewProjectionMatrix, deltaTime);
+	}
+	GatherVisible();
+
+	// GPU転送用の範囲を確保（アリーナのフレーム開始はParticleSystemが行う）
+	AllocateInstances();
 
-	// GPU転送用のデータを更新（ビルボード行列はManagerから受け取る）
-	UpdateParticleForGPUBuffer(viewProjectionMatrix, billboardMatrix);
+	// GPU転送用データの更新（ビルボード行列はManagerから受け取る）
+	const uint32_t writeChunkCount = GetWriteChunkCount();
+	for (uint32_t chunk = 0; chunk < writeChunkCount; ++chunk) {
+		WriteInstanceChunk(chunk);
+	}
+
+	// 軌跡の頂点
+	const Vector3 cameraPosition = CameraController::GetInstance()->GetPosition();
+	const uint32_t trailChunkCount = GetTrailChunkCount();
+	for (uint32_t chunk = 0; chunk < trailChunkCount; ++chunk) {
+		WriteTrailChunk(chunk, cameraPosition);
+	}
 
 	// マテリアル更新
-	materials_.UpdateAllUVTransforms();
+	FinishUpdate();
 }
 
-void ParticleGroup::UpdateParticles(float deltaTime, const std::vector<BaseField*>& fields)
+void ParticleGroup::CullFields(const std::vector<FieldBroadphaseEntry>& fields)
 {
-	// アクティブなパーティクル数をリセット
-	activeParticleCount_ = 0;
-
-	// 死んだパーティクルを削除するためのイテレータ
-	auto it = particles_.begin();
-	while (it != particles_.end()) {
-		auto& particle = *it;
+	candidateFields_.clear();
+	if (storage_.IsEmpty()) {
+		return;
+	}
 
-		// 寿命チェック
-		if (particle.lifeTime <= particle.currentTime) {
-			// 寿命が尽きたパーティクルを削除
-			it = particles_.erase(it);
-			continue;
+	for (const auto& entry : fields) {
+		if (FieldKernels::Overlaps(entry.bounds, bounds_)) {
+			candidateFields_.push_back(entry);
 		}
+	}
+}
 
-		// フィールドの効果を適用
-		bool shouldDelete = false;
-		for (auto* field : fields) {
-			if (field && field->IsEnabled() && field->IsInField(particle.transform.translate)) {
-				// フィールドの効果を適用
-				shouldDelete = field->ApplyEffect(particle, deltaTime);
-				if (shouldDelete) {
-					break;	// 削除フラグが立ったらループを抜ける
-				}
-			}
-		}
+void ParticleGroup::AdvanceSubstep(float deltaTime)
+{
+	if (!substepSettings_.enabled) {
+		return;
+	}
 
-		// フィールドによって削除フラグが立った場合
-		if (shouldDelete) {
-			it = particles_.erase(it);
-			continue;
-		}
+	// 時間を溜めて固定刻みの数に変換（スローモーション中は刻みが無いフレームもある）
+	substepCount_ = substepDriver_.Advance(deltaTime);
+}
 
-		// 速度を位置に加算
-		particle.transform.translate.x += particle.velocity.x * deltaTime;
-		particle.transform.translate.y += particle.velocity.y * deltaTime;
-		particle.transform.translate.z += particle.velocity.z * deltaTime;
+void ParticleGroup::SetSubstep(const ParticleSubstepSettings& settings)
+{
+	substepSettings_ = settings;
+	substepSettings_.maxStepsPerFrame = std::max(substepSettings_.maxStepsPerFrame, 1u);
+
+	substepDriver_.SetStep(substepSettings_.step);
+	substepDriver_.SetMaxStepsPerFrame(substepSettings_.maxStepsPerFrame);
+	substepDriver_.Reset();
+	substepSettings_.step = substepDriver_.GetStep();
+	substepCount_ = 0;
+}
 
-		/// 寿命に関連した更新処理
+void ParticleGroup::ExpireChunk(uint32_t chunkIndex, float deltaTime)
+{
+	uint32_t begin = 0;
+	uint32_t end = 0;
+	GetChunkRange(chunkIndex, begin, end);
 
-		// 寿命の進行率を計算（0.0 ~ 1.0）
-		float t = particle.currentTime / particle.lifeTime;
+	// 寿命チェック（寿命が尽きたパーティクルに死亡フラグを立てる）
+	ParticleKernels::MarkExpired(storage_, begin, end);
 
-		// Color Over Lifetime
-		if (particle.useColorOverLifetime) {
-			// 開始色から終了色へ線形補間
-			particle.color = Lerp(particle.startColor, particle.endColor, t);
-		} else {
-			//色を透明にしていく
-			float alpha = 1.0f - t;
-			particle.color.w = alpha;
+	// フィールドの効果を適用（1刻み目。チャンクと重なるフィールドだけ）
+	if (GetStepCount() > 0) {
+		ApplyFields(begin, end, &chunkBounds_[chunkIndex], GetStepTime(deltaTime));
+	}
+}
+
+void ParticleGroup::ApplyFields(uint32_t begin, uint32_t end, const AABB* chunkBounds, float deltaTime)
+{
+	if (candidateFields_.empty()) {
+		return;
+	}
+
+	// フィールド毎にまとめて処理
+	ParticleFieldSpan span;
+	span.positionX = storage_.positionX.data();
+	span.positionY = storage_.positionY.data();
+	span.positionZ = storage_.positionZ.data();
+	span.velocityX = storage_.velocityX.data();
+	span.velocityY = storage_.velocityY.data();
+	span.velocityZ = storage_.velocityZ.data();
+	span.killFlags = storage_.killFlags.data();
+	span.begin = begin;
+	span.end = end;
+
+	for (const auto& entry : candidateFields_) {
+		if (!chunkBounds || FieldKernels::Overlaps(entry.bounds, *chunkBounds)) {
+			entry.field->ApplyBatch(span, deltaTime);
 		}
+	}
+}
 
-		// Size Over Lifetime
-		if (particle.useSizeOverLifetime) {
-			// 開始スケールから終了スケールへ線形補間
-			particle.transform.scale = Lerp(particle.startScale, particle.endScale, t);
+void ParticleGroup::CompactParticles()
+{
+	// 死亡フラグが立ったパーティクルを除去して詰める
+	storage_.Compact();
+
+	// 先頭からactiveParticleCount_個が連続した生存範囲になる
+	activeParticleCount_ = storage_.GetCount();
+
+	// 使われなくなったチャンクの範囲を空にする（範囲はシミュレーション後に計算し直す）
+	for (uint32_t chunk = GetChunkCount(); chunk < chunkBounds_.size(); ++chunk) {
+		chunkBounds_[chunk] = FieldKernels::EmptyBounds();
+	}
+}
+
+void ParticleGroup::AdvanceTrail(float deltaTime)
+{
+	recordTrailThisStep_ = false;
+	if (!storage_.HasTrail()) {
+		return;
+	}
+
+	// 記録間隔毎に1行進める（間隔より長いステップでも記録は1回で、間隔の余りだけ持ち越す）
+	trailTimer_ += deltaTime;
+	if (trailTimer_ >= trailSettings_.recordInterval) {
+		trailTimer_ = std::fmod(trailTimer_, std::max(trailSettings_.recordInterval, 1.0e-6f));
+		storage_.AdvanceTrailHead();
+		recordTrailThisStep_ = true;
+	}
+}
+
+void ParticleGroup::SimulateChunk(uint32_t chunkIndex, const ParticleFrustum* frustum, const Matrix4x4& viewProjectionMatrix, float deltaTime)
+{
+	uint32_t begin = 0;
+	uint32_t end = 0;
+	GetChunkRange(chunkIndex, begin, end);
+
+	// 移動前の位置を軌跡の履歴に記録（現在位置は描画時に先頭の点として加える）
+	if (recordTrailThisStep_) {
+		ParticleKernels::RecordTrail(storage_, begin, end);
+	}
+
+	// 移動・色・サイズ・回転・寿命をグループのモードに応じてまとめて更新
+	// サブステップ有効時は刻み数だけ繰り返す（チャンク内のパーティクルは互いに独立なので、チャンク毎に進めてよい）
+	const uint32_t stepCount = GetStepCount();
+	const float stepTime = GetStepTime(deltaTime);
+	for (uint32_t step = 0; step < stepCount; ++step) {
+		// 2刻み目以降のフィールド（刻みの間に動くので、チャンクの範囲では絞らない）
+		// ここで立った死亡フラグのレーンはフィールドの対象から外れ、可視判定・軌跡でも描かれない
+		// フラグは次のフレームの寿命チェックでも残るので、その後の除去で取り除かれる
+		if (step > 0) {
+			ApplyFields(begin, end, nullptr, stepTime);
 		}
+		ParticleKernels::Simulate(storage_, begin, end, stepTime);
+	}
+
+	// 移動後の位置で範囲を計算（次フレームのブロードフェーズで使う）
+	chunkBounds_[chunkIndex] = ParticleKernels::ComputeBounds(storage_, begin, end);
+
+	// 可視判定（チャンクと同じ位置に書き出すので、他のチャンクと競合しない）
+	uint32_t* keys = sortBackToFront_ ? sortKeys_.data() + begin : nullptr;
+	chunkVisibleCounts_[chunkIndex] = ParticleKernels::CullVisible(storage_, begin, end, frustum,
+		viewProjectionMatrix, visibleIndices_.data() + begin, keys);
+}
 
-		// Rotation
-		if (particle.useRotation) {
-			// 回転速度を適用（度/秒 → ラジアン/秒に変換）
-			Vector3 rotationDelta = {
-				DegToRad(particle.rotationSpeed.x) * deltaTime,
-				DegToRad(particle.rotationSpeed.y) * deltaTime,
-				DegToRad(particle.rotationSpeed.z) * deltaTime
-			};
-
-			particle.transform.rotate.x += rotationDelta.x;
-			particle.transform.rotate.y += rotationDelta.y;
-			particle.transform.rotate.z += rotationDelta.z;
+void ParticleGroup::GatherVisible()
+{
+	// チャンク毎の可視リストを順に先頭へ詰める（書き込み先は常に読み込み元以前なので上書きしない）
+	uint32_t visibleCount = 0;
+	const uint32_t chunkCount = GetChunkCount();
+	for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+		const uint32_t source = chunk * ParticleKernels::kChunkSize;
+		const uint32_t count = chunkVisibleCounts_[chunk];
+		if (count > 0 && source != visibleCount) {
+			std::copy(visibleIndices_.begin() + source, visibleIndices_.begin() + source + count,
+				visibleIndices_.begin() + visibleCount);
+			if (sortBackToFront_) {
+				std::copy(sortKeys_.begin() + source, sortKeys_.begin() + source + count,
+					sortKeys_.begin() + visibleCount);
+			}
 		}
+		visibleCount += count;
+	}
+	visibleParticleCount_ = visibleCount;
 
-		// 寿命を進める
-		particle.currentTime += deltaTime;
+	// 奥から手前の順に並べ替える
+	if (sortBackToFront_) {
+		ParticleKernels::RadixSort(sortKeys_.data(), visibleIndices_.data(), visibleParticleCount_,
+			sortTempKeys_.data(), sortTempIndices_.data());
+	}
+}
 
-		// アクティブなパーティクルとしてカウント
-		++activeParticleCount_;
-		++it;
+void ParticleGroup::AllocateInstances()
+{
+	instanceRange_ = instanceArena_ ? instanceArena_->Allocate(visibleParticleCount_) : ParticleInstanceRange{};
+}
+
+void ParticleGroup::WriteInstanceChunk(uint32_t chunkIndex)
+{
+	// 範囲が確保できなかった場合は描画しない
+	if (!instanceRange_.IsValid()) {
+		return;
 	}
+
+	const uint32_t begin = std::min(chunkIndex * ParticleKernels::kChunkSize, visibleParticleCount_);
+	const uint32_t end = std::min(begin + ParticleKernels::kChunkSize, visibleParticleCount_);
+	ParticleKernels::WriteInstancesIndexed(storage_, visibleIndices_.data(), begin, end, instanceRange_.data,
+		useBillboard_);
 }
 
-void ParticleGroup::UpdateParticleForGPUBuffer(const Matrix4x4& viewProjectionMatrix, const Matrix4x4& billboardMatrix)
+void ParticleGroup::WriteTrailChunk(uint32_t chunkIndex, const Vector3& cameraPosition)
 {
-	// アクティブなパーティクルのみGPUバッファに書き込む
-	for (uint32_t i = 0; i < activeParticleCount_ && i < particles_.size(); ++i) {
-		const auto& particle = particles_[i];
-
-		if (useBillboard_) {
-			// ビルボードが有効な場合（ビルボード行列はManagerから受け取る）
-			Matrix4x4 scaleMatrix = MakeScaleMatrix(particle.transform.scale);
-			Matrix4x4 translateMatrix = MakeTranslateMatrix(particle.transform.translate);
-
-			// World = Scale * Billboard * Translate
-			instancingData_[i].World = Matrix4x4Multiply(
-				Matrix4x4Multiply(scaleMatrix, billboardMatrix),
-				translateMatrix
-			);
-		} else {
-			// ビルボードが無効な場合
-			instancingData_[i].World = MakeAffineMatrix(
-				particle.transform.scale,
-				particle.transform.rotate,
-				particle.transform.translate
-			);
-		}
+	if (!trailVertexData_) {
+		return;
+	}
 
-		// WVP行列の計算
-		instancingData_[i].WVP = Matrix4x4Multiply(
-			instancingData_[i].World,
-			viewProjectionMatrix
-		);
+	uint32_t begin = 0;
+	uint32_t end = 0;
+	GetChunkRange(chunkIndex, begin, end);
+	ParticleKernels::WriteTrailVertices(storage_, begin, end, trailSettings_, cameraPosition, trailVertexData_);
+}
 
-		// 色の設定
-		instancingData_[i].color = particle.color;
+void ParticleGroup::FinishUpdate()
+{
+	// 軌跡は生存している全パーティクル分を書き込んでいる
+	trailDrawCount_ = trailVertexData_ ? storage_.GetCount() : 0;
+
+	// チャンクの範囲をまとめてグループの範囲にする
+	bounds_ = FieldKernels::EmptyBounds();
+	const uint32_t chunkCount = GetChunkCount();
+	for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+		FieldKernels::Expand(bounds_, chunkBounds_[chunk]);
 	}
+
+	// マテリアル更新
+	materials_.UpdateAllUVTransforms();
+}
+
+void ParticleGroup::GetChunkRange(uint32_t chunkIndex, uint32_t& begin, uint32_t& end) const
+{
+	begin = std::min(chunkIndex * ParticleKernels::kChunkSize, storage_.GetCount());
+	end = std::min(begin + ParticleKernels::kChunkSize, storage_.GetCount());
 }
 
 void ParticleGroup::Draw()
@@ -241,7 +409,7 @@ void ParticleGroup::Draw()
 		return;
 	}
 
-	if (activeParticleCount_ == 0) {
+	if (visibleParticleCount_ == 0 || !instanceRange_.IsValid()) {
 		return;
 	}
 
@@ -261,21 +429,44 @@ void ParticleGroup::Draw()
 		commandList->SetGraphicsRootConstantBufferView(0,
 			materials_.GetMaterial(materialIndex).GetResource()->GetGPUVirtualAddress());
 
-		// トランスフォーム（構造化バッファ）
-		commandList->SetGraphicsRootDescriptorTable(1, srvHandle_.gpuHandle);
+		// トランスフォーム（共有アリーナ内のこのグループの範囲をルートSRVでバインド）
+		commandList->SetGraphicsRootShaderResourceView(1, instanceRange_.gpuAddress);
 
 		// テクスチャの設定
-		if (!textureName_.empty()) {
-			commandList->SetGraphicsRootDescriptorTable(2,
-				textureManager_->GetTextureHandle(textureName_));
-		} else if (sharedModel_->HasTexture(materialIndex)) {
-			commandList->SetGraphicsRootDescriptorTable(2,
-				textureManager_->GetTextureHandle(sharedModel_->GetTextureTagName(materialIndex)));
-		}
+		SetTextureTable(commandList, materialIndex);
 
 		// メッシュをバインドして描画（アクティブなパーティクル数を指定）
 		const_cast<Mesh&>(mesh).Bind(commandList);
-		const_cast<Mesh&>(mesh).Draw(commandList, activeParticleCount_);
+		const_cast<Mesh&>(mesh).Draw(commandList, instanceRange_.count);
+	}
+}
+
+void ParticleGroup::DrawTrail()
+{
+	if (trailDrawCount_ == 0 || !trailVertexBuffer_ || !sharedModel_ || !sharedModel_->IsValid()) {
+		return;
+	}
+
+	ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+
+	// マテリアルとテクスチャは先頭のマテリアルのものを使う
+	commandList->SetGraphicsRootConstantBufferView(0, materials_.GetMaterial(0).GetResource()->GetGPUVirtualAddress());
+	SetTextureTable(commandList, 0);
+
+	// 全パーティクルの帯を1回で描画（未記録の点は面積0になっている）
+	commandList->IASetVertexBuffers(0, 1, &trailVertexBufferView_);
+	commandList->IASetIndexBuffer(&trailIndexBufferView_);
+	commandList->DrawIndexedInstanced(trailDrawCount_ * trailSettings_.GetIndexCountPerTrail(), 1, 0, 0, 0);
+}
+
+void ParticleGroup::SetTextureTable(ID3D12GraphicsCommandList* commandList, size_t materialIndex)
+{
+	if (!textureName_.empty()) {
+		commandList->SetGraphicsRootDescriptorTable(2,
+			textureManager_->GetTextureHandle(textureName_));
+	} else if (sharedModel_->HasTexture(materialIndex)) {
+		commandList->SetGraphicsRootDescriptorTable(2,
+			textureManager_->GetTextureHandle(sharedModel_->GetTextureTagName(materialIndex)));
 	}
 }
 
@@ -286,13 +477,69 @@ void ParticleGroup::ImGui()
 		// パーティクルグループ全体の設定
 		if (ImGui::CollapsingHeader("Particle Group", ImGuiTreeNodeFlags_DefaultOpen)) {
 			ImGui::Text("Active Particles: %u / %u", activeParticleCount_, maxParticles_);
-			ImGui::Text("SRV Index: %u", srvHandle_.index); // デバッグ用にSRVインデックス表示
+			ImGui::Text("Visible Particles: %u (culled %u)", visibleParticleCount_, activeParticleCount_ - visibleParticleCount_);
+			ImGui::Text("Arena Offset: %u (%u instances)",
+				instanceRange_.IsValid() ? instanceRange_.offset : 0u, instanceRange_.count); // デバッグ用にアリーナ内の位置を表示
 			ImGui::Checkbox("Use Billboard", &useBillboard_);
+			bool sortBackToFront = sortBackToFront_;
+			if (ImGui::Checkbox("Sort Back To Front", &sortBackToFront)) {
+				SetSortBackToFront(sortBackToFront);
+			}
+
+			// グループ単位の更新モード（有効なカーネル）
+			const ParticleUpdateModes& modes = storage_.GetModes();
+			ImGui::Text("Modes: Color %s / Size %s / Rotation %s",
+				modes.colorOverLifetime ? "ON" : "off",
+				modes.sizeOverLifetime ? "ON" : "off",
+				modes.rotation ? "ON" : "off");
 
 			ImGui::Separator();
 		}
 
 
+		// 軌跡の設定
+		if (ImGui::CollapsingHeader("Trail")) {
+			ParticleTrailSettings trail = trailSettings_;
+			bool changed = ImGui::Checkbox("Enable Trail", &trail.enabled);
+			int length = static_cast<int>(trail.length);
+			if (ImGui::SliderInt("Length", &length, ParticleTrailSettings::kMinLength, ParticleTrailSettings::kMaxLength)) {
+				trail.length = static_cast<uint32_t>(length);
+				changed = true;
+			}
+			changed |= ImGui::DragFloat("Record Interval", &trail.recordInterval, 0.001f, 0.0f, 1.0f, "%.3f");
+			changed |= ImGui::DragFloat("Width", &trail.width, 0.01f, 0.0f, 100.0f);
+			changed |= ImGui::SliderFloat("Tail Width Rate", &trail.tailWidthRate, 0.0f, 2.0f);
+			changed |= ImGui::SliderFloat("Tail Alpha Rate", &trail.tailAlphaRate, 0.0f, 1.0f);
+			if (changed) {
+				SetTrail(trail);
+			}
+			if (trailDrawCount_ > 0) {
+				ImGui::Text("Trails: %u  Vertices: %u", trailDrawCount_, trailDrawCount_ * trailSettings_.GetVertexCountPerTrail());
+			}
+		}
+
+		// 固定刻みサブステップ
+		if (ImGui::CollapsingHeader("Substep")) {
+			ParticleSubstepSettings substep = substepSettings_;
+			bool changed = ImGui::Checkbox("Enable Fixed Substep", &substep.enabled);
+			float stepRate = 1.0f / substep.step;
+			if (ImGui::DragFloat("Step Rate (Hz)", &stepRate, 1.0f, 30.0f, 1000.0f, "%.0f")) {
+				substep.step = 1.0f / std::max(stepRate, 1.0f);
+				changed = true;
+			}
+			int maxSteps = static_cast<int>(substep.maxStepsPerFrame);
+			if (ImGui::SliderInt("Max Steps / Frame", &maxSteps, 1, 32)) {
+				substep.maxStepsPerFrame = static_cast<uint32_t>(maxSteps);
+				changed = true;
+			}
+			if (changed) {
+				SetSubstep(substep);
+			}
+			if (substepSettings_.enabled) {
+				ImGui::Text("Steps This Frame: %u", substepCount_);
+			}
+		}
+
 		// テクスチャ設定
 		if (ImGui::CollapsingHeader("Texture")) {
 			std::vector<std::string> textureList = textureManager_->GetTextureTagList();
@@ -333,10 +580,10 @@ void ParticleGroup::ImGui()
 			uint32_t displayCount = std::min(activeParticleCount_, 5u);
 			ImGui::Text("Showing first %u particles", displayCount);
 
-			for (uint32_t i = 0; i < displayCount && i < particles_.size(); ++i) {
+			for (uint32_t i = 0; i < displayCount; ++i) {
 				std::string particleLabel = std::format("Particle {}", i);
 				if (ImGui::TreeNode(particleLabel.c_str())) {
-					auto& particle = particles_[i];
+					ParticleState particle = storage_.GetParticle(i);
 
 					ImGui::Text("Position: (%.2f, %.2f, %.2f)",
 						particle.transform.translate.x,
@@ -352,7 +599,9 @@ void ParticleGroup::ImGui()
 						particle.currentTime,
 						particle.lifeTime);
 
-					ImGui::ColorEdit4("Color", &particle.color.x);
+					if (ImGui::ColorEdit4("Color", &particle.color.x)) {
+						storage_.SetColor(i, particle.color);
+					}
 
 					ImGui::TreePop();
 				}
@@ -3,12 +3,14 @@
 #include <vector>
 #include "DirectXCommon.h"
 #include "ParticleState.h"
+#include "ParticleStorage.h"
+#include "ParticleKernels.h"
+#include "ParticleInstanceArena.h"
+#include "ParticleFixedStepDriver.h"
+#include "BaseField.h"
 #include "Texture/TextureManager.h"
 #include "Model/ModelManager.h"
 
-
-// 前方宣言
-class BaseField;
 /// <summary>
 /// パーティクルグループ
 /// <para>同じモデル・テクスチャを使用するパーティクルの集合</para>
@@ -18,32 +20,133 @@ class ParticleGroup
 {
 public:
 	ParticleGroup() = default;
-	~ParticleGroup(); // デストラクタでSRVを解放
+	~ParticleGroup() = default;
 
 	/// <summary>
 	/// 初期化
 	/// </summary>
 	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	/// <param name="instanceArena">GPU転送用データの切り出し元（ParticleSystemが所有）</param>
 	/// <param name="modelTag">使用するモデルのタグ名</param>
 	/// <param name="maxParticles">最大パーティクル数</param>
 	/// <param name="textureName">テクスチャ名</param>
 	/// <param name="useBillboard">ビルボードを使用するか</param>
-	void Initialize(DirectXCommon* dxCommon, const std::string& modelTag,
+	void Initialize(DirectXCommon* dxCommon, ParticleInstanceArena* instanceArena, const std::string& modelTag,
 		uint32_t maxParticles, const std::string& textureName = "", bool useBillboard = true);
 
 	/// <summary>
 	/// 更新処理
 	/// </summary>
-	/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
-	/// <param name="billboardMatrix">ビルボード行列（Managerから渡される）</param>
+	/// <param name="viewProjectionMatrix">ビュープロジェクション行列（カリングとソートに使う）</param>
+	/// <param name="deltaTime">デルタタイム</param>
+	void Update(const Matrix4x4& viewProjectionMatrix, float deltaTime, const std::vector<BaseField*>& fields = {});
+
+	///*-----------------------------------------------------------------------*///
+	///					並列更新用（ParticleSystemからフェーズ毎に呼ばれる）			///
+	///*-----------------------------------------------------------------------*///
+
+	/// <summary>
+	/// 現在のパーティクル数でのチャンク数
+	/// </summary>
+	uint32_t GetChunkCount() const { return ParticleKernels::GetChunkCount(storage_.GetCount()); }
+
+	/// <summary>
+	/// フェーズ0：グループ全体の範囲と重なるフィールドだけを候補として残す（グループ単位、並列実行可）
+	/// </summary>
+	/// <param name="fields">有効なフィールドとその範囲</param>
+	void CullFields(const std::vector<FieldBroadphaseEntry>& fields);
+
+	/// <summary>
+	/// 固定刻みサブステップの刻み数を決める（フェーズ1の前、メインスレッドから呼ぶ）
+	/// <para>サブステップが無効なら何もしない（deltaTimeで1回だけ進める）</para>
+	/// </summary>
+	/// <param name="deltaTime">デルタタイム</param>
+	void AdvanceSubstep(float deltaTime);
+
+	/// <summary>
+	/// フェーズ1：寿命チェックとフィールド適用（チャンク単位、並列実行可）
+	/// <para>CullFieldsで残ったフィールドのうち、チャンクの範囲と重なるものだけを適用する</para>
+	/// <para>サブステップ有効時は1刻み分だけ適用する（刻みが無いフレームでは適用しない）</para>
+	/// </summary>
+	/// <param name="chunkIndex">チャンク番号</param>
+	/// <param name="deltaTime">デルタタイム</param>
+	void ExpireChunk(uint32_t chunkIndex, float deltaTime);
+
+	/// <summary>
+	/// フェーズ2：死亡パーティクルを除去（グループ単位、グループ間で並列実行可）
+	/// </summary>
+	void CompactParticles();
+
+	/// <summary>
+	/// 軌跡の記録タイマーを進める（CompactParticles後、メインスレッドから呼ぶ）
+	/// <para>記録間隔に達したら履歴の書き込み先を進め、このステップのSimulateChunkで記録させる</para>
+	/// </summary>
+	/// <param name="deltaTime">デルタタイム</param>
+	void AdvanceTrail(float deltaTime);
+
+	/// <summary>
+	/// フェーズ3：シミュレーションと可視判定（チャンク単位、並列実行可）
+	/// <para>視錐台と重なるパーティクルの番号を、チャンクと同じ位置の可視リストに書き出す</para>
+	/// <para>サブステップ有効時は刻み数だけ移動を繰り返し、2刻み目以降のフィールドもここで適用する</para>
+	/// </summary>
+	/// <param name="chunkIndex">チャンク番号（CompactParticles後の数で数える）</param>
+	/// <param name="frustum">視錐台（nullptrならカリングしない）</param>
+	/// <param name="viewProjectionMatrix">ビュープロジェクション行列（ソート用の深度計算に使う）</param>
 	/// <param name="deltaTime">デルタタイム</param>
-	void Update(const Matrix4x4& viewProjectionMatrix, const Matrix4x4& billboardMatrix, float deltaTime, const std::vector<BaseField*>& fields = {});
+	void SimulateChunk(uint32_t chunkIndex, const ParticleFrustum* frustum, const Matrix4x4& viewProjectionMatrix, float deltaTime);
+
+	/// <summary>
+	/// フェーズ4：チャンク毎の可視リストを先頭に詰め、必要なら奥から手前の順に並べ替える（グループ単位、並列実行可）
+	/// </summary>
+	void GatherVisible();
+
+	/// <summary>
+	/// GPU転送用の範囲をアリーナから切り出す（GatherVisible後、メインスレッドから呼ぶ）
+	/// <para>可視数ぴったりの範囲を確保する</para>
+	/// </summary>
+	void AllocateInstances();
+
+	/// <summary>
+	/// 可視数でのチャンク数（WriteInstanceChunk用）
+	/// </summary>
+	uint32_t GetWriteChunkCount() const { return ParticleKernels::GetChunkCount(visibleParticleCount_); }
+
+	/// <summary>
+	/// フェーズ5：可視リストの順にGPUバッファへ書き込む（チャンク単位、並列実行可）
+	/// <para>チャンク毎に書き込み範囲が分かれているので、バッファへの書き込みは競合しない</para>
+	/// <para>行列は頂点シェーダーで組み立てるので、ここでは位置・スケール・回転・色を詰めるだけ</para>
+	/// </summary>
+	/// <param name="chunkIndex">チャンク番号（可視数で数える）</param>
+	void WriteInstanceChunk(uint32_t chunkIndex);
+
+	/// <summary>
+	/// 軌跡の頂点を書き込むチャンク数（軌跡が無効なら0）
+	/// </summary>
+	uint32_t GetTrailChunkCount() const { return storage_.HasTrail() ? GetChunkCount() : 0; }
+
+	/// <summary>
+	/// フェーズ5'：軌跡の頂点をGPUバッファに書き込む（チャンク単位、並列実行可）
+	/// <para>パーティクル毎に書き込み位置が固定なので、チャンク間で競合しない</para>
+	/// </summary>
+	/// <param name="chunkIndex">チャンク番号（生存数で数える）</param>
+	/// <param name="cameraPosition">カメラのワールド座標（帯をカメラに向ける）</param>
+	void WriteTrailChunk(uint32_t chunkIndex, const Vector3& cameraPosition);
+
+	/// <summary>
+	/// フェーズ6：GPUリソースの更新（メインスレッドで呼ぶ）
+	/// </summary>
+	void FinishUpdate();
 
 	/// <summary>
 	/// 描画処理
 	/// </summary>
 	void Draw();
 
+	/// <summary>
+	/// 軌跡の描画（ParticleCommon::setTrailRenderSettings後に呼ぶ）
+	/// </summary>
+	void DrawTrail();
+
 	/// <summary>
 	/// ImGui用のデバッグ表示
 	/// </summary>
@@ -63,9 +166,13 @@ public:
 
 	// パーティクル状態
 	uint32_t GetActiveParticleCount() const { return activeParticleCount_; }
+	uint32_t GetVisibleParticleCount() const { return visibleParticleCount_; }
 	uint32_t GetMaxParticleCount() const { return maxParticles_; }
-	bool IsFull() const { return particles_.size() >= maxParticles_; }
-	bool IsEmpty() const { return particles_.empty(); }
+	bool IsFull() const { return storage_.IsFull(); }
+	bool IsEmpty() const { return storage_.IsEmpty(); }
+	const AABB& GetBounds() const { return bounds_; }
+	size_t GetCandidateFieldCount() const { return candidateFields_.size(); }
+	const ParticleUpdateModes& GetUpdateModes() const { return storage_.GetModes(); }
 
 	// Model関連
 	Model* GetModel() { return sharedModel_; }
@@ -93,39 +200,95 @@ public:
 	void SetBillboard(bool enabled) { useBillboard_ = enabled; }
 	bool UseBillboard() const { return useBillboard_; }
 
+	/// <summary>
+	/// 奥から手前の順に描画するか（半透明のグループ用、有効にした時にソート用の領域を確保する）
+	/// </summary>
+	void SetSortBackToFront(bool enabled);
+	bool IsSortBackToFront() const { return sortBackToFront_; }
+
+	/// <summary>
+	/// 軌跡の設定（点数が変わった時だけ履歴と頂点バッファを確保し直す）
+	/// </summary>
+	void SetTrail(const ParticleTrailSettings& settings);
+	const ParticleTrailSettings& GetTrailSettings() const { return trailSettings_; }
+	bool HasTrail() const { return storage_.HasTrail(); }
+
+	/// <summary>
+	/// 固定刻みサブステップの設定（変更すると溜まっている時間は捨てる）
+	/// </summary>
+	void SetSubstep(const ParticleSubstepSettings& settings);
+	const ParticleSubstepSettings& GetSubstepSettings() const { return substepSettings_; }
+
 private:
 	/// <summary>
-	/// GPU転送用のトランスフォームバッファを作成
+	/// チャンク番号から処理範囲を計算
 	/// </summary>
-	void CreateTransformBuffer();
+	void GetChunkRange(uint32_t chunkIndex, uint32_t& begin, uint32_t& end) const;
 
 	/// <summary>
-	/// GPU転送用のデータを更新
+	/// 候補のフィールドを[begin, end)に適用
 	/// </summary>
-	/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
-	/// <param name="billboardMatrix">ビルボード行列</param>
-	void UpdateParticleForGPUBuffer(const Matrix4x4& viewProjectionMatrix, const Matrix4x4& billboardMatrix);
+	/// <param name="chunkBounds">チャンクの範囲（nullptrなら範囲で絞らずに全ての候補を適用）</param>
+	void ApplyFields(uint32_t begin, uint32_t end, const AABB* chunkBounds, float deltaTime);
 
 	/// <summary>
-	/// パーティクルの物理更新
+	/// このフレームの刻み数と1刻みの時間（サブステップ無効ならdeltaTimeで1回）
 	/// </summary>
-	/// <param name="deltaTime">デルタタイム</param>
-	void UpdateParticles(float deltaTime, const std::vector<BaseField*>& fields = {});
+	uint32_t GetStepCount() const { return substepSettings_.enabled ? substepCount_ : 1; }
+	float GetStepTime(float deltaTime) const { return substepSettings_.enabled ? substepDriver_.GetStep() : deltaTime; }
 
 	/// <summary>
 	/// モデルとマテリアルを設定
 	/// </summary>
 	void SetModel(const std::string& modelTag, const std::string& textureName);
 
-	// パーティクルデータ
-	std::vector<ParticleState> particles_;
+	/// <summary>
+	/// 軌跡の頂点・インデックスバッファを作成（最大数×1本あたりの頂点数）
+	/// </summary>
+	void CreateTrailBuffers();
+
+	/// <summary>
+	/// 描画に使うテクスチャのハンドルを設定（ルートパラメータ2）
+	/// </summary>
+	void SetTextureTable(ID3D12GraphicsCommandList* commandList, size_t materialIndex);
+
+	// パーティクルデータ（SoA）
+	ParticleStorage storage_;
+
+	// ブロードフェーズ用の範囲
+	std::vector<AABB> chunkBounds_;		// チャンク毎の位置の範囲（シミュレーション後に計算、追加時に拡張）
+	AABB bounds_;						// グループ全体の範囲（チャンクの和）
+	std::vector<FieldBroadphaseEntry> candidateFields_;	// グループと重なるフィールド
 	uint32_t maxParticles_ = 0;			// 最大パーティクル数
 	uint32_t activeParticleCount_ = 0;	// アクティブなパーティクル数
 
-	// GPU転送用バッファ
-	Microsoft::WRL::ComPtr<ID3D12Resource> transformResource_;
-	ParticleForGPU* instancingData_ = nullptr;
-	DescriptorHeapManager::DescriptorHandle srvHandle_;
+	// 可視リスト（チャンク毎にチャンクと同じ位置へ書き出し、GatherVisibleで先頭に詰める）
+	std::vector<uint32_t> visibleIndices_;		// 描画するパーティクルの番号
+	std::vector<uint32_t> sortKeys_;			// 奥から手前の順のソートキー（ソート時のみ使用）
+	std::vector<uint32_t> sortTempKeys_;		// 基数ソートの作業領域
+	std::vector<uint32_t> sortTempIndices_;		// 基数ソートの作業領域
+	std::vector<uint32_t> chunkVisibleCounts_;	// チャンク毎の可視数
+	uint32_t visibleParticleCount_ = 0;		// 可視パーティクル数（GPUに書き込む数）
+
+	// GPU転送用データ（共有アリーナから毎フレーム切り出す）
+	ParticleInstanceArena* instanceArena_ = nullptr;
+	ParticleInstanceRange instanceRange_;
+
+	// 軌跡（頂点は毎フレームCPUで書き込み、インデックスは作成時に固定）
+	ParticleTrailSettings trailSettings_;
+	Microsoft::WRL::ComPtr<ID3D12Resource> trailVertexBuffer_;
+	Microsoft::WRL::ComPtr<ID3D12Resource> trailIndexBuffer_;
+	D3D12_VERTEX_BUFFER_VIEW trailVertexBufferView_{};
+	D3D12_INDEX_BUFFER_VIEW trailIndexBufferView_{};
+	ParticleTrailVertex* trailVertexData_ = nullptr;
+	float trailTimer_ = 0.0f;				// 前回の記録からの経過時間
+	bool recordTrailThisStep_ = false;		// このステップで履歴を記録するか
+	uint32_t trailDrawCount_ = 0;			// 頂点を書き込んだ軌跡の本数
+
+	// 固定刻みサブステップ（フレーム時間を固定の刻みに分けて進める）
+	ParticleSubstepSettings substepSettings_;
+	ParticleFixedStepDriver substepDriver_;
+	uint32_t substepCount_ = 0;				// このフレームの刻み数
 
 	// モデルとマテリアル
 	Model* sharedModel_ = nullptr;
@@ -137,10 +300,11 @@ private:
 
 	// ビルボード設定
 	bool useBillboard_ = true;
+	// 奥から手前の順に並べ替えるか
+	bool sortBackToFront_ = false;
 
 	// システム参照
 	DirectXCommon* dxCommon_ = nullptr;
-	DescriptorHeapManager* descriptorManager_ = nullptr; // SRV解放のために保持
 	TextureManager* textureManager_ = TextureManager::GetInstance();
 	ModelManager* modelManager_ = ModelManager::GetInstance();
 };
\ No newline at end of file
@@ -0,0 +1,453 @@
+#define NOMINMAX
+#include "ParticleHeadlessSimulation.h"
+#include "ParticleKernels.h"
+#include "Random/CounterRandom.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <fstream>
+
+namespace {
+
+	/// <summary>
+	/// AABBのminとmaxを正しい向きに揃える（MyFunctionに依存しないよう、ここで行う）
+	/// </summary>
+	AABB SortedAABB(const AABB& aabb)
+	{
+		AABB result;
+		result.min = { std::min(aabb.min.x, aabb.max.x), std::min(aabb.min.y, aabb.max.y), std::min(aabb.min.z, aabb.max.z) };
+		result.max = { std::max(aabb.min.x, aabb.max.x), std::max(aabb.min.y, aabb.max.y), std::max(aabb.min.z, aabb.max.z) };
+		return result;
+	}
+
+	/// <summary>
+	/// ローカル座標のAABBをフィールドの位置にずらす
+	/// </summary>
+	AABB OffsetAABB(const AABB& aabb, const Vector3& position)
+	{
+		AABB result;
+		result.min = { position.x + aabb.min.x, position.y + aabb.min.y, position.z + aabb.min.z };
+		result.max = { position.x + aabb.max.x, position.y + aabb.max.y, position.z + aabb.max.z };
+		return result;
+	}
+
+	/// <summary>
+	/// 正規化したベクトル（長さ0ならfallback）
+	/// </summary>
+	Vector3 NormalizedOr(const Vector3& v, const Vector3& fallback)
+	{
+		const float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+		if (length <= 0.0f) {
+			return fallback;
+		}
+		return { v.x / length, v.y / length, v.z / length };
+	}
+
+	/// <summary>
+	/// FNV-1aでストリームの先頭count要素をハッシュに混ぜる
+	/// </summary>
+	void HashStream(uint64_t& hash, const float* data, uint32_t count)
+	{
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+		const size_t size = sizeof(float) * count;
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 0x100000001B3ull;
+		}
+	}
+}
+
+bool ParticleHeadlessSimulation::Load(const ParticlePresetData& preset, uint64_t seed)
+{
+	groups_.clear();
+	emitters_.clear();
+	fields_.clear();
+
+	// グループ（ストレージのみ）
+	groups_.reserve(preset.groups.size());
+	for (const auto& groupData : preset.groups) {
+		Group& group = groups_.emplace_back();
+		group.name = groupData.groupName;
+		group.storage.Initialize(groupData.maxParticles);
+
+		// サブステップ（ParticleGroup::SetSubstepと同じ設定）
+		group.substep = groupData.substep;
+		group.substep.maxStepsPerFrame = std::max(group.substep.maxStepsPerFrame, 1u);
+		group.substepDriver.SetStep(group.substep.step);
+		group.substepDriver.SetMaxStepsPerFrame(group.substep.maxStepsPerFrame);
+	}
+
+	// エミッター（ParticleSystemの決定論モードと同じく、名前からシードを作る）
+	for (const auto& emitterData : preset.emitters) {
+		auto it = std::find_if(groups_.begin(), groups_.end(),
+			[&](const Group& group) { return group.name == emitterData.targetGroupName; });
+		if (it == groups_.end()) {
+			Logger::Log(Logger::GetStream(),
+				std::format("[ParticleHeadless] Target group '{}' not found for emitter '{}'\n",
+					emitterData.targetGroupName, emitterData.emitterName));
+			continue;
+		}
+
+		Emitter& emitter = emitters_.emplace_back();
+		emitter.desc = MakeSpawnDesc(emitterData);
+		// 発生を止めた状態で保存されたプリセット（ヒットエフェクトなど）は、発生を始めた状態にして
+		// 最初のステップで1回分を発生させる（エミッター寿命が発生頻度以下でも必ずパーティクルが出る）
+		emitter.timer.isEmitting = true;
+		emitter.burstOnStart = !emitterData.isEmitting;
+		emitter.random.SetSeed(CounterRandom::CombineSeed(seed, CounterRandom::HashString(emitterData.emitterName)));
+		emitter.position = emitterData.position;
+		emitter.groupIndex = static_cast<uint32_t>(std::distance(groups_.begin(), it));
+	}
+
+	// フィールド（有効なもののみ）
+	for (const auto& fieldData : preset.fields) {
+		if (!fieldData.isEnabled) {
+			continue;
+		}
+
+		Field field;
+		if (MakeField(fieldData, field)) {
+			fields_.push_back(field);
+		} else {
+			Logger::Log(Logger::GetStream(),
+				std::format("[ParticleHeadless] Unsupported field type: {}\n", fieldData.fieldType));
+		}
+	}
+
+	return !groups_.empty();
+}
+
+void ParticleHeadlessSimulation::Step(float deltaTime)
+{
+	// 乱流のスクロール（フィールドクラスのUpdateに相当）
+	for (Field& field : fields_) {
+		field.time += deltaTime;
+	}
+
+	// エミッターの発生処理
+	for (Emitter& emitter : emitters_) {
+		ParticleStorage& storage = groups_[emitter.groupIndex].storage;
+		if (emitter.burstOnStart) {
+			ParticleSpawner::Spawn(emitter.desc, emitter.position, emitter.random, emitter.desc.emitCount,
+				[&storage](const ParticleState& particle) { return storage.Add(particle); });
+			emitter.burstOnStart = false;
+		}
+		ParticleSpawner::Update(emitter.desc, emitter.timer, deltaTime, emitter.position, emitter.random,
+			[&storage](const ParticleState& particle) { return storage.Add(particle); });
+	}
+
+	for (Group& group : groups_) {
+		ParticleStorage& storage = group.storage;
+
+		// 全パーティクルにフィールドを適用
+		auto applyFields = [&](float stepTime) {
+			const uint32_t count = storage.GetCount();
+			if (fields_.empty() || count == 0) {
+				return;
+			}
+
+			ParticleFieldSpan span;
+			span.positionX = storage.positionX.data();
+			span.positionY = storage.positionY.data();
+			span.positionZ = storage.positionZ.data();
+			span.velocityX = storage.velocityX.data();
+			span.velocityY = storage.velocityY.data();
+			span.velocityZ = storage.velocityZ.data();
+			span.killFlags = storage.killFlags.data();
+			span.begin = 0;
+			span.end = count;
+
+			for (const Field& field : fields_) {
+				ApplyField(field, span, stepTime);
+			}
+		};
+
+		// 刻み数と1刻みの時間（サブステップ無効なら1刻み）
+		const uint32_t stepCount = group.substep.enabled ? group.substepDriver.Advance(deltaTime) : 1;
+		const float stepTime = group.substep.enabled ? group.substepDriver.GetStep() : deltaTime;
+
+		// 寿命チェックとフィールド適用（1刻み目）
+		ParticleKernels::MarkExpired(storage, 0, storage.GetCount());
+		if (stepCount > 0) {
+			applyFields(stepTime);
+		}
+
+		// 死亡パーティクルを除去してシミュレーション
+		// 2刻み目以降のフィールドで立った死亡フラグは、次のステップの除去で取り除かれる
+		storage.Compact();
+		for (uint32_t step = 0; step < stepCount; ++step) {
+			if (step > 0) {
+				applyFields(stepTime);
+			}
+			ParticleKernels::Simulate(storage, 0, storage.GetCount(), stepTime);
+		}
+	}
+}
+
+uint64_t ParticleHeadlessSimulation::ComputeStateHash() const
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (const Group& group : groups_) {
+		const ParticleStorage& storage = group.storage;
+		const uint32_t count = storage.GetCount();
+
+		// 数も混ぜて、空のグループの並びでも区別できるようにする
+		hash ^= count;
+		hash *= 0x100000001B3ull;
+
+		HashStream(hash, storage.positionX.data(), count);
+		HashStream(hash, storage.positionY.data(), count);
+		HashStream(hash, storage.positionZ.data(), count);
+		HashStream(hash, storage.velocityX.data(), count);
+		HashStream(hash, storage.velocityY.data(), count);
+		HashStream(hash, storage.velocityZ.data(), count);
+		HashStream(hash, storage.colorR.data(), count);
+		HashStream(hash, storage.colorG.data(), count);
+		HashStream(hash, storage.colorB.data(), count);
+		HashStream(hash, storage.colorA.data(), count);
+		HashStream(hash, storage.scaleX.data(), count);
+		HashStream(hash, storage.scaleY.data(), count);
+		HashStream(hash, storage.scaleZ.data(), count);
+		HashStream(hash, storage.currentTime.data(), count);
+	}
+	return hash;
+}
+
+uint32_t ParticleHeadlessSimulation::GetActiveParticleCount() const
+{
+	uint32_t count = 0;
+	for (const Group& group : groups_) {
+		count += group.storage.GetCount();
+	}
+	return count;
+}
+
+ParticleHeadlessSimulation::Result ParticleHeadlessSimulation::Run(uint32_t frameCount, float fixedDeltaTime)
+{
+	Result result;
+	result.frameCount = frameCount;
+	result.frameHashes.reserve(frameCount);
+
+	// ハッシュ計算は計測に含めない
+	std::chrono::steady_clock::duration elapsed{};
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		auto start = std::chrono::steady_clock::now();
+		Step(fixedDeltaTime);
+		elapsed += std::chrono::steady_clock::now() - start;
+
+		result.particleUpdates += GetActiveParticleCount();
+		result.frameHashes.push_back(ComputeStateHash());
+	}
+
+	result.totalMs = std::chrono::duration<double, std::milli>(elapsed).count();
+	result.particlesPerMs = result.totalMs > 0.0 ? static_cast<double>(result.particleUpdates) / result.totalMs : 0.0;
+	return result;
+}
+
+bool ParticleHeadlessSimulation::RunPresetFile(const std::string& presetFilePath, uint64_t seed,
+	uint32_t frameCount, float fixedDeltaTime, Result& result)
+{
+	ParticlePresetData preset = ParticlePresetData::LoadFromFile(presetFilePath);
+	if (preset.presetName.empty()) {
+		return false;
+	}
+
+	ParticleHeadlessSimulation simulation;
+	if (!simulation.Load(preset, seed)) {
+		return false;
+	}
+
+	result = simulation.Run(frameCount, fixedDeltaTime);
+	return true;
+}
+
+bool ParticleHeadlessSimulation::SaveHashes(const std::string& filePath, const Result& result)
+{
+	std::ofstream ofs(filePath);
+	if (ofs.fail()) {
+		Logger::Log(Logger::GetStream(),
+			std::format("[ParticleHeadless] Failed to open file for saving: {}\n", filePath));
+		return false;
+	}
+
+	for (uint64_t hash : result.frameHashes) {
+		ofs << std::format("{:016x}\n", hash);
+	}
+	return true;
+}
+
+int32_t ParticleHeadlessSimulation::CompareHashes(const std::string& filePath, const Result& result)
+{
+	std::ifstream ifs(filePath);
+	if (ifs.fail()) {
+		Logger::Log(Logger::GetStream(),
+			std::format("[ParticleHeadless] Failed to open file for comparing: {}\n", filePath));
+		return -2;
+	}
+
+	std::string line;
+	uint32_t frame = 0;
+	for (; frame < result.frameHashes.size(); ++frame) {
+		if (!std::getline(ifs, line)) {
+			return static_cast<int32_t>(frame);
+		}
+		if (std::stoull(line, nullptr, 16) != result.frameHashes[frame]) {
+			return static_cast<int32_t>(frame);
+		}
+	}
+
+	// 保存側のフレーム数が多い場合も不一致とする
+	if (std::getline(ifs, line) && !line.empty()) {
+		return static_cast<int32_t>(frame);
+	}
+	return -1;
+}
+
+ParticleSpawnDesc ParticleHeadlessSimulation::MakeSpawnDesc(const ParticleEmitterData& data)
+{
+	// ParticleEditor::ApplyEmitterData と同じ対応
+	ParticleSpawnDesc desc;
+	desc.emitCount = data.emitCount;
+	desc.emitFrequency = data.emitFrequency;
+	desc.useEmitterLifeTime = data.useEmitterLifeTime;
+	desc.emitterLifeTime = data.emitterLifeTime;
+	desc.emitterLifeTimeLoop = data.emitterLifeTimeLoop;
+	desc.useContinuousEmission = data.useContinuousEmission;
+	desc.lifeTimeMin = data.particleLifeTimeMin;
+	desc.lifeTimeMax = data.particleLifeTimeMax;
+	desc.useDirectionalEmit = data.useDirectionalEmit;
+	desc.emitDirection = Normalize(data.emitDirection);
+	desc.initialSpeed = data.initialSpeed;
+	desc.spreadAngle = data.spreadAngle;
+	desc.velocityRange = data.velocityRange;
+	desc.scaleMin = data.particleScaleMin;
+	desc.scaleMax = data.particleScaleMax;
+	desc.rotateMin = data.particleRotateMin;
+	desc.rotateMax = data.particleRotateMax;
+	desc.spawnArea = SortedAABB(data.spawnArea);
+	desc.enableColorOverLifetime = data.enableColorOverLifetime;
+	desc.enableSizeOverLifetime = data.enableSizeOverLifetime;
+	desc.lifetimeLut = data.lifetimeLut;
+	desc.enableRotation = data.enableRotation;
+	desc.rotationSpeed = data.rotationSpeed;
+	return desc;
+}
+
+bool ParticleHeadlessSimulation::MakeField(const ParticleFieldData& data, Field& field)
+{
+	// 各フィールドクラスのDeserializeParametersと同じキー・既定値
+	const json& parameters = data.parameters;
+	field.position = data.position;
+
+	if (data.fieldType == "AccelerationField") {
+		field.type = FieldType::Acceleration;
+		if (parameters.contains("acceleration")) {
+			const auto& accel = parameters["acceleration"];
+			field.acceleration = { accel[0], accel[1], accel[2] };
+		}
+		if (parameters.contains("areaMin")) {
+			const auto& minVec = parameters["areaMin"];
+			field.area.min = { minVec[0], minVec[1], minVec[2] };
+		}
+		if (parameters.contains("areaMax")) {
+			const auto& maxVec = parameters["areaMax"];
+			field.area.max = { maxVec[0], maxVec[1], maxVec[2] };
+		}
+		field.area = SortedAABB(field.area);
+		return true;
+	}
+
+	if (data.fieldType == "GravityField") {
+		field.type = FieldType::Gravity;
+		field.gravityStrength = parameters.value("gravityStrength", field.gravityStrength);
+		field.effectRadius = parameters.value("effectRadius", field.effectRadius);
+		field.deleteRadius = parameters.value("deleteRadius", field.deleteRadius);
+		return true;
+	}
+
+	if (data.fieldType == "VortexField") {
+		field.type = FieldType::Vortex;
+		if (parameters.contains("axis")) {
+			const auto& axis = parameters["axis"];
+			field.axis = NormalizedOr({ axis[0], axis[1], axis[2] }, field.axis);
+		}
+		field.vortexStrength = parameters.value("strength", field.vortexStrength);
+		field.pullStrength = parameters.value("pullStrength", field.pullStrength);
+		field.radius = parameters.value("radius", field.radius);
+		field.height = parameters.value("height", field.height);
+		return true;
+	}
+
+	if (data.fieldType == "TurbulenceField" || data.fieldType == "DragField") {
+		// 範囲はAccelerationFieldと同じキー（既定値は±2）
+		field.area = { {-2.0f, -2.0f, -2.0f}, {2.0f, 2.0f, 2.0f} };
+		if (parameters.contains("areaMin")) {
+			const auto& minVec = parameters["areaMin"];
+			field.area.min = { minVec[0], minVec[1], minVec[2] };
+		}
+		if (parameters.contains("areaMax")) {
+			const auto& maxVec = parameters["areaMax"];
+			field.area.max = { maxVec[0], maxVec[1], maxVec[2] };
+		}
+		field.area = SortedAABB(field.area);
+
+		if (data.fieldType == "DragField") {
+			field.type = FieldType::Drag;
+			field.dragCoefficient = parameters.value("coefficient", field.dragCoefficient);
+			return true;
+		}
+
+		field.type = FieldType::Turbulence;
+		field.turbulenceStrength = parameters.value("strength", field.turbulenceStrength);
+		field.frequency = parameters.value("frequency", field.frequency);
+		if (parameters.contains("scrollSpeed")) {
+			const auto& speed = parameters["scrollSpeed"];
+			field.scrollSpeed = { speed[0], speed[1], speed[2] };
+		}
+		field.volume = CurlNoiseVolume::GetShared(parameters.value("seed", 1u));
+		return true;
+	}
+
+	if (data.fieldType == "KillPlaneField") {
+		field.type = FieldType::KillPlane;
+		if (parameters.contains("normal")) {
+			const auto& normal = parameters["normal"];
+			field.normal = NormalizedOr({ normal[0], normal[1], normal[2] }, field.normal);
+		}
+		return true;
+	}
+
+	return false;
+}
+
+void ParticleHeadlessSimulation::ApplyField(const Field& field, const ParticleFieldSpan& span, float deltaTime)
+{
+	switch (field.type) {
+	case FieldType::Acceleration:
+		FieldKernels::ApplyAcceleration(span, OffsetAABB(field.area, field.position), field.acceleration, deltaTime);
+		break;
+	case FieldType::Gravity:
+		FieldKernels::ApplyGravity(span, field.position, field.gravityStrength,
+			field.effectRadius, field.deleteRadius, deltaTime);
+		break;
+	case FieldType::Vortex:
+		FieldKernels::ApplyVortex(span, field.position, field.axis, field.vortexStrength,
+			field.pullStrength, field.radius, field.height * 0.5f, deltaTime);
+		break;
+	case FieldType::Turbulence:
+	{
+		const Vector3 offset = { field.scrollSpeed.x * field.time, field.scrollSpeed.y * field.time, field.scrollSpeed.z * field.time };
+		FieldKernels::ApplyTurbulence(span, OffsetAABB(field.area, field.position), *field.volume,
+			field.frequency, offset, field.turbulenceStrength, deltaTime);
+		break;
+	}
+	case FieldType::Drag:
+		FieldKernels::ApplyDrag(span, OffsetAABB(field.area, field.position), field.dragCoefficient, deltaTime);
+		break;
+	case FieldType::KillPlane:
+		FieldKernels::ApplyKillPlane(span, field.position, field.normal);
+		break;
+	}
+}
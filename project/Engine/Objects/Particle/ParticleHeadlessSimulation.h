@@ -0,0 +1,164 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ParticlePreset.h"
+#include "ParticleStorage.h"
+#include "ParticleSpawner.h"
+#include "ParticleFixedStepDriver.h"
+#include <memory>
+#include "FieldKernels.h"
+#include "CurlNoiseVolume.h"
+
+/// <summary>
+/// プリセットをGPU・ウィンドウ無しでシミュレーションする（決定論モード）
+/// <para>エミッター毎にシードから作った乱数を使い、固定刻みで進めるので結果が毎回一致する</para>
+/// <para>毎フレームのパーティクル状態のハッシュを記録し、回帰テストとスループット計測に使う</para>
+/// </summary>
+class ParticleHeadlessSimulation
+{
+public:
+	/// <summary>
+	/// 実行結果
+	/// </summary>
+	struct Result {
+		uint32_t frameCount = 0;				// シミュレーションしたフレーム数
+		uint64_t particleUpdates = 0;			// 全フレームの更新パーティクル数の合計
+		double totalMs = 0.0;					// 合計時間（ミリ秒）
+		double particlesPerMs = 0.0;			// 1ミリ秒あたりの更新パーティクル数
+		std::vector<uint64_t> frameHashes;		// フレーム毎の状態ハッシュ
+	};
+
+	/// <summary>
+	/// プリセットを読み込んでシミュレーションを初期状態にする
+	/// <para>発生を止めて保存されたエミッターも、発生を始めた状態から再生する（最初のステップで1回分を発生）</para>
+	/// </summary>
+	/// <param name="preset">プリセットデータ</param>
+	/// <param name="seed">基準のシード（エミッター名と合成して使う）</param>
+	/// <returns>グループが1つも無い場合false</returns>
+	bool Load(const ParticlePresetData& preset, uint64_t seed);
+
+	/// <summary>
+	/// 1ステップ進める（ParticleSystem::Stepと同じ順序：発生→寿命・フィールド→除去→シミュレーション）
+	/// <para>サブステップが有効なグループは、2刻み目以降もParticleGroupと同じくフィールド→シミュレーションを繰り返す</para>
+	/// </summary>
+	void Step(float deltaTime);
+
+	/// <summary>
+	/// 全グループの生存パーティクルの状態からハッシュを計算（FNV-1a）
+	/// </summary>
+	uint64_t ComputeStateHash() const;
+
+	/// <summary>
+	/// 生存パーティクル数の合計
+	/// </summary>
+	uint32_t GetActiveParticleCount() const;
+
+	/// <summary>
+	/// 固定刻みでframeCountフレーム実行し、フレーム毎のハッシュを記録する
+	/// </summary>
+	Result Run(uint32_t frameCount, float fixedDeltaTime);
+
+	/// <summary>
+	/// プリセットファイルを読み込んで実行する
+	/// </summary>
+	/// <param name="presetFilePath">プリセットのJSONファイル</param>
+	/// <param name="seed">基準のシード</param>
+	/// <param name="frameCount">フレーム数</param>
+	/// <param name="fixedDeltaTime">固定刻み</param>
+	/// <param name="result">実行結果</param>
+	/// <returns>読み込みに失敗した場合false</returns>
+	static bool RunPresetFile(const std::string& presetFilePath, uint64_t seed,
+		uint32_t frameCount, float fixedDeltaTime, Result& result);
+
+	/// <summary>
+	/// フレーム毎のハッシュをテキストファイルに保存（1行1フレーム、16進数）
+	/// </summary>
+	static bool SaveHashes(const std::string& filePath, const Result& result);
+
+	/// <summary>
+	/// 保存済みのハッシュと比較する
+	/// </summary>
+	/// <returns>最初に一致しなかったフレーム番号（全て一致なら-1、読み込み失敗は-2）</returns>
+	static int32_t CompareHashes(const std::string& filePath, const Result& result);
+
+private:
+	struct Group {
+		std::string name;
+		ParticleStorage storage;
+		ParticleSubstepSettings substep;			// ParticleGroupと同じ固定刻みサブステップ
+		ParticleFixedStepDriver substepDriver;
+	};
+
+	struct Emitter {
+		ParticleSpawnDesc desc;
+		ParticleSpawnTimer timer;
+		FastRandom random;
+		Vector3 position;
+		uint32_t groupIndex = 0;
+		bool burstOnStart = false;	// 最初のステップで1回分を発生させるか（発生を止めて保存されたプリセット用）
+	};
+
+	// フィールドの種類（フィールドクラスと同じJSONパラメータを読む）
+	enum class FieldType {
+		Acceleration,
+		Gravity,
+		Vortex,
+		Turbulence,
+		Drag,
+		KillPlane,
+	};
+
+	struct Field {
+		FieldType type = FieldType::Acceleration;
+		Vector3 position;
+
+		// Acceleration
+		Vector3 acceleration = { 0.0f, 1.0f, 0.0f };
+		AABB area = { {-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f} };
+
+		// Gravity
+		float gravityStrength = 5.0f;
+		float effectRadius = 3.0f;
+		float deleteRadius = 0.3f;
+
+		// Vortex
+		Vector3 axis = { 0.0f, 1.0f, 0.0f };
+		float vortexStrength = 5.0f;
+		float pullStrength = 1.0f;
+		float radius = 3.0f;
+		float height = 6.0f;
+
+		// Turbulence（範囲はAccelerationと共用）
+		float turbulenceStrength = 4.0f;
+		float frequency = 1.0f;
+		Vector3 scrollSpeed = { 0.0f, 0.5f, 0.0f };
+		std::shared_ptr<const CurlNoiseVolume> volume;
+		float time = 0.0f;
+
+		// Drag（範囲はAccelerationと共用）
+		float dragCoefficient = 1.0f;
+
+		// KillPlane
+		Vector3 normal = { 0.0f, 1.0f, 0.0f };
+	};
+
+	/// <summary>
+	/// エミッターデータから発生設定を作成
+	/// </summary>
+	static ParticleSpawnDesc MakeSpawnDesc(const ParticleEmitterData& data);
+
+	/// <summary>
+	/// フィールドデータを読み込む（未対応の種類はfalse）
+	/// </summary>
+	static bool MakeField(const ParticleFieldData& data, Field& field);
+
+	/// <summary>
+	/// フィールドを範囲に適用
+	/// </summary>
+	static void ApplyField(const Field& field, const ParticleFieldSpan& span, float deltaTime);
+
+	std::vector<Group> groups_;
+	std::vector<Emitter> emitters_;
+	std::vector<Field> fields_;
+};
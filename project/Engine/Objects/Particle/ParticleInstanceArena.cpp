@@ -0,0 +1,72 @@
+#include "ParticleInstanceArena.h"
+#include "BufferResource.h"
+#include "ImGui/ImGuiManager.h"
+#include "Logger.h"
+
+void ParticleInstanceArena::Initialize(DirectXCommon* dxCommon, uint32_t initialCapacity)
+{
+	dxCommon_ = dxCommon;
+	CreateBuffer(initialCapacity);
+}
+
+void ParticleInstanceArena::BeginFrame(uint32_t requiredCount)
+{
+	// 足りない場合のみ作り直す（フレーム間で前のGPU処理は完了しているので解放してよい）
+	uint32_t capacity = ParticleArenaAllocator::ComputeGrowCapacity(allocator_.GetCapacity(), requiredCount);
+	if (capacity != allocator_.GetCapacity()) {
+		CreateBuffer(capacity);
+		++growCount_;
+	}
+
+	allocator_.BeginFrame();
+}
+
+ParticleInstanceRange ParticleInstanceArena::Allocate(uint32_t count)
+{
+	ParticleInstanceRange range;
+
+	uint32_t offset = allocator_.Allocate(count);
+	if (offset == ParticleArenaAllocator::kInvalidOffset) {
+		return range;
+	}
+
+	range.data = mappedData_ + offset;
+	range.gpuAddress = resource_->GetGPUVirtualAddress() + static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(offset) * sizeof(ParticleForGPU);
+	range.offset = offset;
+	range.count = count;
+	return range;
+}
+
+void ParticleInstanceArena::CreateBuffer(uint32_t capacity)
+{
+	if (resource_) {
+		resource_->Unmap(0, nullptr);
+		mappedData_ = nullptr;
+	}
+
+	// 0要素のバッファは作れないので最低1要素
+	if (capacity == 0) {
+		capacity = 1;
+	}
+
+	resource_ = CreateBufferResource(dxCommon_->GetDevice(), sizeof(ParticleForGPU) * capacity);
+	resource_->Map(0, nullptr, reinterpret_cast<void**>(&mappedData_));
+
+	allocator_.Reset(capacity);
+
+	Logger::Log(Logger::GetStream(),
+		std::format("ParticleInstanceArena: Allocated {} instances ({} KB)\n",
+			capacity, sizeof(ParticleForGPU) * capacity / 1024));
+}
+
+void ParticleInstanceArena::ImGui()
+{
+#ifdef USEIMGUI
+	ImGui::Text("Instance Arena: %u / %u (peak %u)",
+		allocator_.GetUsedCount(), allocator_.GetCapacity(), allocator_.GetPeakCount());
+	ImGui::Text("Arena Allocations: %u  Failed: %u  Grows: %u",
+		allocator_.GetAllocationCount(), allocator_.GetFailedAllocationCount(), growCount_);
+	ImGui::Text("Arena Memory: %zu KB",
+		sizeof(ParticleForGPU) * allocator_.GetCapacity() / 1024);
+#endif
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "DirectXCommon.h"
+#include "ParticleState.h"
+#include "ParticleArenaAllocator.h"
+
+/// <summary>
+/// アリーナから切り出したインスタンスデータの範囲
+/// </summary>
+struct ParticleInstanceRange {
+	ParticleForGPU* data = nullptr;				// 書き込み先（マップ済み）
+	D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;	// ルートSRVにバインドするアドレス
+	uint32_t offset = ParticleArenaAllocator::kInvalidOffset;
+	uint32_t count = 0;
+
+	bool IsValid() const { return data != nullptr; }
+};
+
+/// <summary>
+/// ParticleSystem全体で共有するインスタンスデータ用のバッファ
+/// <para>グループ毎にバッファとSRVを持たず、毎フレームアクティブ数だけ切り出してオフセットでバインドする</para>
+/// </summary>
+class ParticleInstanceArena
+{
+public:
+	// 初期容量（要素数）
+	static constexpr uint32_t kDefaultCapacity = 4096;
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	/// <param name="initialCapacity">初期容量（要素数）</param>
+	void Initialize(DirectXCommon* dxCommon, uint32_t initialCapacity = kDefaultCapacity);
+
+	/// <summary>
+	/// フレーム開始（前フレームの割り当てを解放し、足りなければバッファを作り直す）
+	/// <para>前フレームのGPU処理が完了している前提（DirectXCommonがフレーム毎に待機している）</para>
+	/// </summary>
+	/// <param name="requiredCount">今フレームに必要な要素数の合計</param>
+	void BeginFrame(uint32_t requiredCount);
+
+	/// <summary>
+	/// 要素を切り出す（メインスレッドからのみ呼ぶ）
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <returns>切り出した範囲（0個、または容量不足なら無効な範囲）</returns>
+	ParticleInstanceRange Allocate(uint32_t count);
+
+	/// <summary>
+	/// ImGuiで使用状況を表示
+	/// </summary>
+	void ImGui();
+
+	const ParticleArenaAllocator& GetAllocator() const { return allocator_; }
+
+private:
+	/// <summary>
+	/// 指定容量でバッファを作成してマップする
+	/// </summary>
+	void CreateBuffer(uint32_t capacity);
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource_;
+	ParticleForGPU* mappedData_ = nullptr;
+	ParticleArenaAllocator allocator_;
+	uint32_t growCount_ = 0;	// バッファを作り直した回数
+
+	DirectXCommon* dxCommon_ = nullptr;
+};
@@ -0,0 +1,747 @@
+#define NOMINMAX
+#include "ParticleKernels.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+
+namespace {
+
+	/// <summary>
+	/// 処理終端をSIMD幅に切り上げる（パディング領域も一緒に処理して端数ループを無くす）
+	/// </summary>
+	uint32_t AlignedEnd(uint32_t end) {
+		return ParticleStorage::RoundUpToSimdWidth(end);
+	}
+
+	/// <summary>
+	/// dst += src * scale
+	/// </summary>
+	void MultiplyAdd(float* dst, const float* src, __m128 scale, uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i += ParticleStorage::kSimdWidth) {
+			__m128 d = _mm_loadu_ps(dst + i);
+			__m128 s = _mm_loadu_ps(src + i);
+			_mm_storeu_ps(dst + i, _mm_add_ps(d, _mm_mul_ps(s, scale)));
+		}
+	}
+
+	/// <summary>
+	/// dst += src * scale をして、結果を -π～π に折り返す（回転を半精度に詰めても精度が落ちないようにする）
+	/// </summary>
+	void MultiplyAddWrapAngle(float* dst, const float* src, __m128 scale, uint32_t begin, uint32_t end) {
+		constexpr float kTwoPi = 6.28318530718f;
+		const __m128 twoPi = _mm_set1_ps(kTwoPi);
+		const __m128 invTwoPi = _mm_set1_ps(1.0f / kTwoPi);
+		for (uint32_t i = begin; i < end; i += ParticleStorage::kSimdWidth) {
+			__m128 angle = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), scale));
+			// 最も近い一周分を引く（_mm_cvtps_epi32 は最近接丸め）
+			const __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(angle, invTwoPi)));
+			angle = _mm_sub_ps(angle, _mm_mul_ps(turns, twoPi));
+			_mm_storeu_ps(dst + i, angle);
+		}
+	}
+
+	/// <summary>
+	/// i番目から4つの死亡フラグをレーンのマスクにする（フラグが立っているレーンが全ビット1）
+	/// </summary>
+	__m128 KillMask(const ParticleStorage& storage, uint32_t i) {
+		int32_t packedFlags = 0;
+		std::memcpy(&packedFlags, storage.killFlags.data() + i, sizeof(packedFlags));
+		const __m128i flags = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packedFlags), _mm_setzero_si128()),
+			_mm_setzero_si128());
+		return _mm_castsi128_ps(_mm_cmpgt_epi32(flags, _mm_setzero_si128()));
+	}
+
+	/// <summary>
+	/// 寿命の進行率 t = currentTime / lifeTime
+	/// </summary>
+	__m128 LifeRatio(const ParticleStorage& storage, uint32_t i) {
+		__m128 current = _mm_loadu_ps(storage.currentTime.data() + i);
+		__m128 life = _mm_loadu_ps(storage.lifeTime.data() + i);
+		return _mm_div_ps(current, life);
+	}
+
+	/// <summary>
+	/// 参照テーブルの番号 x4（寿命の進行率を0～1に丸めてから計算。0/0のパディングレーンは1になる）
+	/// </summary>
+	__m128i LutIndices(__m128 t) {
+		t = _mm_max_ps(_mm_min_ps(t, _mm_set1_ps(1.0f)), _mm_setzero_ps());
+		const __m128 scale = _mm_set1_ps(static_cast<float>(ParticleLifetimeLut::kResolution - 1));
+		return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(t, scale), _mm_set1_ps(0.5f)));
+	}
+
+	/// <summary>
+	/// [begin, end)の最小値と最大値（パディングは含めない）
+	/// </summary>
+	void MinMax(const float* data, uint32_t begin, uint32_t end, float& outMin, float& outMax) {
+		__m128 minValue = _mm_set1_ps(FLT_MAX);
+		__m128 maxValue = _mm_set1_ps(-FLT_MAX);
+
+		// 4要素単位で処理できる範囲
+		uint32_t i = begin;
+		for (; i + ParticleStorage::kSimdWidth <= end; i += ParticleStorage::kSimdWidth) {
+			__m128 v = _mm_loadu_ps(data + i);
+			minValue = _mm_min_ps(minValue, v);
+			maxValue = _mm_max_ps(maxValue, v);
+		}
+
+		alignas(16) float mins[4];
+		alignas(16) float maxs[4];
+		_mm_store_ps(mins, minValue);
+		_mm_store_ps(maxs, maxValue);
+		outMin = std::min(std::min(mins[0], mins[1]), std::min(mins[2], mins[3]));
+		outMax = std::max(std::max(maxs[0], maxs[1]), std::max(maxs[2], maxs[3]));
+
+		// 端数
+		for (; i < end; ++i) {
+			outMin = std::min(outMin, data[i]);
+			outMax = std::max(outMax, data[i]);
+		}
+	}
+
+	/// <summary>
+	/// float x4 をhalf x4（各レーンの下位16bit）に変換
+	/// <para>丸めは最近接（同値は0から遠い方）、非正規化数になる値は0、範囲外は無限大にする</para>
+	/// </summary>
+	__m128i ToHalf(__m128 value) {
+		const __m128i bits = _mm_castps_si128(value);
+		const __m128i sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+		const __m128i absBits = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+		// 仮数を丸めて10bitにし、指数の偏りを127から15に付け替える
+		__m128i half = _mm_sub_epi32(_mm_srli_epi32(_mm_add_epi32(absBits, _mm_set1_epi32(0x1000)), 13),
+			_mm_set1_epi32(0x1C000));
+
+		const __m128i tooSmall = _mm_cmplt_epi32(absBits, _mm_set1_epi32(0x38800000));	// 2^-14 未満
+		const __m128i tooLarge = _mm_cmpgt_epi32(absBits, _mm_set1_epi32(0x477FEFFF));	// 65504 を超える
+		half = _mm_andnot_si128(tooSmall, half);
+		half = _mm_or_si128(_mm_andnot_si128(tooLarge, half), _mm_and_si128(tooLarge, _mm_set1_epi32(0x7C00)));
+
+		return _mm_or_si128(sign, half);
+	}
+
+	/// <summary>
+	/// half x4 を2つずつ32bitに詰める（low が下位16bit）
+	/// </summary>
+	__m128i PackHalf2(__m128i low, __m128i high) {
+		return _mm_or_si128(low, _mm_slli_epi32(high, 16));
+	}
+
+	/// <summary>
+	/// [0, 1]の色 x4 をRGBA8に詰める
+	/// </summary>
+	__m128i PackColor(__m128 r, __m128 g, __m128 b, __m128 a) {
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(255.0f);
+		auto toByte = [&](__m128 value) {
+			return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(value, zero), one), scale));
+		};
+		return _mm_or_si128(
+			_mm_or_si128(toByte(r), _mm_slli_epi32(toByte(g), 8)),
+			_mm_or_si128(_mm_slli_epi32(toByte(b), 16), _mm_slli_epi32(toByte(a), 24)));
+	}
+
+	/// <summary>
+	/// 4つずつ読み込んでインスタンスデータに詰める
+	/// </summary>
+	/// <param name="load">__m128(const float* stream, uint32_t k, uint32_t laneCount) k番目から4つ読む</param>
+	template<typename Loader>
+	void PackInstances(const ParticleStorage& storage, uint32_t begin, uint32_t end, ParticleForGPU* instances,
+		bool useBillboard, Loader&& load)
+	{
+		const uint32_t flags = useBillboard ? kParticleFlagBillboard : 0u;
+
+		alignas(16) float positionX[4];
+		alignas(16) float positionY[4];
+		alignas(16) float positionZ[4];
+		alignas(16) uint32_t color[4];
+		alignas(16) uint32_t scaleXY[4];
+		alignas(16) uint32_t scaleZRotateX[4];
+		alignas(16) uint32_t rotateYZ[4] = {};
+
+		for (uint32_t k = begin; k < end; k += ParticleStorage::kSimdWidth) {
+			const uint32_t laneCount = std::min(end - k, ParticleStorage::kSimdWidth);
+
+			_mm_store_ps(positionX, load(storage.positionX.data(), k, laneCount));
+			_mm_store_ps(positionY, load(storage.positionY.data(), k, laneCount));
+			_mm_store_ps(positionZ, load(storage.positionZ.data(), k, laneCount));
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(color), PackColor(
+				load(storage.colorR.data(), k, laneCount), load(storage.colorG.data(), k, laneCount),
+				load(storage.colorB.data(), k, laneCount), load(storage.colorA.data(), k, laneCount)));
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(scaleXY), PackHalf2(
+				ToHalf(load(storage.scaleX.data(), k, laneCount)), ToHalf(load(storage.scaleY.data(), k, laneCount))));
+
+			// ビルボードは回転を使わないので読まない
+			const __m128i scaleZ = ToHalf(load(storage.scaleZ.data(), k, laneCount));
+			if (useBillboard) {
+				_mm_store_si128(reinterpret_cast<__m128i*>(scaleZRotateX), scaleZ);
+			} else {
+				_mm_store_si128(reinterpret_cast<__m128i*>(scaleZRotateX),
+					PackHalf2(scaleZ, ToHalf(load(storage.rotateX.data(), k, laneCount))));
+				_mm_store_si128(reinterpret_cast<__m128i*>(rotateYZ), PackHalf2(
+					ToHalf(load(storage.rotateY.data(), k, laneCount)), ToHalf(load(storage.rotateZ.data(), k, laneCount))));
+			}
+
+			for (uint32_t lane = 0; lane < laneCount; ++lane) {
+				ParticleForGPU& instance = instances[k + lane];
+				instance.translate = { positionX[lane], positionY[lane], positionZ[lane] };
+				instance.color = color[lane];
+				instance.scaleXY = scaleXY[lane];
+				instance.scaleZRotateX = scaleZRotateX[lane];
+				instance.rotateYZ = rotateYZ[lane];
+				instance.flags = flags;
+			}
+		}
+	}
+}
+
+void ParticleKernels::MarkExpired(ParticleStorage& storage, uint32_t begin, uint32_t end)
+{
+	const float* life = storage.lifeTime.data();
+	const float* current = storage.currentTime.data();
+	uint8_t* kill = storage.killFlags.data();
+
+	end = AlignedEnd(end);
+	for (uint32_t i = begin; i < end; i += ParticleStorage::kSimdWidth) {
+		// lifeTime <= currentTime のレーンをマスクとして取り出す
+		// 前フレームのサブステップでフィールドが立てたフラグを消さないよう、既存のフラグに重ねる
+		int mask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(life + i), _mm_loadu_ps(current + i)));
+		kill[i + 0] |= static_cast<uint8_t>((mask >> 0) & 1);
+		kill[i + 1] |= static_cast<uint8_t>((mask >> 1) & 1);
+		kill[i + 2] |= static_cast<uint8_t>((mask >> 2) & 1);
+		kill[i + 3] |= static_cast<uint8_t>((mask >> 3) & 1);
+	}
+}
+
+void ParticleKernels::IntegratePositions(ParticleStorage& storage, uint32_t begin, uint32_t end, float deltaTime)
+{
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	end = AlignedEnd(end);
+
+	MultiplyAdd(storage.positionX.data(), storage.velocityX.data(), dt, begin, end);
+	MultiplyAdd(storage.positionY.data(), storage.velocityY.data(), dt, begin, end);
+	MultiplyAdd(storage.positionZ.data(), storage.velocityZ.data(), dt, begin, end);
+}
+
+void ParticleKernels::FadeAlpha(ParticleStorage& storage, uint32_t begin, uint32_t end)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	float* alpha = storage.colorA.data();
+
+	// 連続発生で前進させたパーティクルは経過時間が負から始まるので、0～1に収める
+	end = AlignedEnd(end);
+	for (uint32_t i = begin; i < end; i += ParticleStorage::kSimdWidth) {
+		_mm_storeu_ps(alpha + i, _mm_max_ps(zero, _mm_min_ps(one, _mm_sub_ps(one, LifeRatio(storage, i)))));
+	}
+}
+
+void ParticleKernels::ColorOverLifetime(ParticleStorage& storage, uint32_t begin, uint32_t end)
+{
+	float* colorR = storage.colorR.data();
+	float* colorG = storage.colorG.data();
+	float* colorB = storage.colorB.data();
+	float* colorA = storage.colorA.data();
+	const uint16_t* slots = storage.lifetimeLutSlot.data();
+
+	alignas(16) float ratio[4];
+	alignas(16) uint32_t indices[4];
+
+	const uint32_t alignedEnd = AlignedEnd(end);
+	for (uint32_t i = begin; i < alignedEnd; i += ParticleStorage::kSimdWidth) {
+		const __m128 t = LifeRatio(storage, i);
+		_mm_store_ps(ratio, t);
+		_mm_store_si128(reinterpret_cast<__m128i*>(indices), LutIndices(t));
+
+		// レーン毎にテーブルから1要素（RGBA）を読む
+		__m128 rows[4];
+		for (uint32_t lane = 0; lane < ParticleStorage::kSimdWidth; ++lane) {
+			const uint32_t k = i + lane;
+			const ParticleLifetimeLut* lut = k < end ? storage.GetLifetimeLut(slots[k]) : nullptr;
+			if (lut && lut->HasColor()) {
+				rows[lane] = _mm_load_ps(&lut->GetColor(indices[lane]).x);
+			} else {
+				// テーブル無しは従来のフェードアウト（RGBは維持、αは1→0、FadeAlphaと同じく0～1に収める）
+				rows[lane] = _mm_setr_ps(colorR[k], colorG[k], colorB[k], std::clamp(1.0f - ratio[lane], 0.0f, 1.0f));
+			}
+		}
+
+		// RGBA x4 → R x4, G x4, B x4, A x4
+		_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+		_mm_storeu_ps(colorR + i, rows[0]);
+		_mm_storeu_ps(colorG + i, rows[1]);
+		_mm_storeu_ps(colorB + i, rows[2]);
+		_mm_storeu_ps(colorA + i, rows[3]);
+	}
+}
+
+void ParticleKernels::SizeOverLifetime(ParticleStorage& storage, uint32_t begin, uint32_t end)
+{
+	float* scaleX = storage.scaleX.data();
+	float* scaleY = storage.scaleY.data();
+	float* scaleZ = storage.scaleZ.data();
+	const uint16_t* slots = storage.lifetimeLutSlot.data();
+
+	alignas(16) uint32_t indices[4];
+
+	const uint32_t alignedEnd = AlignedEnd(end);
+	for (uint32_t i = begin; i < alignedEnd; i += ParticleStorage::kSimdWidth) {
+		_mm_store_si128(reinterpret_cast<__m128i*>(indices), LutIndices(LifeRatio(storage, i)));
+
+		// レーン毎にテーブルから1要素（XYZ）を読む
+		__m128 rows[4];
+		for (uint32_t lane = 0; lane < ParticleStorage::kSimdWidth; ++lane) {
+			const uint32_t k = i + lane;
+			const ParticleLifetimeLut* lut = k < end ? storage.GetLifetimeLut(slots[k]) : nullptr;
+			if (lut && lut->HasSize()) {
+				rows[lane] = _mm_load_ps(&lut->GetSize(indices[lane]).x);
+			} else {
+				// テーブル無しは現在のスケールを維持
+				rows[lane] = _mm_setr_ps(scaleX[k], scaleY[k], scaleZ[k], 0.0f);
+			}
+		}
+
+		_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+		_mm_storeu_ps(scaleX + i, rows[0]);
+		_mm_storeu_ps(scaleY + i, rows[1]);
+		_mm_storeu_ps(scaleZ + i, rows[2]);
+	}
+}
+
+void ParticleKernels::Rotate(ParticleStorage& storage, uint32_t begin, uint32_t end, float deltaTime)
+{
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	end = AlignedEnd(end);
+
+	// 加算し続けると半精度に詰めたときに精度が落ちるので、毎回 -π～π に折り返す
+	MultiplyAddWrapAngle(storage.rotateX.data(), storage.rotationSpeedX.data(), dt, begin, end);
+	MultiplyAddWrapAngle(storage.rotateY.data(), storage.rotationSpeedY.data(), dt, begin, end);
+	MultiplyAddWrapAngle(storage.rotateZ.data(), storage.rotationSpeedZ.data(), dt, begin, end);
+}
+
+void ParticleKernels::AdvanceTime(ParticleStorage& storage, uint32_t begin, uint32_t end, float deltaTime)
+{
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	float* current = storage.currentTime.data();
+
+	end = AlignedEnd(end);
+	for (uint32_t i = begin; i < end; i += ParticleStorage::kSimdWidth) {
+		_mm_storeu_ps(current + i, _mm_add_ps(_mm_loadu_ps(current + i), dt));
+	}
+}
+
+void ParticleKernels::Simulate(ParticleStorage& storage, uint32_t begin, uint32_t end, float deltaTime)
+{
+	if (begin >= end) {
+		return;
+	}
+
+	const ParticleUpdateModes& modes = storage.GetModes();
+
+	// 速度を位置に加算
+	IntegratePositions(storage, begin, end, deltaTime);
+
+	// 色（寿命を進める前の進行率を使う）
+	if (modes.colorOverLifetime) {
+		ColorOverLifetime(storage, begin, end);
+	} else {
+		FadeAlpha(storage, begin, end);
+	}
+
+	// サイズ
+	if (modes.sizeOverLifetime) {
+		SizeOverLifetime(storage, begin, end);
+	}
+
+	// 回転
+	if (modes.rotation) {
+		Rotate(storage, begin, end, deltaTime);
+	}
+
+	// 寿命を進める
+	AdvanceTime(storage, begin, end, deltaTime);
+}
+
+void ParticleKernels::WriteInstances(const ParticleStorage& storage, uint32_t begin, uint32_t end, ParticleForGPU* instances,
+	bool useBillboard)
+{
+	PackInstances(storage, begin, end, instances, useBillboard,
+		[end](const float* stream, uint32_t k, uint32_t laneCount) {
+			// ストリームはSIMD幅の倍数まで確保されているが、範囲の先頭が揃っていない場合に備えて端数は個別に読む
+			if (laneCount == ParticleStorage::kSimdWidth) {
+				return _mm_loadu_ps(stream + k);
+			}
+			alignas(16) float values[4] = {};
+			for (uint32_t lane = 0; lane < laneCount && k + lane < end; ++lane) {
+				values[lane] = stream[k + lane];
+			}
+			return _mm_load_ps(values);
+		});
+}
+
+void ParticleKernels::WriteInstancesIndexed(const ParticleStorage& storage, const uint32_t* visibleIndices, uint32_t begin, uint32_t end,
+	ParticleForGPU* instances, bool useBillboard)
+{
+	PackInstances(storage, begin, end, instances, useBillboard,
+		[visibleIndices](const float* stream, uint32_t k, uint32_t laneCount) {
+			// 可視リストの番号で集める（端数のレーンは先頭の値で埋める）
+			const uint32_t* index = visibleIndices + k;
+			return _mm_setr_ps(
+				stream[index[0]],
+				stream[index[laneCount > 1 ? 1 : 0]],
+				stream[index[laneCount > 2 ? 2 : 0]],
+				stream[index[laneCount > 3 ? 3 : 0]]);
+		});
+}
+
+void ParticleKernels::RecordTrail(ParticleStorage& storage, uint32_t begin, uint32_t end)
+{
+	if (!storage.HasTrail() || begin >= end) {
+		return;
+	}
+
+	// 行はSIMD幅の倍数まで確保してあるので、パディングも一緒に写す
+	const uint32_t row = storage.GetTrailHead();
+	const uint32_t alignedEnd = AlignedEnd(end);
+	std::memcpy(storage.GetTrailRowX(row) + begin, storage.positionX.data() + begin, sizeof(float) * (alignedEnd - begin));
+	std::memcpy(storage.GetTrailRowY(row) + begin, storage.positionY.data() + begin, sizeof(float) * (alignedEnd - begin));
+	std::memcpy(storage.GetTrailRowZ(row) + begin, storage.positionZ.data() + begin, sizeof(float) * (alignedEnd - begin));
+
+	// 記録済みの点数を履歴の長さまで増やす（16個ずつ飽和加算）
+	uint8_t* counts = storage.trailCount.data();
+	const __m128i one = _mm_set1_epi8(1);
+	const __m128i length = _mm_set1_epi8(static_cast<char>(storage.GetTrailLength()));
+	uint32_t i = begin;
+	for (; i + 16 <= alignedEnd; i += 16) {
+		__m128i count = _mm_loadu_si128(reinterpret_cast<const __m128i*>(counts + i));
+		count = _mm_min_epu8(_mm_adds_epu8(count, one), length);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(counts + i), count);
+	}
+	for (; i < alignedEnd; ++i) {
+		counts[i] = static_cast<uint8_t>(std::min<uint32_t>(counts[i] + 1u, storage.GetTrailLength()));
+	}
+}
+
+void ParticleKernels::WriteTrailVertices(const ParticleStorage& storage, uint32_t begin, uint32_t end,
+	const ParticleTrailSettings& settings, const Vector3& cameraPosition, ParticleTrailVertex* vertices)
+{
+	const uint32_t length = storage.GetTrailLength();
+	if (length == 0 || begin >= end) {
+		return;
+	}
+
+	const uint32_t head = storage.GetTrailHead();
+	const uint32_t vertexCountPerTrail = (length + 1) * 2;
+	const float invLength = 1.0f / static_cast<float>(length);
+
+	const __m128 cameraX = _mm_set1_ps(cameraPosition.x);
+	const __m128 cameraY = _mm_set1_ps(cameraPosition.y);
+	const __m128 cameraZ = _mm_set1_ps(cameraPosition.z);
+	const __m128 epsilon = _mm_set1_ps(1.0e-12f);
+	const __m128 zero = _mm_setzero_ps();
+
+	// 1点分の座標 x4
+	struct Point {
+		__m128 x, y, z;
+	};
+
+	alignas(16) float leftX[4], leftY[4], leftZ[4];
+	alignas(16) float rightX[4], rightY[4], rightZ[4];
+	alignas(16) uint32_t color[4];
+
+	for (uint32_t i = begin; i < end; i += ParticleStorage::kSimdWidth) {
+		const uint32_t laneCount = std::min(end - i, ParticleStorage::kSimdWidth);
+
+		// 記録済みの点数 x4（8bit → 32bit）
+		int32_t packedCounts = 0;
+		std::memcpy(&packedCounts, storage.trailCount.data() + i, sizeof(packedCounts));
+		const __m128i counts = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packedCounts), _mm_setzero_si128()),
+			_mm_setzero_si128());
+
+		// 先頭の幅の半分と色（サブステップで死亡したパーティクルは幅0にして描かない）
+		const __m128 halfWidth = _mm_andnot_ps(KillMask(storage, i),
+			_mm_mul_ps(_mm_loadu_ps(storage.scaleX.data() + i), _mm_set1_ps(settings.width * 0.5f)));
+		const __m128 colorR = _mm_loadu_ps(storage.colorR.data() + i);
+		const __m128 colorG = _mm_loadu_ps(storage.colorG.data() + i);
+		const __m128 colorB = _mm_loadu_ps(storage.colorB.data() + i);
+		const __m128 colorA = _mm_loadu_ps(storage.colorA.data() + i);
+
+		// j番目の点（0は現在位置、1以降は新しい順の履歴。未記録なら直前の点に重ねる）
+		auto loadPoint = [&](uint32_t j, const Point& previous) {
+			const uint32_t row = (head + length - (j - 1)) % length;
+			const __m128 valid = _mm_castsi128_ps(_mm_cmpgt_epi32(counts, _mm_set1_epi32(static_cast<int32_t>(j) - 1)));
+			auto select = [&](const float* rowData, __m128 fallback) {
+				const __m128 value = _mm_loadu_ps(rowData + i);
+				return _mm_or_ps(_mm_and_ps(valid, value), _mm_andnot_ps(valid, fallback));
+			};
+			return Point{
+				select(storage.GetTrailRowX(row), previous.x),
+				select(storage.GetTrailRowY(row), previous.y),
+				select(storage.GetTrailRowZ(row), previous.z) };
+		};
+
+		Point current = {
+			_mm_loadu_ps(storage.positionX.data() + i),
+			_mm_loadu_ps(storage.positionY.data() + i),
+			_mm_loadu_ps(storage.positionZ.data() + i) };
+		Point previous = current;
+		Point next = loadPoint(1, current);
+
+		for (uint32_t j = 0; j <= length; ++j) {
+			// 進行方向（前後の点の差。端では片側だけ）
+			const Point& front = (j == 0) ? current : previous;
+			const Point& back = (j == length) ? current : next;
+			const __m128 tangentX = _mm_sub_ps(front.x, back.x);
+			const __m128 tangentY = _mm_sub_ps(front.y, back.y);
+			const __m128 tangentZ = _mm_sub_ps(front.z, back.z);
+
+			// 視線との外積で帯の横方向を決める
+			const __m128 viewX = _mm_sub_ps(cameraX, current.x);
+			const __m128 viewY = _mm_sub_ps(cameraY, current.y);
+			const __m128 viewZ = _mm_sub_ps(cameraZ, current.z);
+			__m128 sideX = _mm_sub_ps(_mm_mul_ps(tangentY, viewZ), _mm_mul_ps(tangentZ, viewY));
+			__m128 sideY = _mm_sub_ps(_mm_mul_ps(tangentZ, viewX), _mm_mul_ps(tangentX, viewZ));
+			__m128 sideZ = _mm_sub_ps(_mm_mul_ps(tangentX, viewY), _mm_mul_ps(tangentY, viewX));
+
+			// 正規化して幅を掛ける（動いていない点は幅0）
+			const float u = static_cast<float>(j) * invLength;
+			const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(sideX, sideX), _mm_mul_ps(sideY, sideY)), _mm_mul_ps(sideZ, sideZ));
+			const __m128 hasSide = _mm_cmpgt_ps(lengthSq, epsilon);
+			const __m128 widthRate = _mm_set1_ps(1.0f + (settings.tailWidthRate - 1.0f) * u);
+			const __m128 scale = _mm_and_ps(hasSide,
+				_mm_mul_ps(_mm_rsqrt_ps(_mm_max_ps(lengthSq, epsilon)), _mm_mul_ps(halfWidth, widthRate)));
+			sideX = _mm_mul_ps(sideX, scale);
+			sideY = _mm_mul_ps(sideY, scale);
+			sideZ = _mm_mul_ps(sideZ, scale);
+
+			_mm_store_ps(leftX, _mm_sub_ps(current.x, sideX));
+			_mm_store_ps(leftY, _mm_sub_ps(current.y, sideY));
+			_mm_store_ps(leftZ, _mm_sub_ps(current.z, sideZ));
+			_mm_store_ps(rightX, _mm_add_ps(current.x, sideX));
+			_mm_store_ps(rightY, _mm_add_ps(current.y, sideY));
+			_mm_store_ps(rightZ, _mm_add_ps(current.z, sideZ));
+
+			// 末尾に向けてαを変える
+			const __m128 alpha = _mm_max_ps(_mm_mul_ps(colorA, _mm_set1_ps(1.0f + (settings.tailAlphaRate - 1.0f) * u)), zero);
+			_mm_store_si128(reinterpret_cast<__m128i*>(color), PackColor(colorR, colorG, colorB, alpha));
+
+			for (uint32_t lane = 0; lane < laneCount; ++lane) {
+				ParticleTrailVertex* vertex = vertices + static_cast<size_t>(i + lane) * vertexCountPerTrail + j * 2;
+				vertex[0] = { { leftX[lane], leftY[lane], leftZ[lane] }, color[lane], { u, 0.0f } };
+				vertex[1] = { { rightX[lane], rightY[lane], rightZ[lane] }, color[lane], { u, 1.0f } };
+			}
+
+			// 窓をずらす
+			if (j < length) {
+				previous = current;
+				current = next;
+				next = (j + 2 <= length) ? loadPoint(j + 2, current) : current;
+			}
+		}
+	}
+}
+
+void ParticleKernels::BuildTrailIndices(uint32_t length, uint32_t maxTrails, uint32_t* indices)
+{
+	const uint32_t vertexCountPerTrail = (length + 1) * 2;
+	for (uint32_t trail = 0; trail < maxTrails; ++trail) {
+		const uint32_t base = trail * vertexCountPerTrail;
+		for (uint32_t segment = 0; segment < length; ++segment) {
+			// 点segmentの左右(0,1)と点segment+1の左右(2,3)で四角形
+			const uint32_t v0 = base + segment * 2;
+			*indices++ = v0;
+			*indices++ = v0 + 2;
+			*indices++ = v0 + 1;
+			*indices++ = v0 + 1;
+			*indices++ = v0 + 2;
+			*indices++ = v0 + 3;
+		}
+	}
+}
+
+AABB ParticleKernels::ComputeBounds(const ParticleStorage& storage, uint32_t begin, uint32_t end)
+{
+	AABB bounds;
+	MinMax(storage.positionX.data(), begin, end, bounds.min.x, bounds.max.x);
+	MinMax(storage.positionY.data(), begin, end, bounds.min.y, bounds.max.y);
+	MinMax(storage.positionZ.data(), begin, end, bounds.min.z, bounds.max.z);
+	return bounds;
+}
+
+ParticleFrustum ParticleKernels::MakeFrustum(const Matrix4x4& viewProjectionMatrix)
+{
+	// 行ベクトル（clip = p * M）なので、列から平面を取り出す
+	const auto& m = viewProjectionMatrix.m;
+	auto column = [&](int j, float out[4]) {
+		out[0] = m[0][j];
+		out[1] = m[1][j];
+		out[2] = m[2][j];
+		out[3] = m[3][j];
+	};
+
+	float c0[4], c1[4], c2[4], c3[4];
+	column(0, c0);
+	column(1, c1);
+	column(2, c2);
+	column(3, c3);
+
+	ParticleFrustum frustum{};
+	for (int k = 0; k < 4; ++k) {
+		frustum.planes[0][k] = c3[k] + c0[k];	// 左
+		frustum.planes[1][k] = c3[k] - c0[k];	// 右
+		frustum.planes[2][k] = c3[k] + c1[k];	// 下
+		frustum.planes[3][k] = c3[k] - c1[k];	// 上
+		frustum.planes[4][k] = c2[k];			// 近（D3Dは z >= 0）
+		frustum.planes[5][k] = c3[k] - c2[k];	// 遠
+	}
+
+	// 半径と比較できるよう法線を正規化
+	for (auto& plane : frustum.planes) {
+		const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+		if (length > 0.0f) {
+			const float invLength = 1.0f / length;
+			for (float& value : plane) {
+				value *= invLength;
+			}
+		}
+	}
+	return frustum;
+}
+
+uint32_t ParticleKernels::CullVisible(const ParticleStorage& storage, uint32_t begin, uint32_t end, const ParticleFrustum* frustum,
+	const Matrix4x4& viewProjectionMatrix, uint32_t* outIndices, uint32_t* outKeys)
+{
+	const float* px = storage.positionX.data();
+	const float* py = storage.positionY.data();
+	const float* pz = storage.positionZ.data();
+	const float* sx = storage.scaleX.data();
+	const float* sy = storage.scaleY.data();
+	const float* sz = storage.scaleZ.data();
+
+	// 深度 = クリップ空間のw（透視投影ならビュー空間のZ）
+	const auto& m = viewProjectionMatrix.m;
+	const __m128 depthX = _mm_set1_ps(m[0][3]);
+	const __m128 depthY = _mm_set1_ps(m[1][3]);
+	const __m128 depthZ = _mm_set1_ps(m[2][3]);
+	const __m128 depthW = _mm_set1_ps(m[3][3]);
+
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+	uint32_t visibleCount = 0;
+	for (uint32_t i = begin; i < end; i += ParticleStorage::kSimdWidth) {
+		__m128 x = _mm_loadu_ps(px + i);
+		__m128 y = _mm_loadu_ps(py + i);
+		__m128 z = _mm_loadu_ps(pz + i);
+
+		// サブステップ中にフィールドで死亡したパーティクルは、除去が次フレームでも描画しない
+		__m128 visible = _mm_andnot_ps(KillMask(storage, i), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+		if (frustum) {
+			// 半径 = スケールの最大成分
+			__m128 radius = _mm_max_ps(_mm_and_ps(_mm_loadu_ps(sx + i), absMask),
+				_mm_max_ps(_mm_and_ps(_mm_loadu_ps(sy + i), absMask), _mm_and_ps(_mm_loadu_ps(sz + i), absMask)));
+			__m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+			// 全ての平面に対して、距離 >= -半径 なら可視
+			for (const auto& plane : frustum->planes) {
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane[0])), _mm_mul_ps(y, _mm_set1_ps(plane[1]))),
+					_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane[2])), _mm_set1_ps(plane[3])));
+				visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negativeRadius));
+			}
+		}
+
+		// 範囲外（パディング）のレーンを除外
+		int bits = _mm_movemask_ps(visible);
+		if (end - i < ParticleStorage::kSimdWidth) {
+			bits &= (1 << (end - i)) - 1;
+		}
+		if (bits == 0) {
+			continue;
+		}
+
+		alignas(16) float depths[4];
+		if (outKeys) {
+			__m128 depth = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(x, depthX), _mm_mul_ps(y, depthY)),
+				_mm_add_ps(_mm_mul_ps(z, depthZ), depthW));
+			_mm_store_ps(depths, depth);
+		}
+
+		// 可視レーンを詰めて書き出す
+		for (uint32_t lane = 0; lane < ParticleStorage::kSimdWidth; ++lane) {
+			if (!(bits & (1 << lane))) {
+				continue;
+			}
+			outIndices[visibleCount] = i + lane;
+			if (outKeys) {
+				// floatを大小関係を保つuint32に変換し、反転して奥（深度大）を先にする
+				uint32_t key;
+				std::memcpy(&key, &depths[lane], sizeof(key));
+				key = (key & 0x80000000u) ? ~key : (key | 0x80000000u);
+				outKeys[visibleCount] = ~key;
+			}
+			++visibleCount;
+		}
+	}
+	return visibleCount;
+}
+
+void ParticleKernels::RadixSort(uint32_t* keys, uint32_t* indices, uint32_t count, uint32_t* tempKeys, uint32_t* tempIndices)
+{
+	if (count <= 1) {
+		return;
+	}
+
+	// 4パス分のヒストグラムを1回の走査で作る
+	uint32_t histograms[4][256] = {};
+	for (uint32_t i = 0; i < count; ++i) {
+		const uint32_t key = keys[i];
+		++histograms[0][key & 0xFF];
+		++histograms[1][(key >> 8) & 0xFF];
+		++histograms[2][(key >> 16) & 0xFF];
+		++histograms[3][key >> 24];
+	}
+
+	uint32_t* srcKeys = keys;
+	uint32_t* srcIndices = indices;
+	uint32_t* dstKeys = tempKeys;
+	uint32_t* dstIndices = tempIndices;
+
+	for (uint32_t pass = 0; pass < 4; ++pass) {
+		uint32_t* histogram = histograms[pass];
+		const uint32_t shift = pass * 8;
+
+		// 全要素が同じバケットなら並びは変わらない
+		if (histogram[(srcKeys[0] >> shift) & 0xFF] == count) {
+			continue;
+		}
+
+		// 累積和で各バケットの書き込み開始位置を求める
+		uint32_t offset = 0;
+		for (uint32_t bucket = 0; bucket < 256; ++bucket) {
+			const uint32_t bucketCount = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += bucketCount;
+		}
+
+		for (uint32_t i = 0; i < count; ++i) {
+			const uint32_t key = srcKeys[i];
+			const uint32_t position = histogram[(key >> shift) & 0xFF]++;
+			dstKeys[position] = key;
+			dstIndices[position] = srcIndices[i];
+		}
+
+		std::swap(srcKeys, dstKeys);
+		std::swap(srcIndices, dstIndices);
+	}
+
+	// 奇数回入れ替えた場合は作業領域に結果があるので戻す
+	if (srcKeys != keys) {
+		std::memcpy(keys, srcKeys, sizeof(uint32_t) * count);
+		std::memcpy(indices, srcIndices, sizeof(uint32_t) * count);
+	}
+}
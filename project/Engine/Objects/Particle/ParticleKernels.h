@@ -0,0 +1,155 @@
+#pragma once
+#include <cstdint>
+#include "ParticleStorage.h"
+
+/// <summary>
+/// 視錐台（可視判定用の6平面）
+/// <para>平面は ax + by + cz + d >= 0 が内側。法線は正規化済み</para>
+/// </summary>
+struct ParticleFrustum {
+	float planes[6][4];
+};
+
+/// <summary>
+/// パーティクル更新カーネル（SoA + SSE）
+/// <para>[begin, end)の範囲を4要素ずつ処理する。endはSIMD幅に切り上げて処理するため、</para>
+/// <para>ストリームはParticleStorageの様にSIMD幅の倍数まで確保されている必要がある</para>
+/// <para>範囲指定にしているのは、後でチャンク単位に分割して回せるようにするため</para>
+/// </summary>
+namespace ParticleKernels {
+
+	// 並列更新で1ジョブが担当するパーティクル数（SIMD幅の倍数にしてチャンク同士が重ならないようにする）
+	constexpr uint32_t kChunkSize = 4096;
+	static_assert(kChunkSize % ParticleStorage::kSimdWidth == 0, "kChunkSize must be a multiple of kSimdWidth");
+
+	/// <summary>
+	/// パーティクル数からチャンク数を計算
+	/// </summary>
+	inline uint32_t GetChunkCount(uint32_t count) {
+		return (count + kChunkSize - 1) / kChunkSize;
+	}
+
+	/// <summary>
+	/// 寿命が尽きたパーティクルに死亡フラグを立てる
+	/// <para>既に立っているフラグ（前フレームのサブステップでの死亡）は残す</para>
+	/// </summary>
+	void MarkExpired(ParticleStorage& storage, uint32_t begin, uint32_t end);
+
+	/// <summary>
+	/// 速度を位置に加算
+	/// </summary>
+	void IntegratePositions(ParticleStorage& storage, uint32_t begin, uint32_t end, float deltaTime);
+
+	/// <summary>
+	/// 寿命に応じてαを1→0にフェード（Color Over Lifetime無効時）
+	/// </summary>
+	void FadeAlpha(ParticleStorage& storage, uint32_t begin, uint32_t end);
+
+	/// <summary>
+	/// エミッターが焼き込んだ参照テーブルから色を引く（1パーティクルにつき1回の読み込み）
+	/// <para>テーブルを持たないパーティクルは従来のフェードアウト</para>
+	/// </summary>
+	void ColorOverLifetime(ParticleStorage& storage, uint32_t begin, uint32_t end);
+
+	/// <summary>
+	/// エミッターが焼き込んだ参照テーブルからスケールを引く
+	/// <para>テーブルを持たないパーティクルはスケールを維持</para>
+	/// </summary>
+	void SizeOverLifetime(ParticleStorage& storage, uint32_t begin, uint32_t end);
+
+	/// <summary>
+	/// 回転速度（ラジアン/秒）を回転に加算
+	/// <para>回転は -π～π に折り返して保持する（半精度に詰めても精度を保つため）</para>
+	/// </summary>
+	void Rotate(ParticleStorage& storage, uint32_t begin, uint32_t end, float deltaTime);
+
+	/// <summary>
+	/// 寿命を進める
+	/// </summary>
+	void AdvanceTime(ParticleStorage& storage, uint32_t begin, uint32_t end, float deltaTime);
+
+	/// <summary>
+	/// グループのモードに応じて必要なカーネルだけを順に実行
+	/// <para>移動 → 色 → サイズ → 回転 → 寿命の順（従来の更新順と同じ）</para>
+	/// </summary>
+	void Simulate(ParticleStorage& storage, uint32_t begin, uint32_t end, float deltaTime);
+
+	/// <summary>
+	/// GPU転送用のインスタンスデータを書き込む（位置・色・スケール・回転を詰めるだけで行列は作らない）
+	/// <para>instancesの[begin, end)だけに書き込むので、範囲が重ならなければ並列に呼べる</para>
+	/// </summary>
+	/// <param name="instances">書き込み先（グループのインスタンスバッファ先頭）</param>
+	/// <param name="useBillboard">ビルボードを使用するか</param>
+	void WriteInstances(const ParticleStorage& storage, uint32_t begin, uint32_t end, ParticleForGPU* instances,
+		bool useBillboard);
+
+	/// <summary>
+	/// 可視リストの順にGPU転送用のインスタンスデータを書き込む
+	/// <para>instances[k] に storage の visibleIndices[k] 番目を書き込む（k は [begin, end)）</para>
+	/// </summary>
+	/// <param name="visibleIndices">書き込むパーティクルの番号（カリング・ソート済み）</param>
+	/// <param name="instances">書き込み先（グループのインスタンスバッファ先頭）</param>
+	/// <param name="useBillboard">ビルボードを使用するか</param>
+	void WriteInstancesIndexed(const ParticleStorage& storage, const uint32_t* visibleIndices, uint32_t begin, uint32_t end,
+		ParticleForGPU* instances, bool useBillboard);
+
+	/// <summary>
+	/// 現在の位置を軌跡の履歴のtrailHead行に記録し、記録済みの点数を増やす
+	/// <para>行はパーティクル順に並んでいるので、位置ストリームをそのまま写すだけ</para>
+	/// </summary>
+	void RecordTrail(ParticleStorage& storage, uint32_t begin, uint32_t end);
+
+	/// <summary>
+	/// 軌跡の帯の頂点を書き込む（i番目のパーティクルは vertices[i * 1本あたりの頂点数] から）
+	/// <para>現在位置と履歴の各点で、進行方向と視線の外積の向きに左右2頂点を置く（4パーティクルずつSSEで計算）</para>
+	/// <para>未記録の点は直前の点に重ねて面積0にするので、インデックスは全パーティクル共通で使える</para>
+	/// <para>死亡フラグが立っているパーティクルは幅0（面積0）で書き込む</para>
+	/// </summary>
+	/// <param name="settings">幅・末尾の倍率（点数はストレージの履歴の長さを使う）</param>
+	/// <param name="cameraPosition">カメラのワールド座標（帯をカメラに向ける）</param>
+	/// <param name="vertices">書き込み先（グループの頂点バッファ先頭）</param>
+	void WriteTrailVertices(const ParticleStorage& storage, uint32_t begin, uint32_t end,
+		const ParticleTrailSettings& settings, const Vector3& cameraPosition, ParticleTrailVertex* vertices);
+
+	/// <summary>
+	/// 全パーティクル共通の軌跡のインデックスを作る（maxTrails本分、三角形リスト）
+	/// </summary>
+	/// <param name="length">履歴の点数</param>
+	/// <param name="maxTrails">本数</param>
+	/// <param name="indices">書き込み先（length * 6 * maxTrails 個）</param>
+	void BuildTrailIndices(uint32_t length, uint32_t maxTrails, uint32_t* indices);
+
+	/// <summary>
+	/// [begin, end)の位置を囲むAABBを計算（空なら min > max のAABB）
+	/// </summary>
+	AABB ComputeBounds(const ParticleStorage& storage, uint32_t begin, uint32_t end);
+
+	/// <summary>
+	/// ビュープロジェクション行列から視錐台を作る（行ベクトル、D3DのZ範囲[0, w]）
+	/// </summary>
+	ParticleFrustum MakeFrustum(const Matrix4x4& viewProjectionMatrix);
+
+	/// <summary>
+	/// [begin, end)のうち視錐台と重なるパーティクルの番号を詰めて書き出す
+	/// <para>半径はスケールの最大成分（単位サイズのモデルを想定した保守的な値）</para>
+	/// <para>死亡フラグが立っているパーティクルは不可視として扱う</para>
+	/// <para>outKeysを渡すと奥から手前の順に並ぶソートキー（昇順で奥が先）も書き出す</para>
+	/// </summary>
+	/// <param name="frustum">視錐台（nullptrなら全て可視）</param>
+	/// <param name="viewProjectionMatrix">深度（クリップ空間のw）の計算に使う</param>
+	/// <param name="outIndices">可視パーティクルの番号の書き出し先</param>
+	/// <param name="outKeys">ソートキーの書き出し先（nullptrなら計算しない）</param>
+	/// <returns>可視パーティクル数</returns>
+	uint32_t CullVisible(const ParticleStorage& storage, uint32_t begin, uint32_t end, const ParticleFrustum* frustum,
+		const Matrix4x4& viewProjectionMatrix, uint32_t* outIndices, uint32_t* outKeys);
+
+	/// <summary>
+	/// キーの昇順に番号を並べ替える（LSD基数ソート、8bit x 4パス、安定）
+	/// <para>全要素が同じバケットに入るパスは飛ばす</para>
+	/// </summary>
+	/// <param name="keys">キー（並べ替え後の値が入る）</param>
+	/// <param name="indices">キーに対応する番号（並べ替え後の値が入る）</param>
+	/// <param name="tempKeys">作業領域（count個）</param>
+	/// <param name="tempIndices">作業領域（count個）</param>
+	void RadixSort(uint32_t* keys, uint32_t* indices, uint32_t count, uint32_t* tempKeys, uint32_t* tempIndices);
+}
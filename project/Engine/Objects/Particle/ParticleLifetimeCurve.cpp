@@ -0,0 +1,132 @@
+#include "ParticleLifetimeCurve.h"
+#include <algorithm>
+#include <iterator>
+
+using namespace MyMath;
+
+namespace {
+
+	/// <summary>
+	/// イージングの名前と関数（ParticleEasingと同じ並び）
+	/// </summary>
+	struct EasingEntry {
+		const char* name;
+		float (*function)(float);
+	};
+
+	constexpr EasingEntry kEasings[] = {
+		{ "Linear", nullptr },
+		{ "EaseInSine", EaseInSine }, { "EaseOutSine", EaseOutSine }, { "EaseInOutSine", EaseInOutSine },
+		{ "EaseInQuad", EaseInQuad }, { "EaseOutQuad", EaseOutQuad }, { "EaseInOutQuad", EaseInOutQuad },
+		{ "EaseInCubic", EaseInCubic }, { "EaseOutCubic", EaseOutCubic }, { "EaseInOutCubic", EaseInOutCubic },
+		{ "EaseInQuart", EaseInQuart }, { "EaseOutQuart", EaseOutQuart }, { "EaseInOutQuart", EaseInOutQuart },
+		{ "EaseInQuint", EaseInQuint }, { "EaseOutQuint", EaseOutQuint }, { "EaseInOutQuint", EaseInOutQuint },
+		{ "EaseInExpo", EaseInExpo }, { "EaseOutExpo", EaseOutExpo }, { "EaseInOutExpo", EaseInOutExpo },
+		{ "EaseInCirc", EaseInCirc }, { "EaseOutCirc", EaseOutCirc }, { "EaseInOutCirc", EaseInOutCirc },
+		{ "EaseInBack", EaseInBack }, { "EaseOutBack", EaseOutBack }, { "EaseInOutBack", EaseInOutBack },
+		{ "EaseInElastic", EaseInElastic }, { "EaseOutElastic", EaseOutElastic }, { "EaseInOutElastic", EaseInOutElastic },
+		{ "EaseInBounce", EaseInBounce }, { "EaseOutBounce", EaseOutBounce }, { "EaseInOutBounce", EaseInOutBounce },
+	};
+	static_assert(std::size(kEasings) == static_cast<size_t>(ParticleEasing::Count), "kEasings must match ParticleEasing");
+
+	/// <summary>
+	/// 時間順に並べたキー列を t で評価（キーの外側は端のキーの値）
+	/// </summary>
+	template<typename Key, typename GetValue>
+	auto EvaluateKeys(const std::vector<Key>& keys, float t, GetValue&& getValue) {
+		if (t <= keys.front().time) {
+			return getValue(keys.front());
+		}
+		for (size_t i = 0; i + 1 < keys.size(); ++i) {
+			const Key& from = keys[i];
+			const Key& to = keys[i + 1];
+			if (t > to.time) {
+				continue;
+			}
+			const float span = to.time - from.time;
+			const float local = span > 0.0f ? (t - from.time) / span : 1.0f;
+			return Lerp(getValue(from), getValue(to), ParticleEasingUtil::Apply(from.easing, local));
+		}
+		return getValue(keys.back());
+	}
+
+	/// <summary>
+	/// キー列を時間順に並べ替えたコピー
+	/// </summary>
+	template<typename Key>
+	std::vector<Key> SortedKeys(const std::vector<Key>& keys) {
+		std::vector<Key> sorted = keys;
+		std::stable_sort(sorted.begin(), sorted.end(), [](const Key& a, const Key& b) { return a.time < b.time; });
+		return sorted;
+	}
+
+	/// <summary>
+	/// テーブルの番号から寿命の進行率を計算
+	/// </summary>
+	float IndexToTime(uint32_t index) {
+		return static_cast<float>(index) / static_cast<float>(ParticleLifetimeLut::kResolution - 1);
+	}
+}
+
+float ParticleEasingUtil::Apply(ParticleEasing easing, float t)
+{
+	const size_t index = static_cast<size_t>(easing);
+	if (index >= std::size(kEasings) || !kEasings[index].function) {
+		return t;
+	}
+	return kEasings[index].function(t);
+}
+
+const char* ParticleEasingUtil::GetName(ParticleEasing easing)
+{
+	const size_t index = static_cast<size_t>(easing);
+	return index < std::size(kEasings) ? kEasings[index].name : kEasings[0].name;
+}
+
+ParticleEasing ParticleEasingUtil::FromName(const std::string& name)
+{
+	for (size_t i = 0; i < std::size(kEasings); ++i) {
+		if (name == kEasings[i].name) {
+			return static_cast<ParticleEasing>(i);
+		}
+	}
+	return ParticleEasing::Linear;
+}
+
+ParticleColorGradient ParticleColorGradient::MakeLinear(const Vector4& startColor, const Vector4& endColor)
+{
+	ParticleColorGradient gradient;
+	gradient.keys.push_back({ 0.0f, startColor, ParticleEasing::Linear });
+	gradient.keys.push_back({ 1.0f, endColor, ParticleEasing::Linear });
+	return gradient;
+}
+
+ParticleSizeCurve ParticleSizeCurve::MakeLinear(const Vector3& startScale, const Vector3& endScale)
+{
+	ParticleSizeCurve curve;
+	curve.keys.push_back({ 0.0f, startScale, ParticleEasing::Linear });
+	curve.keys.push_back({ 1.0f, endScale, ParticleEasing::Linear });
+	return curve;
+}
+
+void ParticleLifetimeLut::Bake(const ParticleColorGradient* colorGradient, const ParticleSizeCurve* sizeCurve)
+{
+	hasColor_ = colorGradient && !colorGradient->keys.empty();
+	hasSize_ = sizeCurve && !sizeCurve->keys.empty();
+
+	if (hasColor_) {
+		const std::vector<ParticleGradientKey> keys = SortedKeys(colorGradient->keys);
+		for (uint32_t i = 0; i < kResolution; ++i) {
+			const Vector4 color = EvaluateKeys(keys, IndexToTime(i), [](const ParticleGradientKey& key) { return key.color; });
+			color_[i] = { color.x, color.y, color.z, color.w };
+		}
+	}
+
+	if (hasSize_) {
+		const std::vector<ParticleCurveKey> keys = SortedKeys(sizeCurve->keys);
+		for (uint32_t i = 0; i < kResolution; ++i) {
+			const Vector3 size = EvaluateKeys(keys, IndexToTime(i), [](const ParticleCurveKey& key) { return key.value; });
+			size_[i] = { size.x, size.y, size.z, 0.0f };
+		}
+	}
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MyFunction.h"
+
+/// <summary>
+/// キー間の補間に使うイージング（MyMathのイージング関数と1対1）
+/// </summary>
+enum class ParticleEasing : uint8_t {
+	Linear,
+	EaseInSine, EaseOutSine, EaseInOutSine,
+	EaseInQuad, EaseOutQuad, EaseInOutQuad,
+	EaseInCubic, EaseOutCubic, EaseInOutCubic,
+	EaseInQuart, EaseOutQuart, EaseInOutQuart,
+	EaseInQuint, EaseOutQuint, EaseInOutQuint,
+	EaseInExpo, EaseOutExpo, EaseInOutExpo,
+	EaseInCirc, EaseOutCirc, EaseInOutCirc,
+	EaseInBack, EaseOutBack, EaseInOutBack,
+	EaseInElastic, EaseOutElastic, EaseInOutElastic,
+	EaseInBounce, EaseOutBounce, EaseInOutBounce,
+	Count
+};
+
+namespace ParticleEasingUtil {
+
+	/// <summary>
+	/// イージングを適用（t は 0～1）
+	/// </summary>
+	float Apply(ParticleEasing easing, float t);
+
+	/// <summary>
+	/// 保存・表示用の名前（"EaseOutBounce" など）
+	/// </summary>
+	const char* GetName(ParticleEasing easing);
+
+	/// <summary>
+	/// 名前からイージングを取得（見つからなければLinear）
+	/// </summary>
+	ParticleEasing FromName(const std::string& name);
+}
+
+/// <summary>
+/// 色グラデーションのキー
+/// </summary>
+struct ParticleGradientKey {
+	float time = 0.0f;									// 寿命に対する位置（0～1）
+	Vector4 color = { 1.0f, 1.0f, 1.0f, 1.0f };			// 色
+	ParticleEasing easing = ParticleEasing::Linear;		// 次のキーまでの補間
+};
+
+/// <summary>
+/// サイズカーブのキー
+/// </summary>
+struct ParticleCurveKey {
+	float time = 0.0f;									// 寿命に対する位置（0～1）
+	Vector3 value = { 1.0f, 1.0f, 1.0f };				// スケール
+	ParticleEasing easing = ParticleEasing::Linear;		// 次のキーまでの補間
+};
+
+/// <summary>
+/// 寿命に応じた色（複数キーのグラデーション）
+/// <para>キーは時間順でなくてもよい（焼き込み時に並べ替える）</para>
+/// </summary>
+struct ParticleColorGradient {
+	std::vector<ParticleGradientKey> keys;
+
+	/// <summary>
+	/// 開始色から終了色への線形補間（従来の Start / End と同じ結果）
+	/// </summary>
+	static ParticleColorGradient MakeLinear(const Vector4& startColor, const Vector4& endColor);
+};
+
+/// <summary>
+/// 寿命に応じたサイズ（複数キーのカーブ）
+/// <para>キーは時間順でなくてもよい（焼き込み時に並べ替える）</para>
+/// </summary>
+struct ParticleSizeCurve {
+	std::vector<ParticleCurveKey> keys;
+
+	/// <summary>
+	/// 開始スケールから終了スケールへの線形補間（従来の Start / End と同じ結果）
+	/// </summary>
+	static ParticleSizeCurve MakeLinear(const Vector3& startScale, const Vector3& endScale);
+};
+
+/// <summary>
+/// 色・サイズの時間変化を焼き込んだ参照テーブル
+/// <para>更新時はイージングを計算せず、寿命の進行率から1回引くだけにする</para>
+/// <para>パーティクルはポインタだけを持ち、ParticleStorageがshared_from_thisで寿命を延ばすので、</para>
+/// <para>必ずstd::make_sharedで作成すること</para>
+/// </summary>
+class ParticleLifetimeLut : public std::enable_shared_from_this<ParticleLifetimeLut>
+{
+public:
+	// テーブルの分割数（t = index / (kResolution - 1)）
+	static constexpr uint32_t kResolution = 128;
+
+	/// <summary>
+	/// 1要素（SSEで1回に読めるよう16バイト境界に揃える。サイズはwを使わない）
+	/// </summary>
+	struct alignas(16) Sample {
+		float x, y, z, w;
+	};
+
+	/// <summary>
+	/// グラデーション・カーブを焼き込む（nullptrの項目は使用しない）
+	/// </summary>
+	void Bake(const ParticleColorGradient* colorGradient, const ParticleSizeCurve* sizeCurve);
+
+	bool HasColor() const { return hasColor_; }
+	bool HasSize() const { return hasSize_; }
+
+	/// <summary>
+	/// 寿命の進行率（0～1）からテーブルの番号を計算（範囲外は端に丸める）
+	/// </summary>
+	static uint32_t ToIndex(float t) {
+		t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+		return static_cast<uint32_t>(t * static_cast<float>(kResolution - 1) + 0.5f);
+	}
+
+	const Sample& GetColor(uint32_t index) const { return color_[index]; }
+	const Sample& GetSize(uint32_t index) const { return size_[index]; }
+
+	Vector4 SampleColor(float t) const {
+		const Sample& sample = color_[ToIndex(t)];
+		return { sample.x, sample.y, sample.z, sample.w };
+	}
+	Vector3 SampleSize(float t) const {
+		const Sample& sample = size_[ToIndex(t)];
+		return { sample.x, sample.y, sample.z };
+	}
+
+private:
+	std::array<Sample, kResolution> color_{};
+	std::array<Sample, kResolution> size_{};
+	bool hasColor_ = false;
+	bool hasSize_ = false;
+};
@@ -3,6 +3,67 @@
 #include <fstream>
 #include <format>
 
+namespace {
+
+	// ========================================
+	// Color / Size Over Lifetime のキー
+	// ========================================
+
+	json GradientToJson(const ParticleColorGradient& gradient)
+	{
+		json keys = json::array();
+		for (const auto& key : gradient.keys) {
+			keys.push_back({
+				{"time", key.time},
+				{"color", {key.color.x, key.color.y, key.color.z, key.color.w}},
+				{"easing", ParticleEasingUtil::GetName(key.easing)}
+			});
+		}
+		return keys;
+	}
+
+	ParticleColorGradient GradientFromJson(const json& keys)
+	{
+		ParticleColorGradient gradient;
+		for (const auto& keyJson : keys) {
+			ParticleGradientKey key;
+			key.time = keyJson.value("time", 0.0f);
+			auto color = keyJson.value("color", std::vector<float>{1, 1, 1, 1});
+			key.color = { color[0], color[1], color[2], color[3] };
+			key.easing = ParticleEasingUtil::FromName(keyJson.value("easing", "Linear"));
+			gradient.keys.push_back(key);
+		}
+		return gradient;
+	}
+
+	json CurveToJson(const ParticleSizeCurve& curve)
+	{
+		json keys = json::array();
+		for (const auto& key : curve.keys) {
+			keys.push_back({
+				{"time", key.time},
+				{"scale", {key.value.x, key.value.y, key.value.z}},
+				{"easing", ParticleEasingUtil::GetName(key.easing)}
+			});
+		}
+		return keys;
+	}
+
+	ParticleSizeCurve CurveFromJson(const json& keys)
+	{
+		ParticleSizeCurve curve;
+		for (const auto& keyJson : keys) {
+			ParticleCurveKey key;
+			key.time = keyJson.value("time", 0.0f);
+			auto scale = keyJson.value("scale", std::vector<float>{1, 1, 1});
+			key.value = { scale[0], scale[1], scale[2] };
+			key.easing = ParticleEasingUtil::FromName(keyJson.value("easing", "Linear"));
+			curve.keys.push_back(key);
+		}
+		return curve;
+	}
+}
+
 // ========================================
 // ParticleGroupData
 // ========================================
@@ -14,7 +75,21 @@ json ParticleGroupData::ToJson() const
 		{"modelTag", modelTag},
 		{"maxParticles", maxParticles},
 		{"textureName", textureName},
-		{"useBillboard", useBillboard}
+		{"useBillboard", useBillboard},
+		{"sortBackToFront", sortBackToFront},
+		{"trail", {
+			{"enabled", trail.enabled},
+			{"length", trail.length},
+			{"recordInterval", trail.recordInterval},
+			{"width", trail.width},
+			{"tailWidthRate", trail.tailWidthRate},
+			{"tailAlphaRate", trail.tailAlphaRate}
+		}},
+		{"substep", {
+			{"enabled", substep.enabled},
+			{"step", substep.step},
+			{"maxStepsPerFrame", substep.maxStepsPerFrame}
+		}}
 	};
 }
 
@@ -26,6 +101,24 @@ ParticleGroupData ParticleGroupData::FromJson(const json& j)
 	data.maxParticles = j.value("maxParticles", 100u);
 	data.textureName = j.value("textureName", "");
 	data.useBillboard = j.value("useBillboard", true);
+	data.sortBackToFront = j.value("sortBackToFront", false);
+	if (j.contains("trail")) {
+		const json& trailJson = j["trail"];
+		const ParticleTrailSettings defaults;
+		data.trail.enabled = trailJson.value("enabled", defaults.enabled);
+		data.trail.length = trailJson.value("length", defaults.length);
+		data.trail.recordInterval = trailJson.value("recordInterval", defaults.recordInterval);
+		data.trail.width = trailJson.value("width", defaults.width);
+		data.trail.tailWidthRate = trailJson.value("tailWidthRate", defaults.tailWidthRate);
+		data.trail.tailAlphaRate = trailJson.value("tailAlphaRate", defaults.tailAlphaRate);
+	}
+	if (j.contains("substep")) {
+		const json& substepJson = j["substep"];
+		const ParticleSubstepSettings defaults;
+		data.substep.enabled = substepJson.value("enabled", defaults.enabled);
+		data.substep.step = substepJson.value("step", defaults.step);
+		data.substep.maxStepsPerFrame = substepJson.value("maxStepsPerFrame", defaults.maxStepsPerFrame);
+	}
 	return data;
 }
 
@@ -44,6 +137,7 @@ json ParticleEmitterData::ToJson() const
 		{"emitCount", emitCount},
 		{"emitFrequency", emitFrequency},
 		{"isEmitting", isEmitting},
+		{"useContinuousEmission", useContinuousEmission},
 		{"particleLifeTimeMin", particleLifeTimeMin},
 		{"particleLifeTimeMax", particleLifeTimeMax},
 		{"emitDirection", {emitDirection.x, emitDirection.y, emitDirection.z}},
@@ -67,17 +161,19 @@ json ParticleEmitterData::ToJson() const
 
 		// Color Over Lifetime
 		{"enableColorOverLifetime", enableColorOverLifetime},
-		{"particleStartColor", {particleStartColor.x, particleStartColor.y, particleStartColor.z, particleStartColor.w}},
-		{"particleEndColor", {particleEndColor.x, particleEndColor.y, particleEndColor.z, particleEndColor.w}},
+		{"colorGradient", GradientToJson(colorGradient)},
 
 		// Size Over Lifetime
 		{"enableSizeOverLifetime", enableSizeOverLifetime},
-		{"particleStartScale", {particleStartScale.x, particleStartScale.y, particleStartScale.z}},
-		{"particleEndScale", {particleEndScale.x, particleEndScale.y, particleEndScale.z}},
+		{"sizeCurve", CurveToJson(sizeCurve)},
 
 		// Rotation
 		{"enableRotation", enableRotation},
-		{"rotationSpeed", {rotationSpeed.x, rotationSpeed.y, rotationSpeed.z}}
+		{"rotationSpeed", {rotationSpeed.x, rotationSpeed.y, rotationSpeed.z}},
+
+		// Budget
+		{"priority", ParticlePriorityUtil::GetName(priority)},
+		{"useDistanceLod", useDistanceLod}
 	};
 }
 
@@ -99,6 +195,7 @@ ParticleEmitterData ParticleEmitterData::FromJson(const json& j)
 	data.emitCount = j.value("emitCount", 5u);
 	data.emitFrequency = j.value("emitFrequency", 1.0f);
 	data.isEmitting = j.value("isEmitting", true);
+	data.useContinuousEmission = j.value("useContinuousEmission", false);
 
 	data.particleLifeTimeMin = j.value("particleLifeTimeMin", 1.0f);
 	data.particleLifeTimeMax = j.value("particleLifeTimeMax", 3.0f);
@@ -141,23 +238,33 @@ ParticleEmitterData ParticleEmitterData::FromJson(const json& j)
 	auto debugColor = j.value("debugAABBColor", std::vector<float>{1, 0, 0, 1});
 	data.debugAABBColor = { debugColor[0], debugColor[1], debugColor[2], debugColor[3] };
 
-	// Color Over Lifetime
+	// Color Over Lifetime（キーが無い古い形式は開始色・終了色の線形補間として読む）
 	data.enableColorOverLifetime = j.value("enableColorOverLifetime", false);
+	if (j.contains("colorGradient") && !j["colorGradient"].empty()) {
+		data.colorGradient = GradientFromJson(j["colorGradient"]);
+	} else {
+		auto startColor = j.value("particleStartColor", std::vector<float>{1, 1, 1, 1});
+		auto endColor = j.value("particleEndColor", std::vector<float>{1, 1, 1, 0});
+		data.colorGradient = ParticleColorGradient::MakeLinear(
+			{ startColor[0], startColor[1], startColor[2], startColor[3] },
+			{ endColor[0], endColor[1], endColor[2], endColor[3] });
+	}
 
-	auto startColor = j.value("particleStartColor", std::vector<float>{1, 1, 1, 1});
-	data.particleStartColor = { startColor[0], startColor[1], startColor[2], startColor[3] };
-
-	auto endColor = j.value("particleEndColor", std::vector<float>{1, 1, 1, 0});
-	data.particleEndColor = { endColor[0], endColor[1], endColor[2], endColor[3] };
-
-	// Size Over Lifetime
+	// Size Over Lifetime（キーが無い古い形式は開始スケール・終了スケールの線形補間として読む）
 	data.enableSizeOverLifetime = j.value("enableSizeOverLifetime", false);
+	if (j.contains("sizeCurve") && !j["sizeCurve"].empty()) {
+		data.sizeCurve = CurveFromJson(j["sizeCurve"]);
+	} else {
+		auto startScale = j.value("particleStartScale", std::vector<float>{1, 1, 1});
+		auto endScale = j.value("particleEndScale", std::vector<float>{1, 1, 1});
+		data.sizeCurve = ParticleSizeCurve::MakeLinear(
+			{ startScale[0], startScale[1], startScale[2] },
+			{ endScale[0], endScale[1], endScale[2] });
+	}
 
-	auto startScale = j.value("particleStartScale", std::vector<float>{1, 1, 1});
-	data.particleStartScale = { startScale[0], startScale[1], startScale[2] };
-
-	auto endScale = j.value("particleEndScale", std::vector<float>{1, 1, 1});
-	data.particleEndScale = { endScale[0], endScale[1], endScale[2] };
+	// 読み込み時に参照テーブルへ焼き込む（更新時はイージングを計算しない）
+	data.lifetimeLut = std::make_shared<ParticleLifetimeLut>();
+	data.lifetimeLut->Bake(&data.colorGradient, &data.sizeCurve);
 
 	// Rotation
 	data.enableRotation = j.value("enableRotation", false);
@@ -165,6 +272,10 @@ ParticleEmitterData ParticleEmitterData::FromJson(const json& j)
 	auto rotSpeed = j.value("rotationSpeed", std::vector<float>{0, 0, 0});
 	data.rotationSpeed = { rotSpeed[0], rotSpeed[1], rotSpeed[2] };
 
+	// Budget
+	data.priority = ParticlePriorityUtil::FromName(j.value("priority", std::string("Normal")));
+	data.useDistanceLod = j.value("useDistanceLod", true);
+
 	return data;
 }
 
@@ -1,8 +1,12 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <memory>
 #include <json.hpp>
 #include "MyFunction.h"
+#include "ParticleLifetimeCurve.h"
+#include "ParticleBudget.h"
+#include "ParticleState.h"
 
 using json = nlohmann::json;
 
@@ -16,6 +20,9 @@ struct ParticleGroupData
 	uint32_t maxParticles;
 	std::string textureName;
 	bool useBillboard;
+	bool sortBackToFront = false;	// 奥から手前の順に描画するか
+	ParticleTrailSettings trail;	// 軌跡（リボン）
+	ParticleSubstepSettings substep;	// 固定刻みサブステップ
 
 	// JSON変換
 	json ToJson() const;
@@ -39,6 +46,7 @@ struct ParticleEmitterData
 	uint32_t emitCount;
 	float emitFrequency;
 	bool isEmitting;
+	bool useContinuousEmission = false;	// 1個ずつ等間隔に発生させるか
 
 	// パーティクル寿命
 	float particleLifeTimeMin;
@@ -76,18 +84,23 @@ struct ParticleEmitterData
 
 	// 寿命に応じた色(Color Over Lifetime)
 	bool enableColorOverLifetime = false;
-	Vector4 particleStartColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-	Vector4 particleEndColor = { 1.0f, 1.0f, 1.0f, 0.0f };
+	ParticleColorGradient colorGradient = ParticleColorGradient::MakeLinear({ 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 0.0f });
 
 	// 寿命に応じたサイズ(Size Over Lifetime)
 	bool enableSizeOverLifetime = false;
-	Vector3 particleStartScale = { 1.0f, 1.0f, 1.0f };
-	Vector3 particleEndScale = { 1.0f, 1.0f, 1.0f };
+	ParticleSizeCurve sizeCurve = ParticleSizeCurve::MakeLinear({ 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f });
+
+	// 色・サイズを焼き込んだ参照テーブル（FromJsonで作成し、同じプリセットのエミッター間で共有）
+	std::shared_ptr<ParticleLifetimeLut> lifetimeLut;
 
 	// 回転(Rotation)
 	bool enableRotation = false;
 	Vector3 rotationSpeed = { 0.0f, 0.0f, 0.0f };
 
+	// 予算の優先度・距離LOD
+	ParticlePriority priority = ParticlePriority::Normal;
+	bool useDistanceLod = true;
+
 	// JSON変換
 	json ToJson() const;
 	static ParticleEmitterData FromJson(const json& j);
@@ -99,7 +112,7 @@ struct ParticleEmitterData
 struct ParticleFieldData
 {
 	std::string fieldName;
-	std::string fieldType; // "AccelerationField", "GravityField" など
+	std::string fieldType; // "AccelerationField", "GravityField", "VortexField", "TurbulenceField", "DragField", "KillPlaneField"
 
 	// Transform
 	Vector3 position;
@@ -9,6 +9,7 @@
 void ParticlePresetInstance::Initialize(const std::string& instanceName, ParticleSystem* particleSystem)
 {
 	instanceName_ = instanceName;
+	objectPrefix_ = instanceName;
 	particleSystem_ = particleSystem;
 	isDestroyed_ = false;
 }
@@ -116,6 +117,23 @@ void ParticlePresetInstance::SetEnabled(bool enabled)
 	}
 }
 
+void ParticlePresetInstance::Deactivate()
+{
+	if (isDestroyed_) {
+		return;
+	}
+
+	SetEnabled(false);
+
+	// 残っているパーティクルを消す（バッファはそのまま）
+	for (const auto& [localName, uniqueName] : groupNameMap_) {
+		ParticleGroup* group = particleSystem_->GetGroup(uniqueName);
+		if (group) {
+			group->ClearAllParticles();
+		}
+	}
+}
+
 void ParticlePresetInstance::Destroy()
 {
 	if (isDestroyed_) {
@@ -74,11 +74,34 @@ public:
 	/// </summary>
 	void Destroy();
 
+	/// <summary>
+	/// プールへ戻すために休止させる（エミッター・フィールドを止め、パーティクルを消す）
+	/// <para>グループ・エミッター・フィールド自体は残すので、再利用時に確保し直さない</para>
+	/// </summary>
+	void Deactivate();
+
 	/// <summary>
 	/// インスタンス名を取得
 	/// </summary>
 	const std::string& GetInstanceName() const { return instanceName_; }
 
+	/// <summary>
+	/// インスタンス名を変更（プールから再利用する際に使用）
+	/// <para>オブジェクト名のプレフィックスは変わらない</para>
+	/// </summary>
+	void SetInstanceName(const std::string& instanceName) { instanceName_ = instanceName; }
+
+	/// <summary>
+	/// ParticleSystem上のオブジェクト名に付いているプレフィックスを取得
+	/// </summary>
+	const std::string& GetObjectPrefix() const { return objectPrefix_; }
+
+	/// <summary>
+	/// 生成元のプリセット名
+	/// </summary>
+	void SetPresetName(const std::string& presetName) { presetName_ = presetName; }
+	const std::string& GetPresetName() const { return presetName_; }
+
 	/// <summary>
 	/// グループ名を登録
 	/// </summary>
@@ -101,6 +124,8 @@ public:
 
 private:
 	std::string instanceName_;
+	std::string objectPrefix_;	// 生成時のインスタンス名（プールから再利用しても変わらない）
+	std::string presetName_;
 
 	// ローカル名 → 実際の名前のマッピング
 	std::unordered_map<std::string, std::string> groupNameMap_;
@@ -0,0 +1,282 @@
+#define NOMINMAX
+#include "ParticleSpawner.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+	/// <summary>
+	/// まとめて生成する際の作業領域（スレッド毎）
+	/// </summary>
+	struct SpawnScratch {
+		// 乱数ストリームの種類
+		enum Stream {
+			kPositionX, kPositionY, kPositionZ,
+			kScaleX, kScaleY, kScaleZ,
+			kRotateX, kRotateY, kRotateZ,
+			kVelocityX, kVelocityY, kVelocityZ,
+			kColorR, kColorG, kColorB,
+			kLifeTime,
+			kStreamCount
+		};
+
+		std::vector<float> streams[kStreamCount];
+		std::vector<ParticleState> particles;
+
+		/// <summary>
+		/// count個分の領域を確保（縮めない）
+		/// </summary>
+		void Reserve(uint32_t count) {
+			if (particles.size() >= count) {
+				return;
+			}
+			for (auto& stream : streams) {
+				stream.resize(count);
+			}
+			particles.resize(count);
+		}
+
+		float* Get(Stream stream) { return streams[stream].data(); }
+	};
+
+	thread_local SpawnScratch tlsScratch;
+
+	/// <summary>
+	/// エミッター寿命を進め、発生を続けるかを返す
+	/// <para>寿命が尽きてループしない場合は発生を止める</para>
+	/// </summary>
+	bool AdvanceEmitterLife(const ParticleSpawnDesc& desc, ParticleSpawnTimer& timer, float deltaTime) {
+		if (desc.useEmitterLifeTime) {
+			timer.emitterCurrentTime += deltaTime;
+
+			// 寿命が尽きた場合
+			if (timer.emitterCurrentTime >= desc.emitterLifeTime) {
+				if (desc.emitterLifeTimeLoop) {
+					// ループする場合、時間をリセット
+					timer.emitterCurrentTime = 0.0f;
+				} else {
+					// ループしない場合、発生を停止
+					timer.isEmitting = false;
+					return false;
+				}
+			}
+		}
+		return timer.isEmitting;
+	}
+}
+
+uint32_t ParticleSpawner::AdvanceTimer(const ParticleSpawnDesc& desc, ParticleSpawnTimer& timer, float deltaTime)
+{
+	// エミッター寿命処理
+	if (!AdvanceEmitterLife(desc, timer, deltaTime)) {
+		return 0;
+	}
+
+	// 発生頻度が0以下だと終わらないので、毎フレーム1回とする
+	if (desc.emitFrequency <= 0.0f) {
+		timer.frequencyTimer = 0.0f;
+		return 1;
+	}
+
+	// 頻度タイマーを進めて、発生頻度に達した回数を数える
+	timer.frequencyTimer += deltaTime;
+	uint32_t burstCount = 0;
+	while (timer.frequencyTimer >= desc.emitFrequency) {
+		timer.frequencyTimer -= desc.emitFrequency;
+		++burstCount;
+	}
+	return burstCount;
+}
+
+uint32_t ParticleSpawner::AdvanceEmission(const ParticleSpawnDesc& desc, ParticleSpawnTimer& timer, float deltaTime)
+{
+	if (!desc.useContinuousEmission) {
+		return AdvanceTimer(desc, timer, deltaTime) * desc.emitCount;
+	}
+
+	timer.stepDeltaTime = deltaTime;
+	timer.newestSpawnAge = 0.0f;
+	timer.oldestSpawnAge = 0.0f;
+	if (!AdvanceEmitterLife(desc, timer, deltaTime) || desc.emitCount == 0) {
+		return 0;
+	}
+
+	// 発生頻度が0以下だと間隔が決まらないので、毎フレームemitCount個をステップ全体に割り振る
+	if (desc.emitFrequency <= 0.0f) {
+		timer.frequencyTimer = 0.0f;
+		timer.oldestSpawnAge = deltaTime * static_cast<float>(desc.emitCount - 1) / static_cast<float>(desc.emitCount);
+		return desc.emitCount;
+	}
+
+	// 1個あたりの間隔で頻度タイマーを割り、余りを次のステップに持ち越す
+	// （長いステップでもループせずに数を求める）
+	const float interval = desc.emitFrequency / static_cast<float>(desc.emitCount);
+	const float elapsed = timer.frequencyTimer + deltaTime;
+	const uint32_t count = static_cast<uint32_t>(elapsed / interval);
+	timer.frequencyTimer = std::max(elapsed - static_cast<float>(count) * interval, 0.0f);
+	if (count == 0) {
+		return 0;
+	}
+
+	// 最後の1個は余りの分だけ前、最初の1個はそこから(count-1)間隔分前に発生した
+	timer.newestSpawnAge = timer.frequencyTimer;
+	timer.oldestSpawnAge = timer.frequencyTimer + static_cast<float>(count - 1) * interval;
+	return count;
+}
+
+std::span<const ParticleState> ParticleSpawner::CreateParticles(const ParticleSpawnDesc& desc, const Vector3& emitterPosition,
+	FastRandom& random, uint32_t count)
+{
+	if (count == 0) {
+		return {};
+	}
+
+	SpawnScratch& scratch = tlsScratch;
+	scratch.Reserve(count);
+
+	// 色・サイズの時間変化はテーブルがある時だけ有効
+	const ParticleLifetimeLut* lut = desc.lifetimeLut.get();
+	const bool useColorOverLifetime = desc.enableColorOverLifetime && lut && lut->HasColor();
+	const bool useSizeOverLifetime = desc.enableSizeOverLifetime && lut && lut->HasSize();
+	const Vector4 startColor = useColorOverLifetime ? lut->SampleColor(0.0f) : Vector4{};
+	const Vector3 startScale = useSizeOverLifetime ? lut->SampleSize(0.0f) : Vector3{};
+
+	// AABBの範囲内でランダムな位置（エミッター位置を足したワールド座標）
+	random.FillFloat(scratch.Get(SpawnScratch::kPositionX), count, emitterPosition.x + desc.spawnArea.min.x, emitterPosition.x + desc.spawnArea.max.x);
+	random.FillFloat(scratch.Get(SpawnScratch::kPositionY), count, emitterPosition.y + desc.spawnArea.min.y, emitterPosition.y + desc.spawnArea.max.y);
+	random.FillFloat(scratch.Get(SpawnScratch::kPositionZ), count, emitterPosition.z + desc.spawnArea.min.z, emitterPosition.z + desc.spawnArea.max.z);
+
+	// Scale・Rotate（ランダム範囲。Size Over Lifetime使用時は開始スケールで上書きするので生成しない）
+	if (!useSizeOverLifetime) {
+		random.FillFloat(scratch.Get(SpawnScratch::kScaleX), count, desc.scaleMin.x, desc.scaleMax.x);
+		random.FillFloat(scratch.Get(SpawnScratch::kScaleY), count, desc.scaleMin.y, desc.scaleMax.y);
+		random.FillFloat(scratch.Get(SpawnScratch::kScaleZ), count, desc.scaleMin.z, desc.scaleMax.z);
+	}
+	random.FillFloat(scratch.Get(SpawnScratch::kRotateX), count, desc.rotateMin.x, desc.rotateMax.x);
+	random.FillFloat(scratch.Get(SpawnScratch::kRotateY), count, desc.rotateMin.y, desc.rotateMax.y);
+	random.FillFloat(scratch.Get(SpawnScratch::kRotateZ), count, desc.rotateMin.z, desc.rotateMax.z);
+
+	// 速度設定（新方式 or 旧方式）
+	float* velocityX = scratch.Get(SpawnScratch::kVelocityX);
+	float* velocityY = scratch.Get(SpawnScratch::kVelocityY);
+	float* velocityZ = scratch.Get(SpawnScratch::kVelocityZ);
+	float speed = 1.0f;
+	if (desc.useDirectionalEmit) {
+		// 新方式：発射方向を軸に、散らばり角度（全角）の円錐内へ発射
+		random.FillUnitVectorsInCone(velocityX, velocityY, velocityZ, count,
+			desc.emitDirection, DegToRad(desc.spreadAngle) * 0.5f);
+		speed = desc.initialSpeed;
+	} else {
+		// 旧方式：ランダム速度（互換性のため）
+		random.FillFloat(velocityX, count, -desc.velocityRange, desc.velocityRange);
+		random.FillFloat(velocityY, count, -desc.velocityRange, desc.velocityRange);
+		random.FillFloat(velocityZ, count, -desc.velocityRange, desc.velocityRange);
+	}
+
+	// ランダムな色（Color Over Lifetime使用時は開始色で上書きするので生成しない）
+	if (!useColorOverLifetime) {
+		random.FillFloat(scratch.Get(SpawnScratch::kColorR), count, 0.0f, 1.0f);
+		random.FillFloat(scratch.Get(SpawnScratch::kColorG), count, 0.0f, 1.0f);
+		random.FillFloat(scratch.Get(SpawnScratch::kColorB), count, 0.0f, 1.0f);
+	}
+
+	// 寿命
+	random.FillFloat(scratch.Get(SpawnScratch::kLifeTime), count, desc.lifeTimeMin, desc.lifeTimeMax);
+
+	// パーティクルに組み立てる
+	for (uint32_t i = 0; i < count; ++i) {
+		ParticleState& state = scratch.particles[i];
+		state = ParticleState();
+
+		state.transform.translate = {
+			scratch.streams[SpawnScratch::kPositionX][i],
+			scratch.streams[SpawnScratch::kPositionY][i],
+			scratch.streams[SpawnScratch::kPositionZ][i]
+		};
+		state.transform.rotate = {
+			scratch.streams[SpawnScratch::kRotateX][i],
+			scratch.streams[SpawnScratch::kRotateY][i],
+			scratch.streams[SpawnScratch::kRotateZ][i]
+		};
+		state.velocity = { velocityX[i] * speed, velocityY[i] * speed, velocityZ[i] * speed };
+		state.lifeTime = scratch.streams[SpawnScratch::kLifeTime][i];
+		state.currentTime = 0.0f;
+
+		// 時間で色・サイズ変化（テーブルはエミッター単位で共有し、パーティクルは参照だけ持つ）
+		if (useColorOverLifetime || useSizeOverLifetime) {
+			state.lifetimeLut = lut;
+		}
+
+		// 時間で色変化(Color Over Lifetime)
+		if (useColorOverLifetime) {
+			state.useColorOverLifetime = true;
+			state.color = startColor;  // 初期色を設定
+		} else {
+			state.color = {
+				scratch.streams[SpawnScratch::kColorR][i],
+				scratch.streams[SpawnScratch::kColorG][i],
+				scratch.streams[SpawnScratch::kColorB][i],
+				1.0f
+			};
+		}
+
+		// 時間でサイズ変化(Size Over Lifetime)
+		if (useSizeOverLifetime) {
+			state.useSizeOverLifetime = true;
+			state.transform.scale = startScale;  // 初期スケールを設定
+		} else {
+			state.transform.scale = {
+				scratch.streams[SpawnScratch::kScaleX][i],
+				scratch.streams[SpawnScratch::kScaleY][i],
+				scratch.streams[SpawnScratch::kScaleZ][i]
+			};
+		}
+
+		// 回転(Rotation)
+		if (desc.enableRotation) {
+			state.useRotation = true;
+			state.rotationSpeed = desc.rotationSpeed;
+		}
+	}
+
+	return std::span<const ParticleState>(scratch.particles.data(), count);
+}
+
+std::span<const ParticleState> ParticleSpawner::CreateParticlesOverStep(const ParticleSpawnDesc& desc, const ParticleSpawnTimer& timer,
+	const Vector3& previousPosition, const Vector3& emitterPosition, FastRandom& random, uint32_t count)
+{
+	// 現在位置で生成してから、発生時刻に合わせて位置と経過時間をずらす
+	const std::span<const ParticleState> created = CreateParticles(desc, emitterPosition, random, count);
+	if (created.empty()) {
+		return created;
+	}
+	ParticleState* particles = tlsScratch.particles.data();
+
+	const float deltaTime = timer.stepDeltaTime;
+	const float inverseDeltaTime = deltaTime > 0.0f ? 1.0f / deltaTime : 0.0f;
+	const float ageStep = count > 1 ? (timer.oldestSpawnAge - timer.newestSpawnAge) / static_cast<float>(count - 1) : 0.0f;
+	const Vector3 motion = {
+		previousPosition.x - emitterPosition.x,
+		previousPosition.y - emitterPosition.y,
+		previousPosition.z - emitterPosition.z
+	};
+
+	for (uint32_t i = 0; i < count; ++i) {
+		ParticleState& state = particles[i];
+
+		// 古い順に割り振る（発生からステップ終了までの時間）
+		const float age = timer.oldestSpawnAge - ageStep * static_cast<float>(i);
+
+		// 発生時刻のエミッター位置（ステップ終了時の位置から、遡った割合だけ前回位置に寄せる）
+		const float backRate = std::clamp(age * inverseDeltaTime, 0.0f, 1.0f);
+
+		// このステップのシミュレーションでdeltaTime進むので、その分を引いた時間だけ進めておく
+		const float timeOffset = age - deltaTime;
+		state.transform.translate.x += motion.x * backRate + state.velocity.x * timeOffset;
+		state.transform.translate.y += motion.y * backRate + state.velocity.y * timeOffset;
+		state.transform.translate.z += motion.z * backRate + state.velocity.z * timeOffset;
+		state.currentTime = timeOffset;
+	}
+
+	return created;
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include "ParticleState.h"
+#include "ParticleLifetimeCurve.h"
+#include "Random/FastRandom.h"
+
+/// <summary>
+/// パーティクルの発生設定（エミッターの設定のうち、発生と初期値に関わるもの）
+/// <para>DirectXに依存しないので、エミッター無しでも同じ発生処理を実行できる</para>
+/// </summary>
+struct ParticleSpawnDesc {
+	// 発生タイミング
+	uint32_t emitCount = 5;
+	float emitFrequency = 1.0f;
+	bool useEmitterLifeTime = false;
+	float emitterLifeTime = 5.0f;
+	bool emitterLifeTimeLoop = false;
+
+	// 連続発生（emitFrequency秒あたりemitCount個を1個ずつ等間隔に発生させる）
+	// フレーム内の発生時刻に合わせて、エミッター位置の補間と経過時間の前進を行う
+	bool useContinuousEmission = false;
+
+	// 寿命
+	float lifeTimeMin = 1.0f;
+	float lifeTimeMax = 3.0f;
+
+	// 速度
+	bool useDirectionalEmit = false;
+	Vector3 emitDirection = { 0.0f, 1.0f, 0.0f };
+	float initialSpeed = 1.0f;
+	float spreadAngle = 30.0f;		// 度数法
+	float velocityRange = 1.0f;		// useDirectionalEmit=falseの時に使用
+
+	// スケール・回転
+	Vector3 scaleMin = { 1.0f, 1.0f, 1.0f };
+	Vector3 scaleMax = { 1.0f, 1.0f, 1.0f };
+	Vector3 rotateMin = { 0.0f, 0.0f, 0.0f };
+	Vector3 rotateMax = { 0.0f, 0.0f, 0.0f };
+
+	// 発生範囲（エミッター位置からの相対）
+	AABB spawnArea = { {-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f} };
+
+	// 寿命に応じた変化（色・サイズはlifetimeLutに焼き込み済み。テーブルが無ければ無効）
+	bool enableColorOverLifetime = false;
+	bool enableSizeOverLifetime = false;
+	std::shared_ptr<const ParticleLifetimeLut> lifetimeLut;
+	bool enableRotation = false;
+	Vector3 rotationSpeed = { 0.0f, 0.0f, 0.0f };	// 度/秒
+};
+
+/// <summary>
+/// 発生タイミングの状態
+/// </summary>
+struct ParticleSpawnTimer {
+	float frequencyTimer = 0.0f;		// 発生頻度用タイマー
+	float emitterCurrentTime = 0.0f;	// エミッター経過時間
+	bool isEmitting = true;				// パーティクルを発生させるか
+
+	// 直近のAdvanceEmissionで発生した分のフレーム内の発生時刻（連続発生のみ使用）
+	float stepDeltaTime = 0.0f;			// 直近のステップの経過時間
+	float newestSpawnAge = 0.0f;		// 最後に発生した分の、発生からステップ終了までの時間
+	float oldestSpawnAge = 0.0f;		// 最初に発生した分の、発生からステップ終了までの時間
+};
+
+/// <summary>
+/// パーティクルの発生処理
+/// <para>乱数は呼び出し側の生成器から取るので、シードを固定すれば結果が再現できる</para>
+/// </summary>
+namespace ParticleSpawner {
+
+	/// <summary>
+	/// タイマーを進め、今回発生させる回数（1回につきemitCount個）を返す
+	/// <para>エミッター寿命が尽きてループしない場合は発生を止める</para>
+	/// </summary>
+	uint32_t AdvanceTimer(const ParticleSpawnDesc& desc, ParticleSpawnTimer& timer, float deltaTime);
+
+	/// <summary>
+	/// タイマーを進め、今回発生させるパーティクル数を返す
+	/// <para>連続発生では1個ずつの発生時刻をタイマーに記録する（SpawnContinuousで使う）</para>
+	/// </summary>
+	uint32_t AdvanceEmission(const ParticleSpawnDesc& desc, ParticleSpawnTimer& timer, float deltaTime);
+
+	/// <summary>
+	/// 新しいパーティクルをcount個まとめて生成
+	/// <para>乱数は種類ごとにFill系でまとめて生成する（寿命、スケール、回転、位置、速度、色）</para>
+	/// <para>戻り値はスレッド毎の作業領域を指すので、同じスレッドで次に呼ぶまでに使い切ること</para>
+	/// </summary>
+	/// <param name="emitterPosition">エミッターのワールド座標</param>
+	/// <param name="random">乱数生成器</param>
+	/// <param name="count">生成数</param>
+	std::span<const ParticleState> CreateParticles(const ParticleSpawnDesc& desc, const Vector3& emitterPosition,
+		FastRandom& random, uint32_t count);
+
+	/// <summary>
+	/// 直近のステップ内で等間隔に発生したものとしてcount個生成
+	/// <para>発生時刻のエミッター位置（前回位置との線形補間）から出し、発生からの時間だけ進めた状態にする</para>
+	/// <para>発生したステップでdeltaTime分のシミュレーションが走るので、経過時間は「発生からの時間 - deltaTime」（0以下）から始める</para>
+	/// <para>予算で数が減った場合も、同じ時間の範囲に均等に割り振る</para>
+	/// </summary>
+	/// <param name="timer">AdvanceEmissionで発生時刻を記録したタイマー</param>
+	/// <param name="previousPosition">前回のステップでのエミッターのワールド座標</param>
+	/// <param name="emitterPosition">現在のエミッターのワールド座標</param>
+	std::span<const ParticleState> CreateParticlesOverStep(const ParticleSpawnDesc& desc, const ParticleSpawnTimer& timer,
+		const Vector3& previousPosition, const Vector3& emitterPosition, FastRandom& random, uint32_t count);
+
+	/// <summary>
+	/// count個のパーティクルを1回分（emitCount個）ずつ生成して追加先に渡す
+	/// <para>1回分ずつ生成するので、countが同じなら一度に渡してもUpdateと同じ乱数の消費順になる</para>
+	/// </summary>
+	/// <param name="addParticle">bool(const ParticleState&) 追加に失敗したらfalseを返す</param>
+	/// <returns>追加できた数</returns>
+	template<typename AddParticleFunc>
+	uint32_t Spawn(const ParticleSpawnDesc& desc, const Vector3& emitterPosition, FastRandom& random,
+		uint32_t count, AddParticleFunc&& addParticle)
+	{
+		const uint32_t burstSize = desc.emitCount > 0 ? desc.emitCount : count;
+		uint32_t added = 0;
+		while (added < count) {
+			const uint32_t burst = (count - added < burstSize) ? count - added : burstSize;
+			for (const ParticleState& particle : CreateParticles(desc, emitterPosition, random, burst)) {
+				if (!addParticle(particle)) {
+					// 追加に失敗した（満杯）場合はこれ以上追加しない
+					return added;
+				}
+				++added;
+			}
+		}
+		return added;
+	}
+
+	/// <summary>
+	/// count個のパーティクルを直近のステップ内の発生時刻に割り振って生成し、追加先に渡す（連続発生用）
+	/// </summary>
+	/// <param name="addParticle">bool(const ParticleState&) 追加に失敗したらfalseを返す</param>
+	/// <returns>追加できた数</returns>
+	template<typename AddParticleFunc>
+	uint32_t SpawnContinuous(const ParticleSpawnDesc& desc, const ParticleSpawnTimer& timer, const Vector3& previousPosition,
+		const Vector3& emitterPosition, FastRandom& random, uint32_t count, AddParticleFunc&& addParticle)
+	{
+		uint32_t added = 0;
+		for (const ParticleState& particle : CreateParticlesOverStep(desc, timer, previousPosition, emitterPosition, random, count)) {
+			if (!addParticle(particle)) {
+				return added;
+			}
+			++added;
+		}
+		return added;
+	}
+
+	/// <summary>
+	/// タイマーを進めて、発生したパーティクルを追加先に渡す
+	/// <para>エミッターは動かないものとして扱う（連続発生でも位置の補間はしない）</para>
+	/// </summary>
+	/// <param name="addParticle">bool(const ParticleState&) 追加に失敗したらfalseを返す</param>
+	template<typename AddParticleFunc>
+	void Update(const ParticleSpawnDesc& desc, ParticleSpawnTimer& timer, float deltaTime,
+		const Vector3& emitterPosition, FastRandom& random, AddParticleFunc&& addParticle)
+	{
+		const uint32_t count = AdvanceEmission(desc, timer, deltaTime);
+		if (desc.useContinuousEmission) {
+			SpawnContinuous(desc, timer, emitterPosition, emitterPosition, random, count, std::forward<AddParticleFunc>(addParticle));
+			return;
+		}
+		Spawn(desc, emitterPosition, random, count, std::forward<AddParticleFunc>(addParticle));
+	}
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "MyFunction.h"
 
+class ParticleLifetimeLut;
+
 /// <summary>
 /// 個々のパーティクルの状態を保持する構造体
 /// パーティクル一個分ののデータ
@@ -12,15 +14,10 @@ struct ParticleState {
 	float lifeTime;				// 寿命
 	float currentTime;			// 経過時間
 
-	// Color Over Lifetime（色の時間変化）
+	// Color / Size Over Lifetime（エミッターが焼き込んだテーブルを参照する）
 	bool useColorOverLifetime = false;	// 色変化を使用するか
-	Vector4 startColor;					// 開始色
-	Vector4 endColor;					// 終了色
-
-	// Size Over Lifetime（サイズの時間変化）
 	bool useSizeOverLifetime = false;	// サイズ変化を使用するか
-	Vector3 startScale;					// 開始スケール
-	Vector3 endScale;					// 終了スケール
+	const ParticleLifetimeLut* lifetimeLut = nullptr;	// 色・サイズの参照テーブル（エミッター単位で共有）
 
 	// Rotation（回転）
 	bool useRotation = false;			// 回転を使用するか
@@ -34,11 +31,8 @@ struct ParticleState {
 		, lifeTime{ 0.0f }
 		, currentTime{ 0.0f }
 		, useColorOverLifetime{ false }
-		, startColor{ 1.0f, 1.0f, 1.0f, 1.0f }
-		, endColor{ 1.0f, 1.0f, 1.0f, 0.0f }
 		, useSizeOverLifetime{ false }
-		, startScale{ 1.0f, 1.0f, 1.0f }
-		, endScale{ 1.0f, 1.0f, 1.0f }
+		, lifetimeLut{ nullptr }
 		, useRotation{ false }
 		, rotationSpeed{ 0.0f, 0.0f, 0.0f }
 	{
@@ -46,10 +40,73 @@ struct ParticleState {
 };
 
 /// <summary>
-/// パーティクルのGPUに送るデータ
+/// パーティクルのGPUに送るデータ（1つ32バイト）
+/// <para>行列はParticle.VS.hlslでParticleViewForGPUと合わせて組み立てる</para>
 /// </summary>
 struct ParticleForGPU {
-	Matrix4x4 WVP;
-	Matrix4x4 World;
-	Vector4 color;
-};
\ No newline at end of file
+	Vector3 translate;			// ワールド座標
+	uint32_t color;				// RGBA8（Rが下位バイト）
+	uint32_t scaleXY;			// スケールX・Y（half x2、Xが下位）
+	uint32_t scaleZRotateX;		// スケールZ・回転X（half x2、スケールZが下位）
+	uint32_t rotateYZ;			// 回転Y・Z（half x2、ラジアン、Yが下位）
+	uint32_t flags;				// kParticleFlagBillboardなど
+};
+static_assert(sizeof(ParticleForGPU) == 32, "ParticleForGPU must match the shader layout");
+
+// ParticleForGPU::flags
+constexpr uint32_t kParticleFlagBillboard = 1u << 0;	// ビルボード（回転を使わずカメラに向ける）
+
+/// <summary>
+/// パーティクル描画で全インスタンス共通のデータ（フレームに1回更新）
+/// </summary>
+struct ParticleViewForGPU {
+	Matrix4x4 viewProjection;	// ビュープロジェクション行列
+	Matrix4x4 billboard;		// ビルボード行列（カメラの回転）
+};
+
+/// <summary>
+/// パーティクルの軌跡（リボン）の頂点（1つ24バイト）
+/// <para>CPUでワールド座標の帯を組み立て、ParticleTrail.VS.hlslではビュープロジェクションを掛けるだけ</para>
+/// </summary>
+struct ParticleTrailVertex {
+	Vector3 position;			// ワールド座標
+	uint32_t color;				// RGBA8（Rが下位バイト）
+	Vector2 texcoord;			// x:先頭0→末尾1、y:帯の左0・右1
+};
+static_assert(sizeof(ParticleTrailVertex) == 24, "ParticleTrailVertex must match the input layout");
+
+/// <summary>
+/// パーティクルの軌跡の設定（グループ単位）
+/// </summary>
+struct ParticleTrailSettings {
+	// 履歴の最大点数（パーティクル毎に固定長のリングバッファを持つ）
+	static constexpr uint32_t kMaxLength = 32;
+	static constexpr uint32_t kMinLength = 2;
+
+	bool enabled = false;
+	uint32_t length = 8;					// 履歴の点数（kMinLength～kMaxLength）
+	float recordInterval = 1.0f / 60.0f;	// 履歴を記録する間隔（秒）
+	float width = 0.2f;						// 先頭の幅（パーティクルのスケールXを掛ける）
+	float tailWidthRate = 0.0f;				// 末尾の幅の倍率（0で先細り）
+	float tailAlphaRate = 0.0f;				// 末尾のαの倍率（0でフェードアウト）
+
+	/// <summary>
+	/// 1本あたりの頂点数（現在位置＋履歴の各点に左右2頂点）
+	/// </summary>
+	uint32_t GetVertexCountPerTrail() const { return (length + 1) * 2; }
+
+	/// <summary>
+	/// 1本あたりのインデックス数（点の間の四角形を2三角形で描く）
+	/// </summary>
+	uint32_t GetIndexCountPerTrail() const { return length * 6; }
+};
+
+/// <summary>
+/// パーティクルの固定刻みサブステップの設定（グループ単位）
+/// <para>フレーム時間を固定の刻みに分けてフィールドと移動を進めるので、スローモーション等で時間の倍率が変わっても挙動が変わらない</para>
+/// </summary>
+struct ParticleSubstepSettings {
+	bool enabled = false;
+	float step = 1.0f / 240.0f;			// 1刻みの時間（秒）
+	uint32_t maxStepsPerFrame = 8;		// 1フレームの最大刻み数（超えた分の時間は捨てる）
+};
@@ -0,0 +1,293 @@
+#include "ParticleStorage.h"
+#include <algorithm>
+
+void ParticleStorage::Initialize(uint32_t capacity)
+{
+	capacity_ = capacity;
+	count_ = 0;
+	modes_ = {};
+
+	// SIMDで末尾までまとめて処理できるように、幅の倍数まで確保する
+	const size_t paddedCapacity = RoundUpToSimdWidth(capacity_);
+
+	for (auto* stream : {
+		&positionX, &positionY, &positionZ,
+		&velocityX, &velocityY, &velocityZ,
+		&colorR, &colorG, &colorB, &colorA,
+		&scaleX, &scaleY, &scaleZ,
+		&rotateX, &rotateY, &rotateZ,
+		&lifeTime, &currentTime,
+		&rotationSpeedX, &rotationSpeedY, &rotationSpeedZ }) {
+		stream->assign(paddedCapacity, 0.0f);
+	}
+
+	lifetimeLutSlot.assign(paddedCapacity, 0);
+	killFlags.assign(paddedCapacity, 0);
+	trailStride_ = paddedCapacity;
+	EnableTrail(trailLength_);
+	moves_.reserve(capacity_);
+	ResetLifetimeLuts();
+}
+
+bool ParticleStorage::Add(const ParticleState& particle)
+{
+	// 最大数に達していないかチェック
+	if (count_ >= capacity_) {
+		return false;
+	}
+
+	// 機能を使うパーティクルが初めて来たらグループのモードを有効化
+	if (particle.useColorOverLifetime && !modes_.colorOverLifetime) {
+		EnableColorOverLifetime();
+	}
+	if (particle.useSizeOverLifetime && !modes_.sizeOverLifetime) {
+		EnableSizeOverLifetime();
+	}
+	if (particle.useRotation && !modes_.rotation) {
+		EnableRotation();
+	}
+
+	const uint32_t i = count_;
+
+	positionX[i] = particle.transform.translate.x;
+	positionY[i] = particle.transform.translate.y;
+	positionZ[i] = particle.transform.translate.z;
+
+	velocityX[i] = particle.velocity.x;
+	velocityY[i] = particle.velocity.y;
+	velocityZ[i] = particle.velocity.z;
+
+	colorR[i] = particle.color.x;
+	colorG[i] = particle.color.y;
+	colorB[i] = particle.color.z;
+	colorA[i] = particle.color.w;
+
+	scaleX[i] = particle.transform.scale.x;
+	scaleY[i] = particle.transform.scale.y;
+	scaleZ[i] = particle.transform.scale.z;
+
+	rotateX[i] = particle.transform.rotate.x;
+	rotateY[i] = particle.transform.rotate.y;
+	rotateZ[i] = particle.transform.rotate.z;
+
+	lifeTime[i] = particle.lifeTime;
+	currentTime[i] = particle.currentTime;
+
+	// モードが有効なグループでは参照テーブルの番号を持つ
+	// （機能を使わないパーティクルは0にして、カーネル側で従来のフェードアウト・スケール維持にする）
+	if (modes_.colorOverLifetime || modes_.sizeOverLifetime) {
+		const bool useLut = particle.lifetimeLut && (particle.useColorOverLifetime || particle.useSizeOverLifetime);
+		lifetimeLutSlot[i] = useLut ? BindLifetimeLut(particle.lifetimeLut) : 0;
+	}
+
+	if (modes_.rotation) {
+		// 度/秒 → ラジアン/秒は追加時に一度だけ変換する
+		const Vector3 speed = particle.useRotation ? particle.rotationSpeed : Vector3{ 0.0f, 0.0f, 0.0f };
+		rotationSpeedX[i] = DegToRad(speed.x);
+		rotationSpeedY[i] = DegToRad(speed.y);
+		rotationSpeedZ[i] = DegToRad(speed.z);
+	}
+
+	// 軌跡は次の記録から始める（それまでは現在位置だけの長さ0の帯になる）
+	if (trailLength_ > 0) {
+		trailCount[i] = 0;
+	}
+
+	killFlags[i] = 0;
+	++count_;
+	return true;
+}
+
+void ParticleStorage::Clear()
+{
+	count_ = 0;
+	modes_ = {};
+	ResetLifetimeLuts();
+}
+
+template<typename Func>
+void ParticleStorage::ForEachActiveStream(Func&& func)
+{
+	for (auto* stream : {
+		&positionX, &positionY, &positionZ,
+		&velocityX, &velocityY, &velocityZ,
+		&colorR, &colorG, &colorB, &colorA,
+		&scaleX, &scaleY, &scaleZ,
+		&rotateX, &rotateY, &rotateZ,
+		&lifeTime, &currentTime }) {
+		func(*stream);
+	}
+
+	if (modes_.colorOverLifetime || modes_.sizeOverLifetime) {
+		func(lifetimeLutSlot);
+	}
+
+	if (modes_.rotation) {
+		for (auto* stream : { &rotationSpeedX, &rotationSpeedY, &rotationSpeedZ }) {
+			func(*stream);
+		}
+	}
+
+	if (trailLength_ > 0) {
+		func(trailCount);
+	}
+}
+
+void ParticleStorage::Compact()
+{
+	// 穴埋めの移動リストを作成（死亡位置に末尾の生存パーティクルを移す）
+	moves_.clear();
+	uint32_t end = count_;
+	uint32_t i = 0;
+	while (i < end) {
+		if (!killFlags[i]) {
+			++i;
+			continue;
+		}
+
+		// 末尾側の死亡パーティクルは移動せずに切り捨てる
+		--end;
+		while (end > i && killFlags[end]) {
+			--end;
+		}
+
+		if (end > i) {
+			moves_.push_back({ end, i });
+			++i;
+		}
+	}
+
+	// 死亡フラグをクリア
+	std::fill(killFlags.begin(), killFlags.begin() + count_, static_cast<uint8_t>(0));
+
+	// 誰も死んでいなければ何もしない
+	if (end == count_) {
+		return;
+	}
+
+	// ストリームごとに移動を適用
+	ForEachActiveStream([&](auto& stream) {
+		auto* data = stream.data();
+		for (const Move& move : moves_) {
+			data[move.to] = data[move.from];
+		}
+	});
+
+	// 軌跡の履歴は行ごとに同じ移動を適用する
+	for (uint32_t row = 0; row < trailLength_; ++row) {
+		for (float* data : { GetTrailRowX(row), GetTrailRowY(row), GetTrailRowZ(row) }) {
+			for (const Move& move : moves_) {
+				data[move.to] = data[move.from];
+			}
+		}
+	}
+
+	count_ = end;
+
+	// 空になったらモードを戻して、不要なカーネルを回さないようにする
+	if (count_ == 0) {
+		modes_ = {};
+		ResetLifetimeLuts();
+	}
+}
+
+ParticleState ParticleStorage::GetParticle(uint32_t index) const
+{
+	ParticleState state;
+	if (index >= count_) {
+		return state;
+	}
+
+	state.transform.translate = { positionX[index], positionY[index], positionZ[index] };
+	state.transform.scale = { scaleX[index], scaleY[index], scaleZ[index] };
+	state.transform.rotate = { rotateX[index], rotateY[index], rotateZ[index] };
+	state.velocity = { velocityX[index], velocityY[index], velocityZ[index] };
+	state.color = { colorR[index], colorG[index], colorB[index], colorA[index] };
+	state.lifeTime = lifeTime[index];
+	state.currentTime = currentTime[index];
+	return state;
+}
+
+void ParticleStorage::SetColor(uint32_t index, const Vector4& color)
+{
+	if (index >= count_) {
+		return;
+	}
+
+	colorR[index] = color.x;
+	colorG[index] = color.y;
+	colorB[index] = color.z;
+	colorA[index] = color.w;
+}
+
+void ParticleStorage::EnableTrail(uint32_t length)
+{
+	trailLength_ = length;
+	trailHead_ = 0;
+
+	const size_t historySize = static_cast<size_t>(trailLength_) * trailStride_;
+	for (auto* stream : { &trailX, &trailY, &trailZ }) {
+		stream->assign(historySize, 0.0f);
+		stream->shrink_to_fit();
+	}
+	trailCount.assign(trailLength_ > 0 ? trailStride_ : 0, 0);
+	trailCount.shrink_to_fit();
+}
+
+void ParticleStorage::EnableColorOverLifetime()
+{
+	// 既存パーティクルはテーブル無し（従来のフェードアウト）にする
+	if (!modes_.sizeOverLifetime) {
+		std::fill(lifetimeLutSlot.begin(), lifetimeLutSlot.begin() + count_, static_cast<uint16_t>(0));
+	}
+	modes_.colorOverLifetime = true;
+}
+
+void ParticleStorage::EnableSizeOverLifetime()
+{
+	// 既存パーティクルはテーブル無し（現在のスケールを維持）にする
+	if (!modes_.colorOverLifetime) {
+		std::fill(lifetimeLutSlot.begin(), lifetimeLutSlot.begin() + count_, static_cast<uint16_t>(0));
+	}
+	modes_.sizeOverLifetime = true;
+}
+
+void ParticleStorage::EnableRotation()
+{
+	// 既存パーティクルは回転しない
+	for (uint32_t i = 0; i < count_; ++i) {
+		rotationSpeedX[i] = 0.0f;
+		rotationSpeedY[i] = 0.0f;
+		rotationSpeedZ[i] = 0.0f;
+	}
+	modes_.rotation = true;
+}
+
+uint16_t ParticleStorage::BindLifetimeLut(const ParticleLifetimeLut* lut)
+{
+	// 同じエミッターから続けて追加されることが多いので、直前の番号から調べる
+	if (lifetimeLuts_[lastLifetimeLutSlot_].get() == lut) {
+		return lastLifetimeLutSlot_;
+	}
+	for (size_t slot = 1; slot < lifetimeLuts_.size(); ++slot) {
+		if (lifetimeLuts_[slot].get() == lut) {
+			lastLifetimeLutSlot_ = static_cast<uint16_t>(slot);
+			return lastLifetimeLutSlot_;
+		}
+	}
+
+	// 番号が足りない場合はテーブル無しとして扱う
+	if (lifetimeLuts_.size() > UINT16_MAX) {
+		return 0;
+	}
+
+	lifetimeLuts_.push_back(lut->shared_from_this());
+	lastLifetimeLutSlot_ = static_cast<uint16_t>(lifetimeLuts_.size() - 1);
+	return lastLifetimeLutSlot_;
+}
+
+void ParticleStorage::ResetLifetimeLuts()
+{
+	lifetimeLuts_.assign(1, nullptr);
+	lastLifetimeLutSlot_ = 0;
+}
@@ -0,0 +1,186 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "ParticleState.h"
+#include "ParticleLifetimeCurve.h"
+
+/// <summary>
+/// パーティクルグループ単位の更新モード
+/// <para>パーティクル毎にboolを持たず、グループ全体でどのカーネルを回すかを決める</para>
+/// <para>一度でも該当機能を使うパーティクルが追加されると有効になり、グループが空になると戻る</para>
+/// </summary>
+struct ParticleUpdateModes {
+	bool colorOverLifetime = false;	// 色の時間変化
+	bool sizeOverLifetime = false;	// サイズの時間変化
+	bool rotation = false;			// 回転
+};
+
+/// <summary>
+/// パーティクルのSoA（Structure of Arrays）ストレージ
+/// <para>要素ごとに別配列で持つことで、更新カーネルが必要なストリームだけを読み書きできる</para>
+/// <para>[0, count)が常に連続した生存範囲。各配列はSIMD幅の倍数まで確保する</para>
+/// <para>DirectXに依存しないため、デバイス無しでも更新処理を回せる</para>
+/// </summary>
+class ParticleStorage
+{
+public:
+	// SIMDで一度に処理する要素数（SSE: float x4）
+	static constexpr uint32_t kSimdWidth = 4;
+
+	/// <summary>
+	/// 初期化（最大数分の配列を確保）
+	/// </summary>
+	/// <param name="capacity">最大パーティクル数</param>
+	void Initialize(uint32_t capacity);
+
+	/// <summary>
+	/// パーティクルを追加
+	/// </summary>
+	/// <param name="particle">追加するパーティクルの状態</param>
+	/// <returns>追加に成功したらtrue</returns>
+	bool Add(const ParticleState& particle);
+
+	/// <summary>
+	/// すべてのパーティクルをクリア
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 死亡フラグが立ったパーティクルを除去して詰める
+	/// <para>空いた位置に末尾の生存パーティクルを移すため順序は維持しない</para>
+	/// <para>（コストが全体数ではなく死亡数に比例し、ストリーム数が多くても軽い）</para>
+	/// </summary>
+	void Compact();
+
+	/// <summary>
+	/// 軌跡の履歴を確保する（0で無効。既存パーティクルの履歴は空から始める）
+	/// <para>履歴は点数×最大数の固定長で、シミュレーション中は確保しない</para>
+	/// </summary>
+	/// <param name="length">1パーティクルあたりの履歴の点数</param>
+	void EnableTrail(uint32_t length);
+
+	/// <summary>
+	/// 履歴の書き込み先を次の行に進める（記録する前にメインスレッドから呼ぶ）
+	/// <para>全パーティクルが同時に記録するので、リングの先頭はグループで1つ</para>
+	/// </summary>
+	void AdvanceTrailHead() { trailHead_ = (trailHead_ + 1) % trailLength_; }
+
+	uint32_t GetTrailLength() const { return trailLength_; }
+	uint32_t GetTrailHead() const { return trailHead_; }
+	bool HasTrail() const { return trailLength_ > 0; }
+
+	/// <summary>
+	/// 履歴の行の先頭（row番目に記録した全パーティクルの座標が連続して並ぶ）
+	/// </summary>
+	float* GetTrailRowX(uint32_t row) { return trailX.data() + static_cast<size_t>(row) * trailStride_; }
+	float* GetTrailRowY(uint32_t row) { return trailY.data() + static_cast<size_t>(row) * trailStride_; }
+	float* GetTrailRowZ(uint32_t row) { return trailZ.data() + static_cast<size_t>(row) * trailStride_; }
+	const float* GetTrailRowX(uint32_t row) const { return trailX.data() + static_cast<size_t>(row) * trailStride_; }
+	const float* GetTrailRowY(uint32_t row) const { return trailY.data() + static_cast<size_t>(row) * trailStride_; }
+	const float* GetTrailRowZ(uint32_t row) const { return trailZ.data() + static_cast<size_t>(row) * trailStride_; }
+
+	/// <summary>
+	/// 指定インデックスのパーティクルをAoS形式で取得（デバッグ表示用）
+	/// </summary>
+	ParticleState GetParticle(uint32_t index) const;
+
+	/// <summary>
+	/// 指定インデックスのパーティクルの色を設定（デバッグ編集用）
+	/// </summary>
+	void SetColor(uint32_t index, const Vector4& color);
+
+	uint32_t GetCount() const { return count_; }
+	uint32_t GetCapacity() const { return capacity_; }
+	bool IsFull() const { return count_ >= capacity_; }
+	bool IsEmpty() const { return count_ == 0; }
+	const ParticleUpdateModes& GetModes() const { return modes_; }
+
+	/// <summary>
+	/// 参照テーブルの番号からテーブルを取得（0・範囲外はnullptr）
+	/// </summary>
+	const ParticleLifetimeLut* GetLifetimeLut(uint16_t slot) const {
+		return slot < lifetimeLuts_.size() ? lifetimeLuts_[slot].get() : nullptr;
+	}
+	size_t GetLifetimeLutCount() const { return lifetimeLuts_.size() - 1; }
+
+	/// <summary>
+	/// 要素数をSIMD幅の倍数に切り上げる
+	/// </summary>
+	static uint32_t RoundUpToSimdWidth(uint32_t count) {
+		return (count + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+	}
+
+	// ========================================
+	// ストリーム（カーネルから直接読み書きする）
+	// ========================================
+
+	// 位置
+	std::vector<float> positionX, positionY, positionZ;
+	// 速度
+	std::vector<float> velocityX, velocityY, velocityZ;
+	// 色
+	std::vector<float> colorR, colorG, colorB, colorA;
+	// スケール
+	std::vector<float> scaleX, scaleY, scaleZ;
+	// 回転（ラジアン）
+	std::vector<float> rotateX, rotateY, rotateZ;
+	// 寿命
+	std::vector<float> lifeTime, currentTime;
+
+	// Color / Size Over Lifetime の参照テーブル番号（どちらかのモード時のみ使用、0はテーブル無し）
+	std::vector<uint16_t> lifetimeLutSlot;
+
+	// Rotation（modes.rotation時のみ使用、ラジアン/秒）
+	std::vector<float> rotationSpeedX, rotationSpeedY, rotationSpeedZ;
+
+	// 軌跡の履歴（HasTrail時のみ使用。行ごとにSoAで並べ、行の順はtrailHead_から遡る）
+	std::vector<float> trailX, trailY, trailZ;
+	// 記録済みの点数（追加時0、記録毎に履歴の点数まで増える）
+	std::vector<uint8_t> trailCount;
+
+	// 死亡フラグ（1で削除対象、Compactでクリアされる）
+	std::vector<uint8_t> killFlags;
+
+private:
+	/// <summary>
+	/// 現在のモードで使用しているストリームすべてに関数を適用
+	/// </summary>
+	template<typename Func>
+	void ForEachActiveStream(Func&& func);
+
+	// 既存パーティクルの値でストリームを埋めてからモードを有効化する
+	void EnableColorOverLifetime();
+	void EnableSizeOverLifetime();
+	void EnableRotation();
+
+	/// <summary>
+	/// 参照テーブルの番号を取得（初めてのテーブルなら登録して寿命を延ばす）
+	/// </summary>
+	uint16_t BindLifetimeLut(const ParticleLifetimeLut* lut);
+
+	/// <summary>
+	/// 登録済みの参照テーブルを手放す（空になった時）
+	/// </summary>
+	void ResetLifetimeLuts();
+
+	uint32_t count_ = 0;			// 生存パーティクル数
+	uint32_t capacity_ = 0;			// 最大パーティクル数
+	ParticleUpdateModes modes_;		// グループ単位の更新モード
+
+	// 参照テーブル（先頭はテーブル無しを表すnullptr。グループに追加したエミッターの数だけ増える）
+	std::vector<std::shared_ptr<const ParticleLifetimeLut>> lifetimeLuts_ = { nullptr };
+	uint16_t lastLifetimeLutSlot_ = 0;	// 直前に登録・検索した番号（同じエミッターからの連続追加用）
+
+	// 軌跡の履歴
+	uint32_t trailLength_ = 0;		// 1パーティクルあたりの点数（0で無効）
+	uint32_t trailHead_ = 0;		// 最後に記録した行
+	size_t trailStride_ = 0;		// 1行の要素数（SIMD幅に切り上げた最大数）
+
+	// Compact用の移動リスト（毎フレーム再確保しないよう保持）
+	struct Move {
+		uint32_t from;
+		uint32_t to;
+	};
+	std::vector<Move> moves_;
+};
@@ -1,8 +1,11 @@
 #include "ParticleSystem.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h"
 #include "GameTimer.h"
+#include "JobSystem.h"
 
 #include "Logger.h"
+#include "Random/CounterRandom.h"
 
 ParticleSystem* ParticleSystem::GetInstance()
 {
@@ -15,6 +18,15 @@ void ParticleSystem::Initialize(DirectXCommon* dxCommon)
 	dxCommon_ = dxCommon;
 	billboardMatrix_ = MakeIdentity4x4();
 
+	// 全グループで共有するGPU転送用バッファ
+	instanceArena_.Initialize(dxCommon_);
+
+	// 全インスタンス共通のビュー情報（頂点シェーダーでワールド行列と合成する）
+	viewResource_ = CreateBufferResource(dxCommon_->GetDevice(), sizeof(ParticleViewForGPU));
+	viewResource_->Map(0, nullptr, reinterpret_cast<void**>(&viewData_));
+	viewData_->viewProjection = MakeIdentity4x4();
+	viewData_->billboard = billboardMatrix_;
+
 	Logger::Log(Logger::GetStream(), "ParticleSystem: Initialized\n");
 }
 
@@ -27,29 +39,227 @@ void ParticleSystem::Update(const Matrix4x4& viewProjectionMatrix)
 	// ビルボード行列を計算（全グループ共通）
 	CalculateBillboardMatrix();
 
+	// 予算の集計はフレーム単位（決定論モードで複数ステップ進んだ場合は合計）
+	budget_.BeginFrame();
+
+	// 頂点シェーダーに渡すビュー情報を更新（ステップが進まないフレームでもカメラには追従する）
+	if (viewData_) {
+		viewData_->viewProjection = viewProjectionMatrix;
+		viewData_->billboard = billboardMatrix_;
+	}
+
+	// 決定論モードではフレーム時間に関係なく固定刻みで進める
+	if (isDeterministic_) {
+		const uint32_t stepCount = fixedStepDriver_.Advance(gameDeltaTime);
+		for (uint32_t step = 0; step < stepCount; ++step) {
+			Step(viewProjectionMatrix, fixedStepDriver_.GetStep());
+		}
+		return;
+	}
+
+	Step(viewProjectionMatrix, gameDeltaTime);
+}
+
+void ParticleSystem::Step(const Matrix4x4& viewProjectionMatrix, float deltaTime)
+{
 	// すべてのフィールドを更新
 	for (auto& [fieldName, field] : fields_) {
-		field->Update(gameDeltaTime);
+		field->Update(deltaTime);
+	}
+
+	// すべてのエミッターを更新（予算の範囲でパーティクルを発生）
+	EmitWithinBudget(deltaTime);
+
+	// 有効なフィールドとその範囲のリストを作成（範囲の計算はフレームに一度だけ）
+	fieldEntries_.clear();
+	for (auto& [fieldName, field] : fields_) {
+		if (field->IsEnabled()) {
+			fieldEntries_.push_back({ field.get(), field->GetWorldBounds() });
+		}
+	}
+
+	// すべてのグループを並列に更新（フィールドは読み取りのみ）
+	UpdateGroupsParallel(viewProjectionMatrix, deltaTime);
+}
+
+void ParticleSystem::EmitWithinBudget(float deltaTime)
+{
+	// 前回の更新後の生存数から、今回発生できる数を決める
+	uint32_t liveParticles = 0;
+	for (const auto& [groupName, group] : groups_) {
+		liveParticles += group->GetActiveParticleCount();
 	}
+	budget_.BeginStep(liveParticles);
 
-	// すべてのエミッターを更新
+	// 発生要求を集める（距離LODはエミッター毎に掛け、端数はエミッターが持ち越す）
+	// エミッターは名前順に回るので、同じ優先度で予算が足りないときの割り当ても毎回同じになる
+	const Vector3 cameraPosition = cameraController_->GetPosition();
+	emissionRequests_.clear();
 	for (auto& [emitterName, emitter] : emitters_) {
 		// ターゲットグループを取得
 		ParticleGroup* targetGroup = GetGroup(emitter->GetTargetGroupName());
+		if (!targetGroup) {
+			continue;
+		}
 
-		// エミッターを更新（パーティクルを発生）
-		emitter->Update(gameDeltaTime, targetGroup);
+		const uint32_t requested = emitter->RequestEmission(deltaTime);
+		uint32_t desired = 0;
+		if (requested > 0) {
+			const float distance = Distance(emitter->GetTransform().GetPosition(), cameraPosition);
+			const float lodRate = budget_.ComputeLodRate(distance, emitter->GetPriority(), emitter->IsUseDistanceLod());
+			desired = emitter->ApplyEmissionRate(requested, lodRate);
+		}
+		emissionRequests_.push_back({ emitter.get(), targetGroup, budget_.AddRequest(emitter->GetPriority(), requested, desired) });
 	}
 
-	// フィールドのポインタリストを作成
-	std::vector<BaseField*> fieldPtrs;
-	for (auto& [fieldName, field] : fields_) {
-		fieldPtrs.push_back(field.get());
+	// 優先度順に割り当てて発生させる
+	budget_.Resolve();
+	for (const EmissionRequest& request : emissionRequests_) {
+		const uint32_t granted = budget_.GetGrant(request.ticket);
+		const uint32_t spawned = request.emitter->Emit(request.group, granted);
+		budget_.ReportSpawned(granted, spawned);
+	}
+}
+
+void ParticleSystem::SetDeterministic(bool enabled, uint64_t seed)
+{
+	isDeterministic_ = enabled;
+	deterministicSeed_ = seed;
+	fixedStepDriver_.Reset();
+
+	if (enabled) {
+		// 既存のエミッターもシードと発生タイマーを揃え直す
+		for (auto& [emitterName, emitter] : emitters_) {
+			ApplyDeterministicSeed(emitterName, emitter.get());
+			emitter->ResetSpawnTimer();
+		}
 	}
 
-	// すべてのグループを更新（フィールドを渡す）
+	Logger::Log(Logger::GetStream(),
+		std::format("ParticleSystem: Deterministic mode {} (seed: {:#x}, step: {:.4f})\n",
+			enabled ? "enabled" : "disabled", seed, fixedStepDriver_.GetStep()));
+}
+
+void ParticleSystem::ApplyDeterministicSeed(const std::string& emitterName, ParticleEmitter* emitter) const
+{
+	// 生成順に依存しないよう、エミッター名からシードを作る
+	emitter->SetRandomSeed(CounterRandom::CombineSeed(deterministicSeed_, CounterRandom::HashString(emitterName)));
+}
+
+void ParticleSystem::UpdateGroupsParallel(const Matrix4x4& viewProjectionMatrix, float deltaTime)
+{
+	// エミッターの発生処理は上でメインスレッドから順に行っているので、
+	// ここでの並列化は生成順・乱数の消費順に影響しない
+
+	groupList_.clear();
+	culledFieldTestCount_ = 0;
 	for (auto& [groupName, group] : groups_) {
-		group->Update(viewProjectionMatrix, billboardMatrix_, gameDeltaTime, fieldPtrs);
+		groupList_.push_back(group.get());
+
+		// フェーズ0：グループの範囲と重ならないフィールドを除外（ブロードフェーズ）し、サブステップの刻み数を決める
+		group->CullFields(fieldEntries_);
+		group->AdvanceSubstep(deltaTime);
+		if (!group->IsEmpty()) {
+			culledFieldTestCount_ += fieldEntries_.size() - group->GetCandidateFieldCount();
+		}
+	}
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	// フェーズ1：寿命チェックとフィールド適用（グループ×チャンク）
+	BuildChunkTasks();
+	jobSystem->ParallelFor(static_cast<uint32_t>(chunkTasks_.size()), [&](uint32_t taskIndex) {
+		const ChunkTask& task = chunkTasks_[taskIndex];
+		task.group->ExpireChunk(task.chunkIndex, deltaTime);
+	});
+
+	// フェーズ2：死亡パーティクルの除去（グループ単位）
+	jobSystem->ParallelFor(static_cast<uint32_t>(groupList_.size()), [&](uint32_t groupIndex) {
+		groupList_[groupIndex]->CompactParticles();
+	});
+
+	// 軌跡を記録するステップかどうかを決める（メインスレッド）
+	for (ParticleGroup* group : groupList_) {
+		group->AdvanceTrail(deltaTime);
+	}
+
+	// フェーズ3：シミュレーションと可視判定（除去後の数でチャンクを作り直す）
+	const ParticleFrustum frustum = ParticleKernels::MakeFrustum(viewProjectionMatrix);
+	const ParticleFrustum* cullFrustum = useFrustumCulling_ ? &frustum : nullptr;
+	BuildChunkTasks();
+	jobSystem->ParallelFor(static_cast<uint32_t>(chunkTasks_.size()), [&](uint32_t taskIndex) {
+		const ChunkTask& task = chunkTasks_[taskIndex];
+		task.group->SimulateChunk(task.chunkIndex, cullFrustum, viewProjectionMatrix, deltaTime);
+	});
+
+	// フェーズ4：可視リストを詰めて並べ替え（グループ単位）
+	jobSystem->ParallelFor(static_cast<uint32_t>(groupList_.size()), [&](uint32_t groupIndex) {
+		groupList_[groupIndex]->GatherVisible();
+	});
+
+	// GPU転送用の範囲を可視数ぴったりで切り出す（メインスレッド）
+	uint32_t requiredInstanceCount = 0;
+	for (ParticleGroup* group : groupList_) {
+		requiredInstanceCount += group->GetVisibleParticleCount();
+	}
+	instanceArena_.BeginFrame(requiredInstanceCount);
+	for (ParticleGroup* group : groupList_) {
+		group->AllocateInstances();
+	}
+
+	// フェーズ5：可視パーティクルだけをGPUバッファに書き込む（可視数でチャンクを作る）
+	BuildWriteChunkTasks();
+	jobSystem->ParallelFor(static_cast<uint32_t>(chunkTasks_.size()), [&](uint32_t taskIndex) {
+		const ChunkTask& task = chunkTasks_[taskIndex];
+		task.group->WriteInstanceChunk(task.chunkIndex);
+	});
+
+	// フェーズ5'：軌跡の頂点を書き込む（軌跡を持つグループの生存数でチャンクを作る）
+	BuildTrailChunkTasks();
+	if (!chunkTasks_.empty()) {
+		const Vector3 cameraPosition = cameraController_->GetPosition();
+		jobSystem->ParallelFor(static_cast<uint32_t>(chunkTasks_.size()), [&](uint32_t taskIndex) {
+			const ChunkTask& task = chunkTasks_[taskIndex];
+			task.group->WriteTrailChunk(task.chunkIndex, cameraPosition);
+		});
+	}
+
+	// フェーズ6：マテリアル等のGPUリソース更新はメインスレッドで行う
+	for (ParticleGroup* group : groupList_) {
+		group->FinishUpdate();
+	}
+}
+
+void ParticleSystem::BuildChunkTasks()
+{
+	chunkTasks_.clear();
+	for (ParticleGroup* group : groupList_) {
+		const uint32_t chunkCount = group->GetChunkCount();
+		for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+			chunkTasks_.push_back({ group, chunk });
+		}
+	}
+}
+
+void ParticleSystem::BuildWriteChunkTasks()
+{
+	chunkTasks_.clear();
+	for (ParticleGroup* group : groupList_) {
+		const uint32_t chunkCount = group->GetWriteChunkCount();
+		for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+			chunkTasks_.push_back({ group, chunk });
+		}
+	}
+}
+
+void ParticleSystem::BuildTrailChunkTasks()
+{
+	chunkTasks_.clear();
+	for (ParticleGroup* group : groupList_) {
+		const uint32_t chunkCount = group->GetTrailChunkCount();
+		for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+			chunkTasks_.push_back({ group, chunk });
+		}
 	}
 }
 
@@ -57,11 +267,26 @@ void ParticleSystem::Draw()
 {
 	// 共通の描画設定をセット
 	particleCommon_->setCommonRenderSettings();
+	// ビュー情報は全グループ共通
+	dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(3, viewResource_->GetGPUVirtualAddress());
 	// すべてのグループを描画
 	for (auto& [groupName, group] : groups_) {
 		group->Draw();
 	}
 
+	// 軌跡は別のPSOでまとめて描画（軌跡を持つグループがある場合のみ切り替える）
+	bool hasTrail = false;
+	for (const auto& [groupName, group] : groups_) {
+		hasTrail |= group->HasTrail();
+	}
+	if (hasTrail) {
+		particleCommon_->setTrailRenderSettings();
+		dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(1, viewResource_->GetGPUVirtualAddress());
+		for (auto& [groupName, group] : groups_) {
+			group->DrawTrail();
+		}
+	}
+
 #ifdef USEIMGUI
 	/// デバッグ描画(LineSystemに追加するだけでここで実際に描画してない)
 	// すべてのエミッターのデバッグ描画
@@ -90,16 +315,37 @@ void ParticleSystem::ImGui()
 
 			// 全パーティクル数の集計
 			uint32_t totalActiveParticles = 0;
+			uint32_t totalVisibleParticles = 0;
 			uint32_t totalMaxParticles = 0;
 			for (const auto& [name, group] : groups_) {
 				totalActiveParticles += group->GetActiveParticleCount();
+				totalVisibleParticles += group->GetVisibleParticleCount();
 				totalMaxParticles += group->GetMaxParticleCount();
 			}
 			ImGui::Text("Total Particles: %u / %u", totalActiveParticles, totalMaxParticles);
+			ImGui::Text("Visible Particles: %u (culled %u)", totalVisibleParticles, totalActiveParticles - totalVisibleParticles);
+			const ParticleBudgetStats& budgetStats = budget_.GetStats();
+			ImGui::Text("Spawned This Frame: %u / %u requested (dropped: LOD %u, budget %u, full %u)",
+				budgetStats.spawned, budgetStats.requested,
+				budgetStats.droppedByLod, budgetStats.droppedByBudget, budgetStats.droppedByGroupFull);
+			ImGui::Checkbox("Frustum Culling", &useFrustumCulling_);
+			ImGui::Text("Update Jobs: %zu chunks", chunkTasks_.size());
+			ImGui::Text("Fields: %zu enabled, %zu group tests culled", fieldEntries_.size(), culledFieldTestCount_);
+			instanceArena_.ImGui();
+
+			ImGui::Separator();
+
+			// 並列更新のワーカー数
+			JobSystem::GetInstance()->ImGui();
 
 			ImGui::Separator();
 		}
 
+		// 全体の予算（上限・距離LODと直近フレームの集計）
+		if (ImGui::CollapsingHeader("Budget")) {
+			budget_.ImGui();
+		}
+
 		// パーティクルグループ
 		if (ImGui::CollapsingHeader("Particle Groups")) {
 			if (groups_.empty()) {
@@ -133,6 +379,21 @@ void ParticleSystem::ImGui()
 				}
 			}
 		}
+
+		// 決定論モード（固定刻み・シード固定）
+		if (ImGui::CollapsingHeader("Deterministic")) {
+			bool deterministic = isDeterministic_;
+			if (ImGui::Checkbox("Enabled", &deterministic)) {
+				SetDeterministic(deterministic, deterministicSeed_);
+			}
+			ImGui::Text("Seed: %016llx", static_cast<unsigned long long>(deterministicSeed_));
+			ImGui::Text("Step: %.4f (max %u steps/frame)", fixedStepDriver_.GetStep(), fixedStepDriver_.GetMaxStepsPerFrame());
+		}
+
+		// ベンチマーク
+		if (ImGui::CollapsingHeader("Benchmark")) {
+			benchmark_.ImGui();
+		}
 		ImGui::TreePop();
 	}
 #endif
@@ -150,7 +411,7 @@ bool ParticleSystem::CreateGroup(const std::string& groupName, const std::string
 
 	// 新しいグループを作成
 	auto group = std::make_unique<ParticleGroup>();
-	group->Initialize(dxCommon_, modelTag, maxParticles, textureName, useBillboard);
+	group->Initialize(dxCommon_, &instanceArena_, modelTag, maxParticles, textureName, useBillboard);
 	group->SetName(groupName);
 
 	// グループを登録
@@ -202,6 +463,9 @@ ParticleEmitter* ParticleSystem::CreateEmitter(const std::string& emitterName, c
 	auto emitter = std::make_unique<ParticleEmitter>();
 	emitter->Initialize(dxCommon_, targetGroupName);
 	emitter->SetName(emitterName);
+	if (isDeterministic_) {
+		ApplyDeterministicSeed(emitterName, emitter.get());
+	}
 
 	// エミッターを登録
 	ParticleEmitter* emitterPtr = emitter.get();
@@ -1,4 +1,5 @@
 #pragma once
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -9,6 +10,10 @@
 #include "BaseField.h"
 #include "CameraController.h"
 #include "ParticleCommon.h"
+#include "ParticleInstanceArena.h"
+#include "ParticleFixedStepDriver.h"
+#include "ParticleBenchmark.h"
+#include "ParticleBudget.h"
 
 
 /// <summary>
@@ -39,6 +44,42 @@ public:
 	/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
 	void Update(const Matrix4x4& viewProjectionMatrix);
 
+	/// <summary>
+	/// 経過時間を指定して1ステップ更新（GameTimerを参照しない）
+	/// </summary>
+	/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
+	/// <param name="deltaTime">経過時間</param>
+	void Step(const Matrix4x4& viewProjectionMatrix, float deltaTime);
+
+	/// <summary>
+	/// 決定論モードの切り替え
+	/// <para>有効にすると全エミッターの乱数をシードとエミッター名から作り直し、固定刻みで更新する</para>
+	/// <para>同じシード・同じ操作なら毎回同じパーティクルが発生する（リプレイ・比較用）</para>
+	/// </summary>
+	/// <param name="enabled">有効にするか</param>
+	/// <param name="seed">基準のシード</param>
+	void SetDeterministic(bool enabled, uint64_t seed = kDefaultDeterministicSeed);
+	bool IsDeterministic() const { return isDeterministic_; }
+	uint64_t GetDeterministicSeed() const { return deterministicSeed_; }
+
+	/// <summary>
+	/// 決定論モードの固定刻みの設定
+	/// </summary>
+	ParticleFixedStepDriver& GetFixedStepDriver() { return fixedStepDriver_; }
+
+	/// <summary>
+	/// 視錐台カリングの有効・無効（無効なら生存パーティクルを全て書き込む）
+	/// </summary>
+	void SetFrustumCulling(bool enabled) { useFrustumCulling_ = enabled; }
+	bool IsFrustumCulling() const { return useFrustumCulling_; }
+
+	/// <summary>
+	/// 全体のパーティクル予算（生存数・1ステップの発生数の上限、距離LOD）
+	/// <para>集計はUpdate毎にリセットされる</para>
+	/// </summary>
+	ParticleBudget& GetBudget() { return budget_; }
+	const ParticleBudget& GetBudget() const { return budget_; }
+
 	/// <summary>
 	/// 全グループの描画
 	/// </summary>
@@ -173,20 +214,74 @@ public:
 	/// </summary>
 	std::vector<std::string> GetAllFieldNames() const;
 
+	// 決定論モードの既定シード
+	static constexpr uint64_t kDefaultDeterministicSeed = 0x5EED5EED5EED5EEDull;
+
 private:
 	ParticleSystem() = default;
 	~ParticleSystem() = default;
 
+	/// <summary>
+	/// 決定論モード用にエミッターの乱数シードを設定
+	/// </summary>
+	void ApplyDeterministicSeed(const std::string& emitterName, ParticleEmitter* emitter) const;
+
+	/// <summary>
+	/// 全エミッターの発生要求を集め、予算の範囲で発生させる
+	/// <para>要求の収集と発生はエミッターの並び順に行うので、乱数の消費順は予算が無い場合と変わらない</para>
+	/// </summary>
+	/// <param name="deltaTime">デルタタイム</param>
+	void EmitWithinBudget(float deltaTime);
+
 	/// <summary>
 	/// ビルボード行列を計算
 	/// </summary>
 	void CalculateBillboardMatrix();
 
+	/// <summary>
+	/// すべてのグループをJobSystemで並列に更新
+	/// </summary>
+	/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
+	/// <param name="deltaTime">デルタタイム</param>
+	void UpdateGroupsParallel(const Matrix4x4& viewProjectionMatrix, float deltaTime);
+
+	/// <summary>
+	/// groupList_から現在のパーティクル数でチャンクのジョブ一覧を作成
+	/// </summary>
+	void BuildChunkTasks();
+
+	/// <summary>
+	/// groupList_から可視数でGPU書き込みのジョブ一覧を作成
+	/// </summary>
+	void BuildWriteChunkTasks();
+
+	/// <summary>
+	/// groupList_から軌跡を持つグループの生存数で頂点書き込みのジョブ一覧を作成
+	/// </summary>
+	void BuildTrailChunkTasks();
+
+	// 予算の割り当て待ちの発生要求
+	struct EmissionRequest {
+		ParticleEmitter* emitter;
+		ParticleGroup* group;
+		uint32_t ticket;	// ParticleBudget::AddRequestの戻り値
+	};
+
+	// 並列更新の1ジョブ（グループのチャンク1つ）
+	struct ChunkTask {
+		ParticleGroup* group;
+		uint32_t chunkIndex;
+	};
+
+	// 全グループで共有するGPU転送用バッファ（グループより先に宣言し、後に破棄する）
+	ParticleInstanceArena instanceArena_;
+
 	// パーティクルグループ（グループ名 : グループ）
 	std::unordered_map<std::string, std::unique_ptr<ParticleGroup>> groups_;
 
 	// エミッター（エミッター名 : エミッター）
-	std::unordered_map<std::string, std::unique_ptr<ParticleEmitter>> emitters_;
+	// 名前順に並ぶ std::map にして、発生要求・予算の割り当ての順序を実行毎に変えない
+	std::map<std::string, std::unique_ptr<ParticleEmitter>> emitters_;
 
 	// フィールド（フィールド名 : フィールド）
 	std::unordered_map<std::string, std::unique_ptr<BaseField>> fields_;
@@ -194,6 +289,29 @@ private:
 	// ビルボード行列（全グループ共通）
 	Matrix4x4 billboardMatrix_;
 
+	// 頂点シェーダーに渡すビュー情報（ビュープロジェクション・ビルボード行列）
+	Microsoft::WRL::ComPtr<ID3D12Resource> viewResource_;
+	ParticleViewForGPU* viewData_ = nullptr;
+
+	// 並列更新用の作業リスト（毎フレーム再確保しないよう保持）
+	std::vector<FieldBroadphaseEntry> fieldEntries_;
+	size_t culledFieldTestCount_ = 0;	// ブロードフェーズで除外したグループ×フィールドの数（ImGui表示用）
+	std::vector<ParticleGroup*> groupList_;
+	std::vector<ChunkTask> chunkTasks_;
+	std::vector<EmissionRequest> emissionRequests_;
+	bool useFrustumCulling_ = true;		// 視錐台の外のパーティクルをGPUに書き込まない
+
+	// 全体のパーティクル予算
+	ParticleBudget budget_;
+
+	// 決定論モード
+	bool isDeterministic_ = false;
+	uint64_t deterministicSeed_ = kDefaultDeterministicSeed;
+	ParticleFixedStepDriver fixedStepDriver_;
+
+	// 更新処理のベンチマーク（ImGuiから実行）
+	ParticleBenchmark benchmark_;
+
 	// システム参照
 	DirectXCommon* dxCommon_ = nullptr;
 	CameraController* cameraController_ = CameraController::GetInstance();
@@ -1,4 +1,5 @@
 #include "Sprite.h"
+#include "BufferResource.h"
 #include <cassert>
 #include <cstring>
 #include "ImGui/ImGuiManager.h" 
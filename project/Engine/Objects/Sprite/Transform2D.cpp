@@ -1,4 +1,5 @@
 #include "Transform2D.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h" 
 
 void Transform2D::Initialize(DirectXCommon* dxCommon)
@@ -1,4 +1,5 @@
 #include "OffscreenTriangle.h"
+#include "BufferResource.h"
 #include "Logger.h"
 #include <cassert>
 
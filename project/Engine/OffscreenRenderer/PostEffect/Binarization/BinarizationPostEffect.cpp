@@ -1,4 +1,5 @@
 #include "BinarizationPostEffect.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h"
 
 void BinarizationPostEffect::Initialize(DirectXCommon* dxCommon) {
@@ -1,4 +1,5 @@
 #include "DepthFogPostEffect.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h" 
 
 void DepthFogPostEffect::Initialize(DirectXCommon* dxCommon) {
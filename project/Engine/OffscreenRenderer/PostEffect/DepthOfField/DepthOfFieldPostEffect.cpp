@@ -1,4 +1,5 @@
 #include "DepthOfFieldPostEffect.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h" 
 
 void DepthOfFieldPostEffect::Initialize(DirectXCommon* dxCommon) {
@@ -1,4 +1,5 @@
 #include "GrayscalePostEffect.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h" 
 
 void GrayscalePostEffect::Initialize(DirectXCommon* dxCommon) {
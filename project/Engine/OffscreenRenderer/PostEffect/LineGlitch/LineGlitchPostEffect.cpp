@@ -1,4 +1,5 @@
 #include "LineGlitchPostEffect.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h" 
 
 void LineGlitchPostEffect::Initialize(DirectXCommon* dxCommon) {
@@ -1,4 +1,5 @@
 #include "OutlinePostEffect.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h" 
 
 void OutlinePostEffect::Initialize(DirectXCommon* dxCommon) {
@@ -1,4 +1,5 @@
 #include "RGBShiftPostEffect.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h" 
 
 void RGBShiftPostEffect::Initialize(DirectXCommon* dxCommon) {
@@ -1,4 +1,5 @@
 #include "VignettePostEffect.h"
+#include "BufferResource.h"
 #include "ImGui/ImGuiManager.h" 
 
 void VignettePostEffect::Initialize(DirectXCommon* dxCommon) {
@@ -1,7 +1,11 @@
 #include "StringUtility.h"
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 
+#ifdef _WIN32
+
 /// string -> wstringに変換する関数
 std::wstring StringUtility::ConvertString(const std::string& str) {
 	if (str.empty()) {
@@ -29,3 +33,55 @@ std::string StringUtility::ConvertString(const std::wstring& str) {
 	WideCharToMultiByte(CP_UTF8, 0, str.data(), static_cast<int>(str.size()), result.data(), sizeNeeded, NULL, NULL);
 	return result;
 }
+
+#else
+
+// Windows 以外（ヘッドレス実行のツールなど）は wchar_t を UTF-32 として自前で変換する
+
+/// string -> wstringに変換する関数
+std::wstring StringUtility::ConvertString(const std::string& str) {
+	std::wstring result;
+	result.reserve(str.size());
+	for (size_t i = 0; i < str.size();) {
+		const unsigned char lead = static_cast<unsigned char>(str[i]);
+		// 先頭バイトから後続バイト数を決める（不正なバイトはそのまま1文字にする）
+		const size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 1;
+		if (i + length > str.size()) {
+			break;
+		}
+		char32_t code = length == 1 ? lead : lead & (0x7F >> length);
+		for (size_t j = 1; j < length; ++j) {
+			code = (code << 6) | (static_cast<unsigned char>(str[i + j]) & 0x3F);
+		}
+		result.push_back(static_cast<wchar_t>(code));
+		i += length;
+	}
+	return result;
+}
+
+/// wstring -> stringに変換する関数
+std::string StringUtility::ConvertString(const std::wstring& str) {
+	std::string result;
+	result.reserve(str.size());
+	for (wchar_t c : str) {
+		const char32_t code = static_cast<char32_t>(c);
+		if (code < 0x80) {
+			result.push_back(static_cast<char>(code));
+		} else if (code < 0x800) {
+			result.push_back(static_cast<char>(0xC0 | (code >> 6)));
+			result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+		} else if (code < 0x10000) {
+			result.push_back(static_cast<char>(0xE0 | (code >> 12)));
+			result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+		} else {
+			result.push_back(static_cast<char>(0xF0 | (code >> 18)));
+			result.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+		}
+	}
+	return result;
+}
+
+#endif
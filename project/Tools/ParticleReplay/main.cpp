@@ -0,0 +1,149 @@
+#include "ParticleHeadlessSimulation.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace {
+	/// <summary>
+	/// コマンドライン引数
+	/// </summary>
+	struct Options {
+		std::string presetDirectory = "resources/ParticlePresets";	// プリセットのフォルダ
+		std::vector<std::string> presetNames;						// 再生するプリセット（空なら全て）
+		uint64_t seed = 1;											// 基準のシード
+		uint32_t frameCount = 600;									// フレーム数
+		float fixedDeltaTime = 1.0f / 60.0f;						// 固定刻み
+		bool printFrameHashes = false;								// フレーム毎のハッシュを出力するか
+		bool saveBaseline = false;									// 結果を基準として保存するか
+		bool compareBaseline = false;								// 保存済みの基準と比較するか
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: ParticleReplay [options] [preset names...]\n"
+			"  --dir <path>     preset directory (default: resources/ParticlePresets)\n"
+			"  --seed <n>       base seed (default: 1)\n"
+			"  --frames <n>     frame count (default: 600)\n"
+			"  --frame-hashes   print the hash of every frame\n"
+			"  --save           save the hashes as <preset>.replay.txt\n"
+			"  --compare        compare against <preset>.replay.txt (exit code 1 on mismatch)\n");
+	}
+
+	/// <summary>
+	/// 引数を解析する
+	/// </summary>
+	/// <returns>不正な引数があった場合false</returns>
+	bool ParseOptions(int argc, char* argv[], Options& options) {
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+
+			if (arg == "--dir" && hasValue) {
+				options.presetDirectory = argv[++i];
+			} else if (arg == "--seed" && hasValue) {
+				options.seed = std::strtoull(argv[++i], nullptr, 10);
+			} else if (arg == "--frames" && hasValue) {
+				options.frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+			} else if (arg == "--frame-hashes") {
+				options.printFrameHashes = true;
+			} else if (arg == "--save") {
+				options.saveBaseline = true;
+			} else if (arg == "--compare") {
+				options.compareBaseline = true;
+			} else if (!arg.empty() && arg[0] != '-') {
+				options.presetNames.push_back(arg);
+			} else {
+				return false;
+			}
+		}
+		return options.frameCount > 0;
+	}
+
+	/// <summary>
+	/// フォルダ内のプリセット名を集める（基準ファイル等は除き、名前順に並べる）
+	/// </summary>
+	std::vector<std::string> CollectPresetNames(const std::string& directory) {
+		std::vector<std::string> names;
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+			if (entry.is_regular_file() && entry.path().extension() == ".json") {
+				names.push_back(entry.path().stem().string());
+			}
+		}
+		std::sort(names.begin(), names.end());
+		return names;
+	}
+}
+
+// プリセットをGPU・ウィンドウ無しで固定刻み再生し、状態ハッシュを出力する
+// 終了コード: 0 = 成功 / 1 = 基準と不一致 / 2 = 引数・読み込みの失敗
+int main(int argc, char* argv[]) {
+
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return 2;
+	}
+
+	if (options.presetNames.empty()) {
+		options.presetNames = CollectPresetNames(options.presetDirectory);
+	}
+	if (options.presetNames.empty()) {
+		std::fprintf(stderr, "No presets found in %s\n", options.presetDirectory.c_str());
+		return 2;
+	}
+
+	int exitCode = 0;
+	for (const std::string& name : options.presetNames) {
+		const std::string presetPath = options.presetDirectory + "/" + name + ".json";
+		const std::string baselinePath = options.presetDirectory + "/" + name + ".replay.txt";
+
+		ParticleHeadlessSimulation::Result result;
+		if (!ParticleHeadlessSimulation::RunPresetFile(presetPath, options.seed, options.frameCount,
+			options.fixedDeltaTime, result)) {
+			std::fprintf(stderr, "%s: failed to load %s\n", name.c_str(), presetPath.c_str());
+			exitCode = 2;
+			continue;
+		}
+
+		if (options.printFrameHashes) {
+			for (size_t frame = 0; frame < result.frameHashes.size(); ++frame) {
+				std::printf("%s %zu %016llx\n", name.c_str(), frame,
+					static_cast<unsigned long long>(result.frameHashes[frame]));
+			}
+		}
+
+		const uint64_t finalHash = result.frameHashes.empty() ? 0 : result.frameHashes.back();
+		std::printf("%-24s frames %u  updates %llu  %.3f ms  final %016llx",
+			name.c_str(), result.frameCount, static_cast<unsigned long long>(result.particleUpdates),
+			result.totalMs, static_cast<unsigned long long>(finalHash));
+
+		if (options.saveBaseline) {
+			const bool saved = ParticleHeadlessSimulation::SaveHashes(baselinePath, result);
+			std::printf("  %s", saved ? "saved" : "SAVE FAILED");
+			if (!saved) {
+				exitCode = 2;
+			}
+		}
+
+		if (options.compareBaseline) {
+			const int32_t mismatch = ParticleHeadlessSimulation::CompareHashes(baselinePath, result);
+			if (mismatch == -1) {
+				std::printf("  match");
+			} else if (mismatch == -2) {
+				std::printf("  NO BASELINE");
+				exitCode = std::max(exitCode, 2);
+			} else {
+				std::printf("  MISMATCH at frame %d", mismatch);
+				exitCode = std::max(exitCode, 1);
+			}
+		}
+		std::printf("\n");
+	}
+
+	return exitCode;
+}
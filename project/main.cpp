@@ -1,7 +1,38 @@
 #include <Windows.h>
+#include <string_view>
 #include "Game.h"
+#include "Logger.h"
+#include "JobSystem.h"
+#include "CollisionBenchmark.h"
+#include "CollisionNarrowphaseBenchmark.h"
+#include "ParticleBenchmark.h"
+
+namespace {
+	/// <summary>
+	/// ウィンドウを作らずにベンチマークと検証だけを実行する（結果はログに出力）
+	/// </summary>
+	/// <returns>終了コード（0: 全て成功 / 1: 検証に失敗したものがある）</returns>
+	int RunBenchmarks() {
+		Logger::Initialize();
+		JobSystem::GetInstance()->Initialize();
+
+		const bool collisionPassed = CollisionBenchmark::RunAll();
+		const bool narrowphasePassed = CollisionNarrowphaseBenchmark::RunAll();
+		const bool particlePassed = ParticleBenchmark::RunAll();
+
+		JobSystem::GetInstance()->Finalize();
+		Logger::Finalize();
+		return (collisionPassed && narrowphasePassed && particlePassed) ? 0 : 1;
+	}
+}
+
 // Windowsアプリでのエントリーポイント(main関数)
-int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR commandLine, int) {
+
+	// --benchmark 付きで起動した場合はベンチマークだけ実行して終了
+	if (std::string_view(commandLine).find("--benchmark") != std::string_view::npos) {
+		return RunBenchmarks();
+	}
 
 	// 全体の実行
 	std::unique_ptr<Game> game = std::make_unique<Game>();
@@ -1,13 +1,28 @@
 #include "resources/Shader/Particle/Particle.hlsli"
 
+// ビルボードを使用するか
+static const uint32_t kParticleFlagBillboard = 1u << 0;
+
+// CPU側で詰めたインスタンスデータ（32byte）
 struct ParticleForGPU
 {
-    float32_t4x4 WVP;
-    float32_t4x4 World;
-    float32_t4 color;
+    float32_t3 translate;
+    uint32_t color;         // RGBA8（下位からR,G,B,A）
+    uint32_t scaleXY;       // half x2（下位がX）
+    uint32_t scaleZRotateX; // half x2（下位がscaleZ）
+    uint32_t rotateYZ;      // half x2（下位がY、ラジアン）
+    uint32_t flags;
+};
+
+// 全インスタンス共通のビュー情報
+struct ParticleView
+{
+    float32_t4x4 viewProjection;
+    float32_t4x4 billboard;
 };
 
 StructuredBuffer<ParticleForGPU> gParticle : register(t0);
+ConstantBuffer<ParticleView> gView : register(b0);
 
 struct VertexShaderInput
 {
@@ -16,12 +31,57 @@ struct VertexShaderInput
     float32_t3 normal : NORMAL0;
 };
 
+float32_t2 UnpackHalf2(uint32_t packed)
+{
+    return float32_t2(f16tof32(packed), f16tof32(packed >> 16));
+}
+
+float32_t4 UnpackColor(uint32_t packed)
+{
+    return float32_t4(packed & 0xFF, (packed >> 8) & 0xFF, (packed >> 16) & 0xFF, packed >> 24) / 255.0f;
+}
+
+// スケール・回転・平行移動からワールド行列を組み立てる（CPU側のMakeAffineMatrixと同じ行ベクトル形式）
+float32_t4x4 MakeWorldMatrix(ParticleForGPU particle)
+{
+    float32_t2 scaleXY = UnpackHalf2(particle.scaleXY);
+    float32_t2 scaleZRotateX = UnpackHalf2(particle.scaleZRotateX);
+    float32_t3 scale = float32_t3(scaleXY, scaleZRotateX.x);
+
+    float32_t3x3 rotation;
+    if (particle.flags & kParticleFlagBillboard)
+    {
+        rotation = (float32_t3x3) gView.billboard;
+    }
+    else
+    {
+        float32_t2 rotateYZ = UnpackHalf2(particle.rotateYZ);
+        float32_t3 s, c;
+        sincos(float32_t3(scaleZRotateX.y, rotateYZ), s, c);
+
+        float32_t3x3 rotateX = float32_t3x3(1.0f, 0.0f, 0.0f, 0.0f, c.x, s.x, 0.0f, -s.x, c.x);
+        float32_t3x3 rotateY = float32_t3x3(c.y, 0.0f, -s.y, 0.0f, 1.0f, 0.0f, s.y, 0.0f, c.y);
+        float32_t3x3 rotateZ = float32_t3x3(c.z, s.z, 0.0f, -s.z, c.z, 0.0f, 0.0f, 0.0f, 1.0f);
+        rotation = mul(mul(rotateX, rotateY), rotateZ);
+    }
+
+    float32_t4x4 world;
+    world[0] = float32_t4(rotation[0] * scale.x, 0.0f);
+    world[1] = float32_t4(rotation[1] * scale.y, 0.0f);
+    world[2] = float32_t4(rotation[2] * scale.z, 0.0f);
+    world[3] = float32_t4(particle.translate, 1.0f);
+    return world;
+}
+
 VertexShaderOutput main(VertexShaderInput input, uint32_t instanceId : SV_InstanceID)
 {
+    ParticleForGPU particle = gParticle[instanceId];
+    float32_t4x4 world = MakeWorldMatrix(particle);
+
     VertexShaderOutput output;
-    output.position = mul(input.position, gParticle[instanceId].WVP);
+    output.position = mul(mul(input.position, world), gView.viewProjection);
     output.texcoord = input.texcoord;
-    output.normal = normalize(mul(input.normal, (float32_t3x3) gParticle[instanceId].World));
-    output.color = gParticle[instanceId].color;
+    output.normal = normalize(mul(input.normal, (float32_t3x3) world));
+    output.color = UnpackColor(particle.color);
     return output;
-}
\ No newline at end of file
+}
@@ -0,0 +1,37 @@
+#include "resources/Shader/Particle/Particle.hlsli"
+struct Material
+{
+    float32_t4 color; //色
+    int32_t enableLighting; //ライティングするか否か
+    int32_t useLambertianReflectance; //ランバート反射を利用するかどうか
+    float32_t4x4 uvTransform; //uvTransform
+};
+ConstantBuffer<Material> gMaterial : register(b0);
+
+Texture2D<float32_t4> gTexture : register(t0); //SRVのregisterはt
+SamplerState gSampler : register(s0); //Samplerはs
+
+struct PixelShaderOutput
+{
+    float32_t4 color : SV_TARGET0;
+};
+
+PixelShaderOutput main(VertexShaderOutput input)
+{
+    PixelShaderOutput output;
+
+    //UV座標を変換する
+    float4 transformedUV = mul(float32_t4(input.texcoord, 0.0f, 1.0f), gMaterial.uvTransform);
+    float32_t4 textureColor = gTexture.Sample(gSampler, transformedUV.xy);
+
+    // 軌跡は頂点色で末尾に向けてフェードするので、テクスチャのαでは切り抜かない
+    output.color = gMaterial.color * textureColor * input.color;
+
+    //output.colorのa値が0のときPixelを破棄(空白で塗りつぶされないように)
+    if (output.color.a == 0.0)
+    {
+        discard;
+    }
+
+    return output;
+}
@@ -0,0 +1,28 @@
+#include "resources/Shader/Particle/Particle.hlsli"
+
+// 全インスタンス共通のビュー情報（パーティクル本体と同じバッファを使う）
+struct ParticleView
+{
+    float32_t4x4 viewProjection;
+    float32_t4x4 billboard;
+};
+
+ConstantBuffer<ParticleView> gView : register(b0);
+
+// CPU側で組み立てた軌跡の頂点（ワールド座標）
+struct VertexShaderInput
+{
+    float32_t3 position : POSITION0;
+    float32_t4 color : COLOR0;      // RGBA8（UNORMで0～1に展開される）
+    float32_t2 texcoord : TEXCOORD0; // x:先頭0→末尾1、y:帯の左右
+};
+
+VertexShaderOutput main(VertexShaderInput input)
+{
+    VertexShaderOutput output;
+    output.position = mul(float32_t4(input.position, 1.0f), gView.viewProjection);
+    output.texcoord = input.texcoord;
+    output.normal = float32_t3(0.0f, 0.0f, -1.0f);
+    output.color = input.color;
+    return output;
+}